@@ -1,6 +1,7 @@
 #define _GNU_SOURCE
 #include "album_art.h"
-#include "wget_fetch.h"
+#include "http_client.h"
+#include "http_cache.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -227,7 +228,7 @@ void album_art_fetch(const char* artist, const char* title) {
         return;
     }
 
-    int bytes = wget_fetch(search_url, response_buf, 32 * 1024);
+    int bytes = http_cache_fetch(search_url, response_buf, 32 * 1024, HTTP_CACHE_TTL_ARTWORK);
     if (bytes <= 0) {
         LOG_error("Failed to fetch iTunes search results\n");
         free(response_buf);
@@ -313,7 +314,7 @@ void album_art_fetch(const char* artist, const char* title) {
         return;
     }
 
-    int image_bytes = wget_fetch(large_artwork_url, image_buf, 1024 * 1024);
+    int image_bytes = http_fetch(large_artwork_url, image_buf, 1024 * 1024, NULL);
     if (image_bytes <= 0) {
         LOG_error("Failed to download album art image (bytes=%d)\n", image_bytes);
         free(image_buf);
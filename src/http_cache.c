@@ -0,0 +1,363 @@
+#define _GNU_SOURCE
+#include "http_cache.h"
+#include "http_client.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <pthread.h>
+
+#include "defines.h"
+#include "api.h"
+
+#define HTTP_CACHE_DIR    SDCARD_PATH "/.cache/http"
+#define CACHE_PARENT_DIR  SDCARD_PATH "/.cache"
+
+#define HTTP_CACHE_MAGIC 0x48434531  // "HCE1"
+
+// Background revalidations allowed at once (others wait for a later call)
+#define HTTP_CACHE_MAX_REVALIDATIONS 4
+
+// Entries read more recently than this keep their mtime (LRU clock), to
+// avoid a directory write on every hit
+#define HTTP_CACHE_TOUCH_INTERVAL (60 * 60)
+
+// On-disk entry: header, then the URL (collision check), then the body
+typedef struct {
+    uint32_t magic;
+    int32_t status;         // 200, or 404 for a cached "no such resource"
+    int64_t stored_at;      // Time of the last fetch or successful revalidation
+    int32_t url_len;
+    int32_t body_len;
+    HttpValidators validators;
+} CacheEntryHeader;
+
+typedef struct {
+    char* url;
+    int buffer_size;
+} RevalidateArgs;
+
+static pthread_mutex_t cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int64_t cache_bytes = -1;  // Total entry size on disk, -1 until first scanned
+static uint64_t revalidating[HTTP_CACHE_MAX_REVALIDATIONS];
+
+// 64-bit FNV-1a of the URL names the entry
+static uint64_t url_key(const char* url) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    while (*url) {
+        hash ^= (uint8_t)*url++;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static void entry_path(uint64_t key, char* path, int path_size) {
+    snprintf(path, path_size, "%s/%016llx", HTTP_CACHE_DIR, (unsigned long long)key);
+}
+
+// Read an entry's header (and body, if buffer is given) for url.
+// Returns body bytes copied (truncated to buffer_size - 1), or -1 if there
+// is no valid entry for this URL
+static int read_entry(const char* path, const char* url, CacheEntryHeader* hdr,
+                      uint8_t* buffer, int buffer_size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+
+    int result = -1;
+    int url_len = strlen(url);
+    char* stored_url = NULL;
+
+    if (fread(hdr, sizeof(*hdr), 1, f) != 1 || hdr->magic != HTTP_CACHE_MAGIC ||
+        hdr->url_len != url_len || hdr->body_len < 0) {
+        goto done;
+    }
+
+    stored_url = (char*)malloc(url_len);
+    if (!stored_url || fread(stored_url, 1, url_len, f) != (size_t)url_len ||
+        memcmp(stored_url, url, url_len) != 0) {
+        goto done;
+    }
+
+    if (!buffer) {
+        result = 0;
+        goto done;
+    }
+
+    int len = hdr->body_len;
+    if (len > buffer_size - 1) len = buffer_size - 1;
+    if (fread(buffer, 1, len, f) == (size_t)len) {
+        result = len;
+    }
+
+done:
+    free(stored_url);
+    fclose(f);
+    return result;
+}
+
+typedef struct {
+    char name[24];
+    time_t mtime;
+    int64_t size;
+} CacheFile;
+
+static int compare_mtime(const void* a, const void* b) {
+    time_t ta = ((const CacheFile*)a)->mtime;
+    time_t tb = ((const CacheFile*)b)->mtime;
+    return (ta > tb) - (ta < tb);
+}
+
+// Scan the cache directory. With evict set, remove least recently used
+// entries until the total is back under 3/4 of the budget.
+// Call with cache_mutex held
+static void scan_cache(bool evict) {
+    DIR* dir = opendir(HTTP_CACHE_DIR);
+    if (!dir) {
+        cache_bytes = 0;
+        return;
+    }
+
+    int count = 0, capacity = 0;
+    CacheFile* files = NULL;
+    int64_t total = 0;
+
+    struct dirent* ent;
+    while ((ent = readdir(dir)) != NULL) {
+        if (ent->d_name[0] == '.' || strlen(ent->d_name) != 16) continue;
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", HTTP_CACHE_DIR, ent->d_name);
+        struct stat st;
+        if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) continue;
+        total += st.st_size;
+
+        if (!evict) continue;
+        if (count == capacity) {
+            int new_capacity = capacity ? capacity * 2 : 64;
+            CacheFile* grown = (CacheFile*)realloc(files, new_capacity * sizeof(CacheFile));
+            if (!grown) continue;
+            files = grown;
+            capacity = new_capacity;
+        }
+        snprintf(files[count].name, sizeof(files[count].name), "%s", ent->d_name);
+        files[count].mtime = st.st_mtime;
+        files[count].size = st.st_size;
+        count++;
+    }
+    closedir(dir);
+
+    if (count > 0) {
+        qsort(files, count, sizeof(CacheFile), compare_mtime);
+        for (int i = 0; i < count && total > HTTP_CACHE_MAX_BYTES * 3 / 4; i++) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/%s", HTTP_CACHE_DIR, files[i].name);
+            if (unlink(path) == 0) {
+                total -= files[i].size;
+            }
+        }
+    }
+
+    free(files);
+    cache_bytes = total;
+}
+
+// Write an entry atomically (temp file + rename) and keep the budget
+static void store_entry(uint64_t key, const char* url, int status,
+                        const HttpValidators* validators, const uint8_t* body, int body_len) {
+    char path[512], tmp_path[520];
+    entry_path(key, path, sizeof(path));
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    CacheEntryHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = HTTP_CACHE_MAGIC;
+    hdr.status = status;
+    hdr.stored_at = (int64_t)time(NULL);
+    hdr.url_len = strlen(url);
+    hdr.body_len = body_len;
+    if (validators) hdr.validators = *validators;
+
+    pthread_mutex_lock(&cache_mutex);
+
+    mkdir(CACHE_PARENT_DIR, 0755);
+    mkdir(HTTP_CACHE_DIR, 0755);
+    if (cache_bytes < 0) scan_cache(false);
+
+    FILE* f = fopen(tmp_path, "wb");
+    if (!f) {
+        pthread_mutex_unlock(&cache_mutex);
+        return;
+    }
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+              fwrite(url, 1, hdr.url_len, f) == (size_t)hdr.url_len &&
+              (body_len == 0 || fwrite(body, 1, body_len, f) == (size_t)body_len);
+    if (fclose(f) != 0) ok = false;
+
+    struct stat old;
+    int64_t old_size = stat(path, &old) == 0 ? old.st_size : 0;
+    if (ok && rename(tmp_path, path) == 0) {
+        cache_bytes += (int64_t)(sizeof(hdr) + hdr.url_len + body_len) - old_size;
+        if (cache_bytes > HTTP_CACHE_MAX_BYTES) {
+            scan_cache(true);
+        }
+    } else {
+        LOG_error("[HTTPCache] Failed to write entry for %s\n", url);
+        unlink(tmp_path);
+    }
+
+    pthread_mutex_unlock(&cache_mutex);
+}
+
+// A 304 confirmed the entry: restart its freshness lifetime in place
+static void refresh_entry(uint64_t key, CacheEntryHeader* hdr) {
+    char path[512];
+    entry_path(key, path, sizeof(path));
+
+    pthread_mutex_lock(&cache_mutex);
+    FILE* f = fopen(path, "r+b");
+    if (f) {
+        hdr->stored_at = (int64_t)time(NULL);
+        fwrite(hdr, sizeof(*hdr), 1, f);
+        fclose(f);
+    }
+    pthread_mutex_unlock(&cache_mutex);
+}
+
+// Fetch url into buffer and store the result. old is the current entry, if any.
+// Returns body bytes, HTTP_NOT_MODIFIED (entry still current), or -1
+static int fetch_and_store(uint64_t key, const char* url, uint8_t* buffer, int buffer_size,
+                           CacheEntryHeader* old) {
+    if (old && old->status == 200 &&
+        (old->validators.etag[0] || old->validators.last_modified[0])) {
+        HttpValidators validators = old->validators;
+        int bytes = http_fetch_conditional(url, buffer, buffer_size, &validators);
+        if (bytes == HTTP_NOT_MODIFIED) {
+            refresh_entry(key, old);
+        } else if (bytes >= 0) {
+            store_entry(key, url, 200, &validators, buffer, bytes);
+        }
+        return bytes;
+    }
+
+    HttpResponse* resp = (HttpResponse*)malloc(sizeof(HttpResponse));
+    if (!resp) return -1;
+    memset(resp, 0, sizeof(*resp));
+
+    int bytes = http_fetch(url, buffer, buffer_size, resp);
+    if (bytes >= 0) {
+        store_entry(key, url, 200, &resp->validators, buffer, bytes);
+    } else if (resp->status == 404) {
+        store_entry(key, url, 404, NULL, NULL, 0);
+    }
+
+    free(resp);
+    return bytes;
+}
+
+static void* revalidate_thread(void* arg) {
+    RevalidateArgs* args = (RevalidateArgs*)arg;
+    uint64_t key = url_key(args->url);
+
+    char path[512];
+    entry_path(key, path, sizeof(path));
+
+    CacheEntryHeader hdr;
+    uint8_t* buffer = (uint8_t*)malloc(args->buffer_size);
+    if (buffer) {
+        bool have_entry = read_entry(path, args->url, &hdr, NULL, 0) == 0;
+        // On failure (offline) the stale entry simply stays in use
+        fetch_and_store(key, args->url, buffer, args->buffer_size, have_entry ? &hdr : NULL);
+        free(buffer);
+    }
+
+    pthread_mutex_lock(&cache_mutex);
+    for (int i = 0; i < HTTP_CACHE_MAX_REVALIDATIONS; i++) {
+        if (revalidating[i] == key) {
+            revalidating[i] = 0;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&cache_mutex);
+
+    free(args->url);
+    free(args);
+    return NULL;
+}
+
+// Start a background refresh of a stale entry unless one is already running
+static void revalidate_async(uint64_t key, const char* url, int buffer_size) {
+    pthread_mutex_lock(&cache_mutex);
+    int slot = -1;
+    for (int i = 0; i < HTTP_CACHE_MAX_REVALIDATIONS; i++) {
+        if (revalidating[i] == key) {
+            pthread_mutex_unlock(&cache_mutex);
+            return;
+        }
+        if (revalidating[i] == 0 && slot < 0) slot = i;
+    }
+    if (slot < 0) {
+        pthread_mutex_unlock(&cache_mutex);
+        return;
+    }
+    revalidating[slot] = key;
+    pthread_mutex_unlock(&cache_mutex);
+
+    RevalidateArgs* args = (RevalidateArgs*)malloc(sizeof(RevalidateArgs));
+    if (args) {
+        args->url = strdup(url);
+        args->buffer_size = buffer_size;
+    }
+
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    bool started = args && args->url &&
+                   pthread_create(&thread, &attr, revalidate_thread, args) == 0;
+    pthread_attr_destroy(&attr);
+
+    if (!started) {
+        if (args) free(args->url);
+        free(args);
+        pthread_mutex_lock(&cache_mutex);
+        revalidating[slot] = 0;
+        pthread_mutex_unlock(&cache_mutex);
+    }
+}
+
+int http_cache_fetch(const char* url, uint8_t* buffer, int buffer_size, int ttl_sec) {
+    if (!url || !buffer || buffer_size <= 0) {
+        return -1;
+    }
+
+    uint64_t key = url_key(url);
+    char path[512];
+    entry_path(key, path, sizeof(path));
+
+    CacheEntryHeader hdr;
+    int bytes = read_entry(path, url, &hdr, buffer, buffer_size);
+    if (bytes < 0) {
+        // Miss: fetch now
+        return fetch_and_store(key, url, buffer, buffer_size, NULL);
+    }
+
+    time_t now = time(NULL);
+    int64_t age = (int64_t)now - hdr.stored_at;
+    if (age < 0 || age >= ttl_sec) {
+        revalidate_async(key, url, buffer_size);
+    }
+
+    // Advance the LRU clock (mtime) of entries in use
+    struct stat st;
+    if (stat(path, &st) == 0 && now - st.st_mtime > HTTP_CACHE_TOUCH_INTERVAL) {
+        utime(path, NULL);
+    }
+
+    return hdr.status == 200 ? bytes : -1;
+}
@@ -0,0 +1,35 @@
+#ifndef HTTP_CACHE_H
+#define HTTP_CACHE_H
+
+#include <stdint.h>
+
+// Freshness lifetimes of the metadata APIs (seconds)
+#define HTTP_CACHE_TTL_SEARCH   (6 * 60 * 60)        // iTunes podcast search
+#define HTTP_CACHE_TTL_LOOKUP   (24 * 60 * 60)       // iTunes lookup by id
+#define HTTP_CACHE_TTL_LYRICS   (7 * 24 * 60 * 60)   // lrclib get/search
+#define HTTP_CACHE_TTL_ARTWORK  (30 * 24 * 60 * 60)  // iTunes album art query
+
+// Total size of cached responses before least recently used ones are evicted
+#define HTTP_CACHE_MAX_BYTES (4 * 1024 * 1024)
+
+/**
+ * Fetch a small API response through the disk cache in .cache/http.
+ *
+ * - Fresh entry (younger than ttl_sec): returned without touching the network.
+ * - Stale entry: returned immediately and revalidated in the background
+ *   (conditional GET), so the next call sees the refreshed copy.
+ * - No entry: fetched synchronously and stored.
+ *
+ * Any stored entry is used when the network is unavailable, and a 404 is
+ * cached too (as a -1 result) so lookups that have no answer aren't
+ * repeated on every call. Safe to call from any thread.
+ *
+ * @param url          The URL to fetch
+ * @param buffer       Buffer to store response body (at most buffer_size - 1 bytes)
+ * @param buffer_size  Size of buffer
+ * @param ttl_sec      Freshness lifetime for this endpoint (HTTP_CACHE_TTL_*)
+ * @return             Bytes stored in buffer, -1 on failure or no content
+ */
+int http_cache_fetch(const char* url, uint8_t* buffer, int buffer_size, int ttl_sec);
+
+#endif // HTTP_CACHE_H
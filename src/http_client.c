@@ -0,0 +1,718 @@
+#define _GNU_SOURCE
+#include "http_client.h"
+#include "radio_net.h"
+#include "net_dns.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <limits.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+// zlib for gzip/deflate response bodies
+#include <zlib.h>
+
+#include "mbedtls/net_sockets.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+
+#include "defines.h"
+#include "api.h"
+
+// TLS 1.3: mbedtls_ssl_read/write may return non-fatal errors that require retry
+#define SSL_READ_IS_RETRYABLE(r) \
+    ((r) == MBEDTLS_ERR_SSL_WANT_READ || \
+     (r) == MBEDTLS_ERR_SSL_WANT_WRITE || \
+     (r) == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET)
+
+#define HTTP_CLIENT_BUF_SIZE 16384      // Socket read-ahead
+#define HTTP_CLIENT_LINE_MAX 4096       // Longest status/header line kept
+#define HTTP_CLIENT_SSL_RETRIES 3       // WANT_READ/WRITE means the socket timed out
+#define HTTP_CLIENT_HANDSHAKE_RETRIES 100
+
+// One connection (plain or TLS) with a read-ahead buffer.
+// Heap allocated: the mbedTLS contexts are large.
+typedef struct {
+    int fd;
+    bool use_ssl;
+    bool ssl_ready;
+    mbedtls_net_context net;
+    mbedtls_ssl_context ssl;
+    mbedtls_ssl_config conf;
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context ctr_drbg;
+    volatile bool* should_stop;
+
+    uint8_t buf[HTTP_CLIENT_BUF_SIZE];
+    int buf_pos;
+    int buf_len;
+} HttpConn;
+
+typedef enum {
+    HTTP_ENCODING_IDENTITY = 0,
+    HTTP_ENCODING_GZIP,
+    HTTP_ENCODING_DEFLATE
+} HttpEncoding;
+
+// Response headers the client acts on
+typedef struct {
+    int status;
+    int64_t content_length;
+    bool chunked;
+    HttpEncoding encoding;
+    char location[HTTP_CLIENT_MAX_URL];
+    char content_type[128];
+    HttpValidators validators;
+    int64_t range_start;
+    int64_t range_total;        // From Content-Range, -1 if absent or "*"
+    bool accept_ranges;
+} HttpHeaders;
+
+// Body delivery, with optional inflate
+typedef struct {
+    const HttpRequest* req;
+    HttpResponse* resp;
+    int64_t wire_bytes;
+    HttpEncoding encoding;
+    bool inflating;             // zlib stream set up (on the first body bytes)
+    z_stream zs;
+    uint8_t* zbuf;
+} HttpBodySink;
+
+static bool conn_stopped(HttpConn* c) {
+    return c->should_stop && *c->should_stop;
+}
+
+static void conn_close(HttpConn* c) {
+    if (!c) return;
+    if (c->use_ssl) {
+        if (c->ssl_ready) {
+            mbedtls_ssl_close_notify(&c->ssl);
+        }
+        mbedtls_net_free(&c->net);  // Closes the socket
+        mbedtls_ssl_free(&c->ssl);
+        mbedtls_ssl_config_free(&c->conf);
+        mbedtls_ctr_drbg_free(&c->ctr_drbg);
+        mbedtls_entropy_free(&c->entropy);
+    } else if (c->fd >= 0) {
+        close(c->fd);
+    }
+    free(c);
+}
+
+static HttpConn* conn_open(const char* host, int port, bool https, int timeout_ms,
+                           volatile bool* should_stop) {
+    HttpConn* c = (HttpConn*)calloc(1, sizeof(HttpConn));
+    if (!c) {
+        LOG_error("[HTTP] Failed to allocate connection\n");
+        return NULL;
+    }
+    c->fd = -1;
+    c->use_ssl = https;
+    c->should_stop = should_stop;
+
+    if (https) {
+        const char* pers = "http_client";
+        mbedtls_net_init(&c->net);
+        mbedtls_ssl_init(&c->ssl);
+        mbedtls_ssl_config_init(&c->conf);
+        mbedtls_entropy_init(&c->entropy);
+        mbedtls_ctr_drbg_init(&c->ctr_drbg);
+
+        if (mbedtls_ctr_drbg_seed(&c->ctr_drbg, mbedtls_entropy_func, &c->entropy,
+                                  (const unsigned char*)pers, strlen(pers)) != 0 ||
+            mbedtls_ssl_config_defaults(&c->conf, MBEDTLS_SSL_IS_CLIENT,
+                                        MBEDTLS_SSL_TRANSPORT_STREAM,
+                                        MBEDTLS_SSL_PRESET_DEFAULT) != 0) {
+            LOG_error("[HTTP] SSL setup failed\n");
+            goto fail;
+        }
+        mbedtls_ssl_conf_authmode(&c->conf, MBEDTLS_SSL_VERIFY_NONE);
+        mbedtls_ssl_conf_rng(&c->conf, mbedtls_ctr_drbg_random, &c->ctr_drbg);
+
+        if (mbedtls_ssl_setup(&c->ssl, &c->conf) != 0) {
+            LOG_error("[HTTP] mbedtls_ssl_setup failed\n");
+            goto fail;
+        }
+        mbedtls_ssl_set_hostname(&c->ssl, host);
+    }
+
+    c->fd = net_dns_connect(host, port, timeout_ms);
+    if (c->fd < 0) {
+        LOG_error("[HTTP] Connect failed (host=%s, port=%d)\n", host, port);
+        goto fail;
+    }
+    c->net.fd = c->fd;
+
+    struct timeval tv = {timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+    setsockopt(c->fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(c->fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    if (https) {
+        mbedtls_ssl_set_bio(&c->ssl, &c->net, mbedtls_net_send, mbedtls_net_recv, NULL);
+
+        int ret;
+        int retries = 0;
+        while ((ret = mbedtls_ssl_handshake(&c->ssl)) != 0) {
+            // TLS 1.3: session ticket received means handshake is complete
+            if (ret == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET) break;
+            if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+                LOG_error("[HTTP] SSL handshake failed: -0x%04X host=%s\n", -ret, host);
+                goto fail;
+            }
+            if (conn_stopped(c) || ++retries > HTTP_CLIENT_HANDSHAKE_RETRIES) {
+                LOG_error("[HTTP] SSL handshake timeout host=%s\n", host);
+                goto fail;
+            }
+            usleep(100000);
+        }
+        c->ssl_ready = true;
+    }
+
+    return c;
+
+fail:
+    conn_close(c);
+    return NULL;
+}
+
+static int conn_write_all(HttpConn* c, const char* data, int len) {
+    int sent = 0;
+    int retries = 0;
+    while (sent < len) {
+        int r;
+        if (c->use_ssl) {
+            r = mbedtls_ssl_write(&c->ssl, (const unsigned char*)data + sent, len - sent);
+            if (SSL_READ_IS_RETRYABLE(r)) {
+                if (++retries > HTTP_CLIENT_SSL_RETRIES) return -1;
+                continue;
+            }
+        } else {
+            r = send(c->fd, data + sent, len - sent, MSG_NOSIGNAL);
+            if (r < 0 && errno == EINTR) continue;
+        }
+        if (r <= 0) return -1;
+        sent += r;
+    }
+    return 0;
+}
+
+// Returns bytes received, 0 on EOF, -1 on error, timeout or cancellation
+static int conn_recv(HttpConn* c, uint8_t* dst, int len) {
+    int retries = 0;
+    while (!conn_stopped(c)) {
+        int r;
+        if (c->use_ssl) {
+            r = mbedtls_ssl_read(&c->ssl, dst, len);
+            if (r == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) return 0;
+            if (r == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET) continue;
+            if (SSL_READ_IS_RETRYABLE(r)) {
+                if (++retries > HTTP_CLIENT_SSL_RETRIES) return -1;
+                continue;
+            }
+        } else {
+            r = recv(c->fd, dst, len, 0);
+            if (r < 0 && errno == EINTR) continue;
+        }
+        return r < 0 ? -1 : r;
+    }
+    return -1;
+}
+
+// Take up to max bytes from the read-ahead buffer, refilling it if empty.
+// *data points into the buffer. Returns count, 0 on EOF, -1 on error
+static int conn_next(HttpConn* c, const uint8_t** data, int max) {
+    if (c->buf_pos >= c->buf_len) {
+        int r = conn_recv(c, c->buf, sizeof(c->buf));
+        if (r <= 0) return r;
+        c->buf_pos = 0;
+        c->buf_len = r;
+    }
+    int n = c->buf_len - c->buf_pos;
+    if (n > max) n = max;
+    *data = c->buf + c->buf_pos;
+    c->buf_pos += n;
+    return n;
+}
+
+// Read one CRLF-terminated line (overlong lines are truncated).
+// Returns line length, -1 on EOF or error
+static int conn_read_line(HttpConn* c, char* line, int size) {
+    int len = 0;
+    while (1) {
+        const uint8_t* p;
+        if (conn_next(c, &p, 1) <= 0) return -1;
+        if (*p == '\n') break;
+        if (*p != '\r' && len < size - 1) line[len++] = *p;
+    }
+    line[len] = '\0';
+    return len;
+}
+
+static int read_headers(HttpConn* c, HttpHeaders* h) {
+    char line[HTTP_CLIENT_LINE_MAX];
+
+    // Skip interim 1xx responses
+    do {
+        memset(h, 0, sizeof(HttpHeaders));
+        h->content_length = -1;
+        h->range_total = -1;
+
+        if (conn_read_line(c, line, sizeof(line)) < 0) return -1;
+        if (strncmp(line, "HTTP/", 5) != 0) {
+            LOG_error("[HTTP] Bad status line: %.64s\n", line);
+            return -1;
+        }
+        char* space = strchr(line, ' ');
+        h->status = space ? atoi(space + 1) : 0;
+
+        int len;
+        while ((len = conn_read_line(c, line, sizeof(line))) > 0) {
+            char* value = strchr(line, ':');
+            if (!value) continue;
+            *value++ = '\0';
+            while (*value == ' ' || *value == '\t') value++;
+
+            if (strcasecmp(line, "Content-Length") == 0) {
+                h->content_length = strtoll(value, NULL, 10);
+            } else if (strcasecmp(line, "Transfer-Encoding") == 0) {
+                h->chunked = strcasestr(value, "chunked") != NULL;
+            } else if (strcasecmp(line, "Content-Encoding") == 0) {
+                if (strcasestr(value, "gzip")) h->encoding = HTTP_ENCODING_GZIP;
+                else if (strcasestr(value, "deflate")) h->encoding = HTTP_ENCODING_DEFLATE;
+            } else if (strcasecmp(line, "ETag") == 0) {
+                strncpy(h->validators.etag, value, sizeof(h->validators.etag) - 1);
+            } else if (strcasecmp(line, "Last-Modified") == 0) {
+                strncpy(h->validators.last_modified, value, sizeof(h->validators.last_modified) - 1);
+            } else if (strcasecmp(line, "Accept-Ranges") == 0) {
+                h->accept_ranges = strcasestr(value, "bytes") != NULL;
+            } else if (strcasecmp(line, "Content-Range") == 0) {
+                // bytes <first>-<last>/<total or *>
+                long long first, last, total;
+                if (sscanf(value, "bytes %lld-%lld/%lld", &first, &last, &total) == 3) {
+                    h->range_start = first;
+                    h->range_total = total;
+                } else if (sscanf(value, "bytes %lld-%lld", &first, &last) == 2) {
+                    h->range_start = first;
+                } else if (sscanf(value, "bytes */%lld", &total) == 1) {
+                    h->range_total = total;  // 416: the offset was past the end
+                }
+            } else if (strcasecmp(line, "Location") == 0) {
+                strncpy(h->location, value, sizeof(h->location) - 1);
+            } else if (strcasecmp(line, "Content-Type") == 0) {
+                int n = strcspn(value, "; ");
+                if (n >= (int)sizeof(h->content_type)) n = sizeof(h->content_type) - 1;
+                memcpy(h->content_type, value, n);
+                h->content_type[n] = '\0';
+            }
+        }
+        if (len < 0) return -1;
+    } while (h->status >= 100 && h->status < 200);
+
+    return 0;
+}
+
+// Resolve a Location header against the URL that returned it
+static void resolve_location(const char* base, const char* location, char* out, int size) {
+    if (strncmp(location, "http://", 7) == 0 || strncmp(location, "https://", 8) == 0) {
+        snprintf(out, size, "%s", location);
+        return;
+    }
+
+    const char* authority = strstr(base, "://");
+    authority = authority ? authority + 3 : base;
+    const char* path = strchr(authority, '/');
+    int origin_len = path ? (int)(path - base) : (int)strlen(base);
+
+    if (location[0] == '/' && location[1] == '/') {
+        // Scheme-relative
+        int scheme_len = (int)(authority - base) - 2;
+        snprintf(out, size, "%.*s%s", scheme_len, base, location);
+    } else if (location[0] == '/') {
+        snprintf(out, size, "%.*s%s", origin_len, base, location);
+    } else {
+        // Relative to the directory of the base path (ignoring any query)
+        int dir_len = origin_len;
+        if (path) {
+            const char* query = strchr(path, '?');
+            const char* end = query ? query : path + strlen(path);
+            while (end > path && end[-1] != '/') end--;
+            dir_len = (int)(end - base);
+        }
+        snprintf(out, size, "%.*s%s%s", dir_len, base, path ? "" : "/", location);
+    }
+}
+
+// Returns 0 to continue, >0 if the receiver has all it wants, -1 to abort
+static int sink_deliver(HttpBodySink* s, const uint8_t* data, int len) {
+    s->resp->body_bytes += len;
+    return s->req->on_body ? s->req->on_body(data, len, s->req->userdata) : 0;
+}
+
+// Set up zlib for the body's Content-Encoding, looking at its first bytes
+static int sink_start_inflate(HttpBodySink* s, const uint8_t* data, int len) {
+    int window_bits = MAX_WBITS + 16;  // gzip header
+    if (s->encoding == HTTP_ENCODING_DEFLATE) {
+        // "deflate" should be zlib-wrapped, but some servers send raw deflate
+        bool zlib_header = (data[0] & 0x0f) == 8 &&
+                           (len < 2 || ((data[0] << 8) | data[1]) % 31 == 0);
+        window_bits = zlib_header ? MAX_WBITS : -MAX_WBITS;
+    }
+
+    s->zbuf = (uint8_t*)malloc(HTTP_CLIENT_BUF_SIZE);
+    if (!s->zbuf || inflateInit2(&s->zs, window_bits) != Z_OK) {
+        LOG_error("[HTTP] Failed to set up decompression\n");
+        return -1;
+    }
+    s->inflating = true;
+    return 0;
+}
+
+static int sink_write(HttpBodySink* s, const uint8_t* data, int len) {
+    s->wire_bytes += len;
+    int ret = 0;
+
+    if (s->encoding != HTTP_ENCODING_IDENTITY && !s->inflating &&
+        sink_start_inflate(s, data, len) != 0) {
+        return -1;
+    }
+
+    if (!s->inflating) {
+        ret = sink_deliver(s, data, len);
+    } else {
+        s->zs.next_in = (Bytef*)data;
+        s->zs.avail_in = len;
+        do {
+            s->zs.next_out = s->zbuf;
+            s->zs.avail_out = HTTP_CLIENT_BUF_SIZE;
+            int zret = inflate(&s->zs, Z_NO_FLUSH);
+            if (zret != Z_OK && zret != Z_STREAM_END && zret != Z_BUF_ERROR) {
+                LOG_error("[HTTP] Decompression failed: %d\n", zret);
+                return -1;
+            }
+
+            int produced = HTTP_CLIENT_BUF_SIZE - s->zs.avail_out;
+            if (produced > 0) ret = sink_deliver(s, s->zbuf, produced);
+            if (ret != 0 || zret != Z_OK) break;  // Done, or no progress possible
+        } while (s->zs.avail_in > 0 || s->zs.avail_out == 0);
+    }
+
+    if (ret >= 0 && s->req->on_progress) {
+        s->req->on_progress(s->wire_bytes, s->resp->content_length, s->req->userdata);
+    }
+    return ret;
+}
+
+static int read_exact(HttpConn* c, int64_t remaining, HttpBodySink* s) {
+    while (remaining > 0) {
+        const uint8_t* p;
+        int n = conn_next(c, &p, remaining > INT_MAX ? INT_MAX : (int)remaining);
+        if (n <= 0) return -1;
+
+        int ret = sink_write(s, p, n);
+        if (ret != 0) return ret;
+        remaining -= n;
+    }
+    return 0;
+}
+
+// Returns 0 when the body is complete, >0 if the receiver stopped early, -1 on error
+static int read_body(HttpConn* c, const HttpHeaders* h, HttpBodySink* s) {
+    if (h->chunked) {
+        char line[64];
+        while (1) {
+            if (conn_read_line(c, line, sizeof(line)) < 0) return -1;
+            int64_t size = strtoll(line, NULL, 16);  // Stops at any chunk extension
+            if (size < 0) return -1;
+            if (size == 0) {
+                // Skip trailers (a missing final CRLF is harmless)
+                while (conn_read_line(c, line, sizeof(line)) > 0) {}
+                return 0;
+            }
+
+            int ret = read_exact(c, size, s);
+            if (ret != 0) return ret;
+            if (conn_read_line(c, line, sizeof(line)) < 0) return -1;  // CRLF after data
+        }
+    }
+
+    if (h->content_length >= 0) {
+        return read_exact(c, h->content_length, s);
+    }
+
+    // No length: body runs until the server closes the connection
+    while (1) {
+        const uint8_t* p;
+        int n = conn_next(c, &p, INT_MAX);
+        if (n == 0) return 0;
+        if (n < 0) return -1;
+
+        int ret = sink_write(s, p, n);
+        if (ret != 0) return ret;
+    }
+}
+
+// One request/response on resp->final_url.
+// Returns 0 when complete, 1 for a redirect (next_url filled), -1 on error
+static int http_exchange(const HttpRequest* req, HttpResponse* resp, int timeout_ms,
+                         char* next_url, int next_size) {
+    char host[256];
+    char path[HTTP_CLIENT_MAX_URL];
+    int port;
+    bool https;
+
+    if (radio_net_parse_url(resp->final_url, host, sizeof(host), &port,
+                            path, sizeof(path), &https) != 0 || !host[0]) {
+        LOG_error("[HTTP] Failed to parse URL: %s\n", resp->final_url);
+        return -1;
+    }
+
+    HttpConn* c = conn_open(host, port, https, timeout_ms, req->should_stop);
+    if (!c) return -1;
+
+    // Host carries the port only when it isn't the scheme default
+    char host_header[272];
+    if (port != (https ? 443 : 80)) {
+        snprintf(host_header, sizeof(host_header), "%s:%d", host, port);
+    } else {
+        snprintf(host_header, sizeof(host_header), "%s", host);
+    }
+
+    // Revalidation headers for a copy the caller already holds
+    char conditional[256] = "";
+    const HttpValidators* v = req->validators;
+    if (v && v->etag[0]) {
+        snprintf(conditional, sizeof(conditional), "If-None-Match: %s\r\n", v->etag);
+    }
+    if (v && v->last_modified[0]) {
+        int used = strlen(conditional);
+        snprintf(conditional + used, sizeof(conditional) - used,
+                 "If-Modified-Since: %s\r\n", v->last_modified);
+    }
+
+    // Resume: If-Range makes the server send the whole (changed) resource
+    // with a 200 instead of splicing a new version onto the old bytes.
+    // Weak ETags aren't allowed there, Last-Modified is used instead
+    char range[256] = "";
+    if (req->range_start > 0 || req->range_end > 0) {
+        int used;
+        if (req->range_end > 0) {
+            used = snprintf(range, sizeof(range), "Range: bytes=%lld-%lld\r\n",
+                            (long long)req->range_start, (long long)req->range_end);
+        } else {
+            used = snprintf(range, sizeof(range), "Range: bytes=%lld-\r\n",
+                            (long long)req->range_start);
+        }
+        const HttpValidators* ir = req->if_range;
+        if (ir && ir->etag[0] && strncmp(ir->etag, "W/", 2) != 0) {
+            snprintf(range + used, sizeof(range) - used, "If-Range: %s\r\n", ir->etag);
+        } else if (ir && ir->last_modified[0]) {
+            snprintf(range + used, sizeof(range) - used, "If-Range: %s\r\n", ir->last_modified);
+        }
+    }
+
+    char request[HTTP_CLIENT_MAX_URL + 1024];
+    int request_len = snprintf(request, sizeof(request),
+        "GET %s HTTP/1.1\r\n"
+        "Host: %s\r\n"
+        "User-Agent: Mozilla/5.0 (Linux) AppleWebKit/537.36\r\n"
+        "Accept: */*\r\n"
+        "Accept-Encoding: %s\r\n"
+        "%s%s"
+        "Connection: close\r\n"
+        "\r\n",
+        path, host_header, req->accept_compressed ? "gzip, deflate" : "identity",
+        conditional, range);
+    if (request_len >= (int)sizeof(request) || conn_write_all(c, request, request_len) != 0) {
+        LOG_error("[HTTP] Failed to send request: %s\n", resp->final_url);
+        conn_close(c);
+        return -1;
+    }
+
+    HttpHeaders* h = (HttpHeaders*)malloc(sizeof(HttpHeaders));
+    if (!h || read_headers(c, h) != 0) {
+        if (h) LOG_error("[HTTP] Failed to read response headers: %s\n", resp->final_url);
+        free(h);
+        conn_close(c);
+        return -1;
+    }
+
+    resp->status = h->status;
+    resp->content_length = h->content_length;
+    resp->range_start = h->status == 206 ? h->range_start : 0;
+    resp->accept_ranges = h->accept_ranges || h->status == 206;
+    if (h->status == 206 || h->status == 416) {
+        resp->total_length = h->range_total;
+    } else {
+        resp->total_length = h->encoding == HTTP_ENCODING_IDENTITY ? h->content_length : -1;
+    }
+    strncpy(resp->content_type, h->content_type, sizeof(resp->content_type) - 1);
+    resp->validators = h->validators;
+
+    int result = 0;
+    if (h->status == 301 || h->status == 302 || h->status == 303 ||
+        h->status == 307 || h->status == 308) {
+        if (h->location[0]) {
+            resolve_location(resp->final_url, h->location, next_url, next_size);
+            result = 1;
+        } else {
+            LOG_error("[HTTP] Redirect response has no Location header\n");
+            result = -1;
+        }
+    } else if (h->status >= 200 && h->status < 300 && h->status != 204) {
+        // Other statuses (errors, 304 Not Modified) are returned without reading a body
+        HttpBodySink sink;
+        memset(&sink, 0, sizeof(sink));
+        sink.req = req;
+        sink.resp = resp;
+        sink.encoding = h->encoding;
+
+        if (read_body(c, h, &sink) < 0) {
+            if (!conn_stopped(c)) {
+                LOG_error("[HTTP] Transfer incomplete (%lld bytes): %s\n",
+                          (long long)sink.wire_bytes, resp->final_url);
+            }
+            result = -1;
+        }
+
+        if (sink.inflating) inflateEnd(&sink.zs);
+        free(sink.zbuf);
+    }
+
+    free(h);
+    conn_close(c);
+    return result;
+}
+
+int http_client_get(const HttpRequest* req, HttpResponse* resp) {
+    memset(resp, 0, sizeof(HttpResponse));
+    resp->content_length = -1;
+    resp->total_length = -1;
+
+    if (!req || !req->url || !req->url[0]) {
+        LOG_error("[HTTP] Invalid parameters\n");
+        return -1;
+    }
+
+    int timeout_ms = req->timeout_ms > 0 ? req->timeout_ms : HTTP_CLIENT_TIMEOUT_MS;
+    snprintf(resp->final_url, sizeof(resp->final_url), "%s", req->url);
+
+    for (int redirects = 0; redirects <= HTTP_CLIENT_MAX_REDIRECTS; redirects++) {
+        char next_url[HTTP_CLIENT_MAX_URL];
+        int ret = http_exchange(req, resp, timeout_ms, next_url, sizeof(next_url));
+        if (ret <= 0) return ret;
+
+        memcpy(resp->final_url, next_url, sizeof(resp->final_url));
+        if (req->should_stop && *req->should_stop) return -1;
+    }
+
+    LOG_error("[HTTP] Too many redirects (max %d)\n", HTTP_CLIENT_MAX_REDIRECTS);
+    return -1;
+}
+
+// ============== BUFFER FETCH ==============
+
+typedef struct {
+    uint8_t* buf;
+    int size;
+    int len;
+} FetchBuffer;
+
+static int fetch_buffer_write(const uint8_t* data, int len, void* userdata) {
+    FetchBuffer* fb = (FetchBuffer*)userdata;
+    int space = fb->size - 1 - fb->len;
+    if (len > space) len = space;
+    memcpy(fb->buf + fb->len, data, len);
+    fb->len += len;
+    return fb->len >= fb->size - 1 ? 1 : 0;  // Full: stop reading
+}
+
+// Some CDNs send gzip without a Content-Encoding header; detect by magic bytes
+static int gunzip_buffer(uint8_t* buffer, int len, int buffer_size) {
+    if (len < 2 || buffer[0] != 0x1f || buffer[1] != 0x8b) return len;
+
+    uint8_t* out = (uint8_t*)malloc(buffer_size);
+    if (!out) return len;
+
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    strm.next_in = buffer;
+    strm.avail_in = len;
+    strm.next_out = out;
+    strm.avail_out = buffer_size - 1;
+
+    // MAX_WBITS + 16 tells zlib to expect a gzip header
+    if (inflateInit2(&strm, MAX_WBITS + 16) == Z_OK) {
+        int zret = inflate(&strm, Z_FINISH);
+        if (zret == Z_STREAM_END || zret == Z_OK || zret == Z_BUF_ERROR) {
+            len = strm.total_out;
+            memcpy(buffer, out, len);
+        } else {
+            LOG_error("[HTTP] gzip decompression failed: %d\n", zret);
+        }
+        inflateEnd(&strm);
+    }
+    free(out);
+    return len;
+}
+
+static int fetch_into(const char* url, uint8_t* buffer, int buffer_size,
+                      const HttpValidators* validators, HttpResponse* resp) {
+    if (!url || !buffer || buffer_size <= 0) {
+        LOG_error("[HTTP] fetch: invalid parameters\n");
+        return -1;
+    }
+
+    HttpResponse* local = NULL;
+    if (!resp) {
+        local = (HttpResponse*)malloc(sizeof(HttpResponse));
+        if (!local) return -1;
+        resp = local;
+    }
+
+    FetchBuffer fb = {buffer, buffer_size, 0};
+    HttpRequest req;
+    memset(&req, 0, sizeof(req));
+    req.url = url;
+    req.validators = validators;
+    req.accept_compressed = true;
+    req.on_body = fetch_buffer_write;
+    req.userdata = &fb;
+
+    int result = -1;
+    if (http_client_get(&req, resp) == 0) {
+        if (resp->status >= 200 && resp->status < 300) {
+            result = gunzip_buffer(buffer, fb.len, buffer_size);
+        } else if (resp->status == 304 && validators) {
+            result = HTTP_NOT_MODIFIED;
+        } else {
+            LOG_error("[HTTP] HTTP %d for: %s\n", resp->status, url);
+        }
+    }
+
+    free(local);
+    return result;
+}
+
+int http_fetch(const char* url, uint8_t* buffer, int buffer_size, HttpResponse* resp) {
+    return fetch_into(url, buffer, buffer_size, NULL, resp);
+}
+
+int http_fetch_conditional(const char* url, uint8_t* buffer, int buffer_size,
+                           HttpValidators* validators) {
+    HttpResponse* resp = (HttpResponse*)malloc(sizeof(HttpResponse));
+    if (!resp) return -1;
+
+    int result = fetch_into(url, buffer, buffer_size, validators, resp);
+    if (result >= 0 && validators) {
+        *validators = resp->validators;
+    }
+
+    free(resp);
+    return result;
+}
@@ -0,0 +1,98 @@
+#ifndef HTTP_CLIENT_H
+#define HTTP_CLIENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Default network timeout (connect and each read)
+#define HTTP_CLIENT_TIMEOUT_MS 15000
+
+// Maximum redirect depth
+#define HTTP_CLIENT_MAX_REDIRECTS 10
+
+// Longest URL followed through redirects
+#define HTTP_CLIENT_MAX_URL 2048
+
+// http_fetch_conditional() result when the server answered 304
+#define HTTP_NOT_MODIFIED (-2)
+
+// Cache validators of a previously fetched response (empty = none)
+typedef struct {
+    char etag[128];
+    char last_modified[64];
+} HttpValidators;
+
+/**
+ * Receives each piece of the response body (after chunked/gzip decoding).
+ * Return 0 to continue, >0 to stop early (e.g. buffer full; the transfer
+ * still counts as complete), -1 to abort the transfer.
+ */
+typedef int (*HttpBodyCallback)(const uint8_t* data, int len, void* userdata);
+
+/**
+ * Reports transfer progress. total is -1 when the server sent no length.
+ */
+typedef void (*HttpProgressCallback)(int64_t received, int64_t total, void* userdata);
+
+typedef struct {
+    const char* url;
+    int timeout_ms;                     // 0 = HTTP_CLIENT_TIMEOUT_MS
+    volatile bool* should_stop;         // Optional cancellation flag
+    const HttpValidators* validators;   // Optional, sent as If-None-Match/If-Modified-Since
+    bool accept_compressed;             // Offer gzip/deflate (never for ranged or media downloads)
+    int64_t range_start;                // >0: ask for the body from this offset (206 Partial Content)
+    int64_t range_end;                  // >0: last byte wanted (inclusive), 0 = to the end
+    const HttpValidators* if_range;     // With a range: only if the resource still matches
+    HttpBodyCallback on_body;           // Only called for 2xx responses
+    HttpProgressCallback on_progress;   // Optional
+    void* userdata;
+} HttpRequest;
+
+typedef struct {
+    int status;                         // HTTP status of the final response
+    int64_t content_length;             // -1 if unknown
+    int64_t range_start;                // First byte of a 206 body, 0 otherwise
+    int64_t total_length;               // Full resource size (Content-Range or Content-Length), -1 if unknown
+    bool accept_ranges;                 // Server advertised byte ranges (Accept-Ranges: bytes)
+    int64_t body_bytes;                 // Decoded body bytes delivered
+    char content_type[128];             // Without parameters
+    char final_url[HTTP_CLIENT_MAX_URL];  // URL after redirects
+    HttpValidators validators;          // ETag/Last-Modified of this response
+} HttpResponse;
+
+/**
+ * Perform a GET in-process (HTTP or HTTPS), following redirects and
+ * streaming the body to req->on_body. Nothing touches the filesystem,
+ * so any number of requests can run concurrently.
+ *
+ * @param req   Request parameters
+ * @param resp  Filled with the final response status and headers
+ * @return      0 if a complete response was received (check resp->status),
+ *              -1 on network error, cancellation or callback abort
+ */
+int http_client_get(const HttpRequest* req, HttpResponse* resp);
+
+/**
+ * Fetch URL content into a memory buffer. At most buffer_size - 1 bytes
+ * are stored so callers can NUL-terminate; longer bodies are truncated.
+ *
+ * @param url          The URL to fetch
+ * @param buffer       Buffer to store response body
+ * @param buffer_size  Size of buffer
+ * @param resp         Optional, receives response status and headers
+ * @return             Bytes read on success, -1 on failure or non-2xx status
+ */
+int http_fetch(const char* url, uint8_t* buffer, int buffer_size, HttpResponse* resp);
+
+/**
+ * Like http_fetch(), revalidating a previously fetched copy: the stored
+ * validators are sent and, on a 200, replaced with the new response's.
+ *
+ * @param validators   In: validators of the copy the caller holds. Out: updated
+ * @return             Bytes read, HTTP_NOT_MODIFIED if the held copy is
+ *                     still current (buffer untouched), -1 on failure
+ */
+int http_fetch_conditional(const char* url, uint8_t* buffer, int buffer_size,
+                           HttpValidators* validators);
+
+#endif // HTTP_CLIENT_H
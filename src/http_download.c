@@ -1,481 +1,676 @@
 #define _GNU_SOURCE
 #include "http_download.h"
-#include "radio_net.h"
+#include "http_client.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <errno.h>
-#include <sys/socket.h>
-#include <netdb.h>
-
-#include "mbedtls/net_sockets.h"
-#include "mbedtls/ssl.h"
-#include "mbedtls/entropy.h"
-#include "mbedtls/ctr_drbg.h"
-
-// TLS 1.3: mbedtls_ssl_read/write may return non-fatal errors that require retry
-#define SSL_READ_IS_RETRYABLE(r) \
-    ((r) == MBEDTLS_ERR_SSL_WANT_READ || \
-     (r) == MBEDTLS_ERR_SSL_WANT_WRITE || \
-     (r) == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET)
+#include <pthread.h>
+#include <sys/stat.h>
+#include <time.h>
 
 #include "defines.h"
 #include "api.h"
 
-// SSL context for HTTPS downloads
-typedef struct {
-    mbedtls_net_context net;
-    mbedtls_ssl_context ssl;
-    mbedtls_ssl_config conf;
-    mbedtls_entropy_context entropy;
-    mbedtls_ctr_drbg_context ctr_drbg;
-    bool initialized;
-} HttpSSLContext;
-
-// Internal implementation with redirect depth tracking
-static int http_download_file_internal(const char* url, const char* filepath,
-                                       volatile int* progress_percent,
-                                       volatile bool* should_stop, int redirect_depth) {
-    if (!url || !filepath) {
-        LOG_error("[HTTP] download: invalid parameters\n");
-        return -1;
-    }
+// Most pieces tracked at once (the initial split plus stolen halves)
+#define HTTP_DOWNLOAD_MAX_SEGMENTS 32
 
-    if (redirect_depth >= HTTP_DOWNLOAD_MAX_REDIRECTS) {
-        LOG_error("[HTTP] download: too many redirects\n");
-        return -1;
-    }
+// Split points are kept on this boundary
+#define HTTP_DOWNLOAD_ALIGN (64 * 1024)
 
-    // Parse URL
-    char* host = (char*)malloc(256);
-    char* path = (char*)malloc(2048);
-    if (!host || !path) {
-        free(host);
-        free(path);
-        return -1;
-    }
+// Reconnects per segment before its worker gives up
+#define HTTP_DOWNLOAD_SEGMENT_RETRIES 2
 
-    int port;
-    bool is_https;
+// Data a connection may take at once after the budget went unused
+#define HTTP_DOWNLOAD_RATE_BURST_MS 250
 
-    if (radio_net_parse_url(url, host, 256, &port, path, 2048, &is_https) != 0) {
-        LOG_error("[HTTP] download: failed to parse URL: %s\n", url);
-        free(host);
-        free(path);
-        return -1;
-    }
+// Longest single sleep while waiting for budget (keeps cancel responsive)
+#define HTTP_DOWNLOAD_RATE_SLEEP_MS 100
 
-    int sock_fd = -1;
-    HttpSSLContext* ssl_ctx = NULL;
-    char* header_buf = NULL;
-    FILE* outfile = NULL;
-    int result = -1;
+// A piece of the file still to fetch. A worker owns one at a time;
+// stealing lowers a busy segment's end and hands the rest to an idle worker
+typedef struct {
+    int64_t pos;        // Next byte to write
+    int64_t end;        // One past the last byte wanted, -1 = until the body ends
+    int64_t synced;     // pos at the last checkpoint
+    bool active;        // A worker is fetching it
+} DownloadSegment;
 
-    if (is_https) {
-        ssl_ctx = (HttpSSLContext*)calloc(1, sizeof(HttpSSLContext));
-        if (!ssl_ctx) {
-            LOG_error("[HTTP] download: failed to allocate SSL context\n");
-            free(host);
-            free(path);
-            return -1;
-        }
+typedef struct HttpDownload HttpDownload;
 
-        const char* pers = "http_download";
-        mbedtls_net_init(&ssl_ctx->net);
-        mbedtls_ssl_init(&ssl_ctx->ssl);
-        mbedtls_ssl_config_init(&ssl_ctx->conf);
-        mbedtls_entropy_init(&ssl_ctx->entropy);
-        mbedtls_ctr_drbg_init(&ssl_ctx->ctr_drbg);
+typedef struct {
+    HttpDownload* dl;
+    int seg;
+} DownloadWorker;
+
+// Download state shared by all connections
+struct HttpDownload {
+    const char* url;
+    const char* part_path;
+    const char* meta_path;
+    int fd;                     // .part file, opened on the first body bytes
+    int64_t total;              // Full size, -1 until known
+    HttpValidators validators;  // Of the resource being written
+    DownloadSegment segs[HTTP_DOWNLOAD_MAX_SEGMENTS];
+    int seg_count;
+    int64_t unsynced;           // Bytes written since the last checkpoint
+    bool checkpointing;
+    bool allow_split;
+    DownloadWorker workers[HTTP_DOWNLOAD_CONNECTIONS - 1];
+    pthread_t threads[HTTP_DOWNLOAD_CONNECTIONS - 1];
+    int thread_count;
+    pthread_mutex_t lock;
+    volatile bool stop;         // Cancel or fatal error: every connection stops
+    volatile bool* should_stop; // Caller's cancel flag
+    HttpDownloadProgress* progress;
+    int http_status;            // Error status that ended the download, 0 if none
+    bool write_failed;
+    bool restart;               // Server's answer doesn't match the .part file
+};
+
+// One connection's request
+typedef struct {
+    HttpDownload* dl;
+    int seg;
+    bool ranged;                // Asked for a byte range (else the whole body)
+    bool started;               // First body bytes seen and the response checked
+    HttpResponse* resp;
+} SegmentFetch;
+
+static void run_worker(HttpDownload* dl, int seg);
+
+// Bandwidth budget shared by every connection of every download.
+// rate_next_us is when the bytes handed out so far have been "paid" for
+// at the current rate; a connection waits until then before writing more
+static pthread_mutex_t rate_lock = PTHREAD_MUTEX_INITIALIZER;
+static int rate_limit = 0;          // Bytes per second, 0 = unlimited
+static int64_t rate_next_us = 0;
+
+static int64_t rate_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
 
-        if (mbedtls_ctr_drbg_seed(&ssl_ctx->ctr_drbg, mbedtls_entropy_func, &ssl_ctx->entropy,
-                                   (const unsigned char*)pers, strlen(pers)) != 0) {
-            goto cleanup;
-        }
+void http_download_set_rate_limit(int bytes_per_sec) {
+    pthread_mutex_lock(&rate_lock);
+    if (bytes_per_sec < 0) bytes_per_sec = 0;
+    if (bytes_per_sec != rate_limit) {
+        rate_limit = bytes_per_sec;
+        rate_next_us = rate_now_us();
+    }
+    pthread_mutex_unlock(&rate_lock);
+}
 
-        if (mbedtls_ssl_config_defaults(&ssl_ctx->conf, MBEDTLS_SSL_IS_CLIENT,
-                                         MBEDTLS_SSL_TRANSPORT_STREAM,
-                                         MBEDTLS_SSL_PRESET_DEFAULT) != 0) {
-            goto cleanup;
-        }
+// Take len bytes from the shared budget, sleeping until they're covered.
+// Returns -1 if the download was stopped meanwhile
+static int rate_wait(HttpDownload* dl, int len) {
+    pthread_mutex_lock(&rate_lock);
+    if (rate_limit <= 0) {
+        pthread_mutex_unlock(&rate_lock);
+        return 0;
+    }
+    int64_t now = rate_now_us();
+    int64_t burst_start = now - (int64_t)HTTP_DOWNLOAD_RATE_BURST_MS * 1000;
+    if (rate_next_us < burst_start) rate_next_us = burst_start;
+    int64_t wait_until = rate_next_us;
+    rate_next_us += (int64_t)len * 1000000 / rate_limit;
+    pthread_mutex_unlock(&rate_lock);
+
+    while (!dl->stop && !(dl->should_stop && *dl->should_stop)) {
+        int64_t left = wait_until - rate_now_us();
+        if (left <= 0) return 0;
+        if (left > HTTP_DOWNLOAD_RATE_SLEEP_MS * 1000) left = HTTP_DOWNLOAD_RATE_SLEEP_MS * 1000;
+        usleep((useconds_t)left);
+    }
+    return -1;
+}
 
-        mbedtls_ssl_conf_authmode(&ssl_ctx->conf, MBEDTLS_SSL_VERIFY_NONE);
-        mbedtls_ssl_conf_rng(&ssl_ctx->conf, mbedtls_ctr_drbg_random, &ssl_ctx->ctr_drbg);
+// Resume state stored next to the .part file: which resource the bytes
+// belong to and, per unfinished segment, how far it is durable.
+// Call with dl->lock held
+static void write_meta(HttpDownload* dl) {
+    // Written aside and renamed over, so a power cut never leaves a meta
+    // file that lists fewer unfinished segments than there are
+    char tmp_path[1056];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", dl->meta_path);
+    FILE* f = fopen(tmp_path, "w");
+    if (!f) return;
+    fprintf(f, "url=%s\n", dl->url);
+    fprintf(f, "etag=%s\n", dl->validators.etag);
+    fprintf(f, "last_modified=%s\n", dl->validators.last_modified);
+    fprintf(f, "total=%lld\n", (long long)dl->total);
+    for (int i = 0; i < dl->seg_count; i++) {
+        DownloadSegment* s = &dl->segs[i];
+        if (s->end < 0 || s->synced < s->end) {
+            fprintf(f, "seg=%lld %lld\n", (long long)s->synced, (long long)s->end);
+        }
+    }
+    fflush(f);
+    bool ok = fsync(fileno(f)) == 0;
+    if (fclose(f) != 0) ok = false;
+    if (!ok || rename(tmp_path, dl->meta_path) != 0) unlink(tmp_path);
+}
 
-        if (mbedtls_ssl_setup(&ssl_ctx->ssl, &ssl_ctx->conf) != 0) {
-            goto cleanup;
+// Load the state of an earlier interrupted attempt.
+// Returns true if its .part file can be continued
+static bool read_meta(HttpDownload* dl) {
+    FILE* f = fopen(dl->meta_path, "r");
+    if (!f) return false;
+
+    char line[HTTP_CLIENT_MAX_URL + 16];
+    bool same_url = false;
+    long long total = -1;
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        long long synced, end;
+        if (strncmp(line, "url=", 4) == 0) {
+            same_url = strcmp(line + 4, dl->url) == 0;
+        } else if (strncmp(line, "etag=", 5) == 0) {
+            strncpy(dl->validators.etag, line + 5, sizeof(dl->validators.etag) - 1);
+        } else if (strncmp(line, "last_modified=", 14) == 0) {
+            strncpy(dl->validators.last_modified, line + 14, sizeof(dl->validators.last_modified) - 1);
+        } else if (sscanf(line, "total=%lld", &total) == 1) {
+            // Parsed
+        } else if (sscanf(line, "seg=%lld %lld", &synced, &end) == 2 &&
+                   dl->seg_count < HTTP_DOWNLOAD_MAX_SEGMENTS) {
+            DownloadSegment* s = &dl->segs[dl->seg_count++];
+            s->pos = s->synced = synced;
+            s->end = end;
+        }
+    }
+    fclose(f);
+
+    // Without validators there's no way to tell the bytes still belong
+    // to the resource the server has now
+    struct stat st;
+    bool usable = same_url && (dl->validators.etag[0] || dl->validators.last_modified[0]) &&
+                  stat(dl->part_path, &st) == 0;
+    if (usable && dl->seg_count == 1 && dl->segs[0].end < 0) {
+        // Size was unknown: anything past the file's end never arrived
+        if (dl->segs[0].pos > st.st_size) dl->segs[0].pos = dl->segs[0].synced = st.st_size;
+    } else if (usable) {
+        // Every unfinished segment must lie within a known size, and its
+        // durable bytes within the file. No unfinished segments only means
+        // done if the whole file is there
+        usable = total > 0 && (dl->seg_count > 0 || st.st_size == total);
+        for (int i = 0; usable && i < dl->seg_count; i++) {
+            DownloadSegment* s = &dl->segs[i];
+            usable = s->pos >= 0 && s->pos <= s->end && s->end <= total && s->pos <= st.st_size;
         }
+    }
 
-        mbedtls_ssl_set_hostname(&ssl_ctx->ssl, host);
+    if (!usable) {
+        memset(&dl->validators, 0, sizeof(dl->validators));
+        dl->seg_count = 0;
+        return false;
+    }
+    dl->total = total;
+    return true;
+}
 
-        char port_str[16];
-        snprintf(port_str, sizeof(port_str), "%d", port);
+// Call with dl->lock held
+static void update_progress(HttpDownload* dl) {
+    if (!dl->progress) return;
+    if (dl->total <= 0) {
+        // Single stream of unknown size: it is all in the one segment
+        dl->progress->total = 0;
+        dl->progress->bytes = dl->seg_count > 0 ? dl->segs[0].pos : 0;
+        return;
+    }
 
-        int connect_ret = mbedtls_net_connect(&ssl_ctx->net, host, port_str, MBEDTLS_NET_PROTO_TCP);
-        if (connect_ret != 0) {
-            LOG_error("[HTTP] download: mbedtls_net_connect failed: %d (host=%s, port=%s)\n",
-                      connect_ret, host, port_str);
-            goto cleanup;
-        }
+    int64_t left = 0;
+    for (int i = 0; i < dl->seg_count; i++) {
+        if (dl->segs[i].end > dl->segs[i].pos) left += dl->segs[i].end - dl->segs[i].pos;
+    }
+    int pct = (int)(((dl->total - left) * 100) / dl->total);
+    if (pct > 99) pct = 99;  // Don't show 100% until the file is in place
+    dl->progress->total = dl->total;
+    dl->progress->bytes = dl->total - left;
+    dl->progress->percent = pct;
+}
 
-        // Set socket timeout
-        int ssl_sock_fd = ssl_ctx->net.fd;
-        struct timeval tv = {HTTP_DOWNLOAD_TIMEOUT_SECONDS, 0};
-        setsockopt(ssl_sock_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-        setsockopt(ssl_sock_fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
-
-        mbedtls_ssl_set_bio(&ssl_ctx->ssl, &ssl_ctx->net, mbedtls_net_send, mbedtls_net_recv, NULL);
-
-        // SSL handshake
-        int ret;
-        int handshake_retries = 0;
-        const int max_handshake_retries = 100;
-        while ((ret = mbedtls_ssl_handshake(&ssl_ctx->ssl)) != 0) {
-            if (should_stop && *should_stop) goto cleanup;
-            // TLS 1.3: session ticket received means handshake is complete
-            if (ret == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET) {
-                break;
-            }
-            if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
-                LOG_error("[HTTP] download: SSL handshake failed: -0x%04X\n", -ret);
-                goto cleanup;
-            }
-            if (++handshake_retries > max_handshake_retries) {
-                LOG_error("[HTTP] download: SSL handshake timeout\n");
-                goto cleanup;
-            }
-            usleep(100000);
-        }
+// Make written data durable and record the new resume point
+static void checkpoint(HttpDownload* dl) {
+    int64_t pos[HTTP_DOWNLOAD_MAX_SEGMENTS];
+    int count;
 
-        ssl_ctx->initialized = true;
-        sock_fd = ssl_ctx->net.fd;
-    } else {
-        // Plain HTTP
-        struct addrinfo hints, *ai_result = NULL;
-        memset(&hints, 0, sizeof(hints));
-        hints.ai_family = AF_INET;
-        hints.ai_socktype = SOCK_STREAM;
-
-        char port_str[16];
-        snprintf(port_str, sizeof(port_str), "%d", port);
-
-        if (getaddrinfo(host, port_str, &hints, &ai_result) != 0 || !ai_result) {
-            LOG_error("[HTTP] download: getaddrinfo failed for %s\n", host);
-            if (ai_result) freeaddrinfo(ai_result);
-            free(host);
-            free(path);
-            return -1;
+    pthread_mutex_lock(&dl->lock);
+    if (dl->checkpointing || dl->fd < 0 || dl->write_failed) {
+        pthread_mutex_unlock(&dl->lock);
+        return;
+    }
+    dl->checkpointing = true;
+    dl->unsynced = 0;
+    count = dl->seg_count;
+    for (int i = 0; i < count; i++) pos[i] = dl->segs[i].pos;
+    pthread_mutex_unlock(&dl->lock);
+
+    // Other connections keep writing meanwhile; only what was written
+    // before the sync counts as durable
+    bool ok = fdatasync(dl->fd) == 0;
+
+    pthread_mutex_lock(&dl->lock);
+    if (ok) {
+        for (int i = 0; i < count; i++) {
+            DownloadSegment* s = &dl->segs[i];
+            int64_t durable = pos[i] < s->pos ? pos[i] : s->pos;
+            if (durable > s->synced) s->synced = durable;
         }
+        write_meta(dl);
+    }
+    dl->checkpointing = false;
+    pthread_mutex_unlock(&dl->lock);
+}
 
-        sock_fd = socket(ai_result->ai_family, ai_result->ai_socktype, ai_result->ai_protocol);
-        if (sock_fd < 0) {
-            freeaddrinfo(ai_result);
-            free(host);
-            free(path);
-            return -1;
-        }
+static void* worker_thread(void* arg) {
+    DownloadWorker* w = (DownloadWorker*)arg;
+    run_worker(w->dl, w->seg);
+    return NULL;
+}
 
-        struct timeval tv = {HTTP_DOWNLOAD_TIMEOUT_SECONDS, 0};
-        setsockopt(sock_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-        setsockopt(sock_fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
-
-        if (connect(sock_fd, ai_result->ai_addr, ai_result->ai_addrlen) < 0) {
-            LOG_error("[HTTP] download: connect failed: %s\n", strerror(errno));
-            close(sock_fd);
-            freeaddrinfo(ai_result);
-            free(host);
-            free(path);
-            return -1;
-        }
-        freeaddrinfo(ai_result);
+// Start a connection for segment seg. Call from the calling thread only
+static void start_worker(HttpDownload* dl, int seg) {
+    bool started = false;
+    if (dl->thread_count < HTTP_DOWNLOAD_CONNECTIONS - 1) {
+        DownloadWorker* w = &dl->workers[dl->thread_count];
+        w->dl = dl;
+        w->seg = seg;
+        started = pthread_create(&dl->threads[dl->thread_count], NULL, worker_thread, w) == 0;
     }
-
-    // Send HTTP request
-    char request[2560];
-    snprintf(request, sizeof(request),
-        "GET %s HTTP/1.1\r\n"
-        "Host: %s\r\n"
-        "User-Agent: Mozilla/5.0 (Linux) AppleWebKit/537.36\r\n"
-        "Accept: */*\r\n"
-        "Accept-Encoding: identity\r\n"
-        "Connection: close\r\n"
-        "\r\n",
-        path, host);
-
-    int sent;
-    if (is_https) {
-        sent = mbedtls_ssl_write(&ssl_ctx->ssl, (unsigned char*)request, strlen(request));
+    if (started) {
+        dl->thread_count++;
     } else {
-        sent = send(sock_fd, request, strlen(request), 0);
+        // Left inactive; another worker picks it up when it runs out of work
+        pthread_mutex_lock(&dl->lock);
+        dl->segs[seg].active = false;
+        pthread_mutex_unlock(&dl->lock);
     }
+}
 
-    if (sent < 0) {
-        LOG_error("[HTTP] download: failed to send request\n");
-        goto cleanup;
+// The first response of a fresh download decides the file's size and
+// whether the rest is fetched over more connections.
+// Returns the number of new segments to start. Call with dl->lock held
+static int plan_segments(HttpDownload* dl, const HttpResponse* resp) {
+    dl->validators = resp->validators;
+    dl->total = resp->total_length;
+    if (dl->total <= 0) return 0;  // Single stream until the body ends
+    dl->segs[0].end = dl->total;
+
+    // Ranges on a resource we can't identify could splice two versions
+    bool have_validators = dl->validators.etag[0] || dl->validators.last_modified[0];
+    int parts = (int)(dl->total / HTTP_DOWNLOAD_SEGMENT_MIN_SIZE);
+    if (parts > HTTP_DOWNLOAD_CONNECTIONS) parts = HTTP_DOWNLOAD_CONNECTIONS;
+    if (!dl->allow_split || !resp->accept_ranges || !have_validators || parts < 2) {
+        return 0;
     }
 
-    // Read headers
-    #define HEADER_BUF_SIZE 4096
-    header_buf = (char*)malloc(HEADER_BUF_SIZE);
-    if (!header_buf) goto cleanup;
-
-    int header_pos = 0;
-    bool headers_done = false;
+    // Preallocate so every connection can pwrite its part in place
+    if (ftruncate(dl->fd, dl->total) != 0) {
+        LOG_error("[HTTP] download: can't preallocate %lld bytes: %s\n",
+                  (long long)dl->total, dl->part_path);
+        return 0;
+    }
 
-    while (header_pos < HEADER_BUF_SIZE - 1) {
-        if (should_stop && *should_stop) goto cleanup;
+    int64_t size = (dl->total / parts) & ~(int64_t)(HTTP_DOWNLOAD_ALIGN - 1);
+    dl->segs[0].end = size;
+    for (int i = 1; i < parts; i++) {
+        DownloadSegment* s = &dl->segs[dl->seg_count++];
+        s->pos = s->synced = size * i;
+        s->end = (i == parts - 1) ? dl->total : size * (i + 1);
+        s->active = true;
+    }
+    return parts - 1;
+}
 
-        char c;
-        int r;
-        if (is_https) {
-            r = mbedtls_ssl_read(&ssl_ctx->ssl, (unsigned char*)&c, 1);
-            if (SSL_READ_IS_RETRYABLE(r)) {
-                usleep(10000);
-                continue;
-            }
+// Check the response before its first body bytes are written
+static int segment_start(SegmentFetch* f) {
+    HttpDownload* dl = f->dl;
+    const HttpResponse* resp = f->resp;
+    int new_segments = 0;
+    int ret = 0;
+
+    f->started = true;
+    pthread_mutex_lock(&dl->lock);
+    DownloadSegment* s = &dl->segs[f->seg];
+
+    if (f->ranged) {
+        // Exactly the bytes asked for, of the same resource. A 200 means
+        // the resource changed (If-Range) or ranges aren't supported after all
+        if (resp->status != 206 || resp->range_start != s->pos ||
+            (dl->total > 0 && resp->total_length > 0 && resp->total_length != dl->total)) {
+            LOG_error("[HTTP] download: range response doesn't match %s, restarting\n", dl->part_path);
+            dl->restart = true;
+            ret = -1;
+        }
+    } else if (resp->status == 206) {
+        dl->restart = true;  // Partial content we didn't ask for
+        ret = -1;
+    } else {
+        dl->fd = open(dl->part_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (dl->fd < 0) {
+            LOG_error("[HTTP] download: failed to open file: %s\n", dl->part_path);
+            dl->write_failed = true;
+            ret = -1;
         } else {
-            r = recv(sock_fd, &c, 1, 0);
+            new_segments = plan_segments(dl, resp);
+            write_meta(dl);
         }
-        if (r != 1) break;
+    }
+
+    if (ret != 0) dl->stop = true;
+    int first_new = dl->seg_count - new_segments;
+    pthread_mutex_unlock(&dl->lock);
+
+    for (int i = 0; i < new_segments; i++) {
+        start_worker(dl, first_new + i);
+    }
+    return ret;
+}
 
-        header_buf[header_pos++] = c;
-        if (header_pos >= 4 &&
-            header_buf[header_pos-4] == '\r' && header_buf[header_pos-3] == '\n' &&
-            header_buf[header_pos-2] == '\r' && header_buf[header_pos-1] == '\n') {
-            headers_done = true;
+static int segment_write(const uint8_t* data, int len, void* userdata) {
+    SegmentFetch* f = (SegmentFetch*)userdata;
+    HttpDownload* dl = f->dl;
+
+    if (dl->stop) return -1;
+    if (!f->started && segment_start(f) != 0) return -1;
+    if (rate_wait(dl, len) != 0) return -1;
+
+    pthread_mutex_lock(&dl->lock);
+    DownloadSegment* s = &dl->segs[f->seg];
+
+    // The end may have moved down since the request (stolen tail)
+    int n = len;
+    if (s->end >= 0 && s->pos + n > s->end) n = (int)(s->end - s->pos);
+
+    int ret = 0;
+    int64_t offset = s->pos;
+    for (int done = 0; done < n; ) {
+        ssize_t w = pwrite(dl->fd, data + done, n - done, offset + done);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) {
+            LOG_error("[HTTP] download: write failed: %s\n", dl->part_path);
+            dl->write_failed = true;
+            dl->stop = true;
+            ret = -1;
             break;
         }
+        done += w;
     }
-    header_buf[header_pos] = '\0';
 
-    if (!headers_done) {
-        LOG_error("[HTTP] download: failed to read headers\n");
-        goto cleanup;
+    bool need_checkpoint = false;
+    if (ret == 0) {
+        s->pos += n;
+        dl->unsynced += n;
+        update_progress(dl);
+        need_checkpoint = dl->unsynced >= HTTP_DOWNLOAD_CHECKPOINT_BYTES;
+        if (s->end >= 0 && s->pos >= s->end) ret = 1;  // Segment complete
     }
+    pthread_mutex_unlock(&dl->lock);
+
+    if (need_checkpoint) checkpoint(dl);
+    return ret;
+}
 
-    // Check for redirect
-    char* first_line_end = strstr(header_buf, "\r\n");
-    bool is_redirect = false;
-    if (first_line_end) {
-        char* status_start = strstr(header_buf, "HTTP/");
-        if (status_start && status_start < first_line_end) {
-            is_redirect = (strstr(status_start, " 301 ") && strstr(status_start, " 301 ") < first_line_end) ||
-                         (strstr(status_start, " 302 ") && strstr(status_start, " 302 ") < first_line_end) ||
-                         (strstr(status_start, " 303 ") && strstr(status_start, " 303 ") < first_line_end) ||
-                         (strstr(status_start, " 307 ") && strstr(status_start, " 307 ") < first_line_end) ||
-                         (strstr(status_start, " 308 ") && strstr(status_start, " 308 ") < first_line_end);
+// Fetch one segment, reconnecting from where it stopped if the connection drops
+static void fetch_segment(HttpDownload* dl, int seg) {
+    HttpResponse* resp = (HttpResponse*)malloc(sizeof(HttpResponse));
+    if (!resp) return;
+
+    for (int attempt = 0; attempt <= HTTP_DOWNLOAD_SEGMENT_RETRIES && !dl->stop; attempt++) {
+        pthread_mutex_lock(&dl->lock);
+        DownloadSegment* s = &dl->segs[seg];
+        int64_t pos = s->pos;
+        int64_t end = s->end;
+        bool have_validators = dl->validators.etag[0] || dl->validators.last_modified[0];
+        pthread_mutex_unlock(&dl->lock);
+
+        if (end >= 0 && pos >= end) break;
+
+        // Only a fresh download's first connection takes the whole body
+        bool ranged = dl->fd >= 0;
+        if (ranged && !have_validators) break;
+
+        SegmentFetch f;
+        memset(&f, 0, sizeof(f));
+        f.dl = dl;
+        f.seg = seg;
+        f.ranged = ranged;
+        f.resp = resp;
+
+        HttpRequest req;
+        memset(&req, 0, sizeof(req));
+        req.url = dl->url;
+        req.timeout_ms = HTTP_DOWNLOAD_TIMEOUT_SECONDS * 1000;
+        req.should_stop = dl->should_stop;
+        if (ranged) {
+            req.range_start = pos;
+            req.range_end = end > 0 ? end - 1 : 0;
+            req.if_range = &dl->validators;
+        }
+        req.on_body = segment_write;
+        req.userdata = &f;
+
+        int ret = http_client_get(&req, resp);
+        if (dl->should_stop && *dl->should_stop) dl->stop = true;
+
+        if (ret == 0 && (resp->status < 200 || resp->status >= 300)) {
+            // Other errors on a range request (e.g. 503 from a busy server)
+            // are retried like a dropped connection
+            bool gone = !ranged || resp->status == 404 || resp->status == 410;
+            if (gone || resp->status == 416) {
+                pthread_mutex_lock(&dl->lock);
+                if (gone && !dl->http_status) dl->http_status = resp->status;
+                if (!gone) dl->restart = true;
+                dl->stop = true;
+                pthread_mutex_unlock(&dl->lock);
+                break;
+            }
+            continue;
         }
+
+        pthread_mutex_lock(&dl->lock);
+        s = &dl->segs[seg];
+        if (ret == 0 && s->end < 0 && f.started) {
+            // Size was unknown: the body ended, so that's the size
+            s->end = s->pos;
+            dl->total = s->pos;
+        }
+        bool done = s->end >= 0 && s->pos >= s->end;
+        pthread_mutex_unlock(&dl->lock);
+        if (done) break;
     }
 
-    if (is_redirect) {
-        char* loc = strcasestr(header_buf, "\nLocation:");
-        if (loc) {
-            loc += 10;
-            while (*loc == ' ') loc++;
-            char* end = loc;
-            while (*end && *end != '\r' && *end != '\n') end++;
-
-            char redirect_url[1024];
-            int rlen = end - loc;
-            if (rlen >= (int)sizeof(redirect_url)) rlen = sizeof(redirect_url) - 1;
-            strncpy(redirect_url, loc, rlen);
-            redirect_url[rlen] = '\0';
-
-            // Cleanup current connection
-            if (ssl_ctx) {
-                mbedtls_ssl_close_notify(&ssl_ctx->ssl);
-                mbedtls_net_free(&ssl_ctx->net);
-                mbedtls_ssl_free(&ssl_ctx->ssl);
-                mbedtls_ssl_config_free(&ssl_ctx->conf);
-                mbedtls_ctr_drbg_free(&ssl_ctx->ctr_drbg);
-                mbedtls_entropy_free(&ssl_ctx->entropy);
-                free(ssl_ctx);
-            } else if (sock_fd >= 0) {
-                close(sock_fd);
-            }
-            free(header_buf);
-            free(host);
-            free(path);
+    free(resp);
+}
 
-            // Follow redirect
-            return http_download_file_internal(redirect_url, filepath, progress_percent, should_stop, redirect_depth + 1);
+// Pick the next segment for a worker that finished its own: an abandoned
+// one first, otherwise the upper half of the one with the most left.
+// Returns -1 when there's nothing worth taking. Call with dl->lock held
+static int claim_work(HttpDownload* dl) {
+    int busiest = -1;
+    int64_t most = 0;
+    for (int i = 0; i < dl->seg_count; i++) {
+        DownloadSegment* s = &dl->segs[i];
+        if (s->end < 0) continue;  // Size unknown: single stream
+        int64_t left = s->end - s->pos;
+        if (left <= 0) continue;
+        if (!s->active) {
+            s->active = true;
+            return i;
+        }
+        if (left > most) {
+            most = left;
+            busiest = i;
         }
-        goto cleanup;
     }
 
-    // Parse Content-Length
-    long content_length = -1;
-    char* cl = strcasestr(header_buf, "\nContent-Length:");
-    if (cl) {
-        cl += 16;
-        while (*cl == ' ') cl++;
-        content_length = atol(cl);
+    // Slots aren't reused: a checkpoint in progress refers to them by index
+    if (busiest < 0 || most < 2 * HTTP_DOWNLOAD_STEAL_MIN_SIZE ||
+        dl->seg_count >= HTTP_DOWNLOAD_MAX_SEGMENTS) {
+        return -1;
     }
 
-    // Check for chunked transfer encoding
-    bool is_chunked = (strcasestr(header_buf, "Transfer-Encoding: chunked") != NULL);
+    DownloadSegment* victim = &dl->segs[busiest];
+    int64_t mid = (victim->pos + most / 2) & ~(int64_t)(HTTP_DOWNLOAD_ALIGN - 1);
+    if (mid <= victim->pos) return -1;
+
+    int slot = dl->seg_count++;
+    DownloadSegment* s = &dl->segs[slot];
+    s->pos = s->synced = mid;
+    s->end = victim->end;
+    s->active = true;
+    victim->end = mid;
+    return slot;
+}
 
-    // Open output file
-    outfile = fopen(filepath, "wb");
-    if (!outfile) {
-        LOG_error("[HTTP] download: failed to open file: %s\n", filepath);
-        goto cleanup;
+static void run_worker(HttpDownload* dl, int seg) {
+    while (seg >= 0 && !dl->stop) {
+        fetch_segment(dl, seg);
+
+        pthread_mutex_lock(&dl->lock);
+        DownloadSegment* s = &dl->segs[seg];
+        bool finished = s->end >= 0 && s->pos >= s->end;
+        s->active = false;
+        // A worker whose connection keeps failing stops here; the rest of
+        // its segment is picked up by one that is still getting data
+        seg = (finished && !dl->stop) ? claim_work(dl) : -1;
+        pthread_mutex_unlock(&dl->lock);
+    }
+}
+
+static void remove_part(HttpDownload* dl) {
+    unlink(dl->part_path);
+    unlink(dl->meta_path);
+}
+
+int http_download_file(const char* url, const char* filepath,
+                       HttpDownloadProgress* progress, volatile bool* should_stop) {
+    if (!url || !filepath) {
+        LOG_error("[HTTP] download: invalid parameters\n");
+        return -1;
     }
 
-    // Download body in chunks
-    uint8_t* chunk_buf = (uint8_t*)malloc(HTTP_DOWNLOAD_CHUNK_SIZE);
-    if (!chunk_buf) {
-        fclose(outfile);
-        outfile = NULL;
-        goto cleanup;
+    if (progress) {
+        progress->percent = 0;
+        progress->bytes = 0;
+        progress->total = 0;
     }
 
-    long total_read = 0;
-    int read_retries = 0;
-    const int max_read_retries = 50;
-
-    if (is_chunked) {
-        // Handle chunked transfer encoding
-        char chunk_size_buf[20];
-        int chunk_size_pos = 0;
-
-        while (1) {
-            if (should_stop && *should_stop) break;
-
-            // Read chunk size
-            chunk_size_pos = 0;
-            while (chunk_size_pos < (int)sizeof(chunk_size_buf) - 1) {
-                char c;
-                int r;
-                if (is_https) {
-                    r = mbedtls_ssl_read(&ssl_ctx->ssl, (unsigned char*)&c, 1);
-                    if (SSL_READ_IS_RETRYABLE(r)) {
-                        if (++read_retries > max_read_retries) break;
-                        usleep(10000);
-                        continue;
-                    }
-                    read_retries = 0;
-                } else {
-                    r = recv(sock_fd, &c, 1, 0);
-                }
-                if (r != 1) goto chunked_done;
-                if (c == '\r') continue;
-                if (c == '\n') break;
-                chunk_size_buf[chunk_size_pos++] = c;
-            }
-            chunk_size_buf[chunk_size_pos] = '\0';
-
-            long chunk_size = strtol(chunk_size_buf, NULL, 16);
-            if (chunk_size <= 0) break;
-
-            // Read chunk data
-            long chunk_read = 0;
-            while (chunk_read < chunk_size) {
-                if (should_stop && *should_stop) goto chunked_done;
-
-                int to_read = (chunk_size - chunk_read) < HTTP_DOWNLOAD_CHUNK_SIZE ?
-                              (int)(chunk_size - chunk_read) : HTTP_DOWNLOAD_CHUNK_SIZE;
-                int r;
-                if (is_https) {
-                    r = mbedtls_ssl_read(&ssl_ctx->ssl, chunk_buf, to_read);
-                    if (SSL_READ_IS_RETRYABLE(r)) {
-                        if (++read_retries > max_read_retries) goto chunked_done;
-                        usleep(10000);
-                        continue;
-                    }
-                    read_retries = 0;
-                } else {
-                    r = recv(sock_fd, chunk_buf, to_read, 0);
-                }
-                if (r <= 0) goto chunked_done;
+    char part_path[1024];
+    char meta_path[1040];
+    snprintf(part_path, sizeof(part_path), "%s" HTTP_DOWNLOAD_PART_SUFFIX, filepath);
+    snprintf(meta_path, sizeof(meta_path), "%s.meta", part_path);
 
-                fwrite(chunk_buf, 1, r, outfile);
-                chunk_read += r;
-                total_read += r;
-            }
+    // Heap allocated: shared with the worker threads
+    HttpDownload* dl = (HttpDownload*)malloc(sizeof(HttpDownload));
+    if (!dl) return -1;
 
-            // Skip trailing CRLF
-            char crlf[2];
-            int crlf_read = 0;
-            while (crlf_read < 2) {
-                int r;
-                if (is_https) {
-                    r = mbedtls_ssl_read(&ssl_ctx->ssl, (unsigned char*)&crlf[crlf_read], 1);
-                    if (SSL_READ_IS_RETRYABLE(r)) {
-                        usleep(10000);
-                        continue;
-                    }
-                } else {
-                    r = recv(sock_fd, &crlf[crlf_read], 1, 0);
-                }
-                if (r != 1) goto chunked_done;
-                crlf_read++;
-            }
+    int result = -1;
+
+    // A second pass only happens when the kept bytes turned out to be unusable
+    // or the server stopped honouring ranges; it runs as a single stream
+    for (int attempt = 0; attempt < 2; attempt++) {
+        memset(dl, 0, sizeof(HttpDownload));
+        pthread_mutex_init(&dl->lock, NULL);
+        dl->url = url;
+        dl->part_path = part_path;
+        dl->meta_path = meta_path;
+        dl->fd = -1;
+        dl->total = -1;
+        dl->allow_split = attempt == 0;
+        dl->should_stop = should_stop;
+        dl->progress = progress;
+
+        bool resumed = attempt == 0 && read_meta(dl);
+        if (resumed) {
+            dl->fd = open(part_path, O_WRONLY);
+            if (dl->fd < 0) resumed = false;
         }
-        chunked_done:;
-    } else {
-        // Non-chunked: read directly with progress
-        while (1) {
-            if (should_stop && *should_stop) break;
-
-            int r;
-            if (is_https) {
-                r = mbedtls_ssl_read(&ssl_ctx->ssl, chunk_buf, HTTP_DOWNLOAD_CHUNK_SIZE);
-                if (SSL_READ_IS_RETRYABLE(r)) {
-                    if (++read_retries > max_read_retries) break;
-                    usleep(10000);
-                    continue;
+        if (!resumed) {
+            memset(&dl->validators, 0, sizeof(dl->validators));
+            dl->total = -1;
+            dl->seg_count = 1;
+            dl->segs[0].pos = dl->segs[0].synced = 0;
+            dl->segs[0].end = -1;
+        }
+        update_progress(dl);
+
+        // One connection per unfinished segment (up to the limit), this
+        // thread included; any others are claimed as connections free up
+        int pending[HTTP_DOWNLOAD_CONNECTIONS];
+        int pending_count = 0;
+        for (int i = 0; i < dl->seg_count && pending_count < HTTP_DOWNLOAD_CONNECTIONS; i++) {
+            DownloadSegment* s = &dl->segs[i];
+            if (s->end >= 0 && s->pos >= s->end) continue;
+            s->active = true;
+            pending[pending_count++] = i;
+        }
+        for (int i = 1; i < pending_count; i++) {
+            start_worker(dl, pending[i]);
+        }
+
+        if (pending_count > 0) run_worker(dl, pending[0]);
+        for (int i = 0; i < dl->thread_count; i++) {
+            pthread_join(dl->threads[i], NULL);
+        }
+
+        bool complete = dl->total > 0;
+        for (int i = 0; complete && i < dl->seg_count; i++) {
+            if (dl->segs[i].end < 0 || dl->segs[i].pos < dl->segs[i].end) complete = false;
+        }
+        complete = complete && !dl->stop && !dl->write_failed;
+
+        if (complete) {
+            if (dl->fd >= 0 && fsync(dl->fd) != 0) dl->write_failed = true;
+            if (dl->fd >= 0 && close(dl->fd) != 0) dl->write_failed = true;
+            dl->fd = -1;
+            if (dl->write_failed) {
+                remove_part(dl);
+            } else if (rename(part_path, filepath) == 0) {
+                unlink(meta_path);
+                result = (int)dl->total;
+                if (progress) {
+                    progress->bytes = dl->total;
+                    progress->percent = 100;
                 }
-                read_retries = 0;
             } else {
-                r = recv(sock_fd, chunk_buf, HTTP_DOWNLOAD_CHUNK_SIZE, 0);
+                LOG_error("[HTTP] download: failed to move %s into place\n", part_path);
             }
-            if (r <= 0) break;
-
-            fwrite(chunk_buf, 1, r, outfile);
-            total_read += r;
-
-            // Update progress
-            if (progress_percent && content_length > 0) {
-                int pct = (int)((total_read * 100) / content_length);
-                if (pct > 100) pct = 100;
-                *progress_percent = pct;
+        } else if (dl->restart || dl->write_failed || dl->http_status) {
+            if (dl->fd >= 0) close(dl->fd);
+            dl->fd = -1;
+            remove_part(dl);
+            if (dl->http_status) {
+                LOG_error("[HTTP] download: HTTP %d for: %s\n", dl->http_status, url);
             }
+        } else if (dl->fd >= 0) {
+            // Cancelled or connection lost: keep what arrived for the next try
+            checkpoint(dl);
+            close(dl->fd);
+            dl->fd = -1;
         }
-    }
-
-    free(chunk_buf);
-    fclose(outfile);
-    outfile = NULL;
 
-    if (total_read > 0) {
-        result = (int)total_read;
-        if (progress_percent) *progress_percent = 100;
+        pthread_mutex_destroy(&dl->lock);
+        if (dl->restart && !(should_stop && *should_stop)) continue;
+        break;
     }
 
-cleanup:
-    if (outfile) fclose(outfile);
-    if (ssl_ctx) {
-        if (ssl_ctx->initialized) {
-            mbedtls_ssl_close_notify(&ssl_ctx->ssl);
-        }
-        mbedtls_net_free(&ssl_ctx->net);
-        mbedtls_ssl_free(&ssl_ctx->ssl);
-        mbedtls_ssl_config_free(&ssl_ctx->conf);
-        mbedtls_ctr_drbg_free(&ssl_ctx->ctr_drbg);
-        mbedtls_entropy_free(&ssl_ctx->entropy);
-        free(ssl_ctx);
-    } else if (sock_fd >= 0) {
-        close(sock_fd);
-    }
-    free(header_buf);
-    free(host);
-    free(path);
+    free(dl);
     return result;
 }
 
-int http_download_file(const char* url, const char* filepath,
-                       volatile int* progress_pct, volatile bool* should_stop) {
-    return http_download_file_internal(url, filepath, progress_pct, should_stop, 0);
+void http_download_discard(const char* filepath) {
+    if (!filepath) return;
+
+    char path[1040];
+    snprintf(path, sizeof(path), "%s" HTTP_DOWNLOAD_PART_SUFFIX, filepath);
+    unlink(path);
+    snprintf(path, sizeof(path), "%s" HTTP_DOWNLOAD_PART_SUFFIX ".meta", filepath);
+    unlink(path);
+    snprintf(path, sizeof(path), "%s" HTTP_DOWNLOAD_PART_SUFFIX ".meta.tmp", filepath);
+    unlink(path);
 }
@@ -6,28 +6,74 @@
 // Download timeout in seconds
 #define HTTP_DOWNLOAD_TIMEOUT_SECONDS 30
 
-// Maximum redirect depth
-#define HTTP_DOWNLOAD_MAX_REDIRECTS 10
-
-// Chunk size for downloads (32KB)
+// File write buffer size (32KB)
 #define HTTP_DOWNLOAD_CHUNK_SIZE 32768
 
+// Unsynced bytes allowed before the partial file is fsync'ed (resume point)
+#define HTTP_DOWNLOAD_CHECKPOINT_BYTES (2 * 1024 * 1024)
+
+// In-progress data lives in <filepath>.part (+ .part.meta) until complete
+#define HTTP_DOWNLOAD_PART_SUFFIX ".part"
+
+// Connections used for one file when the server supports byte ranges
+#define HTTP_DOWNLOAD_CONNECTIONS 4
+
+// Smallest piece worth its own connection when splitting a file
+#define HTTP_DOWNLOAD_SEGMENT_MIN_SIZE (2 * 1024 * 1024)
+
+// An idle connection takes over half of a slower one's remaining range
+// if that leaves at least this much for each
+#define HTTP_DOWNLOAD_STEAL_MIN_SIZE (512 * 1024)
+
+/**
+ * Progress of a download, updated while it runs.
+ */
+typedef struct {
+    volatile int percent;           // 0-100 (100 only once the file is in place)
+    volatile long long bytes;       // Bytes of the file received, resumed ones included
+    volatile long long total;       // Full size, 0 while unknown
+} HttpDownloadProgress;
+
 /**
  * Download a file from HTTP/HTTPS URL to local filesystem.
- * Supports:
- * - HTTP and HTTPS (with SSL via mbedtls)
- * - Automatic redirect following (301, 302, 303, 307, 308)
- * - Chunked transfer encoding
+ * The body is streamed to the file in-process by http_client (redirects,
+ * chunked and gzip bodies handled there). Supports:
  * - Progress reporting
  * - Cancellation via flag
+ * - Several connections: when the server supports byte ranges and the file
+ *   is large enough, it is split into up to HTTP_DOWNLOAD_CONNECTIONS ranges
+ *   written in place (pwrite) into a preallocated file. A connection that
+ *   finishes early takes over half of the slowest one's remaining range.
+ *   Otherwise the file arrives over a single stream.
+ * - Resuming: data is written to <filepath>.part and checkpointed every
+ *   HTTP_DOWNLOAD_CHECKPOINT_BYTES. After a cancel, lost connection or
+ *   power cut, the next call for the same URL and path continues with a
+ *   Range request, guarded by the resource's ETag/Last-Modified (If-Range),
+ *   and starts over if the resource has changed. The file appears at
+ *   filepath only once it is complete.
  *
  * @param url            The URL to download from
  * @param filepath       Local path to save the file
- * @param progress_pct   Optional pointer to receive progress (0-100), can be NULL
+ * @param progress       Optional pointer to receive progress, can be NULL
  * @param should_stop    Optional pointer to cancellation flag, can be NULL
  * @return               Number of bytes downloaded on success, -1 on failure
  */
 int http_download_file(const char* url, const char* filepath,
-                       volatile int* progress_pct, volatile bool* should_stop);
+                       HttpDownloadProgress* progress, volatile bool* should_stop);
+
+/**
+ * Cap the combined speed of all downloads in progress and started later
+ * (every connection of every http_download_file() call shares the budget).
+ * Takes effect immediately, so it can be lowered while something else
+ * needs the link.
+ *
+ * @param bytes_per_sec  Limit in bytes per second, 0 = unlimited
+ */
+void http_download_set_rate_limit(int bytes_per_sec);
+
+/**
+ * Remove the partial data of an interrupted download of filepath.
+ */
+void http_download_discard(const char* filepath);
 
 #endif // HTTP_DOWNLOAD_H
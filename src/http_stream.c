@@ -0,0 +1,463 @@
+#define _GNU_SOURCE
+#include "http_stream.h"
+#include "http_client.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include "defines.h"
+#include "api.h"
+
+// Pause before reconnecting grows by this much per failed attempt
+#define HTTP_STREAM_RETRY_DELAY_MS 500
+
+struct HttpStream {
+    char url[HTTP_CLIENT_MAX_URL];
+    char cache_path[512];
+    char complete_path[512];
+    int fd;                     // Sparse cache file
+    int64_t size;               // -1 until known (or if the server never says)
+    uint8_t* have;              // Per block: 1 once all of it is in the cache
+    int block_count;
+    int blocks_have;
+    int64_t linear_end;         // Size unknown: bytes cached from the start
+    int64_t pos;                // Reader position
+    int64_t fetch_start;        // The running request's bytes [fetch_start, fetch_pos)
+    int64_t fetch_pos;          // are in the cache
+    bool fetching;
+    bool parked;                // Transfer waiting for the reader to catch up
+    bool ranges;                // Server honours byte ranges for this resource
+    HttpValidators validators;  // Of the resource being cached
+    bool opened;                // First response seen
+    bool complete;
+    bool kept;                  // Complete file moved into place
+    bool failed;
+    bool aborted;
+    bool interrupted;
+    volatile bool stop;         // Ends the transfer
+    pthread_t thread;
+    bool thread_started;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+};
+
+// One request of the fetch thread
+typedef struct {
+    HttpStream* s;
+    HttpResponse* resp;
+    int64_t start;              // Offset asked for
+    int64_t end;                // One past the last byte wanted, -1 = to the end
+    int64_t bytes;              // Body bytes received
+    bool started;               // First body bytes seen and the response checked
+} StreamFetch;
+
+static int64_t block_end(HttpStream* s, int b) {
+    int64_t end = (int64_t)(b + 1) * HTTP_STREAM_BLOCK_SIZE;
+    return end < s->size ? end : s->size;
+}
+
+// Bytes readable at pos without waiting. Call with s->lock held
+static int64_t available_locked(HttpStream* s, int64_t pos) {
+    int64_t end = pos;
+    if (s->have) {
+        for (int b = (int)(pos / HTTP_STREAM_BLOCK_SIZE); b < s->block_count && s->have[b]; b++) {
+            end = block_end(s, b);
+        }
+    } else if (s->linear_end > end) {
+        end = s->linear_end;
+    }
+    if (s->fetching && pos >= s->fetch_start && s->fetch_pos > end) {
+        end = s->fetch_pos;
+    }
+    return end - pos;
+}
+
+// The first response decides the size and whether ranges can be used; a
+// later one that doesn't match it means the resource changed, and what's
+// cached is dropped. Call with s->lock held
+static void fetch_begin_locked(StreamFetch* f) {
+    HttpStream* s = f->s;
+    const HttpResponse* resp = f->resp;
+
+    bool changed = s->opened &&
+                   (resp->total_length != s->size ||
+                    strcmp(resp->validators.etag, s->validators.etag) != 0 ||
+                    strcmp(resp->validators.last_modified, s->validators.last_modified) != 0);
+
+    if (!s->opened || changed) {
+        if (changed) {
+            LOG_error("[HTTP] stream: resource changed, starting over: %s\n", s->url);
+        }
+        s->size = resp->total_length;
+        s->validators = resp->validators;
+        // Ranges on a resource we can't identify could splice two versions
+        s->ranges = resp->accept_ranges &&
+                    (s->validators.etag[0] || s->validators.last_modified[0]);
+
+        free(s->have);
+        s->have = NULL;
+        s->block_count = 0;
+        s->blocks_have = 0;
+        s->linear_end = 0;
+        if (s->size > 0) {
+            s->block_count = (int)((s->size + HTTP_STREAM_BLOCK_SIZE - 1) / HTTP_STREAM_BLOCK_SIZE);
+            s->have = (uint8_t*)calloc(s->block_count, 1);
+            if (!s->have || ftruncate(s->fd, s->size) != 0) {
+                // Read front to back instead
+                free(s->have);
+                s->have = NULL;
+                s->block_count = 0;
+                s->ranges = false;
+            }
+        }
+        s->opened = true;
+    } else if (resp->status != 206) {
+        // Range ignored: the body starts at 0
+        s->ranges = false;
+    }
+
+    s->fetch_start = s->fetch_pos = resp->status == 206 ? resp->range_start : 0;
+    s->fetching = true;
+    pthread_cond_broadcast(&s->cond);
+}
+
+static int stream_write(const uint8_t* data, int len, void* userdata) {
+    StreamFetch* f = (StreamFetch*)userdata;
+    HttpStream* s = f->s;
+
+    pthread_mutex_lock(&s->lock);
+    if (!f->started) {
+        fetch_begin_locked(f);
+        f->started = true;
+    }
+    int64_t offset = s->fetch_pos;
+    if (s->size >= 0 && offset + len > s->size) len = (int)(s->size - offset);
+    pthread_mutex_unlock(&s->lock);
+
+    // Readers only touch bytes below fetch_pos, so this needs no lock
+    for (int done = 0; done < len; ) {
+        ssize_t w = pwrite(s->fd, data + done, len - done, offset + done);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) {
+            LOG_error("[HTTP] stream: write failed: %s\n", s->cache_path);
+            pthread_mutex_lock(&s->lock);
+            s->failed = true;
+            pthread_cond_broadcast(&s->cond);
+            pthread_mutex_unlock(&s->lock);
+            return -1;
+        }
+        done += w;
+    }
+
+    pthread_mutex_lock(&s->lock);
+    f->bytes += len;
+    s->fetch_pos = offset + len;
+    for (int b = (int)(offset / HTTP_STREAM_BLOCK_SIZE); b < s->block_count; b++) {
+        if (block_end(s, b) > s->fetch_pos) break;
+        // A block this request started inside of isn't all its own
+        if ((int64_t)b * HTTP_STREAM_BLOCK_SIZE < s->fetch_start || s->have[b]) continue;
+        s->have[b] = 1;
+        s->blocks_have++;
+    }
+    if (!s->have && s->fetch_start == 0 && s->fetch_pos > s->linear_end) {
+        s->linear_end = s->fetch_pos;
+    }
+    pthread_cond_broadcast(&s->cond);
+
+    // Stay at most HTTP_STREAM_READAHEAD ahead of the reader: the connection
+    // idles (TCP holds the server back) until playback catches up or moves
+    // away. Servers without ranges aren't held, a dropped connection would
+    // have to start over from the beginning
+    while (!s->stop && s->ranges && s->have && s->fetch_pos - s->pos > HTTP_STREAM_READAHEAD &&
+           !(s->pos < s->fetch_start && available_locked(s, s->pos) == 0)) {
+        s->parked = true;
+        pthread_cond_wait(&s->cond, &s->lock);
+    }
+    s->parked = false;
+
+    int ret = 0;
+    if (s->stop) {
+        ret = -1;
+    } else if (f->end > 0 && s->fetch_pos >= f->end) {
+        ret = 1;  // Reached data cached earlier
+    } else if (s->ranges && s->have &&
+               (s->pos < s->fetch_start || s->pos > s->fetch_pos + HTTP_STREAM_READAHEAD) &&
+               available_locked(s, s->pos) == 0) {
+        ret = 1;  // The reader moved away: reconnect where it is
+    }
+    pthread_mutex_unlock(&s->lock);
+    return ret;
+}
+
+// Pick the next range: from the reader's position up to the next cached
+// block or, once everything after it is cached, the first gap before it.
+// Returns false when nothing is missing. Call with s->lock held
+static bool plan_fetch_locked(HttpStream* s, int64_t* start, int64_t* end) {
+    *start = 0;
+    *end = -1;
+    if (!s->opened || !s->ranges || !s->have) {
+        return !s->have || s->blocks_have < s->block_count;
+    }
+
+    int from = (int)(s->pos / HTTP_STREAM_BLOCK_SIZE);
+    int b = -1;
+    for (int i = from; i < s->block_count && b < 0; i++) {
+        if (!s->have[i]) b = i;
+    }
+    for (int i = 0; i < from && i < s->block_count && b < 0; i++) {
+        if (!s->have[i]) b = i;
+    }
+    if (b < 0) return false;
+
+    int e = b;
+    while (e < s->block_count && !s->have[e]) e++;
+    *start = (int64_t)b * HTTP_STREAM_BLOCK_SIZE;
+    *end = block_end(s, e - 1);
+    return true;
+}
+
+// Call with s->lock held
+static void finish_locked(HttpStream* s) {
+    s->complete = true;
+    if (fdatasync(s->fd) != 0) {
+        LOG_error("[HTTP] stream: failed to sync %s\n", s->cache_path);
+    } else if (!s->complete_path[0]) {
+        s->kept = true;
+    } else if (rename(s->cache_path, s->complete_path) == 0) {
+        s->kept = true;
+    } else {
+        LOG_error("[HTTP] stream: failed to move %s into place\n", s->cache_path);
+    }
+}
+
+static void* fetch_thread(void* arg) {
+    HttpStream* s = (HttpStream*)arg;
+    HttpResponse* resp = (HttpResponse*)malloc(sizeof(HttpResponse));
+    int failures = 0;
+
+    while (!s->stop) {
+        StreamFetch f;
+        memset(&f, 0, sizeof(f));
+        f.s = s;
+        f.resp = resp;
+
+        pthread_mutex_lock(&s->lock);
+        bool more = resp && plan_fetch_locked(s, &f.start, &f.end);
+        if (!more && !s->complete) {
+            if (resp) {
+                finish_locked(s);
+            } else {
+                s->failed = true;
+            }
+            pthread_cond_broadcast(&s->cond);
+        }
+        pthread_mutex_unlock(&s->lock);
+        if (!more) break;
+
+        HttpRequest req;
+        memset(&req, 0, sizeof(req));
+        req.url = s->url;
+        req.should_stop = &s->stop;
+        if (f.start > 0 || f.end > 0) {
+            req.range_start = f.start;
+            req.range_end = f.end > 0 ? f.end - 1 : 0;
+            req.if_range = &s->validators;
+        }
+        req.on_body = stream_write;
+        req.userdata = &f;
+
+        int ret = http_client_get(&req, resp);
+        bool ok = ret == 0 && resp->status >= 200 && resp->status < 300;
+
+        pthread_mutex_lock(&s->lock);
+        s->fetching = false;
+        if (ok && f.started && !s->have && s->fetch_start == 0 && f.end < 0) {
+            // Size was unknown: the body ended, so that's the size
+            s->size = s->fetch_pos;
+            finish_locked(s);
+        } else if (s->have && s->blocks_have == s->block_count) {
+            finish_locked(s);
+        }
+
+        failures = f.bytes > 0 ? 0 : failures + 1;
+        if (!s->complete && !s->stop && !s->failed) {
+            // Before the first response there's nothing to play, so give up
+            // at once; afterwards only a gone resource or no progress ends it
+            bool gone = ret == 0 && resp->status >= 400 && resp->status < 500;
+            if (!s->opened || gone || failures > HTTP_STREAM_RETRIES) {
+                if (ret == 0 && !ok) {
+                    LOG_error("[HTTP] stream: HTTP %d for: %s\n", resp->status, s->url);
+                } else {
+                    LOG_error("[HTTP] stream: giving up on: %s\n", s->url);
+                }
+                s->failed = true;
+            }
+        }
+        bool done = s->complete || s->failed;
+        pthread_cond_broadcast(&s->cond);
+        pthread_mutex_unlock(&s->lock);
+        if (done) break;
+
+        for (int waited = 0; failures > 0 && !s->stop &&
+                             waited < failures * HTTP_STREAM_RETRY_DELAY_MS; waited += 100) {
+            usleep(100000);  // 100ms
+        }
+    }
+
+    free(resp);
+    return NULL;
+}
+
+HttpStream* http_stream_open(const char* url, const char* cache_path, const char* complete_path) {
+    if (!url || !url[0] || !cache_path) return NULL;
+
+    HttpStream* s = (HttpStream*)calloc(1, sizeof(HttpStream));
+    if (!s) return NULL;
+
+    snprintf(s->url, sizeof(s->url), "%s", url);
+    snprintf(s->cache_path, sizeof(s->cache_path), "%s", cache_path);
+    if (complete_path) snprintf(s->complete_path, sizeof(s->complete_path), "%s", complete_path);
+    s->size = -1;
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->cond, NULL);
+
+    s->fd = open(cache_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (s->fd < 0) {
+        LOG_error("[HTTP] stream: can't create %s\n", cache_path);
+        http_stream_close(s);
+        return NULL;
+    }
+
+    if (pthread_create(&s->thread, NULL, fetch_thread, s) != 0) {
+        LOG_error("[HTTP] stream: failed to create fetch thread\n");
+        http_stream_close(s);
+        return NULL;
+    }
+    s->thread_started = true;
+
+    pthread_mutex_lock(&s->lock);
+    while (!s->opened && !s->failed) {
+        pthread_cond_wait(&s->cond, &s->lock);
+    }
+    bool opened = s->opened;
+    pthread_mutex_unlock(&s->lock);
+
+    if (!opened) {
+        http_stream_close(s);
+        return NULL;
+    }
+    return s;
+}
+
+size_t http_stream_read(HttpStream* s, void* buf, size_t len) {
+    if (!s || !buf || len == 0) return 0;
+
+    pthread_mutex_lock(&s->lock);
+    int64_t avail = 0;
+    while (!s->aborted && !(s->size >= 0 && s->pos >= s->size)) {
+        avail = available_locked(s, s->pos);
+        if (avail > 0 || s->complete || s->failed) break;
+        if (s->interrupted) {
+            s->interrupted = false;
+            break;
+        }
+        pthread_cond_wait(&s->cond, &s->lock);
+    }
+    int64_t pos = s->pos;
+    pthread_mutex_unlock(&s->lock);
+
+    if (avail <= 0) return 0;
+    if ((int64_t)len > avail) len = (size_t)avail;
+
+    ssize_t got = pread(s->fd, buf, len, pos);
+    if (got <= 0) return 0;
+
+    pthread_mutex_lock(&s->lock);
+    s->pos = pos + got;
+    if (s->parked) pthread_cond_broadcast(&s->cond);
+    pthread_mutex_unlock(&s->lock);
+    return (size_t)got;
+}
+
+int http_stream_seek(HttpStream* s, int64_t offset) {
+    if (!s) return -1;
+
+    pthread_mutex_lock(&s->lock);
+    int result = -1;
+    if (offset >= 0 && (s->size < 0 || offset <= s->size)) {
+        s->pos = offset;
+        s->interrupted = false;
+        if (s->parked) pthread_cond_broadcast(&s->cond);
+        result = 0;
+    }
+    pthread_mutex_unlock(&s->lock);
+    return result;
+}
+
+int64_t http_stream_tell(HttpStream* s) {
+    if (!s) return 0;
+    pthread_mutex_lock(&s->lock);
+    int64_t pos = s->pos;
+    pthread_mutex_unlock(&s->lock);
+    return pos;
+}
+
+int64_t http_stream_size(HttpStream* s) {
+    if (!s) return -1;
+    pthread_mutex_lock(&s->lock);
+    int64_t size = s->size;
+    pthread_mutex_unlock(&s->lock);
+    return size;
+}
+
+bool http_stream_is_complete(HttpStream* s) {
+    if (!s) return false;
+    pthread_mutex_lock(&s->lock);
+    bool complete = s->complete;
+    pthread_mutex_unlock(&s->lock);
+    return complete;
+}
+
+void http_stream_interrupt(HttpStream* s) {
+    if (!s) return;
+    pthread_mutex_lock(&s->lock);
+    s->interrupted = true;
+    pthread_cond_broadcast(&s->cond);
+    pthread_mutex_unlock(&s->lock);
+}
+
+void http_stream_abort(HttpStream* s) {
+    if (!s) return;
+    pthread_mutex_lock(&s->lock);
+    s->aborted = true;
+    pthread_cond_broadcast(&s->cond);
+    pthread_mutex_unlock(&s->lock);
+}
+
+void http_stream_close(HttpStream* s) {
+    if (!s) return;
+
+    pthread_mutex_lock(&s->lock);
+    s->stop = true;
+    s->aborted = true;
+    pthread_cond_broadcast(&s->cond);
+    pthread_mutex_unlock(&s->lock);
+
+    if (s->thread_started) {
+        pthread_join(s->thread, NULL);
+    }
+    if (s->fd >= 0) {
+        close(s->fd);
+        if (!s->kept) unlink(s->cache_path);
+    }
+
+    pthread_mutex_destroy(&s->lock);
+    pthread_cond_destroy(&s->cond);
+    free(s->have);
+    free(s);
+}
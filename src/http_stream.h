@@ -0,0 +1,83 @@
+#ifndef HTTP_STREAM_H
+#define HTTP_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Cache granularity: a block counts as present once all of it has arrived
+#define HTTP_STREAM_BLOCK_SIZE (64 * 1024)
+
+// The transfer runs at most this far ahead of the reader; a read further
+// than this past the data arriving opens a new range instead of waiting
+#define HTTP_STREAM_READAHEAD (1024 * 1024)
+
+// Reconnects without progress before the stream gives up
+#define HTTP_STREAM_RETRIES 5
+
+typedef struct HttpStream HttpStream;
+
+/**
+ * Open a remote file for random-access reading while it downloads.
+ * A background connection writes what arrives into a sparse cache file,
+ * starting at the reader's position and keeping up to HTTP_STREAM_READAHEAD
+ * ahead of it; once the end is reached it fills the gaps before. A read
+ * further away than HTTP_STREAM_READAHEAD from the data arriving (a seek)
+ * makes it reconnect there with a range request. Servers without byte
+ * ranges are read front to back, unbounded. Once every byte is in the cache
+ * it is renamed to complete_path, so a stream played to the end doubles as
+ * a download.
+ *
+ * Returns after the response headers arrive (the size is known by then).
+ *
+ * @param url            The URL to stream
+ * @param cache_path     Sparse cache file, removed if the stream is closed incomplete
+ * @param complete_path  Where the complete file is moved, NULL to keep it at cache_path
+ * @return               Stream handle, or NULL if the server can't be reached
+ */
+HttpStream* http_stream_open(const char* url, const char* cache_path, const char* complete_path);
+
+/**
+ * Read from the current position, waiting until the bytes have arrived.
+ * Call from one thread at a time.
+ *
+ * @return  Bytes read, 0 at the end of the file, after the transfer failed,
+ *          or when the wait was cut short by http_stream_interrupt()/abort
+ */
+size_t http_stream_read(HttpStream* s, void* buf, size_t len);
+
+/**
+ * Move the read position. Also clears a pending interrupt.
+ *
+ * @return  0 on success, -1 if offset is outside the file
+ */
+int http_stream_seek(HttpStream* s, int64_t offset);
+
+// Current read position
+int64_t http_stream_tell(HttpStream* s);
+
+// Full size of the file, -1 if the server didn't say
+int64_t http_stream_size(HttpStream* s);
+
+// True once the whole file is cached (and moved to complete_path)
+bool http_stream_is_complete(HttpStream* s);
+
+/**
+ * Make a read that is waiting (or the next one that would wait) return 0
+ * once, e.g. so a decoder notices a seek request. Safe from any thread.
+ */
+void http_stream_interrupt(HttpStream* s);
+
+/**
+ * Make every read return 0 from now on, so a reader thread can be joined
+ * before http_stream_close(). Safe from any thread.
+ */
+void http_stream_abort(HttpStream* s);
+
+/**
+ * Stop the transfer and free the stream. The cache file is removed unless
+ * the file was complete.
+ */
+void http_stream_close(HttpStream* s);
+
+#endif // HTTP_STREAM_H
@@ -1,6 +1,6 @@
 #define _GNU_SOURCE
 #include "lyrics.h"
-#include "radio_net.h"
+#include "http_cache.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -236,7 +236,7 @@ static void* fetch_thread_func(void* arg) {
     JSON_Value* root = NULL;
 
     // Try exact match first
-    int bytes = radio_net_fetch(url, response_buf, 64 * 1024, NULL, 0);
+    int bytes = http_cache_fetch(url, response_buf, 64 * 1024, HTTP_CACHE_TTL_LYRICS);
 
     if (bytes > 0) {
         response_buf[bytes] = '\0';
@@ -271,7 +271,7 @@ static void* fetch_thread_func(void* arg) {
         url_encode(query, encoded_query, sizeof(encoded_query));
         snprintf(url, sizeof(url), "https://lrclib.net/api/search?q=%s", encoded_query);
 
-        bytes = radio_net_fetch(url, response_buf, 64 * 1024, NULL, 0);
+        bytes = http_cache_fetch(url, response_buf, 64 * 1024, HTTP_CACHE_TTL_LYRICS);
 
         if (bytes > 0) {
             response_buf[bytes] = '\0';
@@ -5,16 +5,19 @@
 #include "api.h"
 #include "module_common.h"
 #include "module_player.h"
+#include "module_radio.h"
 #include "settings.h"
 #include "ui_main.h"
 #include "ui_music.h"
 #include "ui_radio.h"
 #include "player.h"
 #include "radio.h"
+#include "podcast.h"
 #include "spectrum.h"
 
 static bool autosleep_disabled = false;
 static uint32_t last_input_time = 0;
+static uint32_t last_button_time = 0;  // Any button, in every module (auto-download idle)
 
 // Screen off hint state
 static bool screen_off_hint_active = false;
@@ -49,6 +52,7 @@ void ModuleCommon_tickToast(char* message, uint32_t toast_time, int* dirty) {
 void ModuleCommon_init(void) {
     autosleep_disabled = false;
     last_input_time = SDL_GetTicks();
+    last_button_time = last_input_time;
     screen_off_hint_active = false;
     show_quit_confirm = false;
     show_controls_help = false;
@@ -60,6 +64,13 @@ void ModuleCommon_init(void) {
 GlobalInputResult ModuleCommon_handleGlobalInput(SDL_Surface* screen, int* show_setting, int app_state) {
     GlobalInputResult result = {false, false, false};
 
+    // Podcast auto-download waits for the device to sit idle
+    uint32_t now = SDL_GetTicks();
+    if (PAD_anyPressed()) last_button_time = now;
+    uint32_t idle_ms = now - last_button_time;
+    if (now - last_input_time < idle_ms) idle_ms = now - last_input_time;
+    Podcast_autoDownloadTick(idle_ms);
+
     // Poll USB HID events (earphone buttons)
     USBHIDEvent hid_event;
     while ((hid_event = Player_pollUSBHID()) != USB_HID_EVENT_NONE) {
@@ -105,19 +116,8 @@ GlobalInputResult ModuleCommon_handleGlobalInput(SDL_Surface* screen, int* show_
                 RadioStation* stations;
                 int station_count = Radio_getStations(&stations);
                 if (station_count > 1) {
-                    // Find current station index
-                    int current_idx = Radio_findCurrentStationIndex();
-                    if (current_idx < 0) continue;
-                    // Calculate new index
-                    int new_idx;
-                    if (hid_event == USB_HID_EVENT_NEXT_TRACK) {
-                        new_idx = (current_idx + 1) % station_count;
-                    } else {
-                        new_idx = (current_idx - 1 + station_count) % station_count;
-                    }
-                    // Switch to new station
-                    Radio_stop();
-                    Radio_play(stations[new_idx].url);
+                    // Same order as the station list and the D-pad
+                    RadioModule_stepStation(hid_event == USB_HID_EVENT_NEXT_TRACK ? 1 : -1);
                     result.dirty = true;
                     result.input_consumed = true;
                 }
@@ -10,6 +10,8 @@
 #include "player.h"
 #include "keyboard.h"
 #include "ui_podcast.h"
+#include "ui_thumbnail.h"
+#include "settings.h"
 #include "ui_radio.h"
 #include "ui_main.h"
 #include "ui_utils.h"
@@ -117,6 +119,9 @@ ModuleExitReason PodcastModule_run(SDL_Surface* screen) {
     while (1) {
         PAD_poll();
 
+        // Artwork finished loading in the background (lists, headers, now playing)
+        if (Thumbnail_poll()) dirty = 1;
+
         // Handle confirmation dialog
         if (show_confirm) {
             if (PAD_justPressed(BTN_A)) {
@@ -190,6 +195,8 @@ ModuleExitReason PodcastModule_run(SDL_Surface* screen) {
             if (Podcast_checkRefreshCompleted()) {
                 Podcast_saveSubscriptions();
                 dirty = 1;
+            } else if (Podcast_checkFeedRefreshed()) {
+                dirty = 1;  // Show new episode counts feed by feed
             }
 
             int cl_count_raw = Podcast_getContinueListeningCount();
@@ -200,7 +207,6 @@ ModuleExitReason PodcastModule_run(SDL_Surface* screen) {
             if (podcast_toast_message[0] && (SDL_GetTicks() - podcast_toast_time < TOAST_DURATION)) dirty = 1;
             if (Podcast_isTitleScrolling()) Podcast_animateTitleScroll();
             if (Podcast_titleScrollNeedsRender()) dirty = 1;
-            if (Podcast_loadPendingThumbnails()) dirty = 1;
 
             if (PAD_justRepeated(BTN_UP) && total > 0) {
                 podcast_menu_selected = (podcast_menu_selected > 0) ? podcast_menu_selected - 1 : total - 1;
@@ -320,6 +326,18 @@ ModuleExitReason PodcastModule_run(SDL_Surface* screen) {
                 podcast_manage_selected = (podcast_manage_selected < PODCAST_MANAGE_COUNT - 1) ? podcast_manage_selected + 1 : 0;
                 dirty = 1;
             }
+            else if (PAD_justPressed(BTN_LEFT) || PAD_justPressed(BTN_RIGHT)) {
+                bool next = PAD_justPressed(BTN_RIGHT);
+                if (podcast_manage_selected == PODCAST_MANAGE_AUTO_DOWNLOAD) {
+                    if (next) Settings_cyclePodcastAutoDownloadNext();
+                    else Settings_cyclePodcastAutoDownloadPrev();
+                    dirty = 1;
+                } else if (podcast_manage_selected == PODCAST_MANAGE_STORAGE) {
+                    if (next) Settings_cyclePodcastStorageNext();
+                    else Settings_cyclePodcastStoragePrev();
+                    dirty = 1;
+                }
+            }
             else if (PAD_justPressed(BTN_A)) {
                 switch (podcast_manage_selected) {
                     case PODCAST_MANAGE_SEARCH: {
@@ -359,6 +377,15 @@ ModuleExitReason PodcastModule_run(SDL_Surface* screen) {
                         state = PODCAST_INTERNAL_TOP_SHOWS;
                         dirty = 1;
                         break;
+                    case PODCAST_MANAGE_AUTO_DOWNLOAD:
+                        // A also cycles the value (convenience)
+                        Settings_cyclePodcastAutoDownloadNext();
+                        dirty = 1;
+                        break;
+                    case PODCAST_MANAGE_STORAGE:
+                        Settings_cyclePodcastStorageNext();
+                        dirty = 1;
+                        break;
                 }
             }
             else if (PAD_justPressed(BTN_B)) {
@@ -592,7 +619,25 @@ ModuleExitReason PodcastModule_run(SDL_Surface* screen) {
                             snprintf(podcast_toast_message, sizeof(podcast_toast_message), "Cancel failed");
                         }
                         podcast_toast_time = SDL_GetTicks();
-                    } else if (Podcast_episodeFileExists(feed, podcast_current_episode_index)) {
+                    } else if (PAD_isPressed(BTN_SELECT) &&
+                               !Podcast_episodeFileExists(feed, podcast_current_episode_index)) {
+                        // SELECT+A: download for later instead of streaming now
+                        if (!Wifi_ensureConnected(screen, show_setting)) {
+                            snprintf(podcast_toast_message, sizeof(podcast_toast_message), "No network connection");
+                            podcast_toast_time = SDL_GetTicks();
+                        } else if (Podcast_queueDownload(feed, podcast_current_episode_index) == 0) {
+                            snprintf(podcast_toast_message, sizeof(podcast_toast_message), "Downloading...");
+                            podcast_toast_time = SDL_GetTicks();
+                        } else {
+                            snprintf(podcast_toast_message, sizeof(podcast_toast_message), "Download failed");
+                            podcast_toast_time = SDL_GetTicks();
+                        }
+                    } else if (!Podcast_episodeFileExists(feed, podcast_current_episode_index) &&
+                               !Wifi_ensureConnected(screen, show_setting)) {
+                        snprintf(podcast_toast_message, sizeof(podcast_toast_message), "No network connection");
+                        podcast_toast_time = SDL_GetTicks();
+                    } else {
+                        // Downloaded, or streamed while it downloads
                         int load_result = Podcast_loadAndSeek(feed, podcast_current_episode_index);
                         if (load_result >= 0) {
                             // Clear new flag only when actually playing
@@ -615,17 +660,6 @@ ModuleExitReason PodcastModule_run(SDL_Surface* screen) {
                             snprintf(podcast_toast_message, sizeof(podcast_toast_message), "Failed to play");
                             podcast_toast_time = SDL_GetTicks();
                         }
-                    } else {
-                        if (!Wifi_ensureConnected(screen, show_setting)) {
-                            snprintf(podcast_toast_message, sizeof(podcast_toast_message), "No network connection");
-                            podcast_toast_time = SDL_GetTicks();
-                        } else if (Podcast_queueDownload(feed, podcast_current_episode_index) == 0) {
-                            snprintf(podcast_toast_message, sizeof(podcast_toast_message), "Downloading...");
-                            podcast_toast_time = SDL_GetTicks();
-                        } else {
-                            snprintf(podcast_toast_message, sizeof(podcast_toast_message), "Download failed");
-                            podcast_toast_time = SDL_GetTicks();
-                        }
                     }
                 }
                 dirty = 1;
@@ -656,6 +690,11 @@ ModuleExitReason PodcastModule_run(SDL_Surface* screen) {
                 } else if (!Wifi_ensureConnected(screen, show_setting)) {
                     snprintf(podcast_toast_message, sizeof(podcast_toast_message), "No network connection");
                     podcast_toast_time = SDL_GetTicks();
+                } else if (PAD_isPressed(BTN_SELECT)) {
+                    // SELECT+Y: re-read the whole feed, not just up to the stored episodes
+                    Podcast_startResyncFeed(podcast_current_feed_index);
+                    snprintf(podcast_toast_message, sizeof(podcast_toast_message), "Re-syncing all episodes...");
+                    podcast_toast_time = SDL_GetTicks();
                 } else {
                     Podcast_startRefreshFeed(podcast_current_feed_index);
                     snprintf(podcast_toast_message, sizeof(podcast_toast_message), "Checking for new episodes...");
@@ -757,6 +796,16 @@ ModuleExitReason PodcastModule_run(SDL_Surface* screen) {
                     ModuleCommon_recordInputTime();
                     dirty = 1;
                 }
+                else if (PAD_justPressed(BTN_X)) {
+                    Podcast_cyclePlaybackSpeed(podcast_current_feed_index);
+                    ModuleCommon_recordInputTime();
+                    dirty = 1;
+                }
+                else if (PAD_justPressed(BTN_Y)) {
+                    Podcast_toggleSkipSilence(podcast_current_feed_index);
+                    ModuleCommon_recordInputTime();
+                    dirty = 1;
+                }
 
                 Podcast_update();
                 if (Podcast_isTitleScrolling()) Podcast_animateTitleScroll();
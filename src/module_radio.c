@@ -11,6 +11,7 @@
 #include "player.h"
 #include "radio.h"
 #include "radio_curated.h"
+#include "radio_health.h"
 #include "album_art.h"
 #include "ui_radio.h"
 #include "ui_album_art.h"
@@ -27,9 +28,17 @@ typedef enum {
     RADIO_INTERNAL_HELP
 } RadioInternalState;
 
+// Pre-connect a station once the cursor has rested on it this long
+#define RADIO_PRECONNECT_DWELL_MS 700
+
+// Left/Right rewind or skip ahead in the time-shift buffer by this much
+#define RADIO_SEEK_STEP_SEC 10
+
 // Module state
-static int radio_selected = 0;
+static int radio_selected = 0;                // Position in the health-sorted preset list
 static int radio_scroll = 0;
+static uint32_t radio_highlight_time = 0;   // When the cursor last moved
+static int radio_preconnect_index = -1;     // Station being pre-connected (-1 = none)
 static char radio_toast_message[128] = "";
 static uint32_t radio_toast_time = 0;
 
@@ -51,9 +60,15 @@ static char confirm_station_url[RADIO_MAX_URL] = "";
 // Help screen back-navigation
 static RadioInternalState help_return_state = RADIO_INTERNAL_ADD_COUNTRY;
 
-// Sorted station index mapping for alphabetical display
+// Sorted station index mapping for display (healthy first, then alphabetical)
 static int sorted_station_indices[256];
 static int sorted_station_count = 0;
+static uint32_t sorted_health_version = 0;
+
+// Sorted preset index mapping (healthy first, then the user's own order)
+static int preset_sorted_indices[RADIO_MAX_STATIONS];
+static int preset_sorted_count = 0;
+static uint32_t preset_health_version = 0;
 
 // Screen off state
 static bool screen_off = false;
@@ -68,7 +83,9 @@ static void handle_hid_events(void) {
     USBHIDEvent hid_event;
     while ((hid_event = Player_pollUSBHID()) != USB_HID_EVENT_NONE) {
         if (hid_event == USB_HID_EVENT_PLAY_PAUSE) {
-            if (Radio_isActive()) {
+            if (Radio_canTimeshift()) {
+                Radio_setPaused(!Radio_isPaused());
+            } else if (Radio_isActive()) {
                 Radio_stop();
             } else {
                 const char* url = Radio_getCurrentUrl();
@@ -77,17 +94,7 @@ static void handle_hid_events(void) {
                 }
             }
         } else if (hid_event == USB_HID_EVENT_NEXT_TRACK || hid_event == USB_HID_EVENT_PREV_TRACK) {
-            RadioStation* stations;
-            int station_count = Radio_getStations(&stations);
-            if (station_count > 1) {
-                int current_idx = Radio_findCurrentStationIndex();
-                if (current_idx < 0) current_idx = 0;
-                int new_idx = (hid_event == USB_HID_EVENT_NEXT_TRACK)
-                    ? (current_idx + 1) % station_count
-                    : (current_idx - 1 + station_count) % station_count;
-                Radio_stop();
-                Radio_play(stations[new_idx].url);
-            }
+            RadioModule_stepStation(hid_event == USB_HID_EVENT_NEXT_TRACK ? 1 : -1);
         } else {
             ModuleCommon_handleHIDVolume(hid_event);
         }
@@ -98,19 +105,109 @@ static void build_sorted_station_indices(const char* country_code) {
     int sc = 0;
     const CuratedStation* cs = Radio_getCuratedStations(country_code, &sc);
     sorted_station_count = (sc < 256) ? sc : 256;
-    for (int i = 0; i < sorted_station_count; i++) sorted_station_indices[i] = i;
-    // Insertion sort by name (max ~50 stations per country, adequate)
+    sorted_health_version = radio_health_version();
+
+    // Look up health once per station rather than per comparison
+    int rank[256];
+    for (int i = 0; i < sorted_station_count; i++) {
+        sorted_station_indices[i] = i;
+        rank[i] = radio_health_rank(cs[i].url);
+    }
+    // Insertion sort by health, then name (max ~50 stations per country, adequate)
     for (int i = 1; i < sorted_station_count; i++) {
         int key = sorted_station_indices[i];
         int j = i - 1;
-        while (j >= 0 && strcasecmp(cs[sorted_station_indices[j]].name, cs[key].name) > 0) {
-            sorted_station_indices[j + 1] = sorted_station_indices[j];
+        while (j >= 0) {
+            int prev = sorted_station_indices[j];
+            int cmp = rank[prev] - rank[key];
+            if (cmp == 0) cmp = strcasecmp(cs[prev].name, cs[key].name);
+            if (cmp <= 0) break;
+            sorted_station_indices[j + 1] = prev;
             j--;
         }
         sorted_station_indices[j + 1] = key;
     }
 }
 
+static void build_sorted_preset_indices(void) {
+    RadioStation* stations;
+    int count = Radio_getStations(&stations);
+    preset_sorted_count = (count < RADIO_MAX_STATIONS) ? count : RADIO_MAX_STATIONS;
+    preset_health_version = radio_health_version();
+
+    int rank[RADIO_MAX_STATIONS];
+    for (int i = 0; i < preset_sorted_count; i++) {
+        preset_sorted_indices[i] = i;
+        rank[i] = radio_health_rank(stations[i].url);
+    }
+    // Stable insertion sort by health only - presets keep their saved order otherwise
+    for (int i = 1; i < preset_sorted_count; i++) {
+        int key = preset_sorted_indices[i];
+        int j = i - 1;
+        while (j >= 0 && rank[preset_sorted_indices[j]] > rank[key]) {
+            preset_sorted_indices[j + 1] = preset_sorted_indices[j];
+            j--;
+        }
+        preset_sorted_indices[j + 1] = key;
+    }
+}
+
+// Re-sort presets, keeping the cursor on the same station where possible
+static void resort_presets(void) {
+    int sel_actual = (radio_selected < preset_sorted_count) ? preset_sorted_indices[radio_selected] : -1;
+    build_sorted_preset_indices();
+    if (radio_selected >= preset_sorted_count) {
+        radio_selected = (preset_sorted_count > 0) ? preset_sorted_count - 1 : 0;
+    }
+    for (int i = 0; i < preset_sorted_count; i++) {
+        if (preset_sorted_indices[i] == sel_actual) {
+            radio_selected = i;
+            break;
+        }
+    }
+}
+
+void RadioModule_stepStation(int step) {
+    RadioStation* stations;
+    int count = Radio_getStations(&stations);
+    if (count <= 1) return;
+    if (count != preset_sorted_count || radio_health_version() != preset_health_version) {
+        resort_presets();
+    }
+
+    // From the station playing now, if it's a preset
+    int current = Radio_findCurrentStationIndex();
+    for (int i = 0; i < preset_sorted_count; i++) {
+        if (preset_sorted_indices[i] == current) {
+            radio_selected = i;
+            break;
+        }
+    }
+    radio_selected = (radio_selected + step % preset_sorted_count + preset_sorted_count) % preset_sorted_count;
+    Radio_stop();
+    Radio_play(stations[preset_sorted_indices[radio_selected]].url);
+}
+
+// Queue background health probes for a station list (skipped when offline)
+static void probe_user_stations(void) {
+    if (!Wifi_isConnected()) return;
+    RadioStation* stations;
+    int count = Radio_getStations(&stations);
+    const char* urls[RADIO_MAX_STATIONS];
+    for (int i = 0; i < count && i < RADIO_MAX_STATIONS; i++) urls[i] = stations[i].url;
+    radio_health_probe(urls, count < RADIO_MAX_STATIONS ? count : RADIO_MAX_STATIONS);
+}
+
+static void probe_country_stations(const char* country_code) {
+    if (!Wifi_isConnected()) return;
+    int count = 0;
+    const CuratedStation* cs = Radio_getCuratedStations(country_code, &count);
+    const char* urls[256];
+    if (count > 256) count = 256;
+    for (int i = 0; i < count; i++) urls[i] = cs[i].url;
+    radio_health_probe(urls, count);
+}
+
 ModuleExitReason RadioModule_run(SDL_Surface* screen) {
     Radio_init();
 
@@ -123,6 +220,10 @@ ModuleExitReason RadioModule_run(SDL_Surface* screen) {
     ModuleCommon_recordInputTime();
     radio_toast_message[0] = '\0';
     show_confirm = false;
+    radio_highlight_time = SDL_GetTicks();
+    radio_preconnect_index = -1;
+    resort_presets();
+    probe_user_stations();
 
     while (1) {
         PAD_poll();
@@ -134,17 +235,12 @@ ModuleExitReason RadioModule_run(SDL_Surface* screen) {
                     // Delete from main list
                     Radio_removeStation(confirm_target_index);
                     Radio_saveStations();
-                    RadioStation* stations;
-                    int station_count = Radio_getStations(&stations);
-                    if (radio_selected >= station_count && station_count > 0) {
-                        radio_selected = station_count - 1;
-                    } else if (station_count == 0) {
-                        radio_selected = 0;
-                    }
+                    resort_presets();
                 } else if (confirm_action_type == 1) {
                     // Remove from browse
                     Radio_removeStationByUrl(confirm_station_url);
                     Radio_saveStations();
+                    resort_presets();
                 }
                 show_confirm = false;
                 dirty = 1;
@@ -195,20 +291,35 @@ ModuleExitReason RadioModule_run(SDL_Surface* screen) {
             RadioStation* stations;
             int station_count = Radio_getStations(&stations);
 
+            // Re-sort as probe results arrive, keeping the cursor on the same station
+            if (radio_health_version() != preset_health_version || station_count != preset_sorted_count) {
+                resort_presets();
+                dirty = 1;
+            }
+            int selected_actual = (station_count > 0) ? preset_sorted_indices[radio_selected] : 0;
+
             if (PAD_justRepeated(BTN_UP) && station_count > 0) {
                 radio_selected = (radio_selected > 0) ? radio_selected - 1 : station_count - 1;
+                Radio_cancelPreconnect();
+                radio_preconnect_index = -1;
+                radio_highlight_time = SDL_GetTicks();
                 dirty = 1;
             }
             else if (PAD_justRepeated(BTN_DOWN) && station_count > 0) {
                 radio_selected = (radio_selected < station_count - 1) ? radio_selected + 1 : 0;
+                Radio_cancelPreconnect();
+                radio_preconnect_index = -1;
+                radio_highlight_time = SDL_GetTicks();
                 dirty = 1;
             }
             else if (PAD_justPressed(BTN_A) && station_count > 0) {
+                // Radio_play() promotes a matching pre-connect, so forget it here
+                radio_preconnect_index = -1;
                 if (!Wifi_ensureConnected(screen, show_setting)) {
                     snprintf(radio_toast_message, sizeof(radio_toast_message), "Internet connection required");
                     radio_toast_time = SDL_GetTicks();
                     dirty = 1;
-                } else if (Radio_play(stations[radio_selected].url) == 0) {
+                } else if (Radio_play(stations[selected_actual].url) == 0) {
                     ModuleCommon_recordInputTime();
                     last_rendered_artist[0] = '\0';
                     last_rendered_title[0] = '\0';
@@ -222,19 +333,33 @@ ModuleExitReason RadioModule_run(SDL_Surface* screen) {
                 return MODULE_EXIT_TO_MENU;
             }
             else if (PAD_justPressed(BTN_Y)) {
+                Radio_cancelPreconnect();
+                radio_preconnect_index = -1;
                 add_country_selected = 0;
                 add_country_scroll = 0;
                 state = RADIO_INTERNAL_ADD_COUNTRY;
                 dirty = 1;
             }
             else if (PAD_justPressed(BTN_X) && station_count > 0) {
-                strncpy(confirm_station_name, stations[radio_selected].name, RADIO_MAX_NAME - 1);
+                Radio_cancelPreconnect();
+                radio_preconnect_index = -1;
+                strncpy(confirm_station_name, stations[selected_actual].name, RADIO_MAX_NAME - 1);
                 confirm_station_name[RADIO_MAX_NAME - 1] = '\0';
-                confirm_target_index = radio_selected;
+                confirm_target_index = selected_actual;
                 confirm_action_type = 0;
                 show_confirm = true;
                 dirty = 1;
             }
+
+            // Speculatively connect to the station the cursor rests on
+            if (state == RADIO_INTERNAL_LIST && !show_confirm && station_count > 0) {
+                selected_actual = preset_sorted_indices[radio_selected];
+                if (radio_preconnect_index != selected_actual &&
+                    SDL_GetTicks() - radio_highlight_time >= RADIO_PRECONNECT_DWELL_MS &&
+                    Wifi_isConnected() && Radio_preconnect(stations[selected_actual].url)) {
+                    radio_preconnect_index = selected_actual;
+                }
+            }
         }
         // =========================================
         // RADIO PLAYING STATE
@@ -282,17 +407,13 @@ ModuleExitReason RadioModule_run(SDL_Surface* screen) {
 
             if (PAD_justPressed(BTN_UP) || PAD_justPressed(BTN_R1)) {
                 if (station_count > 1) {
-                    radio_selected = (radio_selected + 1) % station_count;
-                    Radio_stop();
-                    Radio_play(stations[radio_selected].url);
+                    RadioModule_stepStation(1);
                     dirty = 1;
                 }
             }
             else if (PAD_justPressed(BTN_DOWN) || PAD_justPressed(BTN_L1)) {
                 if (station_count > 1) {
-                    radio_selected = (radio_selected - 1 + station_count) % station_count;
-                    Radio_stop();
-                    Radio_play(stations[radio_selected].url);
+                    RadioModule_stepStation(-1);
                     dirty = 1;
                 }
             }
@@ -304,12 +425,18 @@ ModuleExitReason RadioModule_run(SDL_Surface* screen) {
                 cleanup_album_art_background();
                 RadioStatus_clear();
                 ModuleCommon_setAutosleepDisabled(false);
+                radio_highlight_time = SDL_GetTicks();
+                radio_preconnect_index = -1;
                 state = RADIO_INTERNAL_LIST;
                 dirty = 1;
             }
             else if (PAD_justPressed(BTN_A)) {
                 // A toggles play/pause
-                if (Radio_isActive()) {
+                if (Radio_canTimeshift()) {
+                    // Direct streams keep recording while paused
+                    Radio_setPaused(!Radio_isPaused());
+                    dirty = 1;
+                } else if (Radio_isActive()) {
                     // Playing - stop it
                     Radio_stop();
                     dirty = 1;
@@ -322,6 +449,18 @@ ModuleExitReason RadioModule_run(SDL_Surface* screen) {
                     }
                 }
             }
+            else if (PAD_justRepeated(BTN_LEFT) && Radio_canTimeshift()) {
+                Radio_seek(-RADIO_SEEK_STEP_SEC);
+                dirty = 1;
+            }
+            else if (PAD_justRepeated(BTN_RIGHT) && Radio_canTimeshift()) {
+                Radio_seek(RADIO_SEEK_STEP_SEC);
+                dirty = 1;
+            }
+            else if (PAD_justPressed(BTN_X) && Radio_canTimeshift()) {
+                Radio_goLive();
+                dirty = 1;
+            }
             else if (PAD_tappedSelect(SDL_GetTicks())) {
                 ModuleCommon_startScreenOffHint();
                 GFX_clearLayers(LAYER_SCROLLTEXT);
@@ -379,6 +518,7 @@ ModuleExitReason RadioModule_run(SDL_Surface* screen) {
                 add_station_selected = 0;
                 add_station_scroll = 0;
                 build_sorted_station_indices(add_selected_country_code);
+                probe_country_stations(add_selected_country_code);
                 state = RADIO_INTERNAL_ADD_STATIONS;
                 dirty = 1;
             }
@@ -400,6 +540,19 @@ ModuleExitReason RadioModule_run(SDL_Surface* screen) {
             int station_count = 0;
             const CuratedStation* stations = Radio_getCuratedStations(add_selected_country_code, &station_count);
 
+            // Re-sort as probe results arrive, keeping the cursor on the same station
+            if (radio_health_version() != sorted_health_version && sorted_station_count > 0) {
+                int sel_actual = sorted_station_indices[add_station_selected];
+                build_sorted_station_indices(add_selected_country_code);
+                for (int i = 0; i < sorted_station_count; i++) {
+                    if (sorted_station_indices[i] == sel_actual) {
+                        add_station_selected = i;
+                        break;
+                    }
+                }
+                dirty = 1;
+            }
+
             if (PAD_justRepeated(BTN_UP) && sorted_station_count > 0) {
                 add_station_selected = (add_station_selected > 0) ? add_station_selected - 1 : sorted_station_count - 1;
                 dirty = 1;
@@ -424,6 +577,7 @@ ModuleExitReason RadioModule_run(SDL_Surface* screen) {
                     // Not subscribed - add instantly
                     if (Radio_addStation(station->name, station->url, station->genre, station->slogan) >= 0) {
                         Radio_saveStations();
+                        resort_presets();
                         snprintf(radio_toast_message, sizeof(radio_toast_message), "Added: %s", station->name);
                         radio_toast_time = SDL_GetTicks();
                     } else {
@@ -484,10 +638,12 @@ ModuleExitReason RadioModule_run(SDL_Surface* screen) {
                 switch (state) {
                     case RADIO_INTERNAL_LIST:
                         render_radio_list(screen, show_setting, radio_selected, &radio_scroll,
+                                          preset_sorted_indices, preset_sorted_count,
                                           radio_toast_message, radio_toast_time);
                         break;
                     case RADIO_INTERNAL_PLAYING: {
-                        render_radio_playing(screen, show_setting, radio_selected);
+                        render_radio_playing(screen, show_setting,
+                                             preset_sorted_count > 0 ? preset_sorted_indices[radio_selected] : 0);
                         const RadioMetadata* meta = Radio_getMetadata();
                         strncpy(last_rendered_artist, meta->artist, sizeof(last_rendered_artist) - 1);
                         last_rendered_artist[sizeof(last_rendered_artist) - 1] = '\0';
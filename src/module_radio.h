@@ -8,4 +8,9 @@
 // Handles: Station list, playback, adding stations from curated list
 ModuleExitReason RadioModule_run(SDL_Surface* screen);
 
+// Switch to the next (step 1) or previous (-1) preset in the health-sorted
+// list the station screen shows, moving its cursor along. Used by the D-pad
+// and by media buttons, in or out of the radio screen
+void RadioModule_stepStation(int step);
+
 #endif
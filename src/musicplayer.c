@@ -31,6 +31,7 @@
 #include "settings.h"
 #include "resume.h"
 #include "scrobbler.h"
+#include "podcast.h"
 
 // Global quit flag
 static bool quit = false;
@@ -121,6 +122,9 @@ int main(int argc, char* argv[]) {
     // Initialize Last.fm scrobbler log
     Scrobbler_init();
 
+    // Load podcasts now so auto-download can run from any screen
+    Podcast_init();
+
     // Main application loop
     while (!quit) {
         // Run main menu - returns selected item or MENU_QUIT
@@ -162,6 +166,7 @@ int main(int argc, char* argv[]) {
     }
 
 cleanup:
+    Podcast_cleanup();
     Scrobbler_quit();
     Settings_quit();
     ModuleCommon_quit();
@@ -0,0 +1,425 @@
+#define _GNU_SOURCE
+#include "net_dns.h"
+#include "radio_net.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <netdb.h>
+#include <netinet/in.h>
+
+#include "defines.h"
+#include "api.h"
+
+// getaddrinfo() doesn't expose record TTLs, so cached answers use a fixed
+// lifetime. Expired answers are still served (and refreshed in the
+// background) for a while, so a slow resolver never stalls a reconnect.
+#define NET_DNS_CACHE_SIZE 32
+#define NET_DNS_TTL_MS (5 * 60 * 1000)
+#define NET_DNS_NEGATIVE_TTL_MS (30 * 1000)
+#define NET_DNS_STALE_MS (60 * 60 * 1000)
+#define NET_DNS_ATTEMPT_DELAY_MS 250    // RFC 8305 Connection Attempt Delay
+
+typedef struct {
+    char host[256];
+    struct sockaddr_storage addrs[NET_DNS_MAX_ADDRS];
+    socklen_t addr_lens[NET_DNS_MAX_ADDRS];
+    int addr_count;             // 0 with expires_ms set = negative entry
+    uint64_t expires_ms;
+    uint64_t last_used_ms;
+    bool resolving;
+} DnsEntry;
+
+static DnsEntry dns_cache[NET_DNS_CACHE_SIZE];
+static pthread_mutex_t dns_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t dns_cond = PTHREAD_COND_INITIALIZER;
+
+static uint64_t dns_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Caller holds dns_mutex
+static DnsEntry* find_entry(const char* host) {
+    for (int i = 0; i < NET_DNS_CACHE_SIZE; i++) {
+        if (dns_cache[i].host[0] && strcasecmp(dns_cache[i].host, host) == 0) {
+            return &dns_cache[i];
+        }
+    }
+    return NULL;
+}
+
+// Caller holds dns_mutex. Reuses the least recently used idle slot.
+static DnsEntry* alloc_entry(const char* host) {
+    DnsEntry* victim = NULL;
+    for (int i = 0; i < NET_DNS_CACHE_SIZE; i++) {
+        DnsEntry* e = &dns_cache[i];
+        if (e->resolving) continue;
+        if (!e->host[0]) {
+            victim = e;
+            break;
+        }
+        if (!victim || e->last_used_ms < victim->last_used_ms) victim = e;
+    }
+    if (!victim) return NULL;
+
+    memset(victim, 0, sizeof(DnsEntry));
+    snprintf(victim->host, sizeof(victim->host), "%s", host);
+    return victim;
+}
+
+static void* dns_resolve_thread_func(void* arg) {
+    char* host = (char*)arg;
+
+    struct addrinfo hints, *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_ADDRCONFIG;
+
+    int gai_ret = getaddrinfo(host, NULL, &hints, &res);
+
+    pthread_mutex_lock(&dns_mutex);
+    DnsEntry* e = find_entry(host);
+    if (e) {
+        uint64_t now = dns_now_ms();
+        if (gai_ret == 0 && res) {
+            e->addr_count = 0;
+            for (struct addrinfo* ai = res; ai && e->addr_count < NET_DNS_MAX_ADDRS; ai = ai->ai_next) {
+                if (ai->ai_addrlen > sizeof(struct sockaddr_storage)) continue;
+                memcpy(&e->addrs[e->addr_count], ai->ai_addr, ai->ai_addrlen);
+                e->addr_lens[e->addr_count] = ai->ai_addrlen;
+                e->addr_count++;
+            }
+            e->expires_ms = now + NET_DNS_TTL_MS;
+        } else if (e->addr_count > 0 && now < e->expires_ms + NET_DNS_STALE_MS) {
+            // Refresh failed - keep serving the stale answer until it ages out
+            LOG_error("[DNS] Refresh failed for %s (error: %d), keeping stale entry\n", host, gai_ret);
+            e->expires_ms = now + NET_DNS_NEGATIVE_TTL_MS;  // Back off before retrying
+        } else {
+            LOG_error("[DNS] Lookup failed for %s (error: %d)\n", host, gai_ret);
+            e->addr_count = 0;
+            e->expires_ms = now + NET_DNS_NEGATIVE_TTL_MS;
+        }
+        e->resolving = false;
+    }
+    pthread_cond_broadcast(&dns_cond);
+    pthread_mutex_unlock(&dns_mutex);
+
+    if (res) freeaddrinfo(res);
+    free(host);
+    return NULL;
+}
+
+// Caller holds dns_mutex. Returns 0 if a lookup is now running for e.
+static int start_lookup(DnsEntry* e) {
+    if (e->resolving) return 0;
+
+    char* host = strdup(e->host);
+    if (!host) return -1;
+
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 1024 * 1024);  // getaddrinfo uses a lot of stack
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    int ret = pthread_create(&thread, &attr, dns_resolve_thread_func, host);
+    pthread_attr_destroy(&attr);
+
+    if (ret != 0) {
+        LOG_error("[DNS] Failed to start lookup thread for %s\n", e->host);
+        free(host);
+        return -1;
+    }
+    e->resolving = true;
+    return 0;
+}
+
+// Caller holds dns_mutex
+static int copy_result(const DnsEntry* e, int port, NetDnsResult* result) {
+    result->count = 0;
+    for (int i = 0; i < e->addr_count; i++) {
+        struct sockaddr_storage* sa = &result->addrs[result->count];
+        memcpy(sa, &e->addrs[i], e->addr_lens[i]);
+        if (sa->ss_family == AF_INET) {
+            ((struct sockaddr_in*)sa)->sin_port = htons(port);
+        } else if (sa->ss_family == AF_INET6) {
+            ((struct sockaddr_in6*)sa)->sin6_port = htons(port);
+        } else {
+            continue;
+        }
+        result->addr_lens[result->count] = e->addr_lens[i];
+        result->count++;
+    }
+    return result->count > 0 ? result->count : -1;
+}
+
+int net_dns_resolve(const char* host, int port, NetDnsResult* result, int timeout_ms) {
+    if (!host || !host[0] || !result) return -1;
+    result->count = 0;
+
+    uint64_t now = dns_now_ms();
+    uint64_t deadline = now + (timeout_ms > 0 ? timeout_ms : NET_DNS_TIMEOUT_MS);
+    int ret = -1;
+
+    pthread_mutex_lock(&dns_mutex);
+
+    DnsEntry* e = find_entry(host);
+    if (!e) e = alloc_entry(host);
+    if (!e) {
+        pthread_mutex_unlock(&dns_mutex);
+        LOG_error("[DNS] Cache full, cannot resolve %s\n", host);
+        return -1;
+    }
+    e->last_used_ms = now;
+
+    if (e->expires_ms > 0 && !e->resolving) {
+        if (now < e->expires_ms) {
+            // Fresh positive or negative answer
+            ret = e->addr_count > 0 ? copy_result(e, port, result) : -1;
+            pthread_mutex_unlock(&dns_mutex);
+            return ret;
+        }
+        if (e->addr_count > 0 && now < e->expires_ms + NET_DNS_STALE_MS) {
+            // Stale - use it now, refresh for next time
+            ret = copy_result(e, port, result);
+            start_lookup(e);
+            pthread_mutex_unlock(&dns_mutex);
+            return ret;
+        }
+    } else if (e->resolving && e->addr_count > 0) {
+        // Refresh already in flight and we have an older answer
+        ret = copy_result(e, port, result);
+        pthread_mutex_unlock(&dns_mutex);
+        return ret;
+    }
+
+    if (start_lookup(e) != 0) {
+        pthread_mutex_unlock(&dns_mutex);
+        return -1;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    uint64_t wait_ms = deadline - now;
+    ts.tv_sec += wait_ms / 1000;
+    ts.tv_nsec += (wait_ms % 1000) * 1000000;
+    if (ts.tv_nsec >= 1000000000) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    while (true) {
+        // Entry can't be evicted while resolving, but look it up again in case
+        // it was invalidated or reused after the lookup finished
+        e = find_entry(host);
+        if (!e) break;
+        if (!e->resolving) {
+            if (e->addr_count > 0) ret = copy_result(e, port, result);
+            break;
+        }
+        if (pthread_cond_timedwait(&dns_cond, &dns_mutex, &ts) == ETIMEDOUT) {
+            LOG_error("[DNS] Lookup timed out for %s\n", host);
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&dns_mutex);
+    return ret;
+}
+
+void net_dns_prefetch(const char* host) {
+    if (!host || !host[0]) return;
+
+    pthread_mutex_lock(&dns_mutex);
+    uint64_t now = dns_now_ms();
+    DnsEntry* e = find_entry(host);
+    if (!e) e = alloc_entry(host);
+    if (e) {
+        e->last_used_ms = now;
+        if (!e->resolving && now >= e->expires_ms) start_lookup(e);
+    }
+    pthread_mutex_unlock(&dns_mutex);
+}
+
+void net_dns_prefetch_url(const char* url) {
+    char host[256], path[512];
+    int port;
+    bool is_https;
+    if (radio_net_parse_url(url, host, sizeof(host), &port, path, sizeof(path), &is_https) == 0) {
+        net_dns_prefetch(host);
+    }
+}
+
+void net_dns_invalidate(const char* host) {
+    pthread_mutex_lock(&dns_mutex);
+    DnsEntry* e = find_entry(host);
+    if (e && !e->resolving) {
+        memset(e, 0, sizeof(DnsEntry));
+    }
+    pthread_mutex_unlock(&dns_mutex);
+}
+
+// Reorder so address families alternate, starting with the resolver's first
+// choice (RFC 8305 section 4). A dead IPv6 route then costs one attempt delay
+// instead of stalling every IPv4 attempt behind it.
+static void interleave_families(NetDnsResult* r) {
+    if (r->count < 3) return;
+
+    NetDnsResult sorted;
+    int first_family = r->addrs[0].ss_family;
+    bool used[NET_DNS_MAX_ADDRS] = {false};
+    sorted.count = 0;
+
+    bool want_first = true;
+    while (sorted.count < r->count) {
+        int pick = -1;
+        for (int i = 0; i < r->count; i++) {
+            if (used[i]) continue;
+            bool is_first = r->addrs[i].ss_family == first_family;
+            if (is_first == want_first) {
+                pick = i;
+                break;
+            }
+        }
+        // One family ran out - take the rest in order
+        if (pick < 0) {
+            for (int i = 0; i < r->count && pick < 0; i++) {
+                if (!used[i]) pick = i;
+            }
+        }
+        used[pick] = true;
+        sorted.addrs[sorted.count] = r->addrs[pick];
+        sorted.addr_lens[sorted.count] = r->addr_lens[pick];
+        sorted.count++;
+        want_first = !want_first;
+    }
+
+    memcpy(r, &sorted, sizeof(NetDnsResult));
+}
+
+// Start a non-blocking connect. Returns fd (in progress or connected), or -1.
+static int start_attempt(const struct sockaddr_storage* addr, socklen_t addr_len, bool* connected) {
+    *connected = false;
+    int fd = socket(addr->ss_family, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    if (connect(fd, (const struct sockaddr*)addr, addr_len) == 0) {
+        *connected = true;
+    } else if (errno != EINPROGRESS) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int net_dns_connect(const char* host, int port, int timeout_ms) {
+    if (timeout_ms <= 0) timeout_ms = NET_DNS_TIMEOUT_MS;
+    uint64_t deadline = dns_now_ms() + timeout_ms;
+
+    NetDnsResult* res = (NetDnsResult*)malloc(sizeof(NetDnsResult));
+    if (!res) return -1;
+
+    if (net_dns_resolve(host, port, res, timeout_ms) <= 0) {
+        free(res);
+        return -1;
+    }
+    interleave_families(res);
+
+    // Staggered parallel attempts: a new address every NET_DNS_ATTEMPT_DELAY_MS
+    // (or straight away once the previous one fails); first to connect wins
+    int fds[NET_DNS_MAX_ADDRS];
+    int started = 0;
+    int in_flight = 0;
+    int fd = -1;
+    int last_error = ETIMEDOUT;
+    uint64_t next_start = 0;
+
+    while (fd < 0) {
+        uint64_t now = dns_now_ms();
+        if (now >= deadline) break;
+
+        if (started < res->count && (now >= next_start || in_flight == 0)) {
+            bool connected;
+            int s = start_attempt(&res->addrs[started], res->addr_lens[started], &connected);
+            fds[started++] = s;
+            if (s < 0) {
+                last_error = errno;
+                next_start = 0;
+                continue;
+            }
+            if (connected) {
+                fd = s;
+                fds[started - 1] = -1;
+                break;
+            }
+            in_flight++;
+            next_start = now + NET_DNS_ATTEMPT_DELAY_MS;
+            continue;
+        }
+        if (in_flight == 0) break;
+
+        uint64_t wake = deadline;
+        if (started < res->count && next_start < wake) wake = next_start;
+
+        struct pollfd pfds[NET_DNS_MAX_ADDRS];
+        int owners[NET_DNS_MAX_ADDRS];
+        int n = 0;
+        for (int i = 0; i < started; i++) {
+            if (fds[i] < 0) continue;
+            pfds[n].fd = fds[i];
+            pfds[n].events = POLLOUT;
+            pfds[n].revents = 0;
+            owners[n++] = i;
+        }
+
+        if (poll(pfds, n, (int)(wake - now)) <= 0) continue;
+
+        for (int j = 0; j < n && fd < 0; j++) {
+            if (!pfds[j].revents) continue;
+            int i = owners[j];
+            int err = 0;
+            socklen_t len = sizeof(err);
+            getsockopt(fds[i], SOL_SOCKET, SO_ERROR, &err, &len);
+            if (err == 0) {
+                fd = fds[i];
+            } else {
+                last_error = err;
+                close(fds[i]);
+                next_start = 0;  // Don't wait out the delay after a failure
+            }
+            fds[i] = -1;
+            in_flight--;
+        }
+    }
+
+    // Abandon the losers
+    for (int i = 0; i < started; i++) {
+        if (fds[i] >= 0) close(fds[i]);
+    }
+
+    if (fd >= 0) {
+        // Callers expect a blocking socket
+        int flags = fcntl(fd, F_GETFL, 0);
+        if (flags >= 0) fcntl(fd, F_SETFL, flags & ~O_NONBLOCK);
+    } else {
+        LOG_error("[DNS] Connect failed for %s:%d: %s\n", host, port, strerror(last_error));
+        // Addresses may have moved - look the host up again next time
+        net_dns_invalidate(host);
+    }
+
+    free(res);
+    return fd;
+}
@@ -0,0 +1,37 @@
+#ifndef __NET_DNS_H__
+#define __NET_DNS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/socket.h>
+
+#define NET_DNS_MAX_ADDRS 8             // Addresses kept per host
+#define NET_DNS_TIMEOUT_MS 5000         // Default lookup timeout
+
+// Resolved address list for one host (port already filled in)
+typedef struct {
+    struct sockaddr_storage addrs[NET_DNS_MAX_ADDRS];
+    socklen_t addr_lens[NET_DNS_MAX_ADDRS];
+    int count;
+} NetDnsResult;
+
+// Resolve host through the shared cache.
+// Lookups run on a background thread; the caller waits at most timeout_ms.
+// Returns number of addresses on success, -1 on failure or timeout
+int net_dns_resolve(const char* host, int port, NetDnsResult* result, int timeout_ms);
+
+// Start a background lookup if host isn't cached (never blocks)
+void net_dns_prefetch(const char* host);
+
+// Same as net_dns_prefetch, taking a full URL
+void net_dns_prefetch_url(const char* url);
+
+// Drop a cached host (e.g. after every address failed to connect)
+void net_dns_invalidate(const char* host);
+
+// Resolve host and open a blocking TCP socket. Addresses are tried in
+// parallel with staggered starts ("happy eyeballs"); the first to connect wins.
+// Returns socket fd on success, -1 on failure
+int net_dns_connect(const char* host, int port, int timeout_ms);
+
+#endif
@@ -2,6 +2,8 @@
 #include "radio.h"
 #include "album_art.h"
 #include "settings.h"
+#include "http_stream.h"
+#include "time_stretch.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -226,6 +228,9 @@ static void flac_metadata_callback(void* pUserData, drflac_metadata* pMetadata);
 // Decode chunk size (~0.5 seconds at 48kHz)
 #define DECODE_CHUNK_FRAMES 24000
 
+// Output kept playing when the speech settings change
+#define SPEECH_CHANGE_LEAD_MS 150
+
 // Circular buffer functions
 static int circular_buffer_init(CircularBuffer* cb, size_t capacity_frames) {
     cb->buffer = malloc(capacity_frames * sizeof(int16_t) * AUDIO_CHANNELS);
@@ -238,6 +243,8 @@ static int circular_buffer_init(CircularBuffer* cb, size_t capacity_frames) {
     cb->write_pos = 0;
     cb->read_pos = 0;
     cb->available = 0;
+    cb->span_head = 0;
+    cb->span_count = 0;
     pthread_mutex_init(&cb->mutex, NULL);
     return 0;
 }
@@ -259,6 +266,8 @@ static void circular_buffer_clear(CircularBuffer* cb) {
     cb->write_pos = 0;
     cb->read_pos = 0;
     cb->available = 0;
+    cb->span_head = 0;
+    cb->span_count = 0;
     pthread_mutex_unlock(&cb->mutex);
 }
 
@@ -269,13 +278,80 @@ static size_t circular_buffer_available(CircularBuffer* cb) {
     return avail;
 }
 
-// Write frames to circular buffer (called by decode thread)
-static size_t circular_buffer_write(CircularBuffer* cb, int16_t* data, size_t frames) {
+// Record that the next `frames` written stand for `content_frames` of the track
+static void circular_buffer_add_span(CircularBuffer* cb, size_t frames, size_t content_frames) {
+    if (cb->span_count == STREAM_SPANS) {
+        // Out of slots: fold into the newest span
+        StreamSpan* last = &cb->spans[(cb->span_head + cb->span_count - 1) % STREAM_SPANS];
+        last->frames += (uint32_t)frames;
+        last->content_frames += (uint32_t)content_frames;
+        return;
+    }
+    StreamSpan* span = &cb->spans[(cb->span_head + cb->span_count) % STREAM_SPANS];
+    span->frames = (uint32_t)frames;
+    span->content_frames = (uint32_t)content_frames;
+    cb->span_count++;
+}
+
+// Drop all but the oldest keep frames (output made with old settings).
+// Returns the track time of the frames kept
+static size_t circular_buffer_trim(CircularBuffer* cb, size_t keep) {
+    pthread_mutex_lock(&cb->mutex);
+    if (keep > cb->available) keep = cb->available;
+    size_t drop = cb->available - keep;
+    cb->write_pos = (cb->write_pos + cb->capacity - drop) % cb->capacity;
+    cb->available = keep;
+
+    size_t frames = 0, content = 0;
+    int i = 0;
+    for (; i < cb->span_count && frames < keep; i++) {
+        StreamSpan* span = &cb->spans[(cb->span_head + i) % STREAM_SPANS];
+        if (frames + span->frames > keep) {
+            uint32_t part = (uint32_t)(keep - frames);
+            span->content_frames = (uint32_t)((uint64_t)span->content_frames * part / span->frames);
+            span->frames = part;
+        }
+        frames += span->frames;
+        content += span->content_frames;
+    }
+    cb->span_count = i;
+    pthread_mutex_unlock(&cb->mutex);
+    // Frames not covered by a span count one to one
+    return content + (keep - frames);
+}
+
+// Track frames covered by the next `frames` read, consuming their spans.
+// Frames not covered by a span count one to one
+static size_t circular_buffer_take_spans(CircularBuffer* cb, size_t frames) {
+    size_t content = 0;
+    while (cb->span_count > 0) {
+        StreamSpan* span = &cb->spans[cb->span_head];
+        if (span->frames > frames) {
+            uint32_t part = (uint32_t)((uint64_t)span->content_frames * frames / span->frames);
+            span->content_frames -= part;
+            span->frames -= (uint32_t)frames;
+            return content + part;
+        }
+        content += span->content_frames;
+        frames -= span->frames;
+        cb->span_head = (cb->span_head + 1) % STREAM_SPANS;
+        cb->span_count--;
+    }
+    return content + frames;
+}
+
+// Write frames to circular buffer (called by decode thread). content_frames
+// is how much of the track they play (frames, unless time-stretched)
+static size_t circular_buffer_write(CircularBuffer* cb, int16_t* data, size_t frames,
+                                    size_t content_frames) {
     pthread_mutex_lock(&cb->mutex);
 
     size_t space = cb->capacity - cb->available;
     size_t to_write = (frames < space) ? frames : space;
 
+    // Track time still advances for audio that was dropped or skipped
+    circular_buffer_add_span(cb, to_write, content_frames);
+
     if (to_write == 0) {
         pthread_mutex_unlock(&cb->mutex);
         return 0;
@@ -301,11 +377,14 @@ static size_t circular_buffer_write(CircularBuffer* cb, int16_t* data, size_t fr
     return to_write;
 }
 
-// Read frames from circular buffer (called by audio callback)
-static size_t circular_buffer_read(CircularBuffer* cb, int16_t* data, size_t frames) {
+// Read frames from circular buffer (called by audio callback); content_out
+// gets how far they move the track position
+static size_t circular_buffer_read(CircularBuffer* cb, int16_t* data, size_t frames,
+                                   size_t* content_out) {
     pthread_mutex_lock(&cb->mutex);
 
     size_t to_read = (frames < cb->available) ? frames : cb->available;
+    *content_out = circular_buffer_take_spans(cb, to_read);
 
     if (to_read == 0) {
         pthread_mutex_unlock(&cb->mutex);
@@ -618,6 +697,102 @@ static int stream_decoder_open(StreamDecoder* sd, const char* filepath) {
     return 0;
 }
 
+// dr_mp3 input callbacks for an HTTP source. Offsets the decoder sees are
+// relative to http_base, so it can be restarted mid-file after a seek
+static size_t http_mp3_read(void* user, void* buf, size_t bytes) {
+    StreamDecoder* sd = (StreamDecoder*)user;
+    return http_stream_read((HttpStream*)sd->http, buf, bytes);
+}
+
+static drmp3_bool32 http_mp3_seek(void* user, int offset, drmp3_seek_origin origin) {
+    StreamDecoder* sd = (StreamDecoder*)user;
+    HttpStream* http = (HttpStream*)sd->http;
+    int64_t pos;
+    if (origin == DRMP3_SEEK_SET) {
+        pos = sd->http_base + offset;
+    } else if (origin == DRMP3_SEEK_CUR) {
+        pos = http_stream_tell(http) + offset;
+    } else {
+        return DRMP3_FALSE;  // No tell callback is given, so dr_mp3 doesn't ask for this
+    }
+    return http_stream_seek(http, pos) == 0;
+}
+
+// Open an MP3 decoder on an HTTP source. Without a tell callback dr_mp3
+// doesn't look for tags at the end of the file, which would cost a round
+// trip to its last bytes before playback could start
+static int stream_decoder_open_http(StreamDecoder* sd, HttpStream* http) {
+    memset(sd, 0, sizeof(StreamDecoder));
+    sd->format = AUDIO_FORMAT_MP3;
+    sd->http = http;
+
+    drmp3* mp3 = malloc(sizeof(drmp3));
+    if (!mp3 || !drmp3_init(mp3, http_mp3_read, http_mp3_seek, NULL, NULL, sd, NULL)) {
+        free(mp3);
+        sd->http = NULL;
+        LOG_error("Stream: Failed to open MP3 stream\n");
+        return -1;
+    }
+    sd->decoder = mp3;
+    sd->source_sample_rate = mp3->sampleRate;
+    sd->source_channels = mp3->channels;
+    sd->http_data_start = (int64_t)mp3->streamStartOffset;
+
+    // Counting frames would read the whole file: use the Xing/Info header's
+    // count, else estimate from the size and the first frame's bitrate
+    int64_t size = http_stream_size(http);
+    unsigned kbps = drmp3_hdr_bitrate_kbps(mp3->decoder.header);
+    if (mp3->totalPCMFrameCount != DRMP3_UINT64_MAX) {
+        sd->total_frames = (int64_t)mp3->totalPCMFrameCount;
+    } else if (size > sd->http_data_start && kbps > 0) {
+        sd->total_frames = (size - sd->http_data_start) * 8 * sd->source_sample_rate / ((int64_t)kbps * 1000);
+    } else {
+        sd->total_frames = (int64_t)sd->source_sample_rate * 60 * 60 * 24;  // Unknown: let EOF end it
+    }
+    return 0;
+}
+
+// Seek an HTTP MP3 by jumping to the byte where the frame should be
+// (bitrate assumed near constant) and restarting the decoder there; it
+// resyncs on the next frame header. Only the bytes from there on are fetched
+static bool http_mp3_seek_frame(StreamDecoder* sd, int64_t frame) {
+    HttpStream* http = (HttpStream*)sd->http;
+    drmp3* mp3 = (drmp3*)sd->decoder;
+    int64_t size = http_stream_size(http);
+
+    // An earlier restart may have been cut short by the next seek
+    if (mp3) {
+        drmp3_uninit(mp3);
+    } else if (!(mp3 = malloc(sizeof(drmp3)))) {
+        return false;
+    }
+    sd->decoder = NULL;
+
+    int64_t offset = 0;
+    if (frame > 0 && sd->total_frames > 0 && size > sd->http_data_start) {
+        offset = sd->http_data_start + (size - sd->http_data_start) * frame / sd->total_frames;
+    }
+
+    sd->http_base = offset;
+    if (http_stream_seek(http, offset) != 0 ||
+        !drmp3_init(mp3, http_mp3_read, http_mp3_seek, NULL, NULL, sd, NULL)) {
+        // Without a decoder reads return nothing, which ends the track
+        // unless another seek is already pending
+        free(mp3);
+        return false;
+    }
+    sd->decoder = mp3;
+    return true;
+}
+
+// Close the HTTP source, if any (after the decoder reading it)
+static void stream_decoder_close_http(StreamDecoder* sd) {
+    if (sd->http) {
+        http_stream_close((HttpStream*)sd->http);
+        sd->http = NULL;
+    }
+}
+
 // Read chunk of audio from decoder (returns frames read, outputs stereo)
 static size_t stream_decoder_read(StreamDecoder* sd, int16_t* buffer, size_t frames) {
     if (!sd->decoder) return 0;
@@ -951,7 +1126,7 @@ static size_t stream_decoder_read(StreamDecoder* sd, int16_t* buffer, size_t fra
 
 // Seek to frame position
 static int stream_decoder_seek(StreamDecoder* sd, int64_t frame) {
-    if (!sd->decoder) return -1;
+    if (!sd->decoder && !sd->http) return -1;
 
     if (frame < 0) frame = 0;
     if (frame > sd->total_frames) frame = sd->total_frames;
@@ -959,7 +1134,11 @@ static int stream_decoder_seek(StreamDecoder* sd, int64_t frame) {
     bool success = false;
     switch (sd->format) {
         case AUDIO_FORMAT_MP3:
-            success = drmp3_seek_to_pcm_frame((drmp3*)sd->decoder, frame);
+            if (sd->http) {
+                success = http_mp3_seek_frame(sd, frame);
+            } else {
+                success = drmp3_seek_to_pcm_frame((drmp3*)sd->decoder, frame);
+            }
             break;
         case AUDIO_FORMAT_WAV:
             success = drwav_seek_to_pcm_frame((drwav*)sd->decoder, frame);
@@ -1022,7 +1201,10 @@ static int stream_decoder_seek(StreamDecoder* sd, int64_t frame) {
 
 // Close decoder
 static void stream_decoder_close(StreamDecoder* sd) {
-    if (!sd->decoder) return;
+    if (!sd->decoder) {
+        stream_decoder_close_http(sd);
+        return;
+    }
 
     switch (sd->format) {
         case AUDIO_FORMAT_MP3:
@@ -1081,6 +1263,7 @@ static void stream_decoder_close(StreamDecoder* sd) {
             break;
     }
 
+    stream_decoder_close_http(sd);
     sd->decoder = NULL;
     sd->format = AUDIO_FORMAT_UNKNOWN;
 }
@@ -1210,18 +1393,55 @@ static void* stream_thread_func(void* arg) {
         return NULL;
     }
 
+    // Speech playback stage (created on first use, at the output rate)
+    TimeStretch* stretch = NULL;
+    int stretch_rate = 0;
+    int16_t* stretch_buffer = NULL;
+
     while (player.stream_running) {
+        // Speech settings changed: a short lead of what's buffered plays on,
+        // the rest is decoded again from the track time where the lead ends
+        // (a seek back within a stream is served from its cache)
+        if (player.speech_reseek) {
+            pthread_mutex_lock(&player.mutex);
+            bool reseek = player.speech_reseek && !player.stream_seeking;
+            player.speech_reseek = false;
+            int64_t target_frame = 0;
+            if (reseek) {
+                size_t kept = circular_buffer_trim(&player.stream_buffer,
+                                                   (size_t)current_sample_rate * SPEECH_CHANGE_LEAD_MS / 1000);
+                target_frame = (audio_position_samples + (int64_t)kept) *
+                               player.stream_decoder.source_sample_rate / current_sample_rate;
+            }
+            pthread_mutex_unlock(&player.mutex);
+
+            if (reseek) {
+                stream_decoder_seek(&player.stream_decoder, target_frame);
+                if (player.resampler) {
+                    src_reset((SRC_STATE*)player.resampler);
+                }
+                player.resample_leftover_count = 0;
+                time_stretch_reset(stretch);
+                player.stream_eof = false;
+            }
+        }
+
         // Check if seeking requested
         if (player.stream_seeking) {
-            stream_decoder_seek(&player.stream_decoder, player.seek_target_frame);
+            int64_t target_frame = player.seek_target_frame;
+            stream_decoder_seek(&player.stream_decoder, target_frame);
             circular_buffer_clear(&player.stream_buffer);
             if (player.resampler) {
                 src_reset((SRC_STATE*)player.resampler);
             }
             // Clear resampler leftover buffer to avoid playing stale samples
             player.resample_leftover_count = 0;
+            time_stretch_reset(stretch);
             player.stream_eof = false;  // Reset EOF flag on seek
-            player.stream_seeking = false;
+            // A seek requested meanwhile is handled on the next pass
+            if (player.seek_target_frame == target_frame) {
+                player.stream_seeking = false;
+            }
         }
 
         // Check if buffer needs more data (< 50% full)
@@ -1231,8 +1451,9 @@ static void* stream_thread_func(void* arg) {
             size_t decoded = stream_decoder_read(&player.stream_decoder,
                                                   decode_buffer, DECODE_CHUNK_FRAMES);
             if (decoded == 0) {
-                // Decoder has reached end of file
-                player.stream_eof = true;
+                // Decoder has reached end of file (unless a network read
+                // was cut short for a seek, handled on the next pass)
+                if (!player.stream_seeking && !player.speech_reseek) player.stream_eof = true;
             } else {
                 // Resample chunk to target rate if needed
                 int src_rate = player.stream_decoder.source_sample_rate;
@@ -1240,17 +1461,50 @@ static void* stream_thread_func(void* arg) {
                 bool is_last = (player.stream_decoder.current_frame >= player.stream_decoder.total_frames);
 
                 size_t output_frames;
+                int16_t* output;
                 if (src_rate == dst_rate) {
                     // No resampling needed
                     output_frames = decoded;
-                    circular_buffer_write(&player.stream_buffer, decode_buffer, output_frames);
+                    output = decode_buffer;
                 } else {
                     // Resample
                     output_frames = resample_chunk(decode_buffer, decoded,
                                                    src_rate, dst_rate,
                                                    resample_buffer, resample_buffer_size,
                                                    (SRC_STATE*)player.resampler, is_last);
-                    circular_buffer_write(&player.stream_buffer, resample_buffer, output_frames);
+                    output = resample_buffer;
+                }
+
+                // Time-stretch / skip silence, after resampling so the stretcher
+                // always works at the device rate
+                float speed = player.playback_speed;
+                bool skip_silence = player.skip_silence;
+                if ((speed != 1.0f || skip_silence) && (!stretch || stretch_rate != dst_rate)) {
+                    time_stretch_destroy(stretch);
+                    stretch = time_stretch_create(dst_rate);
+                    stretch_rate = dst_rate;
+                    if (!stretch_buffer) {
+                        stretch_buffer = malloc(DECODE_CHUNK_FRAMES * sizeof(int16_t) * AUDIO_CHANNELS);
+                    }
+                }
+
+                if ((speed != 1.0f || skip_silence) && stretch && stretch_buffer) {
+                    time_stretch_set_speed(stretch, speed);
+                    time_stretch_set_skip_silence(stretch, skip_silence);
+                    // The chunk's track time goes with its first output
+                    size_t content_frames = output_frames;
+                    size_t stretched = time_stretch_process(stretch, output, output_frames,
+                                                            stretch_buffer, DECODE_CHUNK_FRAMES);
+                    while (stretched > 0 || content_frames > 0) {
+                        circular_buffer_write(&player.stream_buffer, stretch_buffer, stretched,
+                                              content_frames);
+                        content_frames = 0;
+                        if (stretched == 0) break;
+                        stretched = time_stretch_process(stretch, NULL, 0,
+                                                         stretch_buffer, DECODE_CHUNK_FRAMES);
+                    }
+                } else {
+                    circular_buffer_write(&player.stream_buffer, output, output_frames, output_frames);
                 }
             }
         } else {
@@ -1259,6 +1513,8 @@ static void* stream_thread_func(void* arg) {
         }
     }
 
+    time_stretch_destroy(stretch);
+    free(stretch_buffer);
     free(decode_buffer);
     free(resample_buffer);
     return NULL;
@@ -1276,7 +1532,7 @@ static void audio_callback(void* userdata, Uint8* stream, int len) {
     if (Radio_isActive()) {
         RadioState state = Radio_getState();
         // Get audio from radio module for both PLAYING and BUFFERING states
-        // This ensures we drain remaining buffer during rebuffer instead of abrupt silence
+        // The radio jitter buffer decides whether to emit audio or hold while it refills
         if (state == RADIO_STATE_PLAYING || state == RADIO_STATE_BUFFERING) {
             // Get audio from radio module
             int samples_got = Radio_getAudioSamples(out, samples_needed * AUDIO_CHANNELS);
@@ -1332,7 +1588,9 @@ static void audio_callback(void* userdata, Uint8* stream, int len) {
     // ============ STREAMING MODE ============
     if (ctx->use_streaming) {
         // Read from circular buffer
-        size_t samples_read = circular_buffer_read(&ctx->stream_buffer, out, samples_needed);
+        size_t content_read;
+        size_t samples_read = circular_buffer_read(&ctx->stream_buffer, out, samples_needed,
+                                                   &content_read);
 
         // If not enough data, fill rest with silence
         if (samples_read < (size_t)samples_needed) {
@@ -1373,8 +1631,8 @@ static void audio_callback(void* userdata, Uint8* stream, int len) {
             pthread_mutex_unlock(&ctx->vis_mutex);
         }
 
-        // Update position
-        audio_position_samples += samples_read;
+        // Update position (in track time, which runs faster when time-stretched)
+        audio_position_samples += content_read;
         ctx->position_ms = (audio_position_samples * 1000) / current_sample_rate;
 
         // Check if track ended (decoder reached EOF or frame count)
@@ -1409,6 +1667,7 @@ int Player_init(void) {
     pthread_mutex_init(&player.vis_mutex, NULL);
 
     player.volume = 1.0f;
+    player.playback_speed = 1.0f;
     player.state = PLAYER_STATE_STOPPED;
 
     // Initialize SDL audio
@@ -2117,10 +2376,14 @@ void Player_setSampleRate(int sample_rate) {
     }
 }
 
-// Load file using streaming playback (decode on-the-fly)
-static int load_streaming(const char* filepath) {
+// Load file using streaming playback (decode on-the-fly).
+// With an HTTP source, filepath is unused and the source is taken over
+static int load_streaming(const char* filepath, HttpStream* http) {
     // Open decoder
-    if (stream_decoder_open(&player.stream_decoder, filepath) != 0) {
+    int opened = http ? stream_decoder_open_http(&player.stream_decoder, http)
+                      : stream_decoder_open(&player.stream_decoder, filepath);
+    if (opened != 0) {
+        if (http) http_stream_close(http);
         return -1;
     }
 
@@ -2157,6 +2420,7 @@ static int load_streaming(const char* filepath) {
     // Start decode thread
     player.stream_running = true;
     player.stream_seeking = false;
+    player.speech_reseek = false;
     player.stream_eof = false;
     pthread_create(&player.stream_thread, NULL, stream_thread_func, NULL);
 
@@ -2208,7 +2472,7 @@ int Player_load(const char* filepath) {
         format == AUDIO_FORMAT_FLAC || format == AUDIO_FORMAT_OGG ||
         format == AUDIO_FORMAT_M4A || format == AUDIO_FORMAT_AAC ||
         format == AUDIO_FORMAT_OPUS) {
-        result = load_streaming(filepath);
+        result = load_streaming(filepath, NULL);
 
         // Parse metadata for MP3
         if (result == 0 && format == AUDIO_FORMAT_MP3) {
@@ -2255,6 +2519,63 @@ int Player_load(const char* filepath) {
     return result;
 }
 
+int Player_loadStream(const char* url, const char* cache_path, const char* complete_path) {
+    if (!url || !cache_path || !complete_path || !player.audio_initialized) return -1;
+
+    // Stop any current playback
+    Player_stop();
+
+    // Waits for the server's response (a few hundred ms); audio starts as
+    // soon as the pre-buffer below is decoded
+    HttpStream* http = http_stream_open(url, cache_path, complete_path);
+    if (!http) {
+        LOG_error("Stream: Failed to open %s\n", url);
+        return -1;
+    }
+
+    pthread_mutex_lock(&player.mutex);
+
+    // Named after the file it becomes
+    strncpy(player.current_file, complete_path, sizeof(player.current_file) - 1);
+
+    const char* filename = strrchr(complete_path, '/');
+    if (filename) filename++; else filename = complete_path;
+    strncpy(player.track_info.title, filename, sizeof(player.track_info.title) - 1);
+
+    char* ext = strrchr(player.track_info.title, '.');
+    if (ext) *ext = '\0';
+
+    player.track_info.artist[0] = '\0';
+    player.track_info.album[0] = '\0';
+
+    pthread_mutex_unlock(&player.mutex);
+
+    // Tags aren't parsed: they would have to be fetched before the audio
+    int result = load_streaming(NULL, http);
+
+    if (result == 0 && player.album_art == NULL && player.track_info.title[0]) {
+        album_art_fetch("", player.track_info.title);
+    }
+
+    if (result == 0) {
+        pthread_mutex_lock(&player.mutex);
+        player.position_ms = 0;
+        audio_position_samples = 0;
+        player.state = PLAYER_STATE_STOPPED;
+        pthread_mutex_unlock(&player.mutex);
+    }
+
+    return result;
+}
+
+bool Player_isNetworkStream(void) {
+    pthread_mutex_lock(&player.mutex);
+    bool streaming = player.use_streaming && player.stream_decoder.http &&
+                     !http_stream_is_complete((HttpStream*)player.stream_decoder.http);
+    pthread_mutex_unlock(&player.mutex);
+    return streaming;
+}
+
 int Player_play(void) {
     // Check if we have audio loaded
     if (!player.use_streaming || !player.stream_decoder.decoder) return -1;
@@ -2280,6 +2601,8 @@ void Player_stop(void) {
     // Stop streaming thread first (before locking mutex to avoid deadlock)
     if (player.use_streaming && player.stream_running) {
         player.stream_running = false;
+        // A decode waiting for network data would hold up the join
+        http_stream_abort((HttpStream*)player.stream_decoder.http);
         pthread_join(player.stream_thread, NULL);
     }
 
@@ -2290,6 +2613,8 @@ void Player_stop(void) {
     player.state = PLAYER_STATE_STOPPED;
     player.position_ms = 0;
     audio_position_samples = 0;
+    player.playback_speed = 1.0f;
+    player.skip_silence = false;
 
     // Clean up streaming resources
     if (player.use_streaming) {
@@ -2352,6 +2677,9 @@ void Player_seek(int position_ms) {
         int64_t target_frame = (int64_t)position_ms * player.stream_decoder.source_sample_rate / 1000;
         player.seek_target_frame = target_frame;
         player.stream_seeking = true;
+        player.speech_reseek = false;
+        // Don't let the decode thread wait for data at the old position
+        http_stream_interrupt((HttpStream*)player.stream_decoder.http);
     }
 
     player.position_ms = position_ms;
@@ -2359,6 +2687,25 @@ void Player_seek(int position_ms) {
     pthread_mutex_unlock(&player.mutex);
 }
 
+void Player_setSpeechPlayback(float speed, bool skip_silence) {
+    if (speed < TIME_STRETCH_MIN_SPEED) speed = TIME_STRETCH_MIN_SPEED;
+    if (speed > TIME_STRETCH_MAX_SPEED) speed = TIME_STRETCH_MAX_SPEED;
+
+    pthread_mutex_lock(&player.mutex);
+    bool changed = speed != player.playback_speed || skip_silence != player.skip_silence;
+    player.playback_speed = speed;
+    player.skip_silence = skip_silence;
+
+    // The seconds already buffered don't keep the old settings: the decode
+    // thread decodes them again, past a short lead
+    if (changed && player.use_streaming) {
+        player.speech_reseek = true;
+        // Don't let the decode thread wait for data further ahead
+        http_stream_interrupt((HttpStream*)player.stream_decoder.http);
+    }
+    pthread_mutex_unlock(&player.mutex);
+}
+
 bool Player_resume(void) {
     return player.stream_seeking;
 }
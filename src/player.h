@@ -53,8 +53,19 @@ typedef struct {
     int source_channels;
     int64_t total_frames;
     int64_t current_frame;
+    void* http;                 // HttpStream* when playing from a URL (MP3), else NULL
+    int64_t http_base;          // Byte the decoder's input starts at (moves on seeks)
+    int64_t http_data_start;    // First audio byte after the ID3v2 tag
 } StreamDecoder;
 
+// Track time covered by a run of buffered frames (they differ once audio is
+// time-stretched or silences are skipped), both at the output rate
+#define STREAM_SPANS 64
+typedef struct {
+    uint32_t frames;
+    uint32_t content_frames;
+} StreamSpan;
+
 // Circular buffer for streaming playback
 #define STREAM_BUFFER_FRAMES (44100 * 3)  // ~3 seconds at 44.1kHz stereo (~500KB)
 typedef struct {
@@ -63,6 +74,9 @@ typedef struct {
     size_t write_pos;           // Write position (frames)
     size_t read_pos;            // Read position (frames)
     size_t available;           // Frames available to read
+    StreamSpan spans[STREAM_SPANS];  // Oldest first from span_head
+    int span_head;
+    int span_count;
     pthread_mutex_t mutex;
 } CircularBuffer;
 
@@ -83,6 +97,8 @@ typedef struct {
     int position_ms;        // Current position in milliseconds
     float volume;           // 0.0 to 1.0
     bool repeat;            // Loop current track
+    float playback_speed;   // 1.0 = normal, pitch is kept (time-stretched)
+    bool skip_silence;      // Shorten long pauses
 
     // Audio buffer for visualization
     int16_t vis_buffer[2048];  // Stereo samples for FFT
@@ -101,6 +117,7 @@ typedef struct {
     bool stream_running;
     bool stream_seeking;        // Flag when seek is requested
     int64_t seek_target_frame;  // Target frame for seeking
+    bool speech_reseek;         // Speech settings changed, decode the buffered part again
     bool use_streaming;         // True if using streaming mode
     bool stream_eof;            // True when decoder has reached end of file
 
@@ -122,6 +139,14 @@ void Player_quit(void);
 // Load a file (does not start playing)
 int Player_load(const char* filepath);
 
+// Load an MP3 from a URL (does not start playing). It downloads into
+// cache_path while playing and is moved to complete_path once all of it
+// has arrived
+int Player_loadStream(const char* url, const char* cache_path, const char* complete_path);
+
+// True while the loaded track still comes over the network
+bool Player_isNetworkStream(void);
+
 // Start/resume playback
 int Player_play(void);
 
@@ -137,6 +162,11 @@ void Player_togglePause(void);
 // Seek to position (in milliseconds)
 void Player_seek(int position_ms);
 
+// Speech playback for the loaded track: speed (pitch kept, clamped to
+// TIME_STRETCH_MIN/MAX_SPEED) and skipping long silences. Position and
+// duration stay in track time. Loading another track goes back to normal
+void Player_setSpeechPlayback(float speed, bool skip_silence);
+
 // Check if a seek operation is still in progress (for resume flow)
 bool Player_resume(void);
 
@@ -1,12 +1,14 @@
 #define _GNU_SOURCE
 #include "podcast.h"
-#include "wget_fetch.h"
+#include "http_client.h"
+#include "http_download.h"
 #include "radio.h"
 #include "player.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <pthread.h>
 #include <errno.h>
 #include <sys/stat.h>
@@ -19,6 +21,8 @@
 #include "api.h"
 #include "wifi.h"
 #include "ui_podcast.h"
+#include "settings.h"
+#include "ui_thumbnail.h"
 
 // SDCARD_PATH is defined in platform.h via api.h
 
@@ -113,6 +117,7 @@ static char downloads_file[512] = "";
 static char charts_cache_file[512] = "";
 static char continue_listening_file[512] = "";
 static char download_dir[512] = "";
+static char autodownload_file[512] = "";
 
 // Module state
 static bool podcast_initialized = false;
@@ -138,9 +143,11 @@ static pthread_t charts_thread;
 static volatile bool charts_running = false;
 static volatile bool charts_should_stop = false;
 static PodcastChartItem top_shows[PODCAST_CHART_FETCH_LIMIT];  // Sized for fetch limit, filtered down to MAX_CHART_ITEMS
+static PodcastChartItem fetched_shows[PODCAST_CHART_FETCH_LIMIT];  // Charts thread's copy until filtered
 static int top_shows_count = 0;
 static PodcastChartsStatus charts_status = {0};
 static char charts_country_code[8] = "us";
+static HttpValidators charts_validators;  // Of the cached chart list (same country)
 
 // Downloads
 static PodcastDownloadItem download_queue[PODCAST_MAX_DOWNLOAD_QUEUE];
@@ -150,22 +157,43 @@ static pthread_t download_thread;
 static volatile bool download_running = false;
 static volatile bool download_should_stop = false;
 static PodcastDownloadProgress download_progress = {0};
+static pthread_mutex_t download_network_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Episode downloads run concurrently, one per worker. A worker finds its
+// item by guid, since cancelling shifts the queue under it
+typedef struct {
+    pthread_t thread;
+    char guid[PODCAST_MAX_GUID];        // Episode being downloaded, "" when idle
+    HttpDownloadProgress progress;      // Copied into the queue item
+    volatile bool stop;                 // Stops this worker's download only
+    long long budgeted;                 // Run budget held by an auto item, 0 otherwise
+} DownloadWorker;
+static DownloadWorker download_workers[PODCAST_DOWNLOAD_WORKERS];
+static int download_workers_active = 0;
 
 // Current playback state
 static int current_episode_duration_sec = 0;
 static PodcastFeed* current_feed = NULL;
 static int current_feed_index = -1;
 static int current_episode_index = -1;
-
-// Progress tracking - simple in-memory cache (will be persisted to JSON)
-#define MAX_PROGRESS_ENTRIES 500
+// Download path of the episode loaded in the player, "" when none. The
+// auto-download worker checks it before deleting a file
+static char playing_path[PODCAST_MAX_URL] = "";
+static pthread_mutex_t playing_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Progress tracking - open-addressing table keyed by a hash of (feed_url, guid),
+// persisted as an append-only journal (progress.log)
+#define PROGRESS_TABLE_SIZE 1024      // Power of two
+#define MAX_PROGRESS_ENTRIES 768      // Keep the table at most 3/4 full
 typedef struct {
-    char feed_url[PODCAST_MAX_URL];
-    char episode_guid[PODCAST_MAX_GUID];
+    uint64_t key;                     // 0 = empty slot
     int position_sec;
+    bool dirty;                       // Changed since the last journal write
 } ProgressEntry;
-static ProgressEntry progress_entries[MAX_PROGRESS_ENTRIES];
+static ProgressEntry progress_table[PROGRESS_TABLE_SIZE];
+static pthread_mutex_t progress_mutex = PTHREAD_MUTEX_INITIALIZER;  // Table and journal (the auto-download worker reads too)
 static int progress_entry_count = 0;
+static int progress_journal_records = 0;  // Records in progress.log, superseded ones included
 
 // Episode cache - only load PODCAST_EPISODE_PAGE_SIZE episodes at a time
 static PodcastEpisode episode_cache[PODCAST_EPISODE_PAGE_SIZE];
@@ -182,8 +210,39 @@ static int continue_listening_count = 0;
 static pthread_t refresh_thread;
 static volatile bool refresh_running = false;
 static int refresh_feed_index = -1;  // -1 = all feeds, >=0 = specific feed
+static bool refresh_full = false;    // Full re-sync of refresh_feed_index
 static volatile bool refresh_completed = false;
+static volatile bool refresh_feed_done = false;  // A feed of a refresh-all finished
 #define REFRESH_COOLDOWN_SEC 900  // 15 minutes
+#define REFRESH_PER_HOST 2        // Feeds fetched at once from the same host
+#define REFRESH_FEED_TIMEOUT_MS 30000  // Whole-feed deadline during refresh-all
+
+// Refresh-all work list, shared by the refresh workers
+typedef struct {
+    char feed_url[PODCAST_MAX_URL];
+    char host[128];
+    bool taken;
+    bool done;
+} RefreshJob;
+static RefreshJob refresh_jobs[PODCAST_MAX_SUBSCRIPTIONS];
+static int refresh_job_count = 0;
+static pthread_mutex_t refresh_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t refresh_cond = PTHREAD_COND_INITIALIZER;
+#define REFRESH_KNOWN_RUN 5       // Stored episodes in a row that end an incremental refresh
+#define STORE_READ_BATCH 16       // Episodes read at a time when scanning a whole store
+
+// Scheduled auto-download: refresh-all, then a worker queues episodes
+typedef enum {
+    AUTO_IDLE = 0,
+    AUTO_REFRESHING,                     // Waiting for refresh-all to finish
+    AUTO_QUEUING                         // Worker picking episodes, making room
+} AutoDownloadState;
+static AutoDownloadState auto_state = AUTO_IDLE;
+static volatile bool auto_worker_running = false;
+static uint64_t auto_next_check_ms = 0;
+static time_t auto_last_run = 0;         // Saved in autodownload.json
+static long long auto_budget_left = PODCAST_AUTO_RUN_BUDGET;  // Bytes auto items may still start (download_mutex)
+#define AUTO_CHECK_INTERVAL_MS 30000     // Conditions checked this often
 
 // Base data directory for podcast data
 static char podcast_data_dir[512] = "";
@@ -194,12 +253,16 @@ static void* charts_thread_func(void* arg);
 static void* download_thread_func(void* arg);
 static void* refresh_thread_func(void* arg);
 static int Podcast_startDownloads(void);
+static void stop_download_locked(const char* guid);
 static void save_charts_cache(void);
-static bool load_charts_cache(void);
+static bool load_charts_cache(bool any_age);
 static void save_continue_listening(void);
+static void load_progress(void);
 static void load_continue_listening(void);
 static void validate_continue_listening(void);
 static void sanitize_for_filename(char* str);
+static uint64_t podcast_now_ms(void);
+static void load_auto_download_state(void);
 
 
 // ============================================================================
@@ -248,10 +311,10 @@ static int get_feed_index(PodcastFeed* feed) {
     return -1;
 }
 
-// Get path to feed's episodes JSON file
+// Get path to feed's episode store
 static void get_episodes_file_path(const char* feed_id, char* path, int path_size) {
     if (!feed_id || !path || path_size <= 0) return;
-    snprintf(path, path_size, "%s/%s/episodes.json", podcast_data_dir, feed_id);
+    snprintf(path, path_size, "%s/%s/episodes.bin", podcast_data_dir, feed_id);
 }
 
 // Create directory recursively
@@ -275,10 +338,40 @@ static void mkdir_recursive(const char* path) {
 }
 
 // ============================================================================
-// Episode Storage (JSON on disk)
+// Episode Storage (binary store on disk, see podcast_store.c)
 // ============================================================================
 
-// Save episodes to JSON file for a feed
+// Start writing a feed's episode store. live: episodes are readable as they
+// are added; otherwise it replaces the old one on commit
+static PodcastStoreWriter* open_episode_store(const char* feed_id, bool live) {
+    // Create feed directory
+    char feed_dir[512];
+    Podcast_getFeedDataPath(feed_id, feed_dir, sizeof(feed_dir));
+    mkdir_recursive(feed_dir);
+
+    char episodes_path[512];
+    get_episodes_file_path(feed_id, episodes_path, sizeof(episodes_path));
+    return live ? podcast_store_writer_open_live(episodes_path) : podcast_store_writer_open(episodes_path);
+}
+
+// Convert the episodes.json written by earlier versions, once
+static void migrate_episodes_json(const char* feed_id) {
+    char episodes_path[512];
+    get_episodes_file_path(feed_id, episodes_path, sizeof(episodes_path));
+    if (access(episodes_path, F_OK) == 0) return;
+
+    char json_path[512];
+    snprintf(json_path, sizeof(json_path), "%s/%s/episodes.json", podcast_data_dir, feed_id);
+    if (access(json_path, F_OK) != 0) return;
+
+    if (podcast_store_migrate_json(json_path, episodes_path) == 0) {
+        unlink(json_path);
+    } else {
+        LOG_error("[Podcast] Failed to migrate %s\n", json_path);
+    }
+}
+
+// Save episodes to the feed's episode store
 int Podcast_saveEpisodes(int feed_index, PodcastEpisode* episodes, int count) {
     if (feed_index < 0 || feed_index >= subscription_count || !episodes || count < 0) {
         return -1;
@@ -288,52 +381,24 @@ int Podcast_saveEpisodes(int feed_index, PodcastEpisode* episodes, int count) {
 
     set_feed_id(feed);
 
-    // Create feed directory
-    char feed_dir[512];
-    Podcast_getFeedDataPath(feed->feed_id, feed_dir, sizeof(feed_dir));
-    mkdir_recursive(feed_dir);
-
-    // Build episodes JSON
-    JSON_Value* root = json_value_init_array();
-    JSON_Array* arr = json_value_get_array(root);
-
-    for (int i = 0; i < count; i++) {
-        PodcastEpisode* ep = &episodes[i];
-        JSON_Value* ep_val = json_value_init_object();
-        JSON_Object* ep_obj = json_value_get_object(ep_val);
-
-        json_object_set_string(ep_obj, "guid", ep->guid);
-        json_object_set_string(ep_obj, "title", ep->title);
-        json_object_set_string(ep_obj, "url", ep->url);
-        json_object_set_string(ep_obj, "description", ep->description);
-        json_object_set_number(ep_obj, "duration", ep->duration_sec);
-        json_object_set_number(ep_obj, "pub_date", ep->pub_date);
-        json_object_set_number(ep_obj, "progress", ep->progress_sec);
-        json_object_set_boolean(ep_obj, "downloaded", ep->downloaded);
-        if (ep->local_path[0]) {
-            json_object_set_string(ep_obj, "local_path", ep->local_path);
-        }
-        json_object_set_boolean(ep_obj, "is_new", ep->is_new);
-
-        json_array_append_value(arr, ep_val);
+    PodcastStoreWriter* writer = open_episode_store(feed->feed_id, false);
+    if (!writer) {
+        return -1;
     }
 
-    // Save to file
-    char episodes_path[512];
-    get_episodes_file_path(feed->feed_id, episodes_path, sizeof(episodes_path));
-    int result = json_serialize_to_file_pretty(root, episodes_path);
-    json_value_free(root);
+    bool ok = true;
+    for (int i = 0; i < count && ok; i++) {
+        ok = podcast_store_writer_add(writer, &episodes[i]) == 0;
+    }
 
-    if (result == JSONSuccess) {
+    if (podcast_store_writer_close(writer, ok) == 0) {
         feed->episode_count = count;
         return 0;
     }
-
-    LOG_error("[Podcast] Failed to save episodes to %s\n", episodes_path);
     return -1;
 }
 
-// Load a page of episodes from JSON file into cache
+// Load a page of episodes from the episode store into cache
 int Podcast_loadEpisodePage(int feed_index, int offset) {
     if (feed_index < 0 || feed_index >= subscription_count || offset < 0) {
         return 0;
@@ -346,63 +411,36 @@ int Podcast_loadEpisodePage(int feed_index, int offset) {
     char episodes_path[512];
     get_episodes_file_path(feed->feed_id, episodes_path, sizeof(episodes_path));
 
-    JSON_Value* root = json_parse_file(episodes_path);
-    if (!root) {
-        LOG_error("[Podcast] Failed to load episodes from %s\n", episodes_path);
-        return 0;
-    }
-
-    JSON_Array* arr = json_value_get_array(root);
-    if (!arr) {
-        json_value_free(root);
-        return 0;
-    }
-
-    int total = json_array_get_count(arr);
-    feed->episode_count = total;  // Update total count
-
     pthread_mutex_lock(&episode_cache_mutex);
 
-    episode_cache_feed_index = feed_index;
-    episode_cache_offset = offset;
+    episode_cache_feed_index = -1;
     episode_cache_count = 0;
 
-    for (int i = offset; i < total && episode_cache_count < PODCAST_EPISODE_PAGE_SIZE; i++) {
-        JSON_Object* ep_obj = json_array_get_object(arr, i);
-        if (!ep_obj) continue;
+    int total = 0;
+    int count = podcast_store_read(episodes_path, offset, episode_cache,
+                                   PODCAST_EPISODE_PAGE_SIZE, &total);
+    if (count < 0) {
+        pthread_mutex_unlock(&episode_cache_mutex);
+        LOG_error("[Podcast] Failed to load episodes from %s\n", episodes_path);
+        return 0;
+    }
+    feed->episode_count = total;  // Update total count
 
-        PodcastEpisode* ep = &episode_cache[episode_cache_count];
-        memset(ep, 0, sizeof(PodcastEpisode));
+    for (int i = 0; i < count; i++) {
+        PodcastEpisode* ep = &episode_cache[i];
 
-        const char* str;
-        str = json_object_get_string(ep_obj, "guid");
-        if (str) strncpy(ep->guid, str, PODCAST_MAX_GUID - 1);
-        str = json_object_get_string(ep_obj, "title");
-        if (str) strncpy(ep->title, str, PODCAST_MAX_TITLE - 1);
-        str = json_object_get_string(ep_obj, "url");
-        if (str) strncpy(ep->url, str, PODCAST_MAX_URL - 1);
-        str = json_object_get_string(ep_obj, "description");
-        if (str) strncpy(ep->description, str, PODCAST_MAX_DESCRIPTION - 1);
-        str = json_object_get_string(ep_obj, "local_path");
-        if (str) strncpy(ep->local_path, str, PODCAST_MAX_URL - 1);
-
-        ep->duration_sec = (int)json_object_get_number(ep_obj, "duration");
-        ep->pub_date = (uint32_t)json_object_get_number(ep_obj, "pub_date");
-        ep->progress_sec = (int)json_object_get_number(ep_obj, "progress");
-        ep->downloaded = json_object_get_boolean(ep_obj, "downloaded");
-        ep->is_new = (json_object_get_boolean(ep_obj, "is_new") == 1);
-
-        // Cross-reference with progress.json (more recent than episodes.json)
+        // Cross-reference with the progress table (more recent than the store)
         int cached_progress = Podcast_getProgress(feed->feed_url, ep->guid);
         if (cached_progress != 0) {
             ep->progress_sec = cached_progress;
         }
-
-        episode_cache_count++;
     }
 
+    episode_cache_feed_index = feed_index;
+    episode_cache_offset = offset;
+    episode_cache_count = count;
+
     pthread_mutex_unlock(&episode_cache_mutex);
-    json_value_free(root);
 
     return episode_cache_count;
 }
@@ -469,7 +507,8 @@ extern int podcast_search_lookup(const char* itunes_id, char* feed_url, int feed
 extern int podcast_search_lookup_full(const char* itunes_id, char* feed_url, int feed_url_size,
                                       char* artwork_url, int artwork_url_size);
 extern int podcast_charts_fetch(const char* country_code, PodcastChartItem* top, int* top_count,
-                                 PodcastChartItem* new_items, int* new_count, int max_items);
+                                 PodcastChartItem* new_items, int* new_count, int max_items,
+                                 HttpValidators* validators);
 extern int podcast_charts_filter_premium(PodcastChartItem* items, int count, int max_items);
 
 // Download artwork image to feed's data directory
@@ -490,7 +529,7 @@ static void download_feed_artwork(PodcastFeed* feed) {
     uint8_t* buf = (uint8_t*)malloc(1024 * 1024);
     if (!buf) return;
 
-    int size = wget_fetch(feed->artwork_url, buf, 1024 * 1024);
+    int size = http_fetch(feed->artwork_url, buf, 1024 * 1024, NULL);
     if (size > 0) {
         f = fopen(art_path, "wb");
         if (f) {
@@ -510,11 +549,12 @@ int Podcast_init(void) {
 
     snprintf(podcast_data_dir, sizeof(podcast_data_dir), "%s/" PODCAST_DATA_DIR, SHARED_USERDATA_PATH);
     snprintf(subscriptions_file, sizeof(subscriptions_file), "%s/" PODCAST_SUBSCRIPTIONS_FILE, podcast_data_dir);
-    snprintf(progress_file, sizeof(progress_file), "%s/progress.json", podcast_data_dir);
+    snprintf(progress_file, sizeof(progress_file), "%s/progress.log", podcast_data_dir);
     snprintf(downloads_file, sizeof(downloads_file), "%s/downloads.json", podcast_data_dir);
     snprintf(charts_cache_file, sizeof(charts_cache_file), "%s/charts.json", podcast_data_dir);
     snprintf(continue_listening_file, sizeof(continue_listening_file), "%s/continue_listening.json", podcast_data_dir);
     snprintf(download_dir, sizeof(download_dir), "%s/Podcasts", SDCARD_PATH);
+    snprintf(autodownload_file, sizeof(autodownload_file), "%s/autodownload.json", podcast_data_dir);
 
     // Create podcast data directory
     mkdir_recursive(podcast_data_dir);
@@ -558,38 +598,21 @@ int Podcast_init(void) {
     }
 
     // Load progress entries
-    JSON_Value* root = json_parse_file(progress_file);
-    if (root) {
-        JSON_Array* arr = json_value_get_array(root);
-        if (arr) {
-            int count = json_array_get_count(arr);
-            for (int i = 0; i < count && progress_entry_count < MAX_PROGRESS_ENTRIES; i++) {
-                JSON_Object* obj = json_array_get_object(arr, i);
-                if (obj) {
-                    const char* feed = json_object_get_string(obj, "feed_url");
-                    const char* guid = json_object_get_string(obj, "guid");
-                    int pos = (int)json_object_get_number(obj, "position");
-                    if (feed && guid) {
-                        strncpy(progress_entries[progress_entry_count].feed_url, feed, PODCAST_MAX_URL - 1);
-                        strncpy(progress_entries[progress_entry_count].episode_guid, guid, PODCAST_MAX_GUID - 1);
-                        progress_entries[progress_entry_count].position_sec = pos;
-                        progress_entry_count++;
-                    }
-                }
-            }
-        }
-        json_value_free(root);
-    }
+    load_progress();
 
     // Load and validate continue listening entries
     load_continue_listening();
     validate_continue_listening();
 
+    load_auto_download_state();
+
     podcast_initialized = true;
     return 0;
 }
 
 void Podcast_cleanup(void) {
+    if (!podcast_initialized) return;
+
     // Stop any running operations
     Podcast_cancelSearch();
     Podcast_stopDownloads();
@@ -609,7 +632,7 @@ void Podcast_cleanup(void) {
     Podcast_flushProgress();
 
     // Clear UI caches
-    Podcast_clearThumbnailCache();
+    Thumbnail_clear();
 }
 
 const char* Podcast_getError(void) {
@@ -646,61 +669,399 @@ PodcastFeed* Podcast_getSubscription(int index) {
     return &subscriptions[index];
 }
 
-int Podcast_subscribe(const char* feed_url) {
-    if (!feed_url || subscription_count >= PODCAST_MAX_SUBSCRIPTIONS) {
+// ============================================================================
+// Streaming Feed Ingestion
+// ============================================================================
+
+// What a refresh must carry over from the stored copy of an episode
+typedef struct {
+    uint64_t guid_hash;
+    int progress_sec;
+    bool downloaded;
+    bool is_new;
+    bool seen;                           // Listed again by this refresh
+    char* local_path;                    // NULL if none
+} KnownEpisode;
+
+static uint64_t guid_hash(const char* guid) {
+    uint64_t hash = 0xcbf29ce484222325ULL;  // FNV-1a
+    while (*guid) {
+        hash ^= (unsigned char)*guid++;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static int compare_known_episodes(const void* a, const void* b) {
+    uint64_t ha = ((const KnownEpisode*)a)->guid_hash;
+    uint64_t hb = ((const KnownEpisode*)b)->guid_hash;
+    return ha < hb ? -1 : (ha > hb ? 1 : 0);
+}
+
+static void free_known_episodes(KnownEpisode* known, int count) {
+    if (!known) return;
+    for (int i = 0; i < count; i++) {
+        free(known[i].local_path);
+    }
+    free(known);
+}
+
+// Reduce a feed's stored episodes to a sorted table keyed by GUID hash
+static KnownEpisode* load_known_episodes(const char* episodes_path, int* count_out) {
+    *count_out = 0;
+
+    int total = 0;
+    if (podcast_store_info(episodes_path, &total, NULL) != 0 || total <= 0) {
+        return NULL;
+    }
+
+    KnownEpisode* known = (KnownEpisode*)calloc(total, sizeof(KnownEpisode));
+    PodcastEpisode* batch = (PodcastEpisode*)malloc(STORE_READ_BATCH * sizeof(PodcastEpisode));
+    if (!known || !batch) {
+        free(known);
+        free(batch);
+        return NULL;
+    }
+
+    int count = 0;
+    for (int offset = 0; offset < total; offset += STORE_READ_BATCH) {
+        int n = podcast_store_read(episodes_path, offset, batch, STORE_READ_BATCH, NULL);
+        if (n <= 0) break;
+
+        for (int i = 0; i < n && count < total; i++) {
+            PodcastEpisode* ep = &batch[i];
+            KnownEpisode* k = &known[count++];
+            k->guid_hash = guid_hash(ep->guid);
+            k->progress_sec = ep->progress_sec;
+            k->downloaded = ep->downloaded;
+            k->is_new = ep->is_new;
+            if (ep->local_path[0]) k->local_path = strdup(ep->local_path);
+        }
+    }
+    free(batch);
+
+    qsort(known, count, sizeof(KnownEpisode), compare_known_episodes);
+
+    // Drop duplicate GUIDs so each maps to exactly one entry
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique > 0 && known[i].guid_hash == known[unique - 1].guid_hash) {
+            free(known[i].local_path);
+            continue;
+        }
+        known[unique++] = known[i];
+    }
+
+    *count_out = unique;
+    return known;
+}
+
+typedef struct {
+    PodcastRssParser* parser;
+    PodcastStoreWriter* writer;          // Live store, opened at the first item
+    const char* feed_url;
+    const char* feed_id;
+    const char* stored_path;             // Stored episodes (refresh), NULL on subscribe
+    char aside_path[520];                // Where the stored copy waits while the new one is written
+    bool incremental;                    // Stop at the first run of stored episodes
+    KnownEpisode* known;                 // Loaded from stored_path at the first item
+    int known_count;
+    int new_count;                       // Episodes flagged is_new in the result
+    int known_run;                       // Consecutive stored episodes just parsed
+    uint32_t last_pub_date;
+    bool newest_first;                   // Every item so far older than the one before
+    bool caught_up;                      // Stopped at a known run: rest comes from storage
+    bool write_failed;
+    uint64_t deadline_ms;                // Give up on the feed after this (0 = no limit)
+} FeedIngest;
+
+static uint64_t podcast_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Index of the subscription with feed_url (caller holds subscriptions_mutex)
+static int find_feed_locked(const char* feed_url) {
+    for (int i = 0; i < subscription_count; i++) {
+        if (strcmp(subscriptions[i].feed_url, feed_url) == 0) return i;
+    }
+    return -1;
+}
+
+// Show a subscribed feed's episode count while its store is being written
+static void publish_episode_count(const char* feed_url, int count) {
+    pthread_mutex_lock(&subscriptions_mutex);
+    int index = find_feed_locked(feed_url);
+    if (index >= 0) subscriptions[index].episode_count = count;
+    pthread_mutex_unlock(&subscriptions_mutex);
+
+    if (index >= 0 && episode_cache_feed_index == index) {
+        Podcast_invalidateEpisodeCache();
+    }
+}
+
+// Start the live store. A stored copy is moved aside first: it still supplies
+// the records append_stored_episodes() carries over, and is put back if the
+// feed fails part way
+static int feed_ingest_go_live(FeedIngest* ingest) {
+    if (ingest->stored_path && access(ingest->stored_path, F_OK) == 0) {
+        if (rename(ingest->stored_path, ingest->aside_path) != 0) {
+            LOG_error("[Podcast] Failed to move aside %s\n", ingest->stored_path);
+            return -1;
+        }
+        ingest->stored_path = ingest->aside_path;
+    } else {
+        ingest->stored_path = NULL;
+    }
+
+    ingest->writer = open_episode_store(ingest->feed_id, true);
+    return ingest->writer ? 0 : -1;
+}
+
+// Parser sink: merge with the stored copy and append to the new store, where
+// it can be read straight away
+static int feed_ingest_item(const PodcastEpisode* episode, void* userdata) {
+    FeedIngest* ingest = (FeedIngest*)userdata;
+
+    if (podcast_store_writer_count(ingest->writer) >= PODCAST_MAX_FEED_EPISODES) {
+        return -1;  // Enough: stop reading the feed
+    }
+
+    PodcastEpisode ep;
+    memcpy(&ep, episode, sizeof(PodcastEpisode));
+
+    if (!ingest->writer) {
+        // Only now that the feed has changed is the stored copy worth reading
+        if (ingest->stored_path) {
+            ingest->known = load_known_episodes(ingest->stored_path, &ingest->known_count);
+        }
+        if (feed_ingest_go_live(ingest) != 0) {
+            ingest->write_failed = true;
+            return -1;
+        }
+    }
+
+    // Early exit only holds up if the feed lists newest first
+    if (!ep.pub_date || (ingest->last_pub_date && ep.pub_date > ingest->last_pub_date)) {
+        ingest->newest_first = false;
+    }
+    ingest->last_pub_date = ep.pub_date;
+
+    if (ingest->known) {
+        KnownEpisode key = {0};
+        key.guid_hash = guid_hash(ep.guid);
+        KnownEpisode* k = (KnownEpisode*)bsearch(&key, ingest->known,
+            ingest->known_count, sizeof(KnownEpisode), compare_known_episodes);
+        ingest->known_run = k ? ingest->known_run + 1 : 0;
+        if (k) {
+            if (k->seen) return 1;  // Listed twice in the feed
+            k->seen = true;
+
+            // Preserve progress/downloaded status
+            ep.progress_sec = k->progress_sec;
+            ep.downloaded = k->downloaded;
+            if (k->local_path) strncpy(ep.local_path, k->local_path, PODCAST_MAX_URL - 1);
+            ep.is_new = k->is_new;
+        } else {
+            ep.is_new = true;  // Brand new episode
+        }
+    }
+    if (ep.is_new) ingest->new_count++;
+
+    if (podcast_store_writer_add(ingest->writer, &ep) != 0) {
+        ingest->write_failed = true;
         return -1;
     }
+    publish_episode_count(ingest->feed_url, podcast_store_writer_count(ingest->writer));
 
-    // Check if already subscribed
-    if (Podcast_isSubscribed(feed_url)) {
-        return 0;  // Already subscribed, not an error
+    if (ingest->incremental && ingest->newest_first && ingest->known_run >= REFRESH_KNOWN_RUN) {
+        // Everything further down is already stored: stop the download here
+        ingest->caught_up = true;
+        return -1;
     }
+    return 0;
+}
 
-    // Fetch the feed
-    uint8_t* buffer = (uint8_t*)malloc(5 * 1024 * 1024);  // 5MB buffer for large RSS feeds
-    if (!buffer) {
-        snprintf(error_message, sizeof(error_message), "Out of memory");
+// After an early exit, carry over the stored episodes the feed wasn't read
+// far enough to list again, in their stored order
+static int append_stored_episodes(FeedIngest* ingest) {
+    int total = 0;
+    if (podcast_store_info(ingest->stored_path, &total, NULL) != 0) {
         return -1;
     }
 
-    int bytes = wget_fetch(feed_url, buffer, 5 * 1024 * 1024);
-    if (bytes <= 0) {
-        LOG_error("[Podcast] Failed to fetch feed: %s\n", feed_url);
-        free(buffer);
-        snprintf(error_message, sizeof(error_message), "Failed to fetch feed");
+    PodcastEpisode* batch = (PodcastEpisode*)malloc(STORE_READ_BATCH * sizeof(PodcastEpisode));
+    if (!batch) return -1;
+
+    int result = 0;
+    for (int offset = 0; offset < total && result == 0; offset += STORE_READ_BATCH) {
+        int n = podcast_store_read(ingest->stored_path, offset, batch, STORE_READ_BATCH, NULL);
+        if (n <= 0) {
+            result = -1;
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            if (podcast_store_writer_count(ingest->writer) >= PODCAST_MAX_FEED_EPISODES) break;
+
+            KnownEpisode key = {0};
+            key.guid_hash = guid_hash(batch[i].guid);
+            KnownEpisode* k = (KnownEpisode*)bsearch(&key, ingest->known,
+                ingest->known_count, sizeof(KnownEpisode), compare_known_episodes);
+            if (!k || k->seen) continue;
+            k->seen = true;
+
+            if (podcast_store_writer_add(ingest->writer, &batch[i]) != 0) {
+                result = -1;
+                break;
+            }
+            if (batch[i].is_new) ingest->new_count++;
+        }
+    }
+
+    free(batch);
+    return result;
+}
+
+// HTTP body sink: parse the feed as it arrives
+static int feed_ingest_body(const uint8_t* data, int len, void* userdata) {
+    FeedIngest* ingest = (FeedIngest*)userdata;
+    if (ingest->deadline_ms && podcast_now_ms() > ingest->deadline_ms) {
+        LOG_error("[Podcast] Feed took too long, giving up\n");
         return -1;
     }
+    int ret = podcast_rss_parser_feed(ingest->parser, (const char*)data, len);
+    if (ingest->write_failed) return -1;
+    return ret;  // 1: episode limit reached, the rest isn't needed
+}
+
+// Download a feed and parse it straight into <feed_id>/episodes.bin, never
+// holding more than one episode of it in memory. Episodes can be listed as
+// soon as they're parsed; the old store is kept aside meanwhile and comes
+// back if the feed doesn't parse completely.
+// meta: receives the channel metadata. stored_path: episode store to carry
+// progress over from, and to compare against for new episodes (NULL when
+// subscribing). incremental: with a stored copy, stop reading a newest-first
+// feed once REFRESH_KNOWN_RUN stored episodes in a row have been listed and
+// keep the rest of the stored list instead. timeout_ms: limit for the whole
+// transfer (0 = only the per-read network timeout).
+// Returns the episode count, HTTP_NOT_MODIFIED, or -1 on failure
+static int ingest_feed(const char* feed_url, const char* feed_id, PodcastFeed* meta,
+                       HttpValidators* validators, const char* stored_path, bool incremental,
+                       int timeout_ms, int* new_count_out) {
+    FeedIngest ingest;
+    memset(&ingest, 0, sizeof(ingest));
+    ingest.feed_url = feed_url;
+    ingest.feed_id = feed_id;
+    ingest.stored_path = stored_path;
+    ingest.incremental = incremental;
+    ingest.newest_first = true;
+    if (timeout_ms > 0) {
+        ingest.deadline_ms = podcast_now_ms() + timeout_ms;
+    }
+
+    if (stored_path) {
+        snprintf(ingest.aside_path, sizeof(ingest.aside_path), "%s.old", stored_path);
+        // A refresh cut short by a crash left the complete list aside
+        if (access(ingest.aside_path, F_OK) == 0) {
+            rename(ingest.aside_path, stored_path);
+        }
+    }
 
-    // Allocate temporary episodes array (parse all episodes from feed)
-    // Using 2000 as a reasonable max - most podcasts have far fewer
-    int max_episodes = 2000;
-    PodcastEpisode* temp_episodes = (PodcastEpisode*)malloc(max_episodes * sizeof(PodcastEpisode));
-    if (!temp_episodes) {
-        free(buffer);
-        snprintf(error_message, sizeof(error_message), "Out of memory");
+    ingest.parser = podcast_rss_parser_create(meta, feed_ingest_item, &ingest);
+    if (!ingest.parser) {
         return -1;
     }
 
-    // Parse RSS into feed and episodes array
-    PodcastFeed temp_feed;
-    memset(&temp_feed, 0, sizeof(PodcastFeed));
-    strncpy(temp_feed.feed_url, feed_url, PODCAST_MAX_URL - 1);
+    HttpRequest req;
+    memset(&req, 0, sizeof(req));
+    req.url = feed_url;
+    req.validators = validators;
+    req.accept_compressed = true;
+    req.on_body = feed_ingest_body;
+    req.userdata = &ingest;
+
+    HttpResponse* resp = (HttpResponse*)malloc(sizeof(HttpResponse));
+    int result = -1;
+    if (resp && http_client_get(&req, resp) == 0) {
+        if (resp->status >= 200 && resp->status < 300) {
+            result = 0;
+            if (validators) *validators = resp->validators;
+        } else if (resp->status == 304 && validators) {
+            result = HTTP_NOT_MODIFIED;
+        } else {
+            LOG_error("[Podcast] HTTP %d for feed: %s\n", resp->status, feed_url);
+        }
+    }
+    free(resp);
 
-    int episode_count = 0;
-    int result = podcast_rss_parse_with_episodes((const char*)buffer, bytes, &temp_feed,
-                                                  temp_episodes, max_episodes, &episode_count);
-    free(buffer);
+    if (podcast_rss_parser_finish(ingest.parser) != 0 && result == 0) {
+        LOG_error("[Podcast] Failed to parse feed: %s\n", feed_url);
+        result = -1;
+    }
+    if (result == 0 && !ingest.writer && feed_ingest_go_live(&ingest) != 0) {
+        result = -1;  // A feed without episodes still replaces the stored list
+    }
+    if (result == 0 && ingest.caught_up && append_stored_episodes(&ingest) != 0) {
+        result = -1;
+    }
+    free_known_episodes(ingest.known, ingest.known_count);
 
+    int episode_count = podcast_store_writer_count(ingest.writer);
+    if (ingest.writer && podcast_store_writer_close(ingest.writer, result == 0) != 0 && result == 0) {
+        result = -1;
+    }
+    if (ingest.stored_path == ingest.aside_path) {
+        if (result == 0) {
+            unlink(ingest.aside_path);
+        } else if (rename(ingest.aside_path, stored_path) == 0) {
+            int total = 0;
+            podcast_store_info(stored_path, &total, NULL);
+            publish_episode_count(feed_url, total);
+        }
+    }
     if (result != 0) {
-        LOG_error("[Podcast] Failed to parse feed: %s\n", feed_url);
-        free(temp_episodes);
-        snprintf(error_message, sizeof(error_message), "Invalid RSS feed");
+        return result;
+    }
+
+    if (new_count_out) *new_count_out = ingest.new_count;
+    return episode_count;
+}
+
+int Podcast_subscribe(const char* feed_url) {
+    if (!feed_url || subscription_count >= PODCAST_MAX_SUBSCRIPTIONS) {
         return -1;
     }
 
+    // Check if already subscribed
+    if (Podcast_isSubscribed(feed_url)) {
+        return 0;  // Already subscribed, not an error
+    }
+
+    // Stream the feed into its episode store as it downloads
+    PodcastFeed temp_feed;
+    memset(&temp_feed, 0, sizeof(PodcastFeed));
+    strncpy(temp_feed.feed_url, feed_url, PODCAST_MAX_URL - 1);
     set_feed_id(&temp_feed);
+
+    HttpValidators validators;
+    memset(&validators, 0, sizeof(validators));
+    int episode_count = ingest_feed(feed_url, temp_feed.feed_id, &temp_feed, &validators,
+                                    NULL, false, 0, NULL);
+    if (episode_count < 0) {
+        LOG_error("[Podcast] Failed to subscribe to feed: %s\n", feed_url);
+        char feed_dir[512];
+        Podcast_getFeedDataPath(temp_feed.feed_id, feed_dir, sizeof(feed_dir));
+        rmdir(feed_dir);  // Only if nothing else is in it
+        snprintf(error_message, sizeof(error_message), "Failed to load feed");
+        return -1;
+    }
+
     temp_feed.last_updated = (uint32_t)time(NULL);
     temp_feed.episode_count = episode_count;
+    strncpy(temp_feed.etag, validators.etag, sizeof(temp_feed.etag) - 1);
+    strncpy(temp_feed.last_modified, validators.last_modified, sizeof(temp_feed.last_modified) - 1);
 
     // Add to subscriptions
     pthread_mutex_lock(&subscriptions_mutex);
@@ -709,12 +1070,6 @@ int Podcast_subscribe(const char* feed_url) {
     subscription_count++;
     pthread_mutex_unlock(&subscriptions_mutex);
 
-    // Save episodes to disk
-    if (episode_count > 0) {
-        Podcast_saveEpisodes(feed_index, temp_episodes, episode_count);
-    }
-    free(temp_episodes);
-
     Podcast_saveSubscriptions();
 
     // Fetch artwork image now so thumbnails are available immediately
@@ -750,6 +1105,7 @@ int Podcast_subscribeFromItunes(const char* itunes_id) {
     int result = Podcast_subscribe(feed_url);
 
     if (result == 0 && subscription_count > 0) {
+        pthread_mutex_lock(&subscriptions_mutex);
         PodcastFeed* feed = &subscriptions[subscription_count - 1];
         // Store iTunes ID
         strncpy(feed->itunes_id, itunes_id, sizeof(feed->itunes_id) - 1);
@@ -757,6 +1113,7 @@ int Podcast_subscribeFromItunes(const char* itunes_id) {
         if (artwork_url[0]) {
             strncpy(feed->artwork_url, artwork_url, sizeof(feed->artwork_url) - 1);
         }
+        pthread_mutex_unlock(&subscriptions_mutex);
         Podcast_saveSubscriptions();  // Save again with iTunes ID and artwork
         // Fetch artwork if RSS didn't have one but iTunes does
         download_feed_artwork(feed);
@@ -803,12 +1160,11 @@ int Podcast_unsubscribe(int index) {
 
     // Cancel/remove all download queue entries for this feed
     pthread_mutex_lock(&download_mutex);
-    bool had_active_download = false;
     int write_idx = 0;
     for (int i = 0; i < download_queue_count; i++) {
         if (strcmp(download_queue[i].feed_url, feed_url) == 0) {
             if (download_queue[i].status == PODCAST_DOWNLOAD_DOWNLOADING) {
-                had_active_download = true;
+                stop_download_locked(download_queue[i].episode_guid);
             }
             continue;  // Skip (remove) this entry
         }
@@ -818,9 +1174,6 @@ int Podcast_unsubscribe(int index) {
         write_idx++;
     }
     download_queue_count = write_idx;
-    if (had_active_download) {
-        download_should_stop = true;
-    }
     pthread_mutex_unlock(&download_mutex);
     Podcast_saveDownloadQueue();
 
@@ -868,104 +1221,99 @@ bool Podcast_isSubscribedByItunesId(const char* itunes_id) {
     return false;
 }
 
-int Podcast_refreshFeed(int index) {
-    if (index < 0 || index >= subscription_count) return -1;
-
-    PodcastFeed* feed = &subscriptions[index];
-
-    uint8_t* buffer = (uint8_t*)malloc(5 * 1024 * 1024);  // 5MB buffer for large RSS feeds
-    if (!buffer) return -1;
-
-    int bytes = wget_fetch(feed->feed_url, buffer, 5 * 1024 * 1024);
-    if (bytes <= 0) {
-        free(buffer);
-        return -1;
+// Refresh the subscription with feed_url. Works on a copy taken under the
+// lock and writes back by URL, so feeds may be (un)subscribed meanwhile.
+// full: re-read the whole feed even if unchanged, instead of stopping at the
+// episodes already stored. timeout_ms: deadline for the whole feed (0 = none)
+static int refresh_feed(const char* feed_url, bool full, int timeout_ms) {
+    PodcastFeed feed;
+    pthread_mutex_lock(&subscriptions_mutex);
+    int index = find_feed_locked(feed_url);
+    if (index >= 0) {
+        set_feed_id(&subscriptions[index]);
+        memcpy(&feed, &subscriptions[index], sizeof(PodcastFeed));
     }
+    pthread_mutex_unlock(&subscriptions_mutex);
+    if (index < 0) return -1;
 
-    // Allocate temporary episodes array
-    int max_episodes = 2000;
-    PodcastEpisode* new_episodes = (PodcastEpisode*)malloc(max_episodes * sizeof(PodcastEpisode));
-    if (!new_episodes) {
-        free(buffer);
-        return -1;
+    char episodes_path[512];
+    get_episodes_file_path(feed.feed_id, episodes_path, sizeof(episodes_path));
+
+    // Revalidate the copy parsed last time (only while its episodes are on disk)
+    HttpValidators validators;
+    memset(&validators, 0, sizeof(validators));
+    if (!full && access(episodes_path, F_OK) == 0) {
+        strncpy(validators.etag, feed.etag, sizeof(validators.etag) - 1);
+        strncpy(validators.last_modified, feed.last_modified, sizeof(validators.last_modified) - 1);
     }
 
     // Parse into temporary feed
     PodcastFeed temp_feed;
     memset(&temp_feed, 0, sizeof(temp_feed));
-    strncpy(temp_feed.feed_url, feed->feed_url, PODCAST_MAX_URL - 1);
+    strncpy(temp_feed.feed_url, feed.feed_url, PODCAST_MAX_URL - 1);
 
-    int new_episode_count = 0;
-    if (podcast_rss_parse_with_episodes((const char*)buffer, bytes, &temp_feed,
-                                        new_episodes, max_episodes, &new_episode_count) == 0) {
-        // Load existing episodes to preserve progress/downloaded status
-        char episodes_path[512];
-        set_feed_id(feed);
-        get_episodes_file_path(feed->feed_id, episodes_path, sizeof(episodes_path));
+    int new_count = 0;
+    int episode_count = ingest_feed(feed.feed_url, feed.feed_id, &temp_feed, &validators,
+                                    episodes_path, !full, timeout_ms, &new_count);
+    if (episode_count < 0 && episode_count != HTTP_NOT_MODIFIED) {
+        return -1;
+    }
 
-        JSON_Value* old_root = json_parse_file(episodes_path);
-        if (old_root) {
-            JSON_Array* old_arr = json_value_get_array(old_root);
-            if (old_arr) {
-                int old_count = json_array_get_count(old_arr);
-                // Preserve progress for matching episodes, detect new ones
-                for (int i = 0; i < new_episode_count; i++) {
-                    bool found_in_old = false;
-                    for (int j = 0; j < old_count; j++) {
-                        JSON_Object* old_ep = json_array_get_object(old_arr, j);
-                        const char* old_guid = json_object_get_string(old_ep, "guid");
-                        if (old_guid && strcmp(new_episodes[i].guid, old_guid) == 0) {
-                            new_episodes[i].progress_sec = (int)json_object_get_number(old_ep, "progress");
-                            new_episodes[i].downloaded = json_object_get_boolean(old_ep, "downloaded");
-                            const char* local = json_object_get_string(old_ep, "local_path");
-                            if (local) strncpy(new_episodes[i].local_path, local, PODCAST_MAX_URL - 1);
-                            new_episodes[i].is_new = (json_object_get_boolean(old_ep, "is_new") == 1);
-                            found_in_old = true;
-                            break;
-                        }
-                    }
-                    if (!found_in_old) {
-                        new_episodes[i].is_new = true;  // Brand new episode
-                    }
-                }
-            }
-            json_value_free(old_root);
-        }
+    pthread_mutex_lock(&subscriptions_mutex);
+    index = find_feed_locked(feed_url);
+    if (index < 0) {
+        pthread_mutex_unlock(&subscriptions_mutex);
+        return -1;  // Unsubscribed while refreshing
+    }
+    PodcastFeed* sub = &subscriptions[index];
+    sub->last_updated = (uint32_t)time(NULL);
 
+    // HTTP_NOT_MODIFIED: unchanged since the last refresh, the store is left as it was
+    if (episode_count != HTTP_NOT_MODIFIED) {
         // Update feed metadata
-        pthread_mutex_lock(&subscriptions_mutex);
-        strncpy(feed->title, temp_feed.title, PODCAST_MAX_TITLE - 1);
-        strncpy(feed->author, temp_feed.author, PODCAST_MAX_AUTHOR - 1);
-        strncpy(feed->description, temp_feed.description, PODCAST_MAX_DESCRIPTION - 1);
+        strncpy(sub->title, temp_feed.title, PODCAST_MAX_TITLE - 1);
+        strncpy(sub->author, temp_feed.author, PODCAST_MAX_AUTHOR - 1);
+        strncpy(sub->description, temp_feed.description, PODCAST_MAX_DESCRIPTION - 1);
         // Only update artwork if we didn't have it from iTunes
-        if (!feed->artwork_url[0] && temp_feed.artwork_url[0]) {
-            strncpy(feed->artwork_url, temp_feed.artwork_url, PODCAST_MAX_URL - 1);
-        }
-        feed->episode_count = new_episode_count;
-        feed->last_updated = (uint32_t)time(NULL);
-        pthread_mutex_unlock(&subscriptions_mutex);
-
-        // Save new episodes to disk
-        Podcast_saveEpisodes(index, new_episodes, new_episode_count);
-
-        // Recount new_episode_count from the episodes we just saved
-        int nc = 0;
-        for (int i = 0; i < new_episode_count; i++) {
-            if (new_episodes[i].is_new) nc++;
+        if (!sub->artwork_url[0] && temp_feed.artwork_url[0]) {
+            strncpy(sub->artwork_url, temp_feed.artwork_url, PODCAST_MAX_URL - 1);
         }
-        feed->new_episode_count = nc;
+        sub->episode_count = episode_count;
+        sub->new_episode_count = new_count;
+        strncpy(sub->etag, validators.etag, sizeof(sub->etag) - 1);
+        sub->etag[sizeof(sub->etag) - 1] = '\0';
+        strncpy(sub->last_modified, validators.last_modified, sizeof(sub->last_modified) - 1);
+        sub->last_modified[sizeof(sub->last_modified) - 1] = '\0';
+    }
+    pthread_mutex_unlock(&subscriptions_mutex);
 
-        // Invalidate cache if this feed was cached
-        if (episode_cache_feed_index == index) {
-            Podcast_invalidateEpisodeCache();
-        }
+    // Invalidate cache if this feed was cached
+    if (episode_count != HTTP_NOT_MODIFIED && episode_cache_feed_index == index) {
+        Podcast_invalidateEpisodeCache();
     }
 
-    free(new_episodes);
-    free(buffer);
     return 0;
 }
 
+// Refresh by index from the caller's thread
+static int refresh_feed_at(int index, bool full) {
+    char feed_url[PODCAST_MAX_URL];
+    pthread_mutex_lock(&subscriptions_mutex);
+    bool valid = index >= 0 && index < subscription_count;
+    if (valid) strcpy(feed_url, subscriptions[index].feed_url);
+    pthread_mutex_unlock(&subscriptions_mutex);
+
+    return valid ? refresh_feed(feed_url, full, 0) : -1;
+}
+
+int Podcast_refreshFeed(int index) {
+    return refresh_feed_at(index, false);
+}
+
+int Podcast_resyncFeed(int index) {
+    return refresh_feed_at(index, true);
+}
+
 void Podcast_saveSubscriptions(void) {
     JSON_Value* root = json_value_init_array();
     JSON_Array* arr = json_value_get_array(root);
@@ -989,8 +1337,14 @@ void Podcast_saveSubscriptions(void) {
         json_object_set_string(feed_obj, "artwork_url", feed->artwork_url);
         json_object_set_number(feed_obj, "last_updated", feed->last_updated);
         json_object_set_number(feed_obj, "episode_count", feed->episode_count);
-        // Note: episodes are stored separately in <feed_id>/episodes.json
-        // new_episode_count is computed dynamically from episodes.json
+        if (feed->etag[0]) json_object_set_string(feed_obj, "etag", feed->etag);
+        if (feed->last_modified[0]) json_object_set_string(feed_obj, "last_modified", feed->last_modified);
+        if (feed->playback_speed > 0 && feed->playback_speed != 100) {
+            json_object_set_number(feed_obj, "playback_speed", feed->playback_speed);
+        }
+        if (feed->skip_silence) json_object_set_boolean(feed_obj, "skip_silence", 1);
+        // Note: episodes are stored separately in <feed_id>/episodes.bin
+        // new_episode_count is read from the episode store header
 
         json_array_append_value(arr, feed_val);
     }
@@ -1036,9 +1390,15 @@ void Podcast_loadSubscriptions(void) {
         if (str) strncpy(feed->description, str, PODCAST_MAX_DESCRIPTION - 1);
         str = json_object_get_string(feed_obj, "artwork_url");
         if (str) strncpy(feed->artwork_url, str, PODCAST_MAX_URL - 1);
+        str = json_object_get_string(feed_obj, "etag");
+        if (str) strncpy(feed->etag, str, sizeof(feed->etag) - 1);
+        str = json_object_get_string(feed_obj, "last_modified");
+        if (str) strncpy(feed->last_modified, str, sizeof(feed->last_modified) - 1);
 
         feed->last_updated = (uint32_t)json_object_get_number(feed_obj, "last_updated");
         feed->episode_count = (int)json_object_get_number(feed_obj, "episode_count");
+        feed->playback_speed = (int)json_object_get_number(feed_obj, "playback_speed");
+        feed->skip_silence = (json_object_get_boolean(feed_obj, "skip_silence") == 1);
 
         // Generate feed_id if not loaded (for backward compatibility)
         set_feed_id(feed);
@@ -1049,26 +1409,15 @@ void Podcast_loadSubscriptions(void) {
     }
     pthread_mutex_unlock(&subscriptions_mutex);
 
-    // Compute new_episode_count dynamically from each feed's episodes.json
+    // Read new_episode_count from each feed's episode store header
     for (int i = 0; i < subscription_count; i++) {
         PodcastFeed* feed = &subscriptions[i];
         feed->new_episode_count = 0;
+        migrate_episodes_json(feed->feed_id);
+
         char episodes_path[512];
         get_episodes_file_path(feed->feed_id, episodes_path, sizeof(episodes_path));
-        JSON_Value* ep_root = json_parse_file(episodes_path);
-        if (ep_root) {
-            JSON_Array* ep_arr = json_value_get_array(ep_root);
-            if (ep_arr) {
-                int ep_count = json_array_get_count(ep_arr);
-                for (int j = 0; j < ep_count; j++) {
-                    JSON_Object* ep_obj = json_array_get_object(ep_arr, j);
-                    if (ep_obj && json_object_get_boolean(ep_obj, "is_new") == 1) {
-                        feed->new_episode_count++;
-                    }
-                }
-            }
-            json_value_free(ep_root);
-        }
+        podcast_store_info(episodes_path, NULL, &feed->new_episode_count);
     }
 
     json_value_free(root);
@@ -1161,6 +1510,7 @@ void Podcast_clearChartsCache(void) {
     // Clear in-memory data
     top_shows_count = 0;
     memset(&charts_status, 0, sizeof(charts_status));
+    memset(&charts_validators, 0, sizeof(charts_validators));
 }
 
 int Podcast_loadCharts(const char* country_code) {
@@ -1176,7 +1526,7 @@ int Podcast_loadCharts(const char* country_code) {
     memset(&charts_status, 0, sizeof(charts_status));
 
     // Try to load from cache first (daily cache)
-    if (load_charts_cache()) {
+    if (load_charts_cache(false)) {
         // Cache hit - no need to fetch from network
         charts_status.top_shows_count = top_shows_count;
         charts_status.loading = false;
@@ -1184,20 +1534,29 @@ int Podcast_loadCharts(const char* country_code) {
         return 0;
     }
 
-    // Cache miss or expired - fetch from network
-    charts_status.loading = true;
+    // Expired cache: show it right away and refresh in the background.
+    // Otherwise (cache miss) show the loading state until the fetch is done
+    bool have_stale = load_charts_cache(true);
+    if (have_stale) {
+        charts_status.top_shows_count = top_shows_count;
+        charts_status.completed = true;
+    } else {
+        top_shows_count = 0;
+        charts_status.loading = true;
+    }
     charts_should_stop = false;
     charts_running = true;
 
     if (pthread_create(&charts_thread, NULL, charts_thread_func, NULL) != 0) {
         charts_running = false;
+        if (have_stale) return 0;
         charts_status.loading = false;
         snprintf(charts_status.error_message, sizeof(charts_status.error_message), "Failed to load charts");
         return -1;
     }
 
     pthread_detach(charts_thread);
-    podcast_state = PODCAST_STATE_LOADING_CHARTS;
+    if (!have_stale) podcast_state = PODCAST_STATE_LOADING_CHARTS;
     return 0;
 }
 
@@ -1209,6 +1568,8 @@ static void save_charts_cache(void) {
     // Save timestamp and country
     json_object_set_number(obj, "timestamp", (double)time(NULL));
     json_object_set_string(obj, "country", charts_country_code);
+    json_object_set_string(obj, "etag", charts_validators.etag);
+    json_object_set_string(obj, "last_modified", charts_validators.last_modified);
 
     // Save top shows
     JSON_Value* top_arr_val = json_value_init_array();
@@ -1230,9 +1591,12 @@ static void save_charts_cache(void) {
     json_value_free(root);
 }
 
-// Load charts from cache if valid (within 24 hours and same country)
+// Load charts from cache if valid (within 24 hours unless any_age, and same country).
+// The cache's validators are kept even when it has expired, for revalidation.
 // Returns true if cache was loaded successfully
-static bool load_charts_cache(void) {
+static bool load_charts_cache(bool any_age) {
+    memset(&charts_validators, 0, sizeof(charts_validators));
+
     JSON_Value* root = json_parse_file(charts_cache_file);
     if (!root) {
         return false;
@@ -1244,18 +1608,26 @@ static bool load_charts_cache(void) {
         return false;
     }
 
-    // Check timestamp - cache valid for 24 hours
-    double timestamp = json_object_get_number(obj, "timestamp");
-    time_t now = time(NULL);
-    time_t cache_age = now - (time_t)timestamp;
-    if (cache_age > 24 * 60 * 60) {  // 24 hours in seconds
+    // Check country matches
+    const char* cached_country = json_object_get_string(obj, "country");
+    if (!cached_country || strcmp(cached_country, charts_country_code) != 0) {
         json_value_free(root);
         return false;
     }
 
-    // Check country matches
-    const char* cached_country = json_object_get_string(obj, "country");
-    if (!cached_country || strcmp(cached_country, charts_country_code) != 0) {
+    const char* s;
+    if ((s = json_object_get_string(obj, "etag"))) {
+        strncpy(charts_validators.etag, s, sizeof(charts_validators.etag) - 1);
+    }
+    if ((s = json_object_get_string(obj, "last_modified"))) {
+        strncpy(charts_validators.last_modified, s, sizeof(charts_validators.last_modified) - 1);
+    }
+
+    // Check timestamp - cache valid for 24 hours
+    double timestamp = json_object_get_number(obj, "timestamp");
+    time_t now = time(NULL);
+    time_t cache_age = now - (time_t)timestamp;
+    if (!any_age && cache_age > 24 * 60 * 60) {  // 24 hours in seconds
         json_value_free(root);
         return false;
     }
@@ -1272,7 +1644,6 @@ static bool load_charts_cache(void) {
             PodcastChartItem* show = &top_shows[top_shows_count];
             memset(show, 0, sizeof(PodcastChartItem));
 
-            const char* s;
             if ((s = json_object_get_string(item, "itunes_id"))) strncpy(show->itunes_id, s, sizeof(show->itunes_id) - 1);
             if ((s = json_object_get_string(item, "title"))) strncpy(show->title, s, PODCAST_MAX_TITLE - 1);
             if ((s = json_object_get_string(item, "author"))) strncpy(show->author, s, PODCAST_MAX_AUTHOR - 1);
@@ -1292,21 +1663,31 @@ static void* charts_thread_func(void* arg) {
     (void)arg;
 
     int top_count = 0;
-    // Fetch more items than needed to have buffer after filtering premium podcasts
-    int result = podcast_charts_fetch(charts_country_code, top_shows, &top_count,
-                                       NULL, NULL, PODCAST_CHART_FETCH_LIMIT);
+    // Fetch more items than needed to have buffer after filtering premium podcasts.
+    // The list on screen (top_shows, possibly from an expired cache) stays
+    // untouched until the new one is ready
+    int result = podcast_charts_fetch(charts_country_code, fetched_shows, &top_count,
+                                       NULL, NULL, PODCAST_CHART_FETCH_LIMIT, &charts_validators);
 
     if (charts_should_stop) {
         charts_running = false;
         return NULL;
     }
 
-    if (result < 0) {
-        snprintf(charts_status.error_message, sizeof(charts_status.error_message), "Failed to fetch charts");
+    if (result == HTTP_NOT_MODIFIED && (top_shows_count > 0 || load_charts_cache(true))) {
+        // Chart unchanged: keep the cached list (skips the premium lookup too)
+        charts_status.top_shows_count = top_shows_count;
+        save_charts_cache();  // Restart the 24 hour clock
+    } else if (result < 0) {
+        // Offline: an expired list on screen is better than an error
+        if (top_shows_count == 0) {
+            snprintf(charts_status.error_message, sizeof(charts_status.error_message), "Failed to fetch charts");
+        }
     } else {
         // Filter out premium podcasts and those without feed URLs
-        top_count = podcast_charts_filter_premium(top_shows, top_count, PODCAST_MAX_CHART_ITEMS);
+        top_count = podcast_charts_filter_premium(fetched_shows, top_count, PODCAST_MAX_CHART_ITEMS);
 
+        memcpy(top_shows, fetched_shows, top_count * sizeof(PodcastChartItem));
         top_shows_count = top_count;
         charts_status.top_shows_count = top_count;
 
@@ -1317,7 +1698,9 @@ static void* charts_thread_func(void* arg) {
     charts_running = false;
     charts_status.loading = false;
     charts_status.completed = true;
-    podcast_state = PODCAST_STATE_IDLE;
+    if (podcast_state == PODCAST_STATE_LOADING_CHARTS) {
+        podcast_state = PODCAST_STATE_IDLE;
+    }
     return NULL;
 }
 
@@ -1335,9 +1718,61 @@ const char* Podcast_getCountryCode(void) {
 }
 
 // ============================================================================
-// Playback (local files only - streaming removed)
+// Playback (local file, or streamed until it has been downloaded)
 // ============================================================================
 
+static int feed_speed(const PodcastFeed* feed) {
+    return feed->playback_speed > 0 ? feed->playback_speed : 100;
+}
+
+// Set the player to the feed's speed and silence skipping
+static void apply_speech_playback(const PodcastFeed* feed) {
+    Player_setSpeechPlayback(feed_speed(feed) / 100.0f, feed->skip_silence);
+}
+
+// Load an episode into the player: the downloaded file if there is one,
+// otherwise the episode URL, cached next to where the download would go.
+// A stream that gets all the way through becomes the downloaded file
+static int load_episode(PodcastFeed* feed, int episode_index, PodcastEpisode* ep) {
+    char local_path[PODCAST_MAX_URL];
+    Podcast_getEpisodeLocalPath(feed, episode_index, local_path, sizeof(local_path));
+    if (local_path[0] == '\0') {
+        snprintf(error_message, sizeof(error_message), "Failed to load local file");
+        return -1;
+    }
+
+    // Before looking for the file: once this is set it won't be deleted
+    pthread_mutex_lock(&playing_mutex);
+    snprintf(playing_path, sizeof(playing_path), "%s", local_path);
+    pthread_mutex_unlock(&playing_mutex);
+
+    if (access(local_path, F_OK) == 0) {
+        if (Player_load(local_path) != 0) {
+            snprintf(error_message, sizeof(error_message), "Failed to load local file");
+            return -1;
+        }
+        apply_speech_playback(feed);
+        return 0;
+    }
+
+    char dir_path[PODCAST_MAX_URL];
+    snprintf(dir_path, sizeof(dir_path), "%s", local_path);
+    char* slash = strrchr(dir_path, '/');
+    if (slash) {
+        *slash = '\0';
+        mkdir(dir_path, 0755);
+    }
+
+    char cache_path[PODCAST_MAX_URL + 16];
+    snprintf(cache_path, sizeof(cache_path), "%s.stream", local_path);
+    if (Player_loadStream(ep->url, cache_path, local_path) != 0) {
+        snprintf(error_message, sizeof(error_message), "Failed to stream episode");
+        return -1;
+    }
+    apply_speech_playback(feed);
+    return 0;
+}
+
 int Podcast_play(PodcastFeed* feed, int episode_index) {
     if (!feed || episode_index < 0 || episode_index >= feed->episode_count) {
         return -1;
@@ -1353,27 +1788,17 @@ int Podcast_play(PodcastFeed* feed, int episode_index) {
         return -1;
     }
 
-    // Check if local file exists
-    char local_path[PODCAST_MAX_URL];
-    Podcast_getEpisodeLocalPath(feed, episode_index, local_path, sizeof(local_path));
-
-    if (access(local_path, F_OK) != 0) {
-        snprintf(error_message, sizeof(error_message), "Episode not downloaded");
-        return -1;  // File doesn't exist - caller should start download
-    }
-
     // Store current feed and episode for later reference
     current_feed = feed;
     current_feed_index = feed_idx;
     current_episode_index = episode_index;
 
-    if (Player_load(local_path) == 0) {
+    if (load_episode(feed, episode_index, ep) == 0) {
         current_episode_duration_sec = ep->duration_sec;
         Player_play();
         return 0;
     }
 
-    snprintf(error_message, sizeof(error_message), "Failed to load local file");
     return -1;
 }
 
@@ -1388,19 +1813,11 @@ int Podcast_loadAndSeek(PodcastFeed* feed, int episode_index) {
     PodcastEpisode* ep = Podcast_getEpisode(feed_idx, episode_index);
     if (!ep) return -1;
 
-    char local_path[PODCAST_MAX_URL];
-    Podcast_getEpisodeLocalPath(feed, episode_index, local_path, sizeof(local_path));
-
-    if (access(local_path, F_OK) != 0) {
-        snprintf(error_message, sizeof(error_message), "Episode not downloaded");
-        return -1;
-    }
-
     current_feed = feed;
     current_feed_index = feed_idx;
     current_episode_index = episode_index;
 
-    if (Player_load(local_path) == 0) {
+    if (load_episode(feed, episode_index, ep) == 0) {
         current_episode_duration_sec = ep->duration_sec;
         if (ep->progress_sec > 0) {
             Player_seek(ep->progress_sec * 1000);
@@ -1409,7 +1826,6 @@ int Podcast_loadAndSeek(PodcastFeed* feed, int episode_index) {
         return ep->progress_sec > 0 ? 1 : 0;  // 1 = seeking, 0 = ready to play
     }
 
-    snprintf(error_message, sizeof(error_message), "Failed to load local file");
     return -1;
 }
 
@@ -1428,6 +1844,10 @@ void Podcast_stop(void) {
 
     Player_stop();
 
+    pthread_mutex_lock(&playing_mutex);
+    playing_path[0] = '\0';
+    pthread_mutex_unlock(&playing_mutex);
+
     current_episode_duration_sec = 0;
     podcast_state = PODCAST_STATE_IDLE;
     current_feed = NULL;
@@ -1444,65 +1864,286 @@ int Podcast_getDuration(void) {
 }
 
 bool Podcast_isActive(void) {
-    // Podcast is active when playing a local file
+    // Podcast is active when playing an episode (local or streamed)
     return current_feed != NULL && Player_getState() != PLAYER_STATE_STOPPED;
 }
 
+int Podcast_getPlaybackSpeed(int feed_index) {
+    PodcastFeed* feed = Podcast_getSubscription(feed_index);
+    return feed ? feed_speed(feed) : 100;
+}
+
+int Podcast_cyclePlaybackSpeed(int feed_index) {
+    PodcastFeed* feed = Podcast_getSubscription(feed_index);
+    if (!feed) return 100;
+
+    static const int speeds[] = PODCAST_SPEEDS;
+    int count = (int)(sizeof(speeds) / sizeof(speeds[0]));
+    int next = speeds[0];
+    for (int i = 0; i < count; i++) {
+        if (speeds[i] > feed_speed(feed)) {
+            next = speeds[i];
+            break;
+        }
+    }
+
+    pthread_mutex_lock(&subscriptions_mutex);
+    feed->playback_speed = next;
+    pthread_mutex_unlock(&subscriptions_mutex);
+    Podcast_saveSubscriptions();
+
+    if (current_feed == feed) apply_speech_playback(feed);
+    return next;
+}
+
+bool Podcast_toggleSkipSilence(int feed_index) {
+    PodcastFeed* feed = Podcast_getSubscription(feed_index);
+    if (!feed) return false;
+
+    pthread_mutex_lock(&subscriptions_mutex);
+    feed->skip_silence = !feed->skip_silence;
+    pthread_mutex_unlock(&subscriptions_mutex);
+    Podcast_saveSubscriptions();
+
+    if (current_feed == feed) apply_speech_playback(feed);
+    return feed->skip_silence;
+}
+
 // ============================================================================
 // Progress Tracking
 // ============================================================================
 
-void Podcast_saveProgress(const char* feed_url, const char* episode_guid, int position_sec) {
-    if (!feed_url || !episode_guid) return;
+// progress.log: ProgressJournalHeader, then one ProgressRecord per saved
+// position. Later records for a key supersede earlier ones; the file is
+// rewritten with only the live entries once superseded ones dominate.
+#define PROGRESS_JOURNAL_MAGIC 0x474f5250  // "PROG"
+#define PROGRESS_JOURNAL_VERSION 1
 
-    // Find existing entry or add new one
-    for (int i = 0; i < progress_entry_count; i++) {
-        if (strcmp(progress_entries[i].feed_url, feed_url) == 0 &&
-            strcmp(progress_entries[i].episode_guid, episode_guid) == 0) {
-            progress_entries[i].position_sec = position_sec;
-            return;
-        }
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+} ProgressJournalHeader;
+
+typedef struct {
+    uint64_t key;
+    int32_t position_sec;
+    uint32_t check;                   // Detects a torn record at the end
+} ProgressRecord;
+
+static uint64_t progress_key(const char* feed_url, const char* episode_guid) {
+    uint64_t hash = 0xcbf29ce484222325ULL;  // FNV-1a over "feed_url\0guid"
+    for (const char* p = feed_url; *p; p++) {
+        hash ^= (unsigned char)*p;
+        hash *= 0x100000001b3ULL;
     }
+    hash *= 0x100000001b3ULL;
+    for (const char* p = episode_guid; *p; p++) {
+        hash ^= (unsigned char)*p;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash ? hash : 1;  // 0 marks an empty slot
+}
 
-    // Add new entry
-    if (progress_entry_count < MAX_PROGRESS_ENTRIES) {
-        strncpy(progress_entries[progress_entry_count].feed_url, feed_url, PODCAST_MAX_URL - 1);
-        strncpy(progress_entries[progress_entry_count].episode_guid, episode_guid, PODCAST_MAX_GUID - 1);
-        progress_entries[progress_entry_count].position_sec = position_sec;
+static uint32_t progress_record_check(const ProgressRecord* rec) {
+    return (uint32_t)(rec->key ^ (rec->key >> 32)) ^ (uint32_t)rec->position_sec ^ 0x9e3779b9u;
+}
+
+// Find the slot for key: its entry, or the empty slot it would go in
+static ProgressEntry* progress_slot(uint64_t key) {
+    uint32_t i = (uint32_t)key & (PROGRESS_TABLE_SIZE - 1);
+    while (progress_table[i].key && progress_table[i].key != key) {
+        i = (i + 1) & (PROGRESS_TABLE_SIZE - 1);
+    }
+    return &progress_table[i];
+}
+
+static void progress_set(uint64_t key, int position_sec, bool dirty) {
+    ProgressEntry* e = progress_slot(key);
+    if (!e->key) {
+        if (progress_entry_count >= MAX_PROGRESS_ENTRIES) return;
+        e->key = key;
         progress_entry_count++;
     }
+    e->position_sec = position_sec;
+    e->dirty = e->dirty || dirty;
 }
 
-int Podcast_getProgress(const char* feed_url, const char* episode_guid) {
-    if (!feed_url || !episode_guid) return 0;
+// Rewrite progress.log with one record per live entry
+static int compact_progress(void) {
+    char tmp_path[520];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", progress_file);
+    FILE* f = fopen(tmp_path, "wb");
+    if (!f) {
+        LOG_error("[Podcast] Failed to write %s\n", tmp_path);
+        return -1;
+    }
 
-    for (int i = 0; i < progress_entry_count; i++) {
-        if (strcmp(progress_entries[i].feed_url, feed_url) == 0 &&
-            strcmp(progress_entries[i].episode_guid, episode_guid) == 0) {
-            return progress_entries[i].position_sec;
-        }
+    ProgressJournalHeader header = {PROGRESS_JOURNAL_MAGIC, PROGRESS_JOURNAL_VERSION};
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    for (int i = 0; i < PROGRESS_TABLE_SIZE && ok; i++) {
+        if (!progress_table[i].key) continue;
+        ProgressRecord rec = {progress_table[i].key, progress_table[i].position_sec, 0};
+        rec.check = progress_record_check(&rec);
+        ok = fwrite(&rec, sizeof(rec), 1, f) == 1;
+    }
+    ok = (fclose(f) == 0) && ok;
+
+    if (!ok || rename(tmp_path, progress_file) != 0) {
+        LOG_error("[Podcast] Failed to save progress to %s\n", progress_file);
+        unlink(tmp_path);
+        return -1;
     }
+
+    for (int i = 0; i < PROGRESS_TABLE_SIZE; i++) {
+        progress_table[i].dirty = false;
+    }
+    progress_journal_records = progress_entry_count;
     return 0;
 }
 
+// Import the progress.json written by earlier versions, once
+static void migrate_progress_json(void) {
+    char json_path[512];
+    snprintf(json_path, sizeof(json_path), "%s/progress.json", podcast_data_dir);
+
+    JSON_Value* root = json_parse_file(json_path);
+    if (!root) return;
+
+    JSON_Array* arr = json_value_get_array(root);
+    int count = arr ? (int)json_array_get_count(arr) : 0;
+    for (int i = 0; i < count; i++) {
+        JSON_Object* obj = json_array_get_object(arr, i);
+        if (obj) {
+            const char* feed = json_object_get_string(obj, "feed_url");
+            const char* guid = json_object_get_string(obj, "guid");
+            int pos = (int)json_object_get_number(obj, "position");
+            if (feed && guid) {
+                progress_set(progress_key(feed, guid), pos, false);
+            }
+        }
+    }
+    json_value_free(root);
+
+    if (compact_progress() == 0) {
+        unlink(json_path);
+    }
+}
+
+// Replay progress.log into the table
+static void load_progress(void) {
+    pthread_mutex_lock(&progress_mutex);
+    memset(progress_table, 0, sizeof(progress_table));
+    progress_entry_count = 0;
+    progress_journal_records = 0;
+
+    int fd = open(progress_file, O_RDWR);
+    if (fd < 0) {
+        migrate_progress_json();
+        pthread_mutex_unlock(&progress_mutex);
+        return;
+    }
+
+    ProgressJournalHeader header;
+    if (read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header) ||
+        header.magic != PROGRESS_JOURNAL_MAGIC || header.version != PROGRESS_JOURNAL_VERSION) {
+        LOG_error("[Podcast] Ignoring invalid progress journal %s\n", progress_file);
+        close(fd);
+        compact_progress();
+        pthread_mutex_unlock(&progress_mutex);
+        return;
+    }
+
+    off_t valid_end = sizeof(header);
+    ProgressRecord recs[64];
+    ssize_t got;
+    bool torn = false;
+    while (!torn && (got = read(fd, recs, sizeof(recs))) > 0) {
+        int n = (int)(got / sizeof(ProgressRecord));
+        for (int i = 0; i < n; i++) {
+            if (recs[i].check != progress_record_check(&recs[i])) {
+                torn = true;
+                break;
+            }
+            progress_set(recs[i].key, recs[i].position_sec, false);
+            progress_journal_records++;
+            valid_end += sizeof(ProgressRecord);
+        }
+        if (got % sizeof(ProgressRecord)) torn = true;
+    }
+
+    // Drop a record cut short by power loss so appends stay aligned
+    if (torn) {
+        if (ftruncate(fd, valid_end) != 0) {
+            LOG_error("[Podcast] Failed to repair %s\n", progress_file);
+        }
+    }
+    close(fd);
+    pthread_mutex_unlock(&progress_mutex);
+}
+
+void Podcast_saveProgress(const char* feed_url, const char* episode_guid, int position_sec) {
+    if (!feed_url || !episode_guid) return;
+
+    pthread_mutex_lock(&progress_mutex);
+    progress_set(progress_key(feed_url, episode_guid), position_sec, true);
+    pthread_mutex_unlock(&progress_mutex);
+}
+
+int Podcast_getProgress(const char* feed_url, const char* episode_guid) {
+    if (!feed_url || !episode_guid) return 0;
+
+    pthread_mutex_lock(&progress_mutex);
+    ProgressEntry* e = progress_slot(progress_key(feed_url, episode_guid));
+    int position_sec = e->key ? e->position_sec : 0;
+    pthread_mutex_unlock(&progress_mutex);
+    return position_sec;
+}
+
 void Podcast_markAsPlayed(const char* feed_url, const char* episode_guid) {
     // Mark as played by setting progress to -1 (special value)
     Podcast_saveProgress(feed_url, episode_guid, -1);
 }
 
+// Call with progress_mutex held
+static void flush_progress_locked(void) {
+    ProgressRecord recs[MAX_PROGRESS_ENTRIES];
+    int n = 0;
+    for (int i = 0; i < PROGRESS_TABLE_SIZE; i++) {
+        if (!progress_table[i].dirty) continue;
+        recs[n].key = progress_table[i].key;
+        recs[n].position_sec = progress_table[i].position_sec;
+        recs[n].check = progress_record_check(&recs[n]);
+        n++;
+    }
+    if (n == 0) return;
+
+    // Compact once superseded records outnumber live ones
+    if (progress_journal_records + n > 2 * progress_entry_count + 64 ||
+        access(progress_file, F_OK) != 0) {
+        compact_progress();
+        return;
+    }
+
+    // Usual case: a few records appended to the journal
+    int fd = open(progress_file, O_WRONLY | O_APPEND);
+    ssize_t len = (ssize_t)n * sizeof(ProgressRecord);
+    if (fd < 0 || write(fd, recs, len) != len) {
+        if (fd >= 0) close(fd);
+        compact_progress();
+        return;
+    }
+    close(fd);
+
+    for (int i = 0; i < PROGRESS_TABLE_SIZE; i++) {
+        progress_table[i].dirty = false;
+    }
+    progress_journal_records += n;
+}
+
 void Podcast_flushProgress(void) {
-    JSON_Value* root = json_value_init_array();
-    JSON_Array* arr = json_value_get_array(root);
-    for (int i = 0; i < progress_entry_count; i++) {
-        JSON_Value* item = json_value_init_object();
-        JSON_Object* obj = json_value_get_object(item);
-        json_object_set_string(obj, "feed_url", progress_entries[i].feed_url);
-        json_object_set_string(obj, "guid", progress_entries[i].episode_guid);
-        json_object_set_number(obj, "position", progress_entries[i].position_sec);
-        json_array_append_value(arr, item);
-    }
-    json_serialize_to_file_pretty(root, progress_file);
-    json_value_free(root);
+    pthread_mutex_lock(&progress_mutex);
+    flush_progress_locked();
+    pthread_mutex_unlock(&progress_mutex);
 }
 
 // Helper to sanitize string for filesystem (removes problematic chars)
@@ -1516,6 +2157,21 @@ static void sanitize_for_filename(char* str) {
 }
 
 // Generate local file path for an episode
+// <download_dir>/<feed title>/<episode title>.mp3
+static void episode_local_path(const PodcastFeed* feed, const PodcastEpisode* ep, char* buf, int buf_size) {
+    char safe_title[256];
+    strncpy(safe_title, ep->title, sizeof(safe_title) - 1);
+    safe_title[sizeof(safe_title) - 1] = '\0';
+    sanitize_for_filename(safe_title);
+
+    char safe_feed[256];
+    strncpy(safe_feed, feed->title, sizeof(safe_feed) - 1);
+    safe_feed[sizeof(safe_feed) - 1] = '\0';
+    sanitize_for_filename(safe_feed);
+
+    snprintf(buf, buf_size, "%s/%s/%s.mp3", download_dir, safe_feed, safe_title);
+}
+
 void Podcast_getEpisodeLocalPath(PodcastFeed* feed, int episode_index, char* buf, int buf_size) {
     if (!feed || episode_index < 0 || episode_index >= feed->episode_count || !buf) {
         if (buf && buf_size > 0) buf[0] = '\0';
@@ -1529,17 +2185,7 @@ void Podcast_getEpisodeLocalPath(PodcastFeed* feed, int episode_index, char* buf
         return;
     }
 
-    char safe_title[256];
-    strncpy(safe_title, ep->title, sizeof(safe_title) - 1);
-    safe_title[sizeof(safe_title) - 1] = '\0';
-    sanitize_for_filename(safe_title);
-
-    char safe_feed[256];
-    strncpy(safe_feed, feed->title, sizeof(safe_feed) - 1);
-    safe_feed[sizeof(safe_feed) - 1] = '\0';
-    sanitize_for_filename(safe_feed);
-
-    snprintf(buf, buf_size, "%s/%s/%s.mp3", download_dir, safe_feed, safe_title);
+    episode_local_path(feed, ep, buf, buf_size);
 }
 
 // Check if episode file exists locally
@@ -1550,6 +2196,24 @@ bool Podcast_episodeFileExists(PodcastFeed* feed, int episode_index) {
     return access(local_path, F_OK) == 0;
 }
 
+// Index of the queued item with this guid, -1 if none. Call with download_mutex held
+static int find_download_locked(const char* guid) {
+    for (int i = 0; i < download_queue_count; i++) {
+        if (strcmp(download_queue[i].episode_guid, guid) == 0) return i;
+    }
+    return -1;
+}
+
+// Stop the worker downloading this episode, leaving the others running.
+// Call with download_mutex held
+static void stop_download_locked(const char* guid) {
+    for (int i = 0; i < PODCAST_DOWNLOAD_WORKERS; i++) {
+        if (download_workers[i].guid[0] && strcmp(download_workers[i].guid, guid) == 0) {
+            download_workers[i].stop = true;
+        }
+    }
+}
+
 // Get download status for a specific episode
 int Podcast_getEpisodeDownloadStatus(const char* feed_url, const char* episode_guid, int* progress_out) {
     if (!feed_url || !episode_guid) return -1;
@@ -1581,9 +2245,12 @@ int Podcast_cancelEpisodeDownload(const char* feed_url, const char* episode_guid
     for (int i = 0; i < download_queue_count; i++) {
         if (strcmp(download_queue[i].feed_url, feed_url) == 0 &&
             strcmp(download_queue[i].episode_guid, episode_guid) == 0) {
-            // If currently downloading, signal stop
+            // If currently downloading, stop its worker (which then discards
+            // the partial file); otherwise discard it here
             if (download_queue[i].status == PODCAST_DOWNLOAD_DOWNLOADING) {
-                download_should_stop = true;
+                stop_download_locked(episode_guid);
+            } else {
+                http_download_discard(download_queue[i].local_path);
             }
             // Remove from queue by shifting
             for (int j = i; j < download_queue_count - 1; j++) {
@@ -1599,73 +2266,103 @@ int Podcast_cancelEpisodeDownload(const char* feed_url, const char* episode_guid
     return -1;  // Not found
 }
 
-int Podcast_queueDownload(PodcastFeed* feed, int episode_index) {
-    if (!feed || episode_index < 0 || episode_index >= feed->episode_count) {
-        return -1;
-    }
-    if (download_queue_count >= PODCAST_MAX_DOWNLOAD_QUEUE) {
-        return -1;
-    }
+// Size guess until the server reports the length
+static long long estimate_episode_bytes(const PodcastEpisode* ep) {
+    int duration = ep->duration_sec > 0 ? ep->duration_sec : 3600;
+    return (long long)duration * PODCAST_AUTO_BYTES_PER_SEC;
+}
 
-    int feed_idx = get_feed_index(feed);
-    PodcastEpisode* ep = (feed_idx >= 0) ? Podcast_getEpisode(feed_idx, episode_index) : NULL;
-    if (!ep) {
-        return -1;
-    }
+// Queue an episode read by the caller (feed may be a copy of the subscription)
+static int queue_episode_download(const PodcastFeed* feed, const PodcastEpisode* ep,
+                                  PodcastDownloadPriority priority) {
+    PodcastDownloadItem new_item;
+    memset(&new_item, 0, sizeof(PodcastDownloadItem));
+    strncpy(new_item.feed_title, feed->title, PODCAST_MAX_TITLE - 1);
+    strncpy(new_item.feed_url, feed->feed_url, PODCAST_MAX_URL - 1);
+    strncpy(new_item.episode_title, ep->title, PODCAST_MAX_TITLE - 1);
+    strncpy(new_item.episode_guid, ep->guid, PODCAST_MAX_GUID - 1);
+    strncpy(new_item.url, ep->url, PODCAST_MAX_URL - 1);
+
+    // Generate local path
+    episode_local_path(feed, ep, new_item.local_path, sizeof(new_item.local_path));
+
+    new_item.status = PODCAST_DOWNLOAD_PENDING;
+    new_item.priority = priority;
+    new_item.progress_percent = 0;
+    new_item.expected_bytes = estimate_episode_bytes(ep);
 
     // Check if already in download queue (only block if PENDING or DOWNLOADING)
     pthread_mutex_lock(&download_mutex);
-    for (int i = 0; i < download_queue_count; i++) {
-        if (strcmp(download_queue[i].episode_guid, ep->guid) == 0) {
-            if (download_queue[i].status == PODCAST_DOWNLOAD_PENDING ||
-                download_queue[i].status == PODCAST_DOWNLOAD_DOWNLOADING) {
-                pthread_mutex_unlock(&download_mutex);
-                return 0;  // Already queued and active
-            }
-            // Remove completed/failed item to allow re-download
-            for (int j = i; j < download_queue_count - 1; j++) {
-                memcpy(&download_queue[j], &download_queue[j + 1], sizeof(PodcastDownloadItem));
-            }
-            download_queue_count--;
-            break;
+    int existing = find_download_locked(ep->guid);
+    if (existing >= 0) {
+        PodcastDownloadItem* item = &download_queue[existing];
+        if (item->status == PODCAST_DOWNLOAD_PENDING ||
+            item->status == PODCAST_DOWNLOAD_DOWNLOADING) {
+            pthread_mutex_unlock(&download_mutex);
+            return 0;  // Already queued and active
+        }
+        // Remove completed/failed item to allow re-download
+        for (int j = existing; j < download_queue_count - 1; j++) {
+            memcpy(&download_queue[j], &download_queue[j + 1], sizeof(PodcastDownloadItem));
         }
+        download_queue_count--;
     }
 
-    PodcastDownloadItem* item = &download_queue[download_queue_count];
-    memset(item, 0, sizeof(PodcastDownloadItem));
-
-    strncpy(item->feed_title, feed->title, PODCAST_MAX_TITLE - 1);
-    strncpy(item->feed_url, feed->feed_url, PODCAST_MAX_URL - 1);
-    strncpy(item->episode_title, ep->title, PODCAST_MAX_TITLE - 1);
-    strncpy(item->episode_guid, ep->guid, PODCAST_MAX_GUID - 1);
-    strncpy(item->url, ep->url, PODCAST_MAX_URL - 1);
-
-    // Generate local path
-    Podcast_getEpisodeLocalPath(feed, episode_index, item->local_path, sizeof(item->local_path));
+    if (download_queue_count >= PODCAST_MAX_DOWNLOAD_QUEUE) {
+        pthread_mutex_unlock(&download_mutex);
+        return -1;
+    }
 
-    item->status = PODCAST_DOWNLOAD_PENDING;
-    item->progress_percent = 0;
+    // Behind everything of the same or higher priority
+    int pos = download_queue_count;
+    while (pos > 0 && download_queue[pos - 1].priority < priority) pos--;
+    memmove(&download_queue[pos + 1], &download_queue[pos],
+            (download_queue_count - pos) * sizeof(PodcastDownloadItem));
+    download_queue[pos] = new_item;
     download_queue_count++;
 
+    // A finishing download thread clears download_running under this lock
+    // once nothing is pending, so the item is either seen by it or started here
+    bool start = !download_running;
     pthread_mutex_unlock(&download_mutex);
 
     Podcast_saveDownloadQueue();
 
     // Auto-start downloads if not already running
-    if (!download_running) {
+    if (start) {
         Podcast_startDownloads();
     }
 
     return 0;
 }
 
+static int queue_download(PodcastFeed* feed, int episode_index, PodcastDownloadPriority priority) {
+    if (!feed || episode_index < 0 || episode_index >= feed->episode_count) {
+        return -1;
+    }
+
+    int feed_idx = get_feed_index(feed);
+    PodcastEpisode* ep = (feed_idx >= 0) ? Podcast_getEpisode(feed_idx, episode_index) : NULL;
+    if (!ep) {
+        return -1;
+    }
+
+    return queue_episode_download(feed, ep, priority);
+}
+
+int Podcast_queueDownload(PodcastFeed* feed, int episode_index) {
+    return queue_download(feed, episode_index, PODCAST_DOWNLOAD_PRIORITY_USER);
+}
+
 PodcastDownloadItem* Podcast_getDownloadQueue(int* count) {
     if (count) *count = download_queue_count;
     return download_queue;
 }
 
 static int Podcast_startDownloads(void) {
+    pthread_mutex_lock(&download_mutex);
     if (download_running || download_queue_count == 0) {
+        pthread_mutex_unlock(&download_mutex);
         return -1;
     }
 
@@ -1674,6 +2371,7 @@ static int Podcast_startDownloads(void) {
 
     download_should_stop = false;
     download_running = true;
+    pthread_mutex_unlock(&download_mutex);
 
     if (pthread_create(&download_thread, NULL, download_thread_func, NULL) != 0) {
         LOG_error("[Podcast] Failed to create download thread\n");
@@ -1686,97 +2384,255 @@ static int Podcast_startDownloads(void) {
     return 0;
 }
 
+// Downloads share the link with anything being streamed; a playing stream
+// (radio, or an episode not downloaded yet) gets it nearly to itself
+static void update_download_rate(void) {
+    bool streaming = Radio_isActive() || Player_isNetworkStream();
+    http_download_set_rate_limit(streaming ? PODCAST_DOWNLOAD_STREAMING_RATE : PODCAST_DOWNLOAD_RATE_LIMIT);
+}
 
-static void* download_thread_func(void* arg) {
-    (void)arg;
+// Workers reconnect one at a time
+static bool download_network_ready(void) {
+    pthread_mutex_lock(&download_network_mutex);
+    bool connected = Wifi_ensureConnected(NULL, 0);
+    pthread_mutex_unlock(&download_network_mutex);
+    return connected;
+}
 
-    for (int i = 0; i < download_queue_count && !download_should_stop; i++) {
-        PodcastDownloadItem* item = &download_queue[i];
+static void* download_worker_func(void* arg) {
+    DownloadWorker* w = (DownloadWorker*)arg;
+    // Checked before the first download and after a failed one, not per episode
+    bool check_network = true;
 
-        if (item->status != PODCAST_DOWNLOAD_PENDING) {
-            continue;
+    while (!download_should_stop) {
+        char url[PODCAST_MAX_URL];
+        char local_path[PODCAST_MAX_URL];
+        char safe_feed[256];
+        char title[PODCAST_MAX_TITLE];
+
+        // The queue is in priority order: take the first pending item
+        pthread_mutex_lock(&download_mutex);
+        PodcastDownloadItem* item = NULL;
+        for (int i = 0; i < download_queue_count; i++) {
+            if (download_queue[i].status == PODCAST_DOWNLOAD_PENDING) {
+                item = &download_queue[i];
+                download_progress.current_index = i;
+                break;
+            }
+        }
+        if (!item) {
+            pthread_mutex_unlock(&download_mutex);
+            break;
+        }
+
+        // Auto items hold their size against the run budget while they download;
+        // one that no longer fits is dropped (the next run may pick it again)
+        w->budgeted = 0;
+        if (item->priority == PODCAST_DOWNLOAD_PRIORITY_AUTO) {
+            if (item->expected_bytes > auto_budget_left) {
+                LOG_info("[Podcast] Auto-download: run budget used, dropping %s\n", item->episode_title);
+                http_download_discard(item->local_path);
+                int index = (int)(item - download_queue);
+                memmove(&download_queue[index], &download_queue[index + 1],
+                        (download_queue_count - index - 1) * sizeof(PodcastDownloadItem));
+                download_queue_count--;
+                pthread_mutex_unlock(&download_mutex);
+                continue;
+            }
+            w->budgeted = item->expected_bytes;
+            auto_budget_left -= w->budgeted;
         }
 
-        // Ensure WiFi is connected before each download
-        if (!Wifi_ensureConnected(NULL, 0)) {
-            LOG_error("[Podcast] No network connection, skipping download: %s\n", item->episode_title);
-            item->status = PODCAST_DOWNLOAD_FAILED;
+        item->status = PODCAST_DOWNLOAD_DOWNLOADING;
+        item->progress_percent = 0;
+        snprintf(url, sizeof(url), "%s", item->url);
+        snprintf(local_path, sizeof(local_path), "%s", item->local_path);
+        snprintf(safe_feed, sizeof(safe_feed), "%s", item->feed_title);
+        snprintf(title, sizeof(title), "%s", item->episode_title);
+        snprintf(download_progress.current_title, sizeof(download_progress.current_title), "%s", title);
+
+        // Cancelling shifts the queue, so the item is found again by guid
+        snprintf(w->guid, sizeof(w->guid), "%s", item->episode_guid);
+        w->progress.percent = 0;
+        w->stop = download_should_stop;
+        pthread_mutex_unlock(&download_mutex);
+
+        if (check_network && !download_network_ready()) {
+            LOG_error("[Podcast] No network connection, skipping download: %s\n", title);
+            pthread_mutex_lock(&download_mutex);
+            int index = find_download_locked(w->guid);
+            if (index >= 0) download_queue[index].status = PODCAST_DOWNLOAD_FAILED;
             download_progress.failed_count++;
             snprintf(download_progress.error_message, sizeof(download_progress.error_message),
                      "No network connection");
+            w->guid[0] = '\0';
+            pthread_mutex_unlock(&download_mutex);
             continue;
         }
-
-        download_progress.current_index = i;
-        strncpy(download_progress.current_title, item->episode_title, PODCAST_MAX_TITLE - 1);
-        item->status = PODCAST_DOWNLOAD_DOWNLOADING;
-        item->progress_percent = 0;
+        check_network = false;
 
         // Create directory for podcast (sanitize feed title for directory name)
-        char safe_feed[256];
-        strncpy(safe_feed, item->feed_title, sizeof(safe_feed) - 1);
-        safe_feed[sizeof(safe_feed) - 1] = '\0';
         sanitize_for_filename(safe_feed);
 
         char dir_path[512];
         snprintf(dir_path, sizeof(dir_path), "%s/%s", download_dir, safe_feed);
         mkdir(dir_path, 0755);
 
-
-        // Use HTTP download module that writes directly to file with progress tracking
-        int bytes = wget_download_file(item->url, item->local_path,
-                                       &item->progress_percent,
-                                       &download_should_stop);
-
-        if (download_should_stop) {
-            // Remove partial file if cancelled
-            unlink(item->local_path);
-            break;
+        // Use HTTP download module that writes directly to file with progress tracking.
+        // An earlier interrupted attempt (e.g. before an app restart) is resumed
+        int bytes = http_download_file(url, local_path, &w->progress, &w->stop);
+
+        pthread_mutex_lock(&download_mutex);
+        int index = find_download_locked(w->guid);
+        w->guid[0] = '\0';
+        // Only a finished download spends its share of the run budget
+        if (bytes <= 0 || w->stop) auto_budget_left += w->budgeted;
+        w->budgeted = 0;
+        if (w->stop) {
+            // Stopped: the partial file is kept for resuming, unless this
+            // episode was cancelled (removed from the queue)
+            pthread_mutex_unlock(&download_mutex);
+            if (index < 0) {
+                http_download_discard(local_path);
+            }
+            continue;
         }
 
         if (bytes > 0) {
-            item->status = PODCAST_DOWNLOAD_COMPLETE;
-            item->progress_percent = 100;
+            if (index >= 0) {
+                download_queue[index].status = PODCAST_DOWNLOAD_COMPLETE;
+                download_queue[index].progress_percent = 100;
+                download_queue[index].expected_bytes = bytes;
+            }
             download_progress.completed_count++;
         } else {
-            item->status = PODCAST_DOWNLOAD_FAILED;
+            if (index >= 0) download_queue[index].status = PODCAST_DOWNLOAD_FAILED;
             download_progress.failed_count++;
-            // Remove partial file on failure
-            unlink(item->local_path);
-            LOG_error("[Podcast] Failed to download: %s\n", item->url);
+            check_network = true;
+            // A partial file from a lost connection stays, so downloading
+            // the episode again continues where this attempt stopped
+            LOG_error("[Podcast] Failed to download: %s\n", url);
         }
+        pthread_mutex_unlock(&download_mutex);
     }
 
-    // Remove completed and failed items from queue, keep pending and interrupted
     pthread_mutex_lock(&download_mutex);
-    int write_idx = 0;
-    for (int i = 0; i < download_queue_count; i++) {
-        if (download_queue[i].status == PODCAST_DOWNLOAD_PENDING ||
-            download_queue[i].status == PODCAST_DOWNLOAD_DOWNLOADING) {
-            // Reset interrupted downloads to pending
-            if (download_queue[i].status == PODCAST_DOWNLOAD_DOWNLOADING) {
-                download_queue[i].status = PODCAST_DOWNLOAD_PENDING;
-                download_queue[i].progress_percent = 0;
+    download_workers_active--;
+    pthread_mutex_unlock(&download_mutex);
+    return NULL;
+}
+
+// Runs the download workers and, while they work, copies each one's
+// progress into its queue item and adjusts the shared bandwidth cap
+static void* download_thread_func(void* arg) {
+    (void)arg;
+
+    for (;;) {
+        update_download_rate();
+
+        pthread_mutex_lock(&download_mutex);
+        int pending = 0;
+        for (int i = 0; i < download_queue_count; i++) {
+            if (download_queue[i].status == PODCAST_DOWNLOAD_PENDING) pending++;
+        }
+        int started = 0;
+        for (int i = 0; i < PODCAST_DOWNLOAD_WORKERS && started < pending && !download_should_stop; i++) {
+            DownloadWorker* w = &download_workers[i];
+            w->guid[0] = '\0';
+            w->stop = false;
+            if (pthread_create(&w->thread, NULL, download_worker_func, w) != 0) break;
+            started++;
+        }
+        download_workers_active = started;
+        pthread_mutex_unlock(&download_mutex);
+
+        if (started == 0 && pending > 0 && !download_should_stop) {
+            LOG_error("[Podcast] Failed to create download workers\n");
+        }
+
+        bool active = started > 0;
+        while (active) {
+            usleep(250000);  // 250ms
+            update_download_rate();
+
+            pthread_mutex_lock(&download_mutex);
+            for (int i = 0; i < started; i++) {
+                DownloadWorker* w = &download_workers[i];
+                int index = w->guid[0] ? find_download_locked(w->guid) : -1;
+                if (index < 0 || download_queue[index].status != PODCAST_DOWNLOAD_DOWNLOADING) continue;
+                PodcastDownloadItem* item = &download_queue[index];
+                item->progress_percent = w->progress.percent;
+
+                // The real length replaces the estimate, in the run budget too
+                long long total = w->progress.total;
+                if (total <= 0 || total == item->expected_bytes) continue;
+                item->expected_bytes = total;
+                if (w->budgeted == 0) continue;
+                auto_budget_left -= total - w->budgeted;
+                w->budgeted = total;
+                if (auto_budget_left >= 0) continue;
+
+                // Larger than estimated and past the budget: dropped like a
+                // cancel, so the worker discards the partial file
+                LOG_info("[Podcast] Auto-download: %s exceeds the run budget, dropping\n", item->episode_title);
+                w->stop = true;
+                memmove(&download_queue[index], &download_queue[index + 1],
+                        (download_queue_count - index - 1) * sizeof(PodcastDownloadItem));
+                download_queue_count--;
             }
-            if (write_idx != i) {
-                memcpy(&download_queue[write_idx], &download_queue[i], sizeof(PodcastDownloadItem));
+            active = download_workers_active > 0;
+            pthread_mutex_unlock(&download_mutex);
+        }
+        for (int i = 0; i < started; i++) {
+            pthread_join(download_workers[i].thread, NULL);
+        }
+
+        // Remove completed and failed items from queue, keep pending and interrupted
+        pthread_mutex_lock(&download_mutex);
+        int write_idx = 0;
+        bool more = false;
+        for (int i = 0; i < download_queue_count; i++) {
+            if (download_queue[i].status == PODCAST_DOWNLOAD_PENDING ||
+                download_queue[i].status == PODCAST_DOWNLOAD_DOWNLOADING) {
+                // Reset interrupted downloads to pending
+                if (download_queue[i].status == PODCAST_DOWNLOAD_DOWNLOADING) {
+                    download_queue[i].status = PODCAST_DOWNLOAD_PENDING;
+                    download_queue[i].progress_percent = 0;
+                }
+                if (write_idx != i) {
+                    memcpy(&download_queue[write_idx], &download_queue[i], sizeof(PodcastDownloadItem));
+                }
+                write_idx++;
+                more = true;
             }
-            write_idx++;
+            // COMPLETE and FAILED items are removed (not copied)
+        }
+        download_queue_count = write_idx;
+
+        // Items queued while the last workers were finishing get a new round
+        bool again = more && started > 0 && !download_should_stop;
+        if (!again) {
+            download_running = false;
         }
-        // COMPLETE and FAILED items are removed (not copied)
+        pthread_mutex_unlock(&download_mutex);
+
+        Podcast_saveDownloadQueue();
+        if (!again) break;
     }
-    download_queue_count = write_idx;
-    pthread_mutex_unlock(&download_mutex);
 
-    download_running = false;
+    http_download_set_rate_limit(0);
     podcast_state = PODCAST_STATE_IDLE;
-    Podcast_saveDownloadQueue();
     return NULL;
 }
 
 void Podcast_stopDownloads(void) {
     if (download_running) {
+        pthread_mutex_lock(&download_mutex);
         download_should_stop = true;
+        for (int i = 0; i < PODCAST_DOWNLOAD_WORKERS; i++) {
+            download_workers[i].stop = true;
+        }
+        pthread_mutex_unlock(&download_mutex);
         for (int i = 0; i < 20 && download_running; i++) {
             usleep(100000);  // 100ms, wait up to 2 seconds
         }
@@ -1814,7 +2670,9 @@ void Podcast_saveDownloadQueue(void) {
         json_object_set_string(obj, "url", item->url);
         json_object_set_string(obj, "local_path", item->local_path);
         json_object_set_number(obj, "status", item->status);
+        json_object_set_number(obj, "priority", item->priority);
         json_object_set_number(obj, "progress", item->progress_percent);
+        json_object_set_number(obj, "expected_bytes", (double)item->expected_bytes);
 
         json_array_append_value(arr, val);
     }
@@ -1861,6 +2719,11 @@ void Podcast_loadDownloadQueue(void) {
 
         item->status = (PodcastDownloadStatus)(int)json_object_get_number(obj, "status");
         item->progress_percent = (int)json_object_get_number(obj, "progress");
+        // Queues saved before priorities only held user-started downloads
+        item->priority = json_object_has_value(obj, "priority")
+                             ? (PodcastDownloadPriority)(int)json_object_get_number(obj, "priority")
+                             : PODCAST_DOWNLOAD_PRIORITY_USER;
+        item->expected_bytes = (long long)json_object_get_number(obj, "expected_bytes");
 
         // Reset downloading status to pending
         if (item->status == PODCAST_DOWNLOAD_DOWNLOADING) {
@@ -1928,20 +2791,100 @@ int Podcast_getDownloadedEpisodeIndex(int feed_index, int episode_index) {
 // Background Feed Refresh
 // ============================================================================
 
+// Host part of a URL, for the per-host limit
+static void url_host(const char* url, char* host, int host_size) {
+    const char* p = strstr(url, "://");
+    p = p ? p + 3 : url;
+    int len = (int)strcspn(p, "/?#");
+    if (len >= host_size) len = host_size - 1;
+    memcpy(host, p, len);
+    host[len] = '\0';
+}
+
+// Take the next feed whose host is below REFRESH_PER_HOST, waiting while
+// every remaining feed is on a busy host. NULL once all are taken.
+static RefreshJob* take_refresh_job(void) {
+    pthread_mutex_lock(&refresh_mutex);
+    for (;;) {
+        bool any_left = false;
+        for (int i = 0; i < refresh_job_count; i++) {
+            RefreshJob* job = &refresh_jobs[i];
+            if (job->taken) continue;
+            any_left = true;
+
+            int active = 0;
+            for (int j = 0; j < refresh_job_count; j++) {
+                if (refresh_jobs[j].taken && !refresh_jobs[j].done &&
+                    strcmp(refresh_jobs[j].host, job->host) == 0) {
+                    active++;
+                }
+            }
+            if (active < REFRESH_PER_HOST) {
+                job->taken = true;
+                pthread_mutex_unlock(&refresh_mutex);
+                return job;
+            }
+        }
+        if (!any_left) break;
+        pthread_cond_wait(&refresh_cond, &refresh_mutex);
+    }
+    pthread_mutex_unlock(&refresh_mutex);
+    return NULL;
+}
+
+static void* refresh_worker_func(void* arg) {
+    (void)arg;
+
+    RefreshJob* job;
+    while ((job = take_refresh_job()) != NULL) {
+        refresh_feed(job->feed_url, false, REFRESH_FEED_TIMEOUT_MS);
+
+        pthread_mutex_lock(&refresh_mutex);
+        job->done = true;
+        pthread_cond_broadcast(&refresh_cond);
+        pthread_mutex_unlock(&refresh_mutex);
+
+        refresh_feed_done = true;  // Let the UI show this feed's result now
+    }
+    return NULL;
+}
+
 static void* refresh_thread_func(void* arg) {
     (void)arg;
 
     if (refresh_feed_index >= 0) {
         // Refresh single feed
-        Podcast_refreshFeed(refresh_feed_index);
+        refresh_feed_at(refresh_feed_index, refresh_full);
     } else {
-        // Refresh all feeds - snapshot count to avoid race with unsubscribe
+        // Refresh all feeds: list them under the lock, then let a few
+        // workers take them in turn
         pthread_mutex_lock(&subscriptions_mutex);
-        int count = subscription_count;
+        refresh_job_count = 0;
+        for (int i = 0; i < subscription_count; i++) {
+            RefreshJob* job = &refresh_jobs[refresh_job_count++];
+            memset(job, 0, sizeof(RefreshJob));
+            strcpy(job->feed_url, subscriptions[i].feed_url);
+            url_host(job->feed_url, job->host, sizeof(job->host));
+        }
         pthread_mutex_unlock(&subscriptions_mutex);
-        for (int i = 0; i < count && i < subscription_count; i++) {
-            if (!refresh_running) break;
-            Podcast_refreshFeed(i);
+
+        int worker_count = PODCAST_REFRESH_WORKERS;
+        if (worker_count < 2) worker_count = 2;
+        if (worker_count > 4) worker_count = 4;
+        if (worker_count > refresh_job_count) worker_count = refresh_job_count;
+
+        pthread_t workers[4];
+        int started = 0;
+        for (int i = 0; i < worker_count; i++) {
+            if (pthread_create(&workers[started], NULL, refresh_worker_func, NULL) == 0) {
+                started++;
+            }
+        }
+        if (started == 0) {
+            refresh_worker_func(NULL);  // No threads available: refresh them here
+        }
+        for (int i = 0; i < started; i++) {
+            pthread_join(workers[i], NULL);
         }
     }
 
@@ -1977,11 +2920,12 @@ int Podcast_startRefreshAll(void) {
     return 0;
 }
 
-int Podcast_startRefreshFeed(int index) {
+static int start_refresh_feed(int index, bool full) {
     if (refresh_running) return -1;
     if (index < 0 || index >= subscription_count) return -1;
 
     refresh_feed_index = index;
+    refresh_full = full;
     refresh_completed = false;
     refresh_running = true;
 
@@ -1993,10 +2937,26 @@ int Podcast_startRefreshFeed(int index) {
     return 0;
 }
 
+int Podcast_startRefreshFeed(int index) {
+    return start_refresh_feed(index, false);
+}
+
+int Podcast_startResyncFeed(int index) {
+    return start_refresh_feed(index, true);
+}
+
 bool Podcast_isRefreshing(void) {
     return refresh_running;
 }
 
+bool Podcast_checkFeedRefreshed(void) {
+    if (refresh_feed_done) {
+        refresh_feed_done = false;
+        return true;
+    }
+    return false;
+}
+
 bool Podcast_checkRefreshCompleted(void) {
     if (refresh_completed) {
         refresh_completed = false;
@@ -2022,32 +2982,329 @@ void Podcast_clearNewFlag(int feed_index, int episode_index) {
     pthread_mutex_unlock(&episode_cache_mutex);
 
     PodcastFeed* feed = &subscriptions[feed_index];
+    pthread_mutex_lock(&subscriptions_mutex);
     if (feed->new_episode_count > 0) {
         feed->new_episode_count--;
     }
+    pthread_mutex_unlock(&subscriptions_mutex);
 
-    // Update the on-disk episodes.json
+    // Update the record in the episode store
     set_feed_id(feed);
     char episodes_path[512];
     get_episodes_file_path(feed->feed_id, episodes_path, sizeof(episodes_path));
+    podcast_store_set_new(episodes_path, episode_index, guid_copy, false);
+}
+
+// ============================================================================
+// Scheduled Auto-Download
+// ============================================================================
+
+// A downloaded episode the quota may delete
+typedef struct {
+    char path[PODCAST_MAX_URL];
+    long long size;
+    time_t used;                         // Last access, oldest deleted first
+} AutoPlayedFile;
+
+// An episode picked for download
+typedef struct {
+    int feed;                            // Index into the run's feed snapshot
+    PodcastEpisode episode;
+    long long size;                      // Estimated from the duration
+} AutoCandidate;
+
+static void load_auto_download_state(void) {
+    JSON_Value* root = json_parse_file(autodownload_file);
+    if (!root) return;
+    JSON_Object* obj = json_value_get_object(root);
+    if (obj) auto_last_run = (time_t)json_object_get_number(obj, "last_run");
+    json_value_free(root);
+}
 
-    JSON_Value* root = json_parse_file(episodes_path);
-    if (root) {
-        JSON_Array* arr = json_value_get_array(root);
-        if (arr) {
-            int total = json_array_get_count(arr);
-            for (int i = 0; i < total; i++) {
-                JSON_Object* obj = json_array_get_object(arr, i);
-                const char* guid = json_object_get_string(obj, "guid");
-                if (guid && strcmp(guid, guid_copy) == 0) {
-                    json_object_set_boolean(obj, "is_new", false);
-                    break;
+static void save_auto_download_state(void) {
+    JSON_Value* root = json_value_init_object();
+    json_object_set_number(json_value_get_object(root), "last_run", (double)auto_last_run);
+    json_serialize_to_file(root, autodownload_file);
+    json_value_free(root);
+}
+
+// Bytes used by downloaded episodes (<download_dir>/<feed>/<episode>.mp3)
+static long long downloads_size(void) {
+    long long total = 0;
+    DIR* dir = opendir(download_dir);
+    if (!dir) return 0;
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+        char feed_path[1024];
+        snprintf(feed_path, sizeof(feed_path), "%s/%s", download_dir, entry->d_name);
+        DIR* feed_dir = opendir(feed_path);
+        if (!feed_dir) continue;
+
+        struct dirent* file;
+        while ((file = readdir(feed_dir)) != NULL) {
+            if (file->d_name[0] == '.') continue;
+            char file_path[1536];
+            snprintf(file_path, sizeof(file_path), "%s/%s", feed_path, file->d_name);
+            struct stat st;
+            if (stat(file_path, &st) == 0 && S_ISREG(st.st_mode)) total += st.st_size;
+        }
+        closedir(feed_dir);
+    }
+    closedir(dir);
+    return total;
+}
+
+// Bytes still to come for queued downloads: each counts at its full expected
+// size, less whatever its .part file already holds (in downloads_size())
+static long long queued_download_bytes(bool auto_only) {
+    long long total = 0;
+    pthread_mutex_lock(&download_mutex);
+    for (int i = 0; i < download_queue_count; i++) {
+        const PodcastDownloadItem* item = &download_queue[i];
+        if (item->status != PODCAST_DOWNLOAD_PENDING && item->status != PODCAST_DOWNLOAD_DOWNLOADING) continue;
+        if (auto_only && item->priority != PODCAST_DOWNLOAD_PRIORITY_AUTO) continue;
+
+        char part_path[PODCAST_MAX_URL + 8];
+        snprintf(part_path, sizeof(part_path), "%s" HTTP_DOWNLOAD_PART_SUFFIX, item->local_path);
+        struct stat st;
+        long long have = stat(part_path, &st) == 0 ? (long long)st.st_size : 0;
+        if (item->expected_bytes > have) total += item->expected_bytes - have;
+    }
+    pthread_mutex_unlock(&download_mutex);
+    return total;
+}
+
+static int compare_played_files(const void* a, const void* b) {
+    time_t ua = ((const AutoPlayedFile*)a)->used;
+    time_t ub = ((const AutoPlayedFile*)b)->used;
+    return (ua > ub) - (ua < ub);
+}
+
+// Delete played downloads, least recently used first, until need bytes are
+// freed. The episode loaded in the player is kept. Returns the bytes freed
+static long long delete_played_downloads(const PodcastFeed* feeds, int feed_count, long long need) {
+    int capacity = 64, count = 0;
+    AutoPlayedFile* files = (AutoPlayedFile*)malloc(capacity * sizeof(AutoPlayedFile));
+    PodcastEpisode* batch = (PodcastEpisode*)malloc(STORE_READ_BATCH * sizeof(PodcastEpisode));
+    if (!files || !batch) {
+        free(files);
+        free(batch);
+        return 0;
+    }
+
+    for (int f = 0; f < feed_count; f++) {
+        char episodes_path[512];
+        get_episodes_file_path(feeds[f].feed_id, episodes_path, sizeof(episodes_path));
+        int total = 0;
+        if (podcast_store_info(episodes_path, &total, NULL) != 0) continue;
+
+        for (int offset = 0; offset < total; offset += STORE_READ_BATCH) {
+            int n = podcast_store_read(episodes_path, offset, batch, STORE_READ_BATCH, NULL);
+            if (n <= 0) break;
+            for (int i = 0; i < n; i++) {
+                if (Podcast_getProgress(feeds[f].feed_url, batch[i].guid) != -1) continue;
+
+                AutoPlayedFile file;
+                episode_local_path(&feeds[f], &batch[i], file.path, sizeof(file.path));
+                struct stat st;
+                if (stat(file.path, &st) != 0) continue;
+                file.size = st.st_size;
+                file.used = st.st_atime > st.st_mtime ? st.st_atime : st.st_mtime;
+
+                if (count == capacity) {
+                    AutoPlayedFile* grown = (AutoPlayedFile*)realloc(files, capacity * 2 * sizeof(AutoPlayedFile));
+                    if (!grown) break;
+                    files = grown;
+                    capacity *= 2;
                 }
+                files[count++] = file;
             }
-            json_serialize_to_file_pretty(root, episodes_path);
         }
-        json_value_free(root);
     }
+    free(batch);
+
+    qsort(files, count, sizeof(AutoPlayedFile), compare_played_files);
+
+    long long freed = 0;
+    int deleted = 0;
+    for (int i = 0; i < count && freed < need; i++) {
+        // Checked and removed under the lock, so an episode starting now
+        // either keeps its file or finds it gone and streams
+        pthread_mutex_lock(&playing_mutex);
+        bool playing = strcmp(playing_path, files[i].path) == 0;
+        bool removed = !playing && remove(files[i].path) == 0;
+        pthread_mutex_unlock(&playing_mutex);
+        if (removed) {
+            freed += files[i].size;
+            deleted++;
+        }
+    }
+    free(files);
+
+    if (deleted > 0) {
+        LOG_error("[Podcast] Auto-download: deleted %d played episodes (%lld MB)\n",
+                  deleted, freed / (1024 * 1024));
+    }
+    return freed;
+}
+
+// Pick the newest unplayed episodes of every feed, make room under the
+// storage quota and queue them. Runs on its own thread after a refresh-all
+static void* auto_download_thread_func(void* arg) {
+    (void)arg;
+    int per_feed = Settings_getPodcastAutoDownload();
+    long long quota = (long long)Settings_getPodcastStorageGB() * 1024 * 1024 * 1024;
+
+    // Work on a copy: the UI may subscribe or unsubscribe meanwhile
+    pthread_mutex_lock(&subscriptions_mutex);
+    int feed_count = subscription_count;
+    PodcastFeed* feeds = (PodcastFeed*)malloc((feed_count > 0 ? feed_count : 1) * sizeof(PodcastFeed));
+    if (feeds) memcpy(feeds, subscriptions, feed_count * sizeof(PodcastFeed));
+    pthread_mutex_unlock(&subscriptions_mutex);
+
+    int slots = feed_count * per_feed + 1;
+    AutoCandidate* picks = (AutoCandidate*)malloc(slots * sizeof(AutoCandidate));
+    PodcastEpisode* newest = (PodcastEpisode*)malloc(slots * sizeof(PodcastEpisode));
+    int* newest_count = (int*)calloc(feed_count + 1, sizeof(int));
+    if (!feeds || !picks || !newest || !newest_count || per_feed <= 0) {
+        free(feeds);
+        free(picks);
+        free(newest);
+        free(newest_count);
+        auto_worker_running = false;
+        return NULL;
+    }
+
+    // Stores list newest first
+    for (int f = 0; f < feed_count; f++) {
+        char episodes_path[512];
+        get_episodes_file_path(feeds[f].feed_id, episodes_path, sizeof(episodes_path));
+        int n = podcast_store_read(episodes_path, 0, &newest[f * per_feed], per_feed, NULL);
+        newest_count[f] = n > 0 ? n : 0;
+    }
+
+    // Rank 0 of every feed, then rank 1, ... so the run budget is shared fairly.
+    // Auto downloads still queued from an earlier run come out of it first
+    int pick_count = 0;
+    long long queued_auto = queued_download_bytes(true);
+    long long wanted = queued_auto;
+    for (int rank = 0; rank < per_feed; rank++) {
+        for (int f = 0; f < feed_count; f++) {
+            if (rank >= newest_count[f]) continue;
+            const PodcastEpisode* ep = &newest[f * per_feed + rank];
+            if (!ep->url[0]) continue;
+            if (Podcast_getProgress(feeds[f].feed_url, ep->guid) == -1) continue;  // Played
+
+            char local_path[PODCAST_MAX_URL];
+            episode_local_path(&feeds[f], ep, local_path, sizeof(local_path));
+            if (access(local_path, F_OK) == 0) continue;
+
+            pthread_mutex_lock(&download_mutex);
+            bool queued = find_download_locked(ep->guid) >= 0;
+            pthread_mutex_unlock(&download_mutex);
+            if (queued) continue;
+
+            long long size = estimate_episode_bytes(ep);
+            if (wanted + size > PODCAST_AUTO_RUN_BUDGET) continue;
+
+            AutoCandidate* pick = &picks[pick_count++];
+            pick->feed = f;
+            pick->episode = *ep;
+            pick->size = size;
+            wanted += size;
+        }
+    }
+    free(newest);
+    free(newest_count);
+
+    // Make room for the picks and everything already queued: played episodes
+    // go first, then the least wanted picks
+    if (pick_count > 0) {
+        long long used = downloads_size() + queued_download_bytes(false);
+        wanted -= queued_auto;
+        if (used + wanted > quota) {
+            used -= delete_played_downloads(feeds, feed_count, used + wanted - quota);
+        }
+        while (pick_count > 0 && used + wanted > quota) {
+            wanted -= picks[--pick_count].size;
+        }
+    }
+
+    // A new run's budget, less what running auto downloads already hold
+    pthread_mutex_lock(&download_mutex);
+    auto_budget_left = PODCAST_AUTO_RUN_BUDGET;
+    for (int i = 0; i < PODCAST_DOWNLOAD_WORKERS; i++) {
+        auto_budget_left -= download_workers[i].budgeted;
+    }
+    pthread_mutex_unlock(&download_mutex);
+
+    int queued = 0;
+    for (int i = 0; i < pick_count; i++) {
+        if (queue_episode_download(&feeds[picks[i].feed], &picks[i].episode,
+                                   PODCAST_DOWNLOAD_PRIORITY_AUTO) == 0) {
+            queued++;
+        }
+    }
+    if (queued > 0) {
+        LOG_error("[Podcast] Auto-download: queued %d episodes\n", queued);
+    }
+
+    free(picks);
+    free(feeds);
+    auto_worker_running = false;
+    return NULL;
+}
+
+void Podcast_autoDownloadTick(uint32_t idle_ms) {
+    if (!podcast_initialized) return;
+
+    uint64_t now_ms = podcast_now_ms();
+    if (now_ms < auto_next_check_ms) return;
+    auto_next_check_ms = now_ms + AUTO_CHECK_INTERVAL_MS;
+
+    if (auto_state == AUTO_REFRESHING) {
+        if (refresh_running) return;
+        Podcast_saveSubscriptions();
+
+        auto_worker_running = true;
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, auto_download_thread_func, NULL) != 0) {
+            LOG_error("[Podcast] Failed to create auto-download thread\n");
+            auto_worker_running = false;
+            auto_state = AUTO_IDLE;
+            return;
+        }
+        pthread_detach(thread);
+        auto_state = AUTO_QUEUING;
+        return;
+    }
+    if (auto_state == AUTO_QUEUING) {
+        if (auto_worker_running) return;
+        auto_last_run = time(NULL);
+        save_auto_download_state();
+        auto_state = AUTO_IDLE;
+        return;
+    }
+
+    if (Settings_getPodcastAutoDownload() <= 0 || subscription_count == 0) return;
+    if (idle_ms < PODCAST_AUTO_IDLE_MS || !Wifi_isConnected()) return;
+
+    // Downloads left pending by a restart or by leaving the podcast screen
+    if (!download_running && download_queue_count > 0) {
+        Podcast_startDownloads();
+    }
+
+    // Due? A clock that went backwards counts as due
+    time_t now = time(NULL);
+    time_t interval = PWR_isCharging() ? PODCAST_AUTO_INTERVAL_CHARGING : PODCAST_AUTO_INTERVAL_BATTERY;
+    if (auto_last_run > 0 && now >= auto_last_run && now - auto_last_run < interval) return;
+
+    // Feeds refreshed within the cooldown are skipped; an ongoing refresh
+    // (started from the podcast screen) is waited for instead
+    Podcast_startRefreshAll();
+    auto_state = AUTO_REFRESHING;
 }
 
 // ============================================================================
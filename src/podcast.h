@@ -10,6 +10,10 @@
 #define PODCAST_MAX_CHART_ITEMS 25
 #define PODCAST_CHART_FETCH_LIMIT 50  // Fetch more to filter out premium podcasts
 #define PODCAST_MAX_DOWNLOAD_QUEUE 50
+#define PODCAST_REFRESH_WORKERS 3  // Feeds refreshed in parallel by refresh-all (2-4)
+#define PODCAST_DOWNLOAD_WORKERS 2  // Episodes downloaded at the same time
+#define PODCAST_DOWNLOAD_RATE_LIMIT (2 * 1024 * 1024)     // Bytes/s shared by all episode downloads
+#define PODCAST_DOWNLOAD_STREAMING_RATE (96 * 1024)       // Bytes/s while a stream is playing
 #define PODCAST_MAX_URL 512
 #define PODCAST_MAX_TITLE 256
 #define PODCAST_MAX_AUTHOR 128
@@ -30,9 +34,15 @@ typedef struct {
     char artwork_url[PODCAST_MAX_URL];
 } ContinueListeningEntry;
 
+// Playback speeds a feed can be set to, in percent (pitch is kept)
+#define PODCAST_SPEEDS {100, 125, 150, 175, 200}
+
 // Episode pagination - only load this many into memory at a time
 #define PODCAST_EPISODE_PAGE_SIZE 50
 
+// Most episodes stored per feed (items further down the RSS are dropped)
+#define PODCAST_MAX_FEED_EPISODES 2000
+
 // Data paths (relative to SDCARD_PATH/.userdata/tg5040/)
 #define PODCAST_DATA_DIR "music-player/podcast"
 #define PODCAST_SUBSCRIPTIONS_FILE "subscriptions.json"
@@ -63,6 +73,10 @@ typedef struct {
     int episode_count;                   // Total episodes (stored on disk)
     uint32_t last_updated;               // Unix timestamp
     int new_episode_count;               // Count of episodes with is_new == true
+    char etag[128];                      // Validators of the last parsed RSS, for
+    char last_modified[64];              // conditional refresh (empty if none)
+    int playback_speed;                  // Percent, one of PODCAST_SPEEDS (0 = 100)
+    bool skip_silence;                   // Shorten long pauses when playing
 } PodcastFeed;
 
 // iTunes search result
@@ -93,6 +107,12 @@ typedef enum {
     PODCAST_DOWNLOAD_FAILED
 } PodcastDownloadStatus;
 
+// Queue order: higher priority first, then in the order queued
+typedef enum {
+    PODCAST_DOWNLOAD_PRIORITY_AUTO = 0,    // Queued without the user asking
+    PODCAST_DOWNLOAD_PRIORITY_USER         // Started from the episode list
+} PodcastDownloadPriority;
+
 typedef struct {
     char feed_title[PODCAST_MAX_TITLE];
     char feed_url[PODCAST_MAX_URL];        // For updating episode status
@@ -101,7 +121,9 @@ typedef struct {
     char url[PODCAST_MAX_URL];
     char local_path[PODCAST_MAX_URL];
     PodcastDownloadStatus status;
-    int progress_percent;
+    PodcastDownloadPriority priority;
+    int progress_percent;                  // This item's own progress (0-100)
+    long long expected_bytes;              // Estimated when queued, the real length once known
 } PodcastDownloadItem;
 
 // Podcast module states
@@ -180,14 +202,20 @@ bool Podcast_isSubscribed(const char* feed_url);
 // Check if already subscribed (by iTunes ID - for chart items)
 bool Podcast_isSubscribedByItunesId(const char* itunes_id);
 
-// Refresh a feed (fetch latest episodes)
+// Refresh a feed (fetch latest episodes). Stops reading the RSS once it
+// reaches episodes already stored
 int Podcast_refreshFeed(int index);
 
+// Full re-sync: re-read the whole RSS, dropping episodes it no longer lists
+int Podcast_resyncFeed(int index);
+
 // Background feed refresh (non-blocking)
 int Podcast_startRefreshAll(void);       // Refresh all subscriptions in background
 int Podcast_startRefreshFeed(int index); // Refresh single feed in background
+int Podcast_startResyncFeed(int index);  // Full re-sync of a single feed in background
 bool Podcast_isRefreshing(void);         // Check if refresh is in progress
 bool Podcast_checkRefreshCompleted(void); // Check & clear completed flag (returns true once)
+bool Podcast_checkFeedRefreshed(void);   // Check & clear: a feed of refresh-all just finished
 void Podcast_clearNewFlag(int feed_index, int episode_index); // Clear is_new on episode
 
 // Save/load subscriptions
@@ -233,7 +261,8 @@ const char* Podcast_getCountryCode(void);
 // Playback (Streaming)
 // ============================================================================
 
-// Play a downloaded episode
+// Play an episode: the downloaded file, or streamed from its URL if there
+// is none (a stream played through becomes the downloaded file)
 int Podcast_play(PodcastFeed* feed, int episode_index);
 
 // Load episode and seek to saved position without starting playback
@@ -249,6 +278,13 @@ int Podcast_getDuration(void);
 // Check if podcast audio is active
 bool Podcast_isActive(void);
 
+// Per-feed speech playback, saved with the subscription and applied to the
+// feed's episode if it is playing. Speed steps through PODCAST_SPEEDS;
+// both return the new setting
+int Podcast_getPlaybackSpeed(int feed_index);
+int Podcast_cyclePlaybackSpeed(int feed_index);
+bool Podcast_toggleSkipSilence(int feed_index);
+
 // ============================================================================
 // Progress Tracking
 // ============================================================================
@@ -299,6 +335,23 @@ const PodcastDownloadProgress* Podcast_getDownloadProgress(void);
 void Podcast_saveDownloadQueue(void);
 void Podcast_loadDownloadQueue(void);
 
+// ============================================================================
+// Scheduled Auto-Download
+// ============================================================================
+
+// While the device sits idle on Wi-Fi, refresh all feeds and queue each one's
+// newest unplayed episodes (count and storage quota are in Settings). Played
+// downloads are deleted, least recently used first, to stay under the quota
+#define PODCAST_AUTO_IDLE_MS (5 * 60 * 1000)              // No input for this long
+#define PODCAST_AUTO_INTERVAL_CHARGING (3 * 3600)         // Seconds between runs on the charger
+#define PODCAST_AUTO_INTERVAL_BATTERY (12 * 3600)         // Seconds between runs on battery
+#define PODCAST_AUTO_RUN_BUDGET (1024LL * 1024 * 1024)    // Bytes queued by one run
+#define PODCAST_AUTO_BYTES_PER_SEC 16000                  // Episode size estimate (128 kbps)
+
+// Run the scheduler (call from every main loop; cheap when nothing is due)
+// idle_ms: time since the last user input
+void Podcast_autoDownloadTick(uint32_t idle_ms);
+
 // Count how many episodes are downloaded for a feed
 int Podcast_countDownloadedEpisodes(int feed_index);
 
@@ -354,4 +407,51 @@ int podcast_rss_parse_with_episodes(const char* xml_data, int xml_len, PodcastFe
                                      PodcastEpisode* episodes_out, int max_episodes,
                                      int* episode_count_out);
 
+// Streaming parser: feed the document in chunks as it downloads and each
+// episode is handed to on_item as soon as its </item> is read, so memory
+// stays at one episode no matter how long the feed is.
+// on_item returns 0 if it took the episode, 1 to skip it, -1 to stop parsing.
+typedef int (*PodcastRssItemCallback)(const PodcastEpisode* episode, void* userdata);
+typedef struct PodcastRssParser PodcastRssParser;
+
+// Create a parser filling feed's metadata (NULL on out of memory)
+PodcastRssParser* podcast_rss_parser_create(PodcastFeed* feed, PodcastRssItemCallback on_item,
+                                            void* userdata);
+
+// Parse the next chunk. Returns 0 to continue, 1 once on_item stopped the parse
+int podcast_rss_parser_feed(PodcastRssParser* parser, const char* data, int len);
+
+// Free the parser. Returns 0 if the document was a feed (had a title), -1 otherwise
+int podcast_rss_parser_finish(PodcastRssParser* parser);
+
+// ============================================================================
+// Episode Store (podcast_store.c)
+// ============================================================================
+
+// Per-feed binary file of fixed-size episode records, read a page at a time
+typedef struct PodcastStoreWriter PodcastStoreWriter;
+
+// Write a new store to path.tmp; it replaces path on a committed close
+PodcastStoreWriter* podcast_store_writer_open(const char* path);
+// Write a new store straight to path, each record readable once added.
+// An uncommitted close deletes it
+PodcastStoreWriter* podcast_store_writer_open_live(const char* path);
+int podcast_store_writer_add(PodcastStoreWriter* writer, const PodcastEpisode* episode);
+int podcast_store_writer_count(const PodcastStoreWriter* writer);
+int podcast_store_writer_close(PodcastStoreWriter* writer, bool commit);
+
+// Read up to max episodes starting at offset. Returns the number read, -1 if
+// the store is missing or invalid. total_out receives the store's episode count
+int podcast_store_read(const char* path, int offset, PodcastEpisode* episodes, int max,
+                       int* total_out);
+
+// Episode and is_new counts from the store header
+int podcast_store_info(const char* path, int* count_out, int* new_count_out);
+
+// Set is_new of one record in place (only if it still holds guid)
+int podcast_store_set_new(const char* path, int index, const char* guid, bool is_new);
+
+// Convert a pre-store episodes.json into a store
+int podcast_store_migrate_json(const char* json_path, const char* path);
+
 #endif // __PODCAST_H__
@@ -161,241 +161,299 @@ static bool stack_contains(ElementStack* stack, const char* elem) {
     return false;
 }
 
-// Parse RSS/Atom XML feed
-// episodes_out: array to store parsed episodes (caller-provided)
-// max_episodes: size of episodes_out array (0 for unlimited if using dynamic allocation)
-// episode_count_out: receives the actual number of episodes parsed
-int podcast_rss_parse_with_episodes(const char* xml_data, int xml_len, PodcastFeed* feed,
-                                     PodcastEpisode* episodes_out, int max_episodes,
-                                     int* episode_count_out) {
-    if (!xml_data || xml_len <= 0 || !feed) {
-        return -1;
-    }
-
-    int episode_count = 0;
-
-    // Allocate parser state on heap
-    yxml_t* parser = (yxml_t*)malloc(sizeof(yxml_t));
-    char* stack_buf = (char*)malloc(4096);  // Stack buffer for yxml
-    if (!parser || !stack_buf) {
-        free(parser);
-        free(stack_buf);
-        return -1;
-    }
-
-    yxml_init(parser, stack_buf, 4096);
-
-    ElementStack elem_stack = {0};
-    RSSParseState state = RSS_STATE_NONE;
+// Incremental parser state (everything a chunk boundary can split)
+struct PodcastRssParser {
+    yxml_t yxml;
+    char yxml_stack[4096];
+    ElementStack elem_stack;
+    RSSParseState state;
 
     // Temporary buffers for collecting content
-    char content_buf[4096] = {0};
-    char attr_name[64] = {0};
-    char attr_value[512] = {0};
+    char content_buf[4096];
+    char attr_name[64];
+    char attr_value[512];
 
     // Current episode being parsed
-    PodcastEpisode* current_episode = NULL;
-    bool in_item = false;
-
-    // Process XML character by character
-    for (int i = 0; i < xml_len; i++) {
-        yxml_ret_t r = yxml_parse(parser, xml_data[i]);
-
-        if (r < 0) {
-            // Parse error - but continue trying
-            continue;
-        }
-
-        switch (r) {
-            case YXML_ELEMSTART: {
-                const char* elem = parser->elem;
-                stack_push(&elem_stack, elem);
+    PodcastEpisode episode;
+    bool in_item;
+    bool stopped;               // Sink asked to stop
+    int episode_count;          // Episodes handed to the sink
+
+    PodcastFeed* feed;
+    PodcastRssItemCallback on_item;
+    void* userdata;
+};
+
+PodcastRssParser* podcast_rss_parser_create(PodcastFeed* feed, PodcastRssItemCallback on_item,
+                                            void* userdata) {
+    if (!feed) return NULL;
+
+    PodcastRssParser* p = (PodcastRssParser*)calloc(1, sizeof(PodcastRssParser));
+    if (!p) return NULL;
+
+    yxml_init(&p->yxml, p->yxml_stack, sizeof(p->yxml_stack));
+    p->state = RSS_STATE_NONE;
+    p->feed = feed;
+    p->on_item = on_item;
+    p->userdata = userdata;
+    return p;
+}
 
-                // Determine parse state based on element hierarchy
-                if (strcmp(elem, "channel") == 0) {
-                    state = RSS_STATE_CHANNEL;
-                }
-                else if (strcmp(elem, "item") == 0 || strcmp(elem, "entry") == 0) {
-                    // New episode
-                    if (episodes_out && (max_episodes == 0 || episode_count < max_episodes)) {
-                        current_episode = &episodes_out[episode_count];
-                        memset(current_episode, 0, sizeof(PodcastEpisode));
-                        in_item = true;
-                        state = RSS_STATE_ITEM;
-                    } else {
-                        in_item = false;
-                    }
-                }
-                else if (in_item) {
-                    if (strcmp(elem, "title") == 0) {
-                        state = RSS_STATE_ITEM_TITLE;
-                    } else if (strcmp(elem, "description") == 0 || strcmp(elem, "summary") == 0) {
-                        state = RSS_STATE_ITEM_DESCRIPTION;
-                    } else if (strcmp(elem, "guid") == 0 || strcmp(elem, "id") == 0) {
-                        state = RSS_STATE_ITEM_GUID;
-                    } else if (strcmp(elem, "pubDate") == 0 || strcmp(elem, "published") == 0) {
-                        state = RSS_STATE_ITEM_PUBDATE;
-                    } else if (strcmp(elem, "enclosure") == 0) {
-                        state = RSS_STATE_ITEM_ENCLOSURE;
-                    } else if (strcmp(elem, "duration") == 0 ||
-                               strcmp(elem, "itunes:duration") == 0 ||
-                               strstr(elem, "duration") != NULL) {
-                        // Match "duration", "itunes:duration", or any element containing "duration"
-                        state = RSS_STATE_ITEM_DURATION;
-                    }
+// Handle one yxml token
+static void rss_handle_token(PodcastRssParser* p, yxml_ret_t r) {
+    yxml_t* parser = &p->yxml;
+    ElementStack* elem_stack = &p->elem_stack;
+    PodcastFeed* feed = p->feed;
+    PodcastEpisode* current_episode = p->in_item ? &p->episode : NULL;
+
+    switch (r) {
+        case YXML_ELEMSTART: {
+            const char* elem = parser->elem;
+            stack_push(elem_stack, elem);
+
+            // Determine parse state based on element hierarchy
+            if (strcmp(elem, "channel") == 0) {
+                p->state = RSS_STATE_CHANNEL;
+            }
+            else if (strcmp(elem, "item") == 0 || strcmp(elem, "entry") == 0) {
+                // New episode
+                memset(&p->episode, 0, sizeof(PodcastEpisode));
+                p->in_item = true;
+                p->state = RSS_STATE_ITEM;
+            }
+            else if (p->in_item) {
+                if (strcmp(elem, "title") == 0) {
+                    p->state = RSS_STATE_ITEM_TITLE;
+                } else if (strcmp(elem, "description") == 0 || strcmp(elem, "summary") == 0) {
+                    p->state = RSS_STATE_ITEM_DESCRIPTION;
+                } else if (strcmp(elem, "guid") == 0 || strcmp(elem, "id") == 0) {
+                    p->state = RSS_STATE_ITEM_GUID;
+                } else if (strcmp(elem, "pubDate") == 0 || strcmp(elem, "published") == 0) {
+                    p->state = RSS_STATE_ITEM_PUBDATE;
+                } else if (strcmp(elem, "enclosure") == 0) {
+                    p->state = RSS_STATE_ITEM_ENCLOSURE;
+                } else if (strcmp(elem, "duration") == 0 ||
+                           strcmp(elem, "itunes:duration") == 0 ||
+                           strstr(elem, "duration") != NULL) {
+                    // Match "duration", "itunes:duration", or any element containing "duration"
+                    p->state = RSS_STATE_ITEM_DURATION;
                 }
-                else if (stack_contains(&elem_stack, "channel") &&
-                         !stack_contains(&elem_stack, "item") &&
-                         !stack_contains(&elem_stack, "entry")) {
-                    // Only handle channel-level elements when NOT inside an item/entry
-                    // (even if in_item is false due to exceeding PODCAST_MAX_EPISODES)
-                    if (strcmp(elem, "title") == 0 && !stack_contains(&elem_stack, "image")) {
-                        state = RSS_STATE_CHANNEL_TITLE;
-                    } else if (strcmp(elem, "description") == 0) {
-                        state = RSS_STATE_CHANNEL_DESCRIPTION;
-                    } else if (strcmp(elem, "author") == 0) {
-                        state = RSS_STATE_ITUNES_AUTHOR;
-                    } else if (strcmp(elem, "image") == 0) {
-                        state = RSS_STATE_CHANNEL_IMAGE;
-                    } else if (strcmp(elem, "url") == 0 && stack_contains(&elem_stack, "image")) {
-                        state = RSS_STATE_CHANNEL_IMAGE_URL;
-                    }
+            }
+            else if (stack_contains(elem_stack, "channel") &&
+                     !stack_contains(elem_stack, "item") &&
+                     !stack_contains(elem_stack, "entry")) {
+                // Only handle channel-level elements when NOT inside an item/entry
+                if (strcmp(elem, "title") == 0 && !stack_contains(elem_stack, "image")) {
+                    p->state = RSS_STATE_CHANNEL_TITLE;
+                } else if (strcmp(elem, "description") == 0) {
+                    p->state = RSS_STATE_CHANNEL_DESCRIPTION;
+                } else if (strcmp(elem, "author") == 0) {
+                    p->state = RSS_STATE_ITUNES_AUTHOR;
+                } else if (strcmp(elem, "image") == 0) {
+                    p->state = RSS_STATE_CHANNEL_IMAGE;
+                } else if (strcmp(elem, "url") == 0 && stack_contains(elem_stack, "image")) {
+                    p->state = RSS_STATE_CHANNEL_IMAGE_URL;
                 }
-
-                content_buf[0] = '\0';
-                attr_name[0] = '\0';
-                attr_value[0] = '\0';
-                break;
             }
 
-            case YXML_ELEMEND: {
-                const char* elem = stack_current(&elem_stack);
+            p->content_buf[0] = '\0';
+            p->attr_name[0] = '\0';
+            p->attr_value[0] = '\0';
+            break;
+        }
+
+        case YXML_ELEMEND: {
+            const char* elem = stack_current(elem_stack);
+            const char* content_buf = p->content_buf;
+            RSSParseState state = p->state;
 
-                // Save collected content
-                if (state == RSS_STATE_CHANNEL_TITLE && content_buf[0]) {
-                    strncpy(feed->title, content_buf, PODCAST_MAX_TITLE - 1);
+            // Save collected content
+            if (state == RSS_STATE_CHANNEL_TITLE && content_buf[0]) {
+                strncpy(feed->title, content_buf, PODCAST_MAX_TITLE - 1);
+            }
+            else if (state == RSS_STATE_CHANNEL_DESCRIPTION && content_buf[0]) {
+                strncpy(feed->description, content_buf, PODCAST_MAX_DESCRIPTION - 1);
+            }
+            else if (state == RSS_STATE_ITUNES_AUTHOR && content_buf[0]) {
+                strncpy(feed->author, content_buf, PODCAST_MAX_AUTHOR - 1);
+            }
+            else if (state == RSS_STATE_CHANNEL_IMAGE_URL && content_buf[0]) {
+                strncpy(feed->artwork_url, content_buf, PODCAST_MAX_URL - 1);
+            }
+            else if (current_episode) {
+                if (state == RSS_STATE_ITEM_TITLE && content_buf[0]) {
+                    strncpy(current_episode->title, content_buf, PODCAST_MAX_TITLE - 1);
                 }
-                else if (state == RSS_STATE_CHANNEL_DESCRIPTION && content_buf[0]) {
-                    strncpy(feed->description, content_buf, PODCAST_MAX_DESCRIPTION - 1);
+                else if (state == RSS_STATE_ITEM_DESCRIPTION && content_buf[0]) {
+                    strncpy(current_episode->description, content_buf, PODCAST_MAX_DESCRIPTION - 1);
                 }
-                else if (state == RSS_STATE_ITUNES_AUTHOR && content_buf[0]) {
-                    strncpy(feed->author, content_buf, PODCAST_MAX_AUTHOR - 1);
+                else if (state == RSS_STATE_ITEM_GUID && content_buf[0]) {
+                    strncpy(current_episode->guid, content_buf, PODCAST_MAX_GUID - 1);
                 }
-                else if (state == RSS_STATE_CHANNEL_IMAGE_URL && content_buf[0]) {
-                    strncpy(feed->artwork_url, content_buf, PODCAST_MAX_URL - 1);
+                else if (state == RSS_STATE_ITEM_PUBDATE && content_buf[0]) {
+                    current_episode->pub_date = parse_rfc2822_date(content_buf);
                 }
-                else if (in_item && current_episode) {
-                    if (state == RSS_STATE_ITEM_TITLE && content_buf[0]) {
-                        strncpy(current_episode->title, content_buf, PODCAST_MAX_TITLE - 1);
-                    }
-                    else if (state == RSS_STATE_ITEM_DESCRIPTION && content_buf[0]) {
-                        strncpy(current_episode->description, content_buf, PODCAST_MAX_DESCRIPTION - 1);
-                    }
-                    else if (state == RSS_STATE_ITEM_GUID && content_buf[0]) {
-                        strncpy(current_episode->guid, content_buf, PODCAST_MAX_GUID - 1);
-                    }
-                    else if (state == RSS_STATE_ITEM_PUBDATE && content_buf[0]) {
-                        current_episode->pub_date = parse_rfc2822_date(content_buf);
-                    }
-                    else if (state == RSS_STATE_ITEM_DURATION && content_buf[0]) {
-                        current_episode->duration_sec = parse_duration(content_buf);
-                    }
+                else if (state == RSS_STATE_ITEM_DURATION && content_buf[0]) {
+                    current_episode->duration_sec = parse_duration(content_buf);
                 }
+            }
 
-                // Handle end of item
-                if ((strcmp(elem, "item") == 0 || strcmp(elem, "entry") == 0) && in_item) {
-                    // Only count episodes that have a URL
-                    if (current_episode && current_episode->url[0]) {
-                        // Generate GUID if not present
-                        if (!current_episode->guid[0]) {
-                            strncpy(current_episode->guid, current_episode->url, PODCAST_MAX_GUID - 1);
-                        }
-                        episode_count++;
+            // Handle end of item: hand it to the sink right away
+            if ((strcmp(elem, "item") == 0 || strcmp(elem, "entry") == 0) && current_episode) {
+                // Only count episodes that have a URL
+                if (current_episode->url[0]) {
+                    // Generate GUID if not present
+                    if (!current_episode->guid[0]) {
+                        strncpy(current_episode->guid, current_episode->url, PODCAST_MAX_GUID - 1);
+                    }
+                    int ret = p->on_item ? p->on_item(current_episode, p->userdata) : 0;
+                    if (ret < 0) {
+                        p->stopped = true;
+                    } else if (ret == 0) {
+                        p->episode_count++;
                     }
-                    in_item = false;
-                    current_episode = NULL;
                 }
+                p->in_item = false;
+            }
 
-                stack_pop(&elem_stack);
+            stack_pop(elem_stack);
 
-                // Reset state based on parent
-                if (stack_contains(&elem_stack, "item") || stack_contains(&elem_stack, "entry")) {
-                    state = RSS_STATE_ITEM;
-                } else if (stack_contains(&elem_stack, "channel")) {
-                    state = RSS_STATE_CHANNEL;
-                } else {
-                    state = RSS_STATE_NONE;
-                }
-                break;
+            // Reset state based on parent
+            if (stack_contains(elem_stack, "item") || stack_contains(elem_stack, "entry")) {
+                p->state = RSS_STATE_ITEM;
+            } else if (stack_contains(elem_stack, "channel")) {
+                p->state = RSS_STATE_CHANNEL;
+            } else {
+                p->state = RSS_STATE_NONE;
             }
+            break;
+        }
 
-            case YXML_CONTENT: {
-                // Append content data
-                safe_strcat(content_buf, parser->data, sizeof(content_buf));
-                break;
-            }
+        case YXML_CONTENT: {
+            // Append content data
+            safe_strcat(p->content_buf, parser->data, sizeof(p->content_buf));
+            break;
+        }
 
-            case YXML_ATTRSTART: {
-                strncpy(attr_name, parser->attr, sizeof(attr_name) - 1);
-                attr_value[0] = '\0';
-                break;
-            }
+        case YXML_ATTRSTART: {
+            strncpy(p->attr_name, parser->attr, sizeof(p->attr_name) - 1);
+            p->attr_value[0] = '\0';
+            break;
+        }
 
-            case YXML_ATTRVAL: {
-                safe_strcat(attr_value, parser->data, sizeof(attr_value));
-                break;
-            }
+        case YXML_ATTRVAL: {
+            safe_strcat(p->attr_value, parser->data, sizeof(p->attr_value));
+            break;
+        }
 
-            case YXML_ATTREND: {
-                // Handle enclosure URL attribute
-                if (state == RSS_STATE_ITEM_ENCLOSURE && current_episode) {
-                    if (strcmp(attr_name, "url") == 0) {
-                        strncpy(current_episode->url, attr_value, PODCAST_MAX_URL - 1);
-                    }
+        case YXML_ATTREND: {
+            const char* attr_name = p->attr_name;
+            const char* attr_value = p->attr_value;
+
+            // Handle enclosure URL attribute
+            if (p->state == RSS_STATE_ITEM_ENCLOSURE && current_episode) {
+                if (strcmp(attr_name, "url") == 0) {
+                    strncpy(current_episode->url, attr_value, PODCAST_MAX_URL - 1);
                 }
-                // Handle itunes:image href attribute at channel level
-                else if (!in_item && strcmp(attr_name, "href") == 0) {
-                    const char* current = stack_current(&elem_stack);
-                    // Check for "image", "itunes:image", or any element containing "image"
-                    if ((strcmp(current, "image") == 0 ||
-                         strcmp(current, "itunes:image") == 0 ||
-                         strstr(current, "image") != NULL) && !feed->artwork_url[0]) {
-                        strncpy(feed->artwork_url, attr_value, PODCAST_MAX_URL - 1);
-                    }
+            }
+            // Handle itunes:image href attribute at channel level
+            else if (!p->in_item && strcmp(attr_name, "href") == 0) {
+                const char* current = stack_current(elem_stack);
+                // Check for "image", "itunes:image", or any element containing "image"
+                if ((strcmp(current, "image") == 0 ||
+                     strcmp(current, "itunes:image") == 0 ||
+                     strstr(current, "image") != NULL) && !feed->artwork_url[0]) {
+                    strncpy(feed->artwork_url, attr_value, PODCAST_MAX_URL - 1);
                 }
-                // Handle Atom link for enclosure
-                else if (in_item && current_episode &&
-                         strcmp(stack_current(&elem_stack), "link") == 0) {
-                    if (strcmp(attr_name, "href") == 0) {
-                        // Check if this is an enclosure link
-                        if (!current_episode->url[0]) {
-                            strncpy(current_episode->url, attr_value, PODCAST_MAX_URL - 1);
-                        }
+            }
+            // Handle Atom link for enclosure
+            else if (current_episode && strcmp(stack_current(elem_stack), "link") == 0) {
+                if (strcmp(attr_name, "href") == 0) {
+                    // Check if this is an enclosure link
+                    if (!current_episode->url[0]) {
+                        strncpy(current_episode->url, attr_value, PODCAST_MAX_URL - 1);
                     }
                 }
-                break;
             }
+            break;
+        }
 
-            default:
-                break;
+        default:
+            break;
+    }
+}
+
+int podcast_rss_parser_feed(PodcastRssParser* p, const char* data, int len) {
+    if (!p || !data || len < 0) return -1;
+    if (p->stopped) return 1;
+
+    for (int i = 0; i < len; i++) {
+        yxml_ret_t r = yxml_parse(&p->yxml, data[i]);
+
+        if (r < 0) {
+            // Parse error - but continue trying
+            continue;
+        }
+        if (r != YXML_OK) {
+            rss_handle_token(p, r);
+            if (p->stopped) return 1;
         }
     }
+    return 0;
+}
 
-    free(parser);
-    free(stack_buf);
+int podcast_rss_parser_finish(PodcastRssParser* p) {
+    if (!p) return -1;
 
-    // Set output episode count
-    if (episode_count_out) {
-        *episode_count_out = episode_count;
+    p->feed->episode_count = p->episode_count;
+    bool valid = p->feed->title[0] != '\0';
+    free(p);
+
+    return valid ? 0 : -1;
+}
+
+// Collects streamed episodes into a caller-provided array
+typedef struct {
+    PodcastEpisode* episodes;
+    int max_episodes;
+    int count;
+} EpisodeArraySink;
+
+static int episode_array_sink(const PodcastEpisode* episode, void* userdata) {
+    EpisodeArraySink* sink = (EpisodeArraySink*)userdata;
+    if (!sink->episodes || (sink->max_episodes > 0 && sink->count >= sink->max_episodes)) {
+        return 1;  // Skipped
+    }
+    memcpy(&sink->episodes[sink->count++], episode, sizeof(PodcastEpisode));
+    return 0;
+}
+
+// Parse RSS/Atom XML feed
+// episodes_out: array to store parsed episodes (caller-provided)
+// max_episodes: size of episodes_out array (0 for unlimited if using dynamic allocation)
+// episode_count_out: receives the actual number of episodes parsed
+int podcast_rss_parse_with_episodes(const char* xml_data, int xml_len, PodcastFeed* feed,
+                                     PodcastEpisode* episodes_out, int max_episodes,
+                                     int* episode_count_out) {
+    if (!xml_data || xml_len <= 0 || !feed) {
+        return -1;
     }
-    feed->episode_count = episode_count;
 
-    // Validate feed
-    if (!feed->title[0]) {
+    EpisodeArraySink sink = {episodes_out, max_episodes, 0};
+    PodcastRssParser* parser = podcast_rss_parser_create(feed, episode_array_sink, &sink);
+    if (!parser) {
         return -1;
     }
 
-    return 0;
+    podcast_rss_parser_feed(parser, xml_data, xml_len);
+    int result = podcast_rss_parser_finish(parser);
+
+    // Set output episode count
+    if (episode_count_out) {
+        *episode_count_out = sink.count;
+    }
+
+    return result;
 }
 
 // Simple wrapper for backward compatibility (no episodes output)
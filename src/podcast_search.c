@@ -1,6 +1,7 @@
 #define _GNU_SOURCE
 #include "podcast.h"
-#include "wget_fetch.h"
+#include "http_client.h"
+#include "http_cache.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -76,7 +77,7 @@ int podcast_search_itunes(const char* query, PodcastSearchResult* results, int m
         return -1;
     }
 
-    int bytes = wget_fetch(url, buffer, 128 * 1024);
+    int bytes = http_cache_fetch(url, buffer, 128 * 1024, HTTP_CACHE_TTL_SEARCH);
 
     if (bytes <= 0) {
         LOG_error("[PodcastSearch] Failed to fetch search results\n");
@@ -200,7 +201,7 @@ int podcast_search_lookup_full(const char* itunes_id, char* feed_url, int feed_u
         return -1;
     }
 
-    int bytes = wget_fetch(url, buffer, 32 * 1024);
+    int bytes = http_cache_fetch(url, buffer, 32 * 1024, HTTP_CACHE_TTL_LOOKUP);
     if (bytes <= 0) {
         free(buffer);
         return -1;
@@ -269,8 +270,11 @@ int podcast_search_lookup(const char* itunes_id, char* feed_url, int feed_url_si
 }
 
 // Fetch Apple Podcast Charts (Top Shows)
+// validators (optional) are those of the caller's cached chart; returns
+// HTTP_NOT_MODIFIED if that copy is still current
 int podcast_charts_fetch(const char* country_code, PodcastChartItem* top, int* top_count,
-                         PodcastChartItem* new_items, int* new_count, int max_items) {
+                         PodcastChartItem* new_items, int* new_count, int max_items,
+                         HttpValidators* validators) {
     (void)new_items;  // Unused - kept for API compatibility
     (void)new_count;  // Unused - kept for API compatibility
 
@@ -296,8 +300,12 @@ int podcast_charts_fetch(const char* country_code, PodcastChartItem* top, int* t
         return -1;
     }
 
-    int bytes = wget_fetch(url, buffer, 256 * 1024);
-    if (bytes <= 0) {
+    int bytes = validators ? http_fetch_conditional(url, buffer, 256 * 1024, validators)
+                           : http_fetch(url, buffer, 256 * 1024, NULL);
+    if (bytes == HTTP_NOT_MODIFIED) {
+        free(buffer);
+        return HTTP_NOT_MODIFIED;
+    } else if (bytes <= 0) {
         LOG_error("[PodcastCharts] Network fetch failed for top shows (bytes=%d)\n", bytes);
     } else {
         buffer[bytes] = '\0';
@@ -392,7 +400,7 @@ int podcast_charts_filter_premium(PodcastChartItem* items, int count, int max_it
         return count;  // Return original count on error
     }
 
-    int bytes = wget_fetch(url, buffer, 256 * 1024);
+    int bytes = http_cache_fetch(url, buffer, 256 * 1024, HTTP_CACHE_TTL_LOOKUP);
     if (bytes <= 0) {
         LOG_error("[PodcastCharts] Batch lookup failed\n");
         free(buffer);
@@ -0,0 +1,297 @@
+#define _GNU_SOURCE
+#include "podcast.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+#include "defines.h"
+#include "api.h"
+
+// JSON library (only for migrating the old episodes.json)
+#include "include/parson/parson.h"
+
+// Episode store file layout:
+//   EpisodeStoreHeader, then `count` fixed-size PodcastEpisode records in feed
+//   order. Record i lives at sizeof(header) + i * record_size, so a page is a
+//   single pread and a flag change is a write of that one field.
+//   A live store is appended to in place: each record is written before the
+//   header count that covers it, so readers always see a complete prefix.
+#define EPISODE_STORE_MAGIC 0x53455050  // "PPES"
+#define EPISODE_STORE_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_size;                // sizeof(PodcastEpisode) when written
+    uint32_t count;
+    uint32_t new_count;                  // Records with is_new set
+    uint32_t reserved[3];
+} EpisodeStoreHeader;
+
+struct PodcastStoreWriter {
+    FILE* fp;
+    char path[512];
+    char tmp_path[520];
+    bool live;                           // Writing path itself, published per record
+    uint32_t published_new;              // new_count already added to the on-disk header
+    EpisodeStoreHeader header;
+};
+
+// Header updates of live stores and podcast_store_set_new() are read-modify-writes
+static pthread_mutex_t header_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static off_t record_offset(int index) {
+    return (off_t)sizeof(EpisodeStoreHeader) + (off_t)index * sizeof(PodcastEpisode);
+}
+
+// Read and check the header of an open store
+static int read_header(int fd, EpisodeStoreHeader* header) {
+    if (pread(fd, header, sizeof(*header), 0) != (ssize_t)sizeof(*header)) {
+        return -1;
+    }
+    if (header->magic != EPISODE_STORE_MAGIC || header->version != EPISODE_STORE_VERSION ||
+        header->record_size != sizeof(PodcastEpisode)) {
+        return -1;
+    }
+    return 0;
+}
+
+static PodcastStoreWriter* writer_open(const char* path, bool live) {
+    if (!path) return NULL;
+
+    PodcastStoreWriter* w = (PodcastStoreWriter*)calloc(1, sizeof(PodcastStoreWriter));
+    if (!w) return NULL;
+
+    snprintf(w->path, sizeof(w->path), "%s", path);
+    snprintf(w->tmp_path, sizeof(w->tmp_path), "%s.tmp", path);
+    w->live = live;
+    const char* target = live ? w->path : w->tmp_path;
+    w->fp = fopen(target, live ? "w+b" : "wb");  // Live: the header is read back when publishing
+    if (!w->fp) {
+        LOG_error("[PodcastStore] Failed to create %s\n", target);
+        free(w);
+        return NULL;
+    }
+
+    // Header is written again with the final counts on close
+    w->header.magic = EPISODE_STORE_MAGIC;
+    w->header.version = EPISODE_STORE_VERSION;
+    w->header.record_size = sizeof(PodcastEpisode);
+    if (fwrite(&w->header, sizeof(w->header), 1, w->fp) != 1 || (live && fflush(w->fp) != 0)) {
+        LOG_error("[PodcastStore] Failed to write %s\n", target);
+        fclose(w->fp);
+        unlink(target);
+        free(w);
+        return NULL;
+    }
+    return w;
+}
+
+// Make the records written so far visible in a live store. is_new flags may
+// have been cleared on disk meanwhile, so new_count is applied as a delta
+static int writer_publish(PodcastStoreWriter* w) {
+    if (fflush(w->fp) != 0) return -1;
+
+    int fd = fileno(w->fp);
+    int result = -1;
+    EpisodeStoreHeader header;
+    pthread_mutex_lock(&header_mutex);
+    if (read_header(fd, &header) == 0) {
+        header.count = w->header.count;
+        header.new_count += w->header.new_count - w->published_new;
+        if (pwrite(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header)) {
+            w->published_new = w->header.new_count;
+            result = 0;
+        }
+    }
+    pthread_mutex_unlock(&header_mutex);
+    return result;
+}
+
+PodcastStoreWriter* podcast_store_writer_open(const char* path) {
+    return writer_open(path, false);
+}
+
+PodcastStoreWriter* podcast_store_writer_open_live(const char* path) {
+    return writer_open(path, true);
+}
+
+int podcast_store_writer_add(PodcastStoreWriter* w, const PodcastEpisode* episode) {
+    if (!w || !episode) return -1;
+
+    if (fwrite(episode, sizeof(PodcastEpisode), 1, w->fp) != 1) {
+        return -1;
+    }
+    w->header.count++;
+    if (episode->is_new) w->header.new_count++;
+    return w->live ? writer_publish(w) : 0;
+}
+
+int podcast_store_writer_count(const PodcastStoreWriter* w) {
+    return w ? (int)w->header.count : 0;
+}
+
+int podcast_store_writer_close(PodcastStoreWriter* w, bool commit) {
+    if (!w) return -1;
+
+    bool ok;
+    if (w->live) {
+        ok = writer_publish(w) == 0;
+    } else {
+        ok = fseek(w->fp, 0, SEEK_SET) == 0 &&
+             fwrite(&w->header, sizeof(w->header), 1, w->fp) == 1;
+        ok = (fflush(w->fp) == 0) && ok;
+    }
+    ok = (fclose(w->fp) == 0) && ok;
+
+    int result = -1;
+    if (commit && ok && (w->live || rename(w->tmp_path, w->path) == 0)) {
+        result = 0;
+    } else {
+        if (commit) {
+            LOG_error("[PodcastStore] Failed to save episodes to %s\n", w->path);
+        }
+        unlink(w->live ? w->path : w->tmp_path);
+    }
+
+    free(w);
+    return result;
+}
+
+int podcast_store_read(const char* path, int offset, PodcastEpisode* episodes, int max,
+                       int* total_out) {
+    if (total_out) *total_out = 0;
+    if (!path || offset < 0 || (max > 0 && !episodes)) return -1;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    EpisodeStoreHeader header;
+    if (read_header(fd, &header) != 0) {
+        LOG_error("[PodcastStore] Not an episode store: %s\n", path);
+        close(fd);
+        return -1;
+    }
+    if (total_out) *total_out = (int)header.count;
+
+    int count = 0;
+    if (offset < (int)header.count && max > 0) {
+        count = (int)header.count - offset;
+        if (count > max) count = max;
+
+        ssize_t want = (ssize_t)count * sizeof(PodcastEpisode);
+        ssize_t got = pread(fd, episodes, want, record_offset(offset));
+        count = got > 0 ? (int)(got / sizeof(PodcastEpisode)) : 0;
+    }
+
+    close(fd);
+    return count;
+}
+
+int podcast_store_info(const char* path, int* count_out, int* new_count_out) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    EpisodeStoreHeader header;
+    int result = read_header(fd, &header);
+    close(fd);
+    if (result != 0) return -1;
+
+    if (count_out) *count_out = (int)header.count;
+    if (new_count_out) *new_count_out = (int)header.new_count;
+    return 0;
+}
+
+int podcast_store_set_new(const char* path, int index, const char* guid, bool is_new) {
+    if (!path || index < 0 || !guid) return -1;
+
+    int fd = open(path, O_RDWR);
+    if (fd < 0) return -1;
+
+    int result = -1;
+    EpisodeStoreHeader header;
+    char stored_guid[PODCAST_MAX_GUID];
+    bool stored_new = false;
+    off_t rec = record_offset(index);
+
+    // The store may have been rewritten by a refresh since the page was read
+    pthread_mutex_lock(&header_mutex);
+    if (read_header(fd, &header) == 0 && index < (int)header.count &&
+        pread(fd, stored_guid, sizeof(stored_guid), rec + offsetof(PodcastEpisode, guid)) ==
+            (ssize_t)sizeof(stored_guid) &&
+        pread(fd, &stored_new, sizeof(stored_new), rec + offsetof(PodcastEpisode, is_new)) ==
+            (ssize_t)sizeof(stored_new)) {
+        stored_guid[PODCAST_MAX_GUID - 1] = '\0';
+        if (strcmp(stored_guid, guid) == 0) {
+            result = 0;
+            if (stored_new != is_new) {
+                if (is_new) {
+                    header.new_count++;
+                } else if (header.new_count > 0) {
+                    header.new_count--;
+                }
+                if (pwrite(fd, &is_new, sizeof(is_new), rec + offsetof(PodcastEpisode, is_new)) !=
+                        (ssize_t)sizeof(is_new) ||
+                    pwrite(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+                    result = -1;
+                }
+            }
+        }
+    }
+    pthread_mutex_unlock(&header_mutex);
+
+    close(fd);
+    return result;
+}
+
+int podcast_store_migrate_json(const char* json_path, const char* path) {
+    JSON_Value* root = json_parse_file(json_path);
+    JSON_Array* arr = root ? json_value_get_array(root) : NULL;
+    if (!arr) {
+        json_value_free(root);
+        return -1;
+    }
+
+    PodcastStoreWriter* w = podcast_store_writer_open(path);
+    if (!w) {
+        json_value_free(root);
+        return -1;
+    }
+
+    bool ok = true;
+    PodcastEpisode ep;
+    int total = (int)json_array_get_count(arr);
+    for (int i = 0; i < total && ok; i++) {
+        JSON_Object* ep_obj = json_array_get_object(arr, i);
+        if (!ep_obj) continue;
+
+        memset(&ep, 0, sizeof(PodcastEpisode));
+
+        const char* str;
+        str = json_object_get_string(ep_obj, "guid");
+        if (str) strncpy(ep.guid, str, PODCAST_MAX_GUID - 1);
+        str = json_object_get_string(ep_obj, "title");
+        if (str) strncpy(ep.title, str, PODCAST_MAX_TITLE - 1);
+        str = json_object_get_string(ep_obj, "url");
+        if (str) strncpy(ep.url, str, PODCAST_MAX_URL - 1);
+        str = json_object_get_string(ep_obj, "description");
+        if (str) strncpy(ep.description, str, PODCAST_MAX_DESCRIPTION - 1);
+        str = json_object_get_string(ep_obj, "local_path");
+        if (str) strncpy(ep.local_path, str, PODCAST_MAX_URL - 1);
+
+        ep.duration_sec = (int)json_object_get_number(ep_obj, "duration");
+        ep.pub_date = (uint32_t)json_object_get_number(ep_obj, "pub_date");
+        ep.progress_sec = (int)json_object_get_number(ep_obj, "progress");
+        ep.downloaded = (json_object_get_boolean(ep_obj, "downloaded") == 1);
+        ep.is_new = (json_object_get_boolean(ep_obj, "is_new") == 1);
+
+        ok = podcast_store_writer_add(w, &ep) == 0;
+    }
+    json_value_free(root);
+
+    return podcast_store_writer_close(w, ok);
+}
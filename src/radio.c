@@ -1,9 +1,15 @@
 #define _GNU_SOURCE  // For strcasestr
 #include "radio.h"
 #include "radio_net.h"
+#include "net_dns.h"
 #include "album_art.h"
 #include "radio_hls.h"
 #include "radio_curated.h"
+#include "radio_health.h"
+#include "radio_mirror.h"
+#include "radio_timeshift.h"
+#include "radio_ogg.h"
+#include "time_stretch.h"
 #include "player.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -45,12 +51,13 @@
 typedef enum {
     RADIO_FORMAT_UNKNOWN = 0,
     RADIO_FORMAT_MP3,
-    RADIO_FORMAT_AAC
+    RADIO_FORMAT_AAC,
+    RADIO_FORMAT_OGG            // Ogg Opus or Ogg Vorbis (codec read from the stream)
 } RadioAudioFormat;
 
 // Stream types
 typedef enum {
-    STREAM_TYPE_DIRECT = 0,  // Direct MP3/AAC stream (Shoutcast/Icecast)
+    STREAM_TYPE_DIRECT = 0,  // Direct MP3/AAC/Ogg stream (Shoutcast/Icecast)
     STREAM_TYPE_HLS          // HLS (m3u8 playlist)
 } StreamType;
 
@@ -60,9 +67,31 @@ typedef enum {
 #define AUDIO_CHANNELS 2
 #define RADIO_STATIONS_FILE SHARED_USERDATA_PATH "/music-player/radio/stations.txt"
 
+// Station probe: how long to wait for audio after the headers
+#define RADIO_PROBE_BODY_TIMEOUT_SEC 5
+#define RADIO_CONNECT_TIMEOUT_MS 10000
+
 // Ring buffer for decoded audio
 #define AUDIO_RING_SIZE (SAMPLE_RATE * 2 * 10)  // 10 seconds of stereo audio
 
+// Adaptive jitter buffer limits, converted to samples at the stream's own rate
+#define JITTER_MIN_START_MS 1000
+#define JITTER_MAX_START_MS 8000
+#define JITTER_DEFAULT_START_MS 3000
+#define JITTER_MIN_LOW_WATER_MS 500
+#define JITTER_MAX_LOW_WATER_MS 4000
+#define JITTER_DEFAULT_LOW_WATER_MS 1000
+#define JITTER_UNDERRUN_MS 100           // Treat as empty
+#define JITTER_SPEED_STRETCH 0.98f       // Play slower while refilling
+#define JITTER_SPEED_COMPRESS 1.01f      // Trim excess latency
+#define JITTER_STRETCH_FEED 256          // Ring frames fed to the stretcher at a time
+#define JITTER_STRETCH_OUT 4096          // Staged stretched frames (also holds drained input)
+
+// Time-shift playback (direct streams)
+#define TIMESHIFT_RING_MARGIN (SAMPLE_RATE * 2 * 2)  // Leave 2s of ring free before pulling more
+#define TIMESHIFT_READ_CHUNK (16 * 1024)             // Compressed bytes pulled per loop
+#define TIMESHIFT_BEHIND_MS 2000                     // Further back than this counts as time-shifted
+
 // Default radio stations
 static RadioStation default_stations[] = {
     {"Hitz FM", "https://n10.rcs.revma.com/488kt4sbv4uvv/10_xn1quxmoht3902/playlist.m3u8", "Pop", "More the Hitz, One the Time"},
@@ -70,16 +99,20 @@ static RadioStation default_stations[] = {
 
 // Curated stations are now in radio_curated.c module
 
-// Radio context
-typedef struct {
-    // State - volatile for cross-thread access
-    volatile RadioState state;
-    char error_msg[256];
+// Current stream + pre-connect + losing mirror race attempts still winding down
+#define RADIO_CONN_SLOTS 4
 
-    // Connection
+// Stream connection (HTTP or HTTPS) and its parsed response headers.
+// Kept out of RadioContext by value so a speculative connection can be opened
+// while browsing and promoted without reconnecting (mbedTLS contexts hold
+// pointers into each other, so a connection must never be copied).
+typedef struct {
     int socket_fd;
-    char current_url[RADIO_MAX_URL];
     char redirect_url[RADIO_MAX_URL];  // For handling HTTP redirects
+    char error_msg[256];
+    int connect_ms;                    // DNS + TCP (+ TLS) time of the last hop
+    char final_url[RADIO_MAX_URL];     // URL that served the stream (after redirects)
+    volatile bool racing;              // Owned by a mirror race worker
 
     // SSL/TLS support
     bool use_ssl;
@@ -90,9 +123,33 @@ typedef struct {
     mbedtls_ctr_drbg_context ctr_drbg;
     bool ssl_initialized;
 
+    // Response headers
+    int icy_metaint;
+    int bitrate;
+    char station_name[256];
+    char content_type[64];
+    RadioAudioFormat audio_format;
+} RadioConn;
+
+// Radio context
+typedef struct {
+    // State - volatile for cross-thread access
+    volatile RadioState state;
+    char error_msg[256];
+
+    // Connection (points into conn_slots; the others are for pre-connect and mirror races)
+    RadioConn* conn;
+    RadioConn conn_slots[RADIO_CONN_SLOTS];
+    int preload_len;          // Bytes handed over from a promoted pre-connect
+    int preload_pos;
+    char current_url[RADIO_MAX_URL];
+
     // ICY metadata
     int icy_metaint;          // Bytes between metadata
     int bytes_until_meta;     // Countdown to next metadata
+    int icy_meta_len;         // Size of the block being read, -1 before its length byte
+    int icy_meta_fill;
+    uint8_t icy_meta_buf[255 * 16];  // A block may arrive split across reads
     RadioMetadata metadata;
 
     // Stream buffer (raw network data)
@@ -107,9 +164,42 @@ typedef struct {
     int audio_ring_count;
     pthread_mutex_t audio_mutex;
 
+    // Adaptive jitter buffer
+    uint64_t jitter_last_arrival_ms;  // Monotonic time of last data arrival
+    float jitter_mean_ms;             // Smoothed inter-arrival gap
+    float jitter_dev_ms;              // Smoothed deviation of the gap
+    uint64_t jitter_decode_last_ms;   // Monotonic time of the last decode pass that produced audio
+    float jitter_decode_audio_ms;     // Audio that pass delivered
+    float jitter_decode_dev_ms;       // Smoothed jitter of decoded audio (RFC 3550 J)
+    int jitter_decode_write;          // Ring write position after that pass
+    bool jitter_decode_throttled;     // Ring was nearly full then, so the next gap is idle time
+    uint64_t jitter_idle_ms;          // Producer idle time since the last decode pass
+    volatile int jitter_start_ms;     // Buffered audio required before PLAYING
+    volatile int jitter_low_ms;       // Below this, playback is stretched
+
+    // Pitch-preserving speed change while the ring is off target
+    TimeStretch* jitter_ts;           // Created at the stream rate on first use
+    int jitter_ts_rate;
+    int16_t* jitter_out;              // Stretched frames not played yet
+    int jitter_out_len;
+    int jitter_out_pos;
+    bool jitter_stretching;           // Output goes through jitter_ts
+
+    // Playback statistics, logged at Radio_stop() if playback stalled
+    RadioPlaybackStats stats;
+    uint64_t session_start_ms;        // Radio_play() time, 0 when stopped
+    uint64_t rebuffer_start_ms;       // When the current rebuffer began, 0 if none
+
     // Audio format detection
     RadioAudioFormat audio_format;
 
+    // Time-shift (direct streams): UI requests are applied by the stream thread
+    volatile bool paused;
+    volatile bool timeshifted;        // Playing from the recording, not live
+    bool timeshift_seek_pending;      // Protected by audio_mutex
+    bool timeshift_seek_live;
+    int timeshift_seek_ms;
+
     // MP3 decoder (low-level for streaming)
     drmp3dec mp3_decoder;
     bool mp3_initialized;
@@ -124,6 +214,10 @@ typedef struct {
     int aac_sample_rate;
     int aac_channels;
 
+    // Ogg Opus/Vorbis decoder (radio_ogg.c)
+    bool ogg_initialized;
+    int ogg_sample_rate;
+
     // HLS support
     StreamType stream_type;
     HLSContext hls;
@@ -136,9 +230,11 @@ typedef struct {
     uint8_t* hls_aac_buf;            // AAC decode buffer
     uint8_t* hls_prefetch_buf;       // Prefetch buffer for next segment
     int hls_prefetch_len;            // Length of prefetched data
-    int hls_prefetch_segment;        // Which segment index is prefetched (-1 if none)
+    int hls_prefetch_segment;        // Sequence number of the prefetched segment (-1 if none)
     volatile bool hls_prefetch_ready; // Is prefetch data ready to use?
     pthread_mutex_t hls_mutex;       // Mutex for HLS prefetch and segments access
+    pthread_cond_t hls_segments_cond; // Signalled when the refresher appends segments
+    float hls_throughput_bps;        // Smoothed segment download throughput
 
     // TS demuxer state
     int ts_aac_pid;                  // PID of AAC audio stream
@@ -166,29 +262,317 @@ typedef struct {
 
 static RadioContext radio = {0};
 
+// Speculative pre-connect of the highlighted station (at most one at a time)
+#define PRECONNECT_DIRECT_CAP (64 * 1024)    // Raw stream bytes buffered before promotion
+#define PRECONNECT_IDLE_TIMEOUT_MS 30000     // Drop a connection nobody promoted
+
+typedef struct {
+    char url[RADIO_MAX_URL];
+    bool is_hls;
+    volatile bool busy;      // Worker thread still running (it owns everything below)
+    volatile bool cancel;    // Cursor moved away - discard results
+    volatile bool promote;   // Radio_play() wants the connection now
+    volatile bool ready;     // Direct: connection open. HLS: playlist and first segment fetched
+    RadioConn* conn;         // Spare connection slot (direct streams)
+    HLSContext* hls;         // Playlist (HLS streams)
+    uint8_t* buf;            // Raw stream bytes (direct) or first segment (HLS)
+    int len;
+    uint64_t ready_ms;       // When it became ready (HLS playlists go stale)
+    pthread_mutex_t mutex;
+    pthread_cond_t done;     // Signalled when busy clears
+} RadioPreconnect;
+
+static RadioPreconnect preconnect;
+
+// Racing a station's mirrors: each attempt runs on its own detached worker and
+// connection slot; the first to deliver audio headers becomes radio.conn
+#define MIRROR_RACE_MAX 3
+#define MIRROR_RACE_STAGGER_MS 250   // Head start per rank, fastest mirror first
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t generation;     // Bumped per race so late finishers know they lost
+    RadioConn* winner;
+    int pending;             // Workers of the current race still running
+    char error_msg[256];     // First failure reason, for when every mirror fails
+} MirrorRace;
+
+typedef struct {
+    RadioConn* conn;
+    uint32_t generation;
+    int delay_ms;
+    char station_url[RADIO_MAX_URL];
+    char url[RADIO_MAX_URL];
+} MirrorRacer;
+
+static MirrorRace mirror_race;
+
+static uint64_t radio_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Sample rate of the audio in the ring: the stream's own once its first frame
+// is decoded
+static int stream_sample_rate(void) {
+    if (radio.aac_sample_rate > 0) return radio.aac_sample_rate;
+    if (radio.mp3_sample_rate > 0) return radio.mp3_sample_rate;
+    if (radio.ogg_sample_rate > 0) return radio.ogg_sample_rate;
+    return SAMPLE_RATE;
+}
+
+static int jitter_clamp(int v, int lo, int hi) {
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return v;
+}
+
+// Interleaved samples holding ms of audio at the stream rate
+static int jitter_samples(int ms) {
+    return (int)((int64_t)ms * stream_sample_rate() * AUDIO_CHANNELS / 1000);
+}
+
+// The ring was emptied: drop what the stretcher holds and restart decode timing
+static void jitter_flush(void) {
+    time_stretch_reset(radio.jitter_ts);
+    radio.jitter_stretching = false;
+    radio.jitter_out_len = 0;
+    radio.jitter_out_pos = 0;
+    radio.jitter_decode_last_ms = 0;
+    radio.jitter_decode_write = radio.audio_ring_write;
+    radio.jitter_decode_throttled = false;
+    radio.jitter_idle_ms = 0;
+}
+
+// Reset the jitter estimator to conservative defaults for a new stream
+static void jitter_reset(void) {
+    radio.jitter_last_arrival_ms = 0;
+    radio.jitter_mean_ms = 0;
+    radio.jitter_dev_ms = 0;
+    radio.jitter_decode_dev_ms = 0;
+    radio.jitter_decode_audio_ms = 0;
+    radio.jitter_start_ms = JITTER_DEFAULT_START_MS;
+    radio.jitter_low_ms = JITTER_DEFAULT_LOW_WATER_MS;
+    jitter_flush();
+}
+
+// Size the targets to survive the worse of network and decode jitter
+static void jitter_retune(void) {
+    float net_ms = radio.jitter_mean_ms + 4.0f * radio.jitter_dev_ms;
+    float decode_ms = 4.0f * radio.jitter_decode_dev_ms;
+    int cover_ms = (int)(net_ms > decode_ms ? net_ms : decode_ms);
+    radio.jitter_low_ms = jitter_clamp(cover_ms, JITTER_MIN_LOW_WATER_MS, JITTER_MAX_LOW_WATER_MS);
+    radio.jitter_start_ms = jitter_clamp(cover_ms * 2, JITTER_MIN_START_MS, JITTER_MAX_START_MS);
+}
+
+// Record a data arrival and retune the buffer targets.
+// excluded_ms is time the producer spent deliberately idle (e.g. waiting for ring space),
+// which must not count as network jitter.
+static void jitter_note_arrival(uint64_t excluded_ms) {
+    uint64_t now = radio_now_ms();
+    if (radio.jitter_last_arrival_ms == 0) {
+        radio.jitter_last_arrival_ms = now;
+        return;
+    }
+    uint64_t elapsed = now - radio.jitter_last_arrival_ms;
+    radio.jitter_last_arrival_ms = now;
+    float gap = (float)(elapsed > excluded_ms ? elapsed - excluded_ms : 0);
+
+    // RFC 3550 style smoothing: the gap we must survive is mean + 4 deviations
+    float diff = gap - radio.jitter_mean_ms;
+    radio.jitter_mean_ms += diff / 16.0f;
+    radio.jitter_dev_ms += ((diff < 0 ? -diff : diff) - radio.jitter_dev_ms) / 16.0f;
+    // Take spikes immediately, decay slowly
+    if (gap > radio.jitter_mean_ms + 4.0f * radio.jitter_dev_ms) {
+        radio.jitter_dev_ms = (gap - radio.jitter_mean_ms) / 4.0f;
+    }
+
+    jitter_retune();
+}
+
+// Record a decode pass on the streaming thread and retune. Decoders turn
+// arrivals into audio unevenly (a whole HLS segment at once, MP3 frames only
+// once complete, resyncs after errors), and the ring drains at the audio
+// rate, so this is RFC 3550 interarrival jitter with the audio each pass
+// delivered standing in for the timestamp spacing.
+static void jitter_note_decoded(void) {
+    int written = (radio.audio_ring_write - radio.jitter_decode_write + AUDIO_RING_SIZE) % AUDIO_RING_SIZE;
+    if (written == 0) return;
+    radio.jitter_decode_write = radio.audio_ring_write;
+
+    uint64_t now = radio_now_ms();
+    uint64_t idle = radio.jitter_idle_ms;
+    radio.jitter_idle_ms = 0;
+    if (radio.jitter_decode_last_ms && !radio.jitter_decode_throttled) {
+        uint64_t elapsed = now - radio.jitter_decode_last_ms;
+        float gap = (float)(elapsed > idle ? elapsed - idle : 0);
+        float d = gap - radio.jitter_decode_audio_ms;
+        if (d < 0) d = -d;
+        radio.jitter_decode_dev_ms += (d - radio.jitter_decode_dev_ms) / 16.0f;
+        // Take late passes immediately, like network spikes
+        if (d > 4.0f * radio.jitter_decode_dev_ms) radio.jitter_decode_dev_ms = d / 4.0f;
+    }
+    radio.jitter_decode_last_ms = now;
+    radio.jitter_decode_audio_ms = written * 1000.0f / (stream_sample_rate() * AUDIO_CHANNELS);
+    radio.jitter_decode_throttled = radio.audio_ring_count > AUDIO_RING_SIZE * 3 / 4;
+
+    jitter_retune();
+}
+
+// Promote BUFFERING to PLAYING once the adaptive start target is reached
+static void jitter_check_start(void) {
+    if (radio.state == RADIO_STATE_BUFFERING &&
+        radio.audio_ring_count >= jitter_samples(radio.jitter_start_ms)) {
+        radio.state = RADIO_STATE_PLAYING;
+
+        uint64_t now = radio_now_ms();
+        if (radio.stats.first_audio_ms < 0 && radio.session_start_ms) {
+            radio.stats.first_audio_ms = (int)(now - radio.session_start_ms);
+        }
+        if (radio.rebuffer_start_ms) {
+            radio.stats.rebuffer_ms += (int)(now - radio.rebuffer_start_ms);
+            radio.rebuffer_start_ms = 0;
+        }
+    }
+}
+
+// The ring ran dry while playing: hold output until it refills
+static void jitter_underrun(void) {
+    radio.state = RADIO_STATE_BUFFERING;
+    radio.stats.rebuffer_count++;
+    radio.rebuffer_start_ms = radio_now_ms();
+}
+
+// Pick a playback speed from the ring level. Caller holds audio_mutex.
+static float jitter_playback_speed(void) {
+    if (radio.audio_ring_count < jitter_samples(radio.jitter_low_ms)) {
+        return JITTER_SPEED_STRETCH;
+    }
+    // HLS fill level is paced by segment throttling, not the server clock,
+    // so only trim latency on direct streams
+    if (radio.stream_type == STREAM_TYPE_DIRECT && !radio.timeshifted &&
+        radio.audio_ring_count > jitter_samples(radio.jitter_start_ms * 3 / 2 + JITTER_MIN_START_MS)) {
+        return JITTER_SPEED_COMPRESS;
+    }
+    return 1.0f;
+}
+
+// Move samples from the ring to out. Caller holds audio_mutex
+static void audio_ring_pop(int16_t* out, int samples) {
+    for (int i = 0; i < samples; i++) {
+        out[i] = radio.audio_ring[radio.audio_ring_read];
+        radio.audio_ring_read = (radio.audio_ring_read + 1) % AUDIO_RING_SIZE;
+    }
+    radio.audio_ring_count -= samples;
+}
+
+// Create the stretcher for the current stream rate. Caller holds audio_mutex
+static bool jitter_stretch_prepare(void) {
+    int rate = stream_sample_rate();
+    if (radio.jitter_ts && radio.jitter_ts_rate != rate) {
+        time_stretch_destroy(radio.jitter_ts);
+        radio.jitter_ts = NULL;
+    }
+    if (!radio.jitter_ts) {
+        radio.jitter_ts = time_stretch_create(rate);
+        radio.jitter_ts_rate = rate;
+    }
+    if (!radio.jitter_out) {
+        radio.jitter_out = malloc(JITTER_STRETCH_OUT * AUDIO_CHANNELS * sizeof(int16_t));
+    }
+    return radio.jitter_ts && radio.jitter_out;
+}
+
+// Back to normal speed: put the input the stretcher still holds back at the
+// front of the ring so playback carries on from where the stretch left off.
+// Caller holds audio_mutex and has played all staged output
+static void jitter_stretch_release(void) {
+    int frames = (int)time_stretch_drain(radio.jitter_ts, radio.jitter_out, JITTER_STRETCH_OUT);
+    int space = (AUDIO_RING_SIZE - radio.audio_ring_count) / AUDIO_CHANNELS;
+    if (frames > space) frames = space;
+
+    int samples = frames * AUDIO_CHANNELS;
+    radio.audio_ring_read = (radio.audio_ring_read - samples + AUDIO_RING_SIZE) % AUDIO_RING_SIZE;
+    for (int i = 0; i < samples; i++) {
+        radio.audio_ring[(radio.audio_ring_read + i) % AUDIO_RING_SIZE] = radio.jitter_out[i];
+    }
+    radio.audio_ring_count += samples;
+
+    radio.jitter_out_len = 0;
+    radio.jitter_out_pos = 0;
+    radio.jitter_stretching = false;
+}
+
+// Fill up to out_frames from the ring. Off target, audio goes through the
+// WSOLA stretcher so the speed changes without shifting pitch.
+// Caller holds audio_mutex. Returns frames written
+static int jitter_read(int16_t* buffer, int out_frames) {
+    float speed = jitter_playback_speed();
+    if (speed != 1.0f && !radio.jitter_stretching) {
+        radio.jitter_stretching = jitter_stretch_prepare();
+    }
+
+    int done = 0;
+    while (radio.jitter_stretching && done < out_frames) {
+        if (radio.jitter_out_pos < radio.jitter_out_len) {
+            int n = radio.jitter_out_len - radio.jitter_out_pos;
+            if (n > out_frames - done) n = out_frames - done;
+            memcpy(buffer + done * AUDIO_CHANNELS, radio.jitter_out + radio.jitter_out_pos * AUDIO_CHANNELS,
+                   n * AUDIO_CHANNELS * sizeof(int16_t));
+            radio.jitter_out_pos += n;
+            done += n;
+            continue;
+        }
+        if (speed == 1.0f) {
+            jitter_stretch_release();
+            break;
+        }
+
+        int feed = radio.audio_ring_count / AUDIO_CHANNELS;
+        if (feed > JITTER_STRETCH_FEED) feed = JITTER_STRETCH_FEED;
+        if (feed == 0) break;
+        int16_t in[JITTER_STRETCH_FEED * AUDIO_CHANNELS];
+        audio_ring_pop(in, feed * AUDIO_CHANNELS);
+        time_stretch_set_speed(radio.jitter_ts, speed);
+        radio.jitter_out_len = (int)time_stretch_process(radio.jitter_ts, in, feed,
+                                                         radio.jitter_out, JITTER_STRETCH_OUT);
+        radio.jitter_out_pos = 0;
+    }
+
+    if (!radio.jitter_stretching) {
+        int n = radio.audio_ring_count / AUDIO_CHANNELS;
+        if (n > out_frames - done) n = out_frames - done;
+        audio_ring_pop(buffer + done * AUDIO_CHANNELS, n * AUDIO_CHANNELS);
+        done += n;
+    }
+    return done;
+}
+
 // Use radio_net_parse_url for URL parsing
 
 // Initialize SSL/TLS
-static int ssl_init(const char* host) {
+static int ssl_init(RadioConn* c, const char* host) {
     int ret;
     const char* pers = "radio_client";
 
-    mbedtls_net_init(&radio.ssl_net);
-    mbedtls_ssl_init(&radio.ssl);
-    mbedtls_ssl_config_init(&radio.ssl_conf);
-    mbedtls_entropy_init(&radio.entropy);
-    mbedtls_ctr_drbg_init(&radio.ctr_drbg);
+    mbedtls_net_init(&c->ssl_net);
+    mbedtls_ssl_init(&c->ssl);
+    mbedtls_ssl_config_init(&c->ssl_conf);
+    mbedtls_entropy_init(&c->entropy);
+    mbedtls_ctr_drbg_init(&c->ctr_drbg);
 
     // Seed random number generator
-    ret = mbedtls_ctr_drbg_seed(&radio.ctr_drbg, mbedtls_entropy_func,
-                                 &radio.entropy, (const unsigned char*)pers, strlen(pers));
+    ret = mbedtls_ctr_drbg_seed(&c->ctr_drbg, mbedtls_entropy_func,
+                                 &c->entropy, (const unsigned char*)pers, strlen(pers));
     if (ret != 0) {
         LOG_error("mbedtls_ctr_drbg_seed failed: %d\n", ret);
         goto ssl_init_error;
     }
 
     // Set up SSL config
-    ret = mbedtls_ssl_config_defaults(&radio.ssl_conf,
+    ret = mbedtls_ssl_config_defaults(&c->ssl_conf,
                                        MBEDTLS_SSL_IS_CLIENT,
                                        MBEDTLS_SSL_TRANSPORT_STREAM,
                                        MBEDTLS_SSL_PRESET_DEFAULT);
@@ -198,123 +582,120 @@ static int ssl_init(const char* host) {
     }
 
     // Skip certificate verification (radio streams use various CAs)
-    mbedtls_ssl_conf_authmode(&radio.ssl_conf, MBEDTLS_SSL_VERIFY_NONE);
-    mbedtls_ssl_conf_rng(&radio.ssl_conf, mbedtls_ctr_drbg_random, &radio.ctr_drbg);
+    mbedtls_ssl_conf_authmode(&c->ssl_conf, MBEDTLS_SSL_VERIFY_NONE);
+    mbedtls_ssl_conf_rng(&c->ssl_conf, mbedtls_ctr_drbg_random, &c->ctr_drbg);
 
     // Set up SSL context
-    ret = mbedtls_ssl_setup(&radio.ssl, &radio.ssl_conf);
+    ret = mbedtls_ssl_setup(&c->ssl, &c->ssl_conf);
     if (ret != 0) {
         LOG_error("mbedtls_ssl_setup failed: %d\n", ret);
         goto ssl_init_error;
     }
 
     // Set hostname for SNI
-    ret = mbedtls_ssl_set_hostname(&radio.ssl, host);
+    ret = mbedtls_ssl_set_hostname(&c->ssl, host);
     if (ret != 0) {
         LOG_error("mbedtls_ssl_set_hostname failed: %d\n", ret);
         goto ssl_init_error;
     }
 
-    radio.ssl_initialized = true;
+    c->ssl_initialized = true;
     return 0;
 
 ssl_init_error:
     // Clean up all initialized contexts on error
-    mbedtls_net_free(&radio.ssl_net);
-    mbedtls_ssl_free(&radio.ssl);
-    mbedtls_ssl_config_free(&radio.ssl_conf);
-    mbedtls_ctr_drbg_free(&radio.ctr_drbg);
-    mbedtls_entropy_free(&radio.entropy);
+    mbedtls_net_free(&c->ssl_net);
+    mbedtls_ssl_free(&c->ssl);
+    mbedtls_ssl_config_free(&c->ssl_conf);
+    mbedtls_ctr_drbg_free(&c->ctr_drbg);
+    mbedtls_entropy_free(&c->entropy);
     return -1;
 }
 
 // Cleanup SSL
-static void ssl_cleanup(void) {
-    if (radio.ssl_initialized) {
-        mbedtls_ssl_close_notify(&radio.ssl);
-        mbedtls_net_free(&radio.ssl_net);
-        mbedtls_ssl_free(&radio.ssl);
-        mbedtls_ssl_config_free(&radio.ssl_conf);
-        mbedtls_ctr_drbg_free(&radio.ctr_drbg);
-        mbedtls_entropy_free(&radio.entropy);
-        radio.ssl_initialized = false;
+static void ssl_cleanup(RadioConn* c) {
+    if (c->ssl_initialized) {
+        mbedtls_ssl_close_notify(&c->ssl);
+        mbedtls_net_free(&c->ssl_net);
+        mbedtls_ssl_free(&c->ssl);
+        mbedtls_ssl_config_free(&c->ssl_conf);
+        mbedtls_ctr_drbg_free(&c->ctr_drbg);
+        mbedtls_entropy_free(&c->entropy);
+        c->ssl_initialized = false;
     }
 }
 
 // Send wrapper (works with both HTTP and HTTPS)
-static int radio_send(const void* buf, size_t len) {
-    if (radio.use_ssl) {
-        return mbedtls_ssl_write(&radio.ssl, buf, len);
+static int radio_send(RadioConn* c, const void* buf, size_t len) {
+    if (c->use_ssl) {
+        return mbedtls_ssl_write(&c->ssl, buf, len);
     } else {
-        return send(radio.socket_fd, buf, len, 0);
+        return send(c->socket_fd, buf, len, 0);
     }
 }
 
 // Receive wrapper (works with both HTTP and HTTPS)
-static int radio_recv(void* buf, size_t len) {
-    if (radio.use_ssl) {
-        return mbedtls_ssl_read(&radio.ssl, buf, len);
+static int radio_recv(RadioConn* c, void* buf, size_t len) {
+    if (c->use_ssl) {
+        return mbedtls_ssl_read(&c->ssl, buf, len);
     } else {
-        return recv(radio.socket_fd, buf, len, 0);
+        return recv(c->socket_fd, buf, len, 0);
     }
 }
 
 // Connect to stream server (supports HTTP and HTTPS)
-static int connect_stream(const char* url) {
+static int connect_stream(RadioConn* c, const char* url) {
     char host[256], path[512];
     int port;
     bool is_https;
     int ret;
+    uint64_t connect_start = radio_now_ms();
 
     if (radio_net_parse_url(url, host, 256, &port, path, 512, &is_https) != 0) {
-        snprintf(radio.error_msg, sizeof(radio.error_msg), "Invalid URL");
+        snprintf(c->error_msg, sizeof(c->error_msg), "Invalid URL");
         return -1;
     }
 
-    radio.use_ssl = is_https;
+    c->use_ssl = is_https;
 
     if (is_https) {
         // HTTPS connection using mbedTLS
-        char port_str[16];
-        snprintf(port_str, sizeof(port_str), "%d", port);
-
         // Initialize SSL
-        if (ssl_init(host) != 0) {
-            snprintf(radio.error_msg, sizeof(radio.error_msg), "SSL init failed");
+        if (ssl_init(c, host) != 0) {
+            snprintf(c->error_msg, sizeof(c->error_msg), "SSL init failed");
             return -1;
         }
 
-        // Connect using mbedTLS
-        ret = mbedtls_net_connect(&radio.ssl_net, host, port_str, MBEDTLS_NET_PROTO_TCP);
-        if (ret != 0) {
-            LOG_error("mbedtls_net_connect failed: %d\n", ret);
-            ssl_cleanup();
-            snprintf(radio.error_msg, sizeof(radio.error_msg), "Connection failed");
+        // Connect through the shared DNS cache; mbedTLS takes over the socket
+        c->ssl_net.fd = net_dns_connect(host, port, RADIO_CONNECT_TIMEOUT_MS);
+        if (c->ssl_net.fd < 0) {
+            ssl_cleanup(c);
+            snprintf(c->error_msg, sizeof(c->error_msg), "Connection failed");
             return -1;
         }
 
         // Set socket for SSL
-        mbedtls_ssl_set_bio(&radio.ssl, &radio.ssl_net,
+        mbedtls_ssl_set_bio(&c->ssl, &c->ssl_net,
                             mbedtls_net_send, mbedtls_net_recv, NULL);
 
         // SSL handshake with timeout protection
         int handshake_retries = 0;
         const int max_handshake_retries = 100;  // 10 seconds with 100ms sleep
-        while ((ret = mbedtls_ssl_handshake(&radio.ssl)) != 0) {
+        while ((ret = mbedtls_ssl_handshake(&c->ssl)) != 0) {
             // TLS 1.3: session ticket received means handshake is complete
             if (ret == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET) {
                 break;
             }
             if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
                 LOG_error("mbedtls_ssl_handshake failed: -0x%04X\n", -ret);
-                ssl_cleanup();
-                snprintf(radio.error_msg, sizeof(radio.error_msg), "SSL handshake failed");
+                ssl_cleanup(c);
+                snprintf(c->error_msg, sizeof(c->error_msg), "SSL handshake failed");
                 return -1;
             }
             if (++handshake_retries > max_handshake_retries) {
                 LOG_error("SSL handshake timeout after %d retries\n", handshake_retries);
-                ssl_cleanup();
-                snprintf(radio.error_msg, sizeof(radio.error_msg), "SSL handshake timeout");
+                ssl_cleanup(c);
+                snprintf(c->error_msg, sizeof(c->error_msg), "SSL handshake timeout");
                 return -1;
             }
             usleep(100000);  // 100ms sleep between retries
@@ -322,47 +703,24 @@ static int connect_stream(const char* url) {
 
 
         // Store socket fd for select() compatibility
-        radio.socket_fd = radio.ssl_net.fd;
+        c->socket_fd = c->ssl_net.fd;
     } else {
-        // Plain HTTP connection - use getaddrinfo (thread-safe)
-        struct addrinfo hints, *result = NULL;
-        memset(&hints, 0, sizeof(hints));
-        hints.ai_family = AF_INET;
-        hints.ai_socktype = SOCK_STREAM;
-
-        char port_str[16];
-        snprintf(port_str, sizeof(port_str), "%d", port);
-
-        int gai_ret = getaddrinfo(host, port_str, &hints, &result);
-        if (gai_ret != 0 || !result) {
-            if (result) freeaddrinfo(result);
-            snprintf(radio.error_msg, sizeof(radio.error_msg), "DNS lookup failed");
-            return -1;
-        }
-
-        radio.socket_fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
-        if (radio.socket_fd < 0) {
-            freeaddrinfo(result);
-            snprintf(radio.error_msg, sizeof(radio.error_msg), "Socket creation failed");
+        // Plain HTTP connection
+        c->socket_fd = net_dns_connect(host, port, RADIO_CONNECT_TIMEOUT_MS);
+        if (c->socket_fd < 0) {
+            snprintf(c->error_msg, sizeof(c->error_msg), "Connection failed");
             return -1;
         }
 
         struct timeval tv;
         tv.tv_sec = 10;
         tv.tv_usec = 0;
-        setsockopt(radio.socket_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-        setsockopt(radio.socket_fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
-
-        if (connect(radio.socket_fd, result->ai_addr, result->ai_addrlen) < 0) {
-            close(radio.socket_fd);
-            radio.socket_fd = -1;
-            freeaddrinfo(result);
-            snprintf(radio.error_msg, sizeof(radio.error_msg), "Connection failed");
-            return -1;
-        }
-        freeaddrinfo(result);
+        setsockopt(c->socket_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(c->socket_fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
     }
 
+    c->connect_ms = (int)(radio_now_ms() - connect_start);
+
     // Send HTTP request with ICY headers
     char request[1024];
     snprintf(request, sizeof(request),
@@ -375,14 +733,14 @@ static int connect_stream(const char* url) {
         "\r\n",
         path, host);
 
-    if (radio_send(request, strlen(request)) < 0) {
-        if (radio.use_ssl) {
-            ssl_cleanup();
+    if (radio_send(c, request, strlen(request)) < 0) {
+        if (c->use_ssl) {
+            ssl_cleanup(c);
         } else {
-            close(radio.socket_fd);
+            close(c->socket_fd);
         }
-        radio.socket_fd = -1;
-        snprintf(radio.error_msg, sizeof(radio.error_msg), "Send failed");
+        c->socket_fd = -1;
+        snprintf(c->error_msg, sizeof(c->error_msg), "Send failed");
         return -1;
     }
 
@@ -391,20 +749,20 @@ static int connect_stream(const char* url) {
 
 // Parse HTTP response headers
 // Returns: 0 = success, 1 = redirect (check redirect_url), -1 = error
-static int parse_headers(void) {
+static int parse_headers(RadioConn* c) {
     char header_buf[4096];
     int header_pos = 0;
-    char c;
+    char ch;
 
-    radio.redirect_url[0] = '\0';
+    c->redirect_url[0] = '\0';
 
     // Read headers until \r\n\r\n
     while (header_pos < sizeof(header_buf) - 1) {
-        if (radio_recv(&c, 1) != 1) {
-            snprintf(radio.error_msg, sizeof(radio.error_msg), "Header read failed");
+        if (radio_recv(c, &ch, 1) != 1) {
+            snprintf(c->error_msg, sizeof(c->error_msg), "Header read failed");
             return -1;
         }
-        header_buf[header_pos++] = c;
+        header_buf[header_pos++] = ch;
 
         // Check for end of headers
         if (header_pos >= 4 &&
@@ -418,7 +776,7 @@ static int parse_headers(void) {
 
     // Check for HTTP or ICY response
     if (strncmp(header_buf, "HTTP/1.", 7) != 0 && strncmp(header_buf, "ICY", 3) != 0) {
-        snprintf(radio.error_msg, sizeof(radio.error_msg), "Invalid response");
+        snprintf(c->error_msg, sizeof(c->error_msg), "Invalid response");
         return -1;
     }
 
@@ -444,71 +802,167 @@ static int parse_headers(void) {
 
                 int len = end - loc;
                 if (len > 0 && len < RADIO_MAX_URL) {
-                    strncpy(radio.redirect_url, loc, len);
-                    radio.redirect_url[len] = '\0';
+                    strncpy(c->redirect_url, loc, len);
+                    c->redirect_url[len] = '\0';
                     return 1;  // Indicate redirect
                 }
             }
-            snprintf(radio.error_msg, sizeof(radio.error_msg), "Redirect without Location");
+            snprintf(c->error_msg, sizeof(c->error_msg), "Redirect without Location");
             return -1;
         }
 
         // Check for error status
         if (http_status >= 400) {
-            snprintf(radio.error_msg, sizeof(radio.error_msg), "HTTP error %d", http_status);
+            snprintf(c->error_msg, sizeof(c->error_msg), "HTTP error %d", http_status);
             return -1;
         }
     }
 
     // Parse ICY headers
-    radio.icy_metaint = 0;
-    radio.metadata.bitrate = 0;
-    radio.metadata.station_name[0] = '\0';
-    radio.metadata.content_type[0] = '\0';
+    c->icy_metaint = 0;
+    c->bitrate = 0;
+    c->station_name[0] = '\0';
+    c->content_type[0] = '\0';
 
     char* line = strtok(header_buf, "\r\n");
     while (line) {
         if (strncasecmp(line, "icy-metaint:", 12) == 0) {
-            radio.icy_metaint = atoi(line + 12);
+            c->icy_metaint = atoi(line + 12);
         }
         else if (strncasecmp(line, "icy-br:", 7) == 0) {
-            radio.metadata.bitrate = atoi(line + 7);
+            c->bitrate = atoi(line + 7);
         }
         else if (strncasecmp(line, "icy-name:", 9) == 0) {
-            strncpy(radio.metadata.station_name, line + 9, sizeof(radio.metadata.station_name) - 1);
+            strncpy(c->station_name, line + 9, sizeof(c->station_name) - 1);
             // Trim leading space
-            char* name = radio.metadata.station_name;
+            char* name = c->station_name;
             while (*name == ' ') name++;
-            memmove(radio.metadata.station_name, name, strlen(name) + 1);
+            memmove(c->station_name, name, strlen(name) + 1);
         }
         else if (strncasecmp(line, "content-type:", 13) == 0) {
-            strncpy(radio.metadata.content_type, line + 13, sizeof(radio.metadata.content_type) - 1);
+            strncpy(c->content_type, line + 13, sizeof(c->content_type) - 1);
         }
         line = strtok(NULL, "\r\n");
     }
 
-    radio.bytes_until_meta = radio.icy_metaint;
-
     // Detect audio format from content type
-    radio.audio_format = RADIO_FORMAT_MP3;  // Default to MP3
-    const char* ct = radio.metadata.content_type;
+    c->audio_format = RADIO_FORMAT_MP3;  // Default to MP3
+    const char* ct = c->content_type;
     if (ct[0]) {
         // Skip leading whitespace
         while (*ct == ' ') ct++;
 
-        if (strcasestr(ct, "aac") != NULL ||
+        if (strcasestr(ct, "ogg") != NULL ||
+            strcasestr(ct, "opus") != NULL ||
+            strcasestr(ct, "vorbis") != NULL) {
+            c->audio_format = RADIO_FORMAT_OGG;
+        } else if (strcasestr(ct, "aac") != NULL ||
             strcasestr(ct, "mp4") != NULL ||
             strcasestr(ct, "m4a") != NULL) {
-            radio.audio_format = RADIO_FORMAT_AAC;
+            c->audio_format = RADIO_FORMAT_AAC;
         } else if (strcasestr(ct, "mpeg") != NULL ||
                    strcasestr(ct, "mp3") != NULL) {
-            radio.audio_format = RADIO_FORMAT_MP3;
+            c->audio_format = RADIO_FORMAT_MP3;
         }
     }
 
     return 0;
 }
 
+// Close a connection (either transport)
+static void conn_close(RadioConn* c) {
+    if (c->use_ssl) {
+        ssl_cleanup(c);
+        c->use_ssl = false;
+    } else if (c->socket_fd >= 0) {
+        close(c->socket_fd);
+    }
+    c->socket_fd = -1;
+}
+
+// Connect and read response headers, following up to 5 redirects
+// Returns 0 with the connection ready to stream, or -1 with c->error_msg set
+static int open_stream(RadioConn* c, const char* url) {
+    char current_url[RADIO_MAX_URL];
+    strncpy(current_url, url, RADIO_MAX_URL - 1);
+    current_url[RADIO_MAX_URL - 1] = '\0';
+
+    int max_redirects = 5;
+
+    for (int redirect_count = 0; redirect_count <= max_redirects; redirect_count++) {
+        // Connect to stream
+        if (connect_stream(c, current_url) != 0) {
+            return -1;
+        }
+
+        // Parse headers
+        int header_result = parse_headers(c);
+
+        if (header_result == 0) {
+            // Success - headers parsed, ready to stream
+            strncpy(c->final_url, current_url, RADIO_MAX_URL - 1);
+            c->final_url[RADIO_MAX_URL - 1] = '\0';
+            return 0;
+        }
+
+        // Redirect or error - cleanup current connection
+        conn_close(c);
+        if (header_result != 1) {
+            return -1;
+        }
+
+        if (c->redirect_url[0] == '\0') {
+            snprintf(c->error_msg, sizeof(c->error_msg), "Empty redirect URL");
+            return -1;
+        }
+
+        strncpy(current_url, c->redirect_url, RADIO_MAX_URL - 1);
+        current_url[RADIO_MAX_URL - 1] = '\0';
+    }
+
+    snprintf(c->error_msg, sizeof(c->error_msg), "Too many redirects");
+    return -1;
+}
+
+// Adopt a connection's response headers as the current stream's
+static void conn_apply_headers(RadioConn* c) {
+    radio.icy_metaint = c->icy_metaint;
+    radio.bytes_until_meta = c->icy_metaint;
+    radio.icy_meta_len = -1;
+    radio.metadata.bitrate = c->bitrate;
+    strncpy(radio.metadata.station_name, c->station_name, sizeof(radio.metadata.station_name) - 1);
+    strncpy(radio.metadata.content_type, c->content_type, sizeof(radio.metadata.content_type) - 1);
+    radio.audio_format = c->audio_format;
+}
+
+// Set the now-playing track. An empty artist means the title may be
+// "Artist - Title" (the usual stream title format).
+static void set_stream_title(const char* artist, const char* title) {
+    // Save old values to detect changes
+    char old_artist[256], old_title[256];
+    strncpy(old_artist, radio.metadata.artist, sizeof(old_artist) - 1);
+    old_artist[sizeof(old_artist) - 1] = '\0';
+    strncpy(old_title, radio.metadata.title, sizeof(old_title) - 1);
+    old_title[sizeof(old_title) - 1] = '\0';
+
+    strncpy(radio.metadata.title, title, sizeof(radio.metadata.title) - 1);
+    strncpy(radio.metadata.artist, artist, sizeof(radio.metadata.artist) - 1);
+
+    // Try to parse "Artist - Title" format
+    char* separator = artist[0] ? NULL : strstr(radio.metadata.title, " - ");
+    if (separator) {
+        *separator = '\0';
+        strncpy(radio.metadata.artist, radio.metadata.title, sizeof(radio.metadata.artist) - 1);
+        memmove(radio.metadata.title, separator + 3, strlen(separator + 3) + 1);
+    }
+
+    // Fetch album art if metadata changed
+    if (strcmp(old_artist, radio.metadata.artist) != 0 ||
+        strcmp(old_title, radio.metadata.title) != 0) {
+        album_art_fetch(radio.metadata.artist, radio.metadata.title);
+    }
+}
+
 // Parse ICY metadata block
 static void parse_icy_metadata(const uint8_t* data, int len) {
     // Format: StreamTitle='Artist - Title';StreamUrl='...';
@@ -517,11 +971,6 @@ static void parse_icy_metadata(const uint8_t* data, int len) {
     memcpy(meta, data, len);
     meta[len] = '\0';
 
-    // Save old values to detect changes
-    char old_artist[256], old_title[256];
-    strncpy(old_artist, radio.metadata.artist, sizeof(old_artist) - 1);
-    strncpy(old_title, radio.metadata.title, sizeof(old_title) - 1);
-
     // Find StreamTitle
     char* title_start = strstr(meta, "StreamTitle='");
     if (title_start) {
@@ -529,25 +978,37 @@ static void parse_icy_metadata(const uint8_t* data, int len) {
         char* title_end = strchr(title_start, '\'');
         if (title_end) {
             *title_end = '\0';
-            strncpy(radio.metadata.title, title_start, sizeof(radio.metadata.title) - 1);
-
-            // Try to parse "Artist - Title" format
-            char* separator = strstr(radio.metadata.title, " - ");
-            if (separator) {
-                *separator = '\0';
-                strncpy(radio.metadata.artist, radio.metadata.title, sizeof(radio.metadata.artist) - 1);
-                memmove(radio.metadata.title, separator + 3, strlen(separator + 3) + 1);
-            } else {
-                radio.metadata.artist[0] = '\0';
-            }
+            set_stream_title("", title_start);
+        }
+    }
+}
 
-            // Fetch album art if metadata changed
-            if (strcmp(old_artist, radio.metadata.artist) != 0 ||
-                strcmp(old_title, radio.metadata.title) != 0) {
-                album_art_fetch(radio.metadata.artist, radio.metadata.title);
-            }
+// Ogg streams carry titles in each chain's comment header instead of ICY metadata
+static void ogg_tags_callback(const char* artist, const char* title) {
+    set_stream_title(artist, title);
+}
+
+// Decoded Ogg audio (stereo) into the ring buffer
+static void ogg_pcm_callback(const int16_t* pcm, int frames, int sample_rate) {
+    // Chains can change sample rate on a track change
+    if (radio.ogg_sample_rate != sample_rate) {
+        radio.ogg_sample_rate = sample_rate;
+        Player_setSampleRate(sample_rate);
+        Player_resumeAudio();  // Resume after reconfiguration
+    }
+
+    pthread_mutex_lock(&radio.audio_mutex);
+
+    int total_samples = frames * 2;
+    for (int s = 0; s < total_samples; s++) {
+        if (radio.audio_ring_count < AUDIO_RING_SIZE) {
+            radio.audio_ring[radio.audio_ring_write] = pcm[s];
+            radio.audio_ring_write = (radio.audio_ring_write + 1) % AUDIO_RING_SIZE;
+            radio.audio_ring_count++;
         }
     }
+
+    pthread_mutex_unlock(&radio.audio_mutex);
 }
 
 // ============== HLS SUPPORT ==============
@@ -564,35 +1025,67 @@ static pthread_t hls_prefetch_thread;
 static volatile bool hls_prefetch_thread_active = false;
 
 // HLS segment prefetch worker thread
+// Fold a segment download into the throughput estimate. Caller holds hls_mutex.
+static void hls_note_throughput(int bytes, uint64_t ms) {
+    if (ms < 1) ms = 1;
+    float bps = bytes * 8000.0f / ms;
+    if (radio.hls_throughput_bps <= 0) {
+        radio.hls_throughput_bps = bps;
+    } else {
+        radio.hls_throughput_bps += (bps - radio.hls_throughput_bps) * 0.3f;
+    }
+    radio.metadata.throughput = (int)(radio.hls_throughput_bps / 1000);
+}
+
+// Reflect the active HLS variant in the metadata
+static void hls_update_variant_metadata(void) {
+    radio.metadata.variant_count = radio.hls.variant_count;
+    radio.metadata.variant_index = radio.hls.current_variant;
+    radio.metadata.variant_bitrate = radio.hls.variant_count > 0 ?
+        radio.hls.variants[radio.hls.current_variant].bandwidth / 1000 : 0;
+}
+
 static void* hls_prefetch_thread_func(void* arg) {
-    int seg_idx = (int)(intptr_t)arg;
+    int seg_seq = (int)(intptr_t)arg;
 
-    // Validate segment index under mutex
+    // Validate segment is still in the ring under mutex
     pthread_mutex_lock(&radio.hls_mutex);
+    int seg_idx = seg_seq - radio.hls.media_sequence;
     if (seg_idx < 0 || seg_idx >= radio.hls.segment_count || radio.should_stop) {
         pthread_mutex_unlock(&radio.hls_mutex);
         return NULL;
     }
 
-    // Copy URL to local buffer to avoid use-after-free
+    // Copy URL to local buffer - the refresher may recycle the ring slot
     char local_url[HLS_MAX_URL_LEN];
-    strncpy(local_url, radio.hls.segments[seg_idx].url, HLS_MAX_URL_LEN - 1);
+    strncpy(local_url, radio_hls_segment(&radio.hls, seg_idx)->url, HLS_MAX_URL_LEN - 1);
     local_url[HLS_MAX_URL_LEN - 1] = '\0';
+
+    // Segments can live on rotating CDN hosts - warm DNS for the one after this
+    char next_url[HLS_MAX_URL_LEN] = "";
+    if (seg_idx + 1 < radio.hls.segment_count) {
+        strncpy(next_url, radio_hls_segment(&radio.hls, seg_idx + 1)->url, HLS_MAX_URL_LEN - 1);
+        next_url[HLS_MAX_URL_LEN - 1] = '\0';
+    }
     pthread_mutex_unlock(&radio.hls_mutex);
 
     if (local_url[0] == '\0') {
         return NULL;
     }
+    if (next_url[0]) net_dns_prefetch_url(next_url);
 
     // Fetch segment into prefetch buffer (outside mutex - network I/O)
+    uint64_t fetch_start = radio_now_ms();
     int len = radio_net_fetch(local_url, radio.hls_prefetch_buf,
                                 HLS_SEGMENT_BUF_SIZE, NULL, 0);
+    uint64_t fetch_ms = radio_now_ms() - fetch_start;
 
     // Only mark as ready if fetch succeeded and we're not stopping
     pthread_mutex_lock(&radio.hls_mutex);
     if (len > 0 && !radio.should_stop) {
+        hls_note_throughput(len, fetch_ms);
         radio.hls_prefetch_len = len;
-        radio.hls_prefetch_segment = seg_idx;
+        radio.hls_prefetch_segment = seg_seq;
         radio.hls_prefetch_ready = true;
     }
     pthread_mutex_unlock(&radio.hls_mutex);
@@ -600,8 +1093,8 @@ static void* hls_prefetch_thread_func(void* arg) {
     return NULL;
 }
 
-// Start prefetching a segment in the background
-static void start_segment_prefetch(int segment_idx) {
+// Start prefetching a segment (by sequence number) in the background
+static void start_segment_prefetch(int segment_seq) {
     // Don't prefetch if stopping or buffer not allocated
     if (radio.should_stop || !radio.hls_prefetch_buf) {
         return;
@@ -613,16 +1106,153 @@ static void start_segment_prefetch(int segment_idx) {
         hls_prefetch_thread_active = false;
     }
 
-    // Validate segment index
-    if (segment_idx < 0 || segment_idx >= radio.hls.segment_count) {
+    // Start prefetch thread (it validates the sequence against the ring)
+    if (pthread_create(&hls_prefetch_thread, NULL, hls_prefetch_thread_func,
+                       (void*)(intptr_t)segment_seq) == 0) {
+        hls_prefetch_thread_active = true;
+    }
+}
+
+// Switch HLS variant at a segment boundary when throughput or buffer health calls for it
+static void hls_check_variant_switch(void) {
+    if (radio.hls.variant_count < 2) return;
+
+    // Decoded audio plus a prefetched segment waiting to be decoded
+    int rate = stream_sample_rate();
+    float buffered_sec = (float)radio.audio_ring_count / (rate * AUDIO_CHANNELS);
+    pthread_mutex_lock(&radio.hls_mutex);
+    int prefetched = radio.hls_prefetch_segment - radio.hls.media_sequence;
+    if (radio.hls_prefetch_ready && prefetched >= 0 && prefetched < radio.hls.segment_count) {
+        buffered_sec += radio_hls_segment(&radio.hls, prefetched)->duration;
+    }
+    pthread_mutex_unlock(&radio.hls_mutex);
+
+    // Thresholds follow the jitter targets rather than the segment length:
+    // the HLS thread stops filling the ring at 90%, so with 6-10s segments
+    // whole multiples of one could never be reached
+    float low_sec = radio.jitter_low_ms / 1000.0f;
+    float high_sec = (radio.jitter_start_ms + radio.jitter_low_ms) / 1000.0f;
+    float fill_sec = (float)AUDIO_RING_SIZE * 9 / 10 / (rate * AUDIO_CHANNELS);
+    if (high_sec > fill_sec * 3 / 4) high_sec = fill_sec * 3 / 4;
+    int target = radio_hls_select_variant(&radio.hls, (int)radio.hls_throughput_bps, buffered_sec,
+                                          low_sec, high_sec);
+    if (target == radio.hls.current_variant) return;
+
+    // Any prefetched segment belongs to the old variant
+    if (hls_prefetch_thread_active) {
+        pthread_join(hls_prefetch_thread, NULL);
+        hls_prefetch_thread_active = false;
+    }
+
+    // Load the new media playlist off to the side so a failure leaves playback untouched
+    HLSContext* next = malloc(sizeof(HLSContext));
+    if (!next) return;
+    pthread_mutex_lock(&radio.hls_mutex);
+    memcpy(next, &radio.hls, sizeof(HLSContext));
+    pthread_mutex_unlock(&radio.hls_mutex);
+    if (radio_hls_load_variant(next, target) <= 0) {
+        LOG_error("[HLS] Failed to load variant %d\n", target);
+        free(next);
         return;
     }
 
-    // Start prefetch thread
-    if (pthread_create(&hls_prefetch_thread, NULL, hls_prefetch_thread_func,
-                       (void*)(intptr_t)segment_idx) == 0) {
-        hls_prefetch_thread_active = true;
+    // Variants of one stream share sequence numbering - continue after the last played one
+    int start_idx = 0;
+    if (next->last_played_sequence >= 0) {
+        start_idx = next->last_played_sequence + 1 - next->media_sequence;
+        if (start_idx < 0) start_idx = 0;
+        if (start_idx > next->segment_count) start_idx = next->segment_count;
+    }
+    next->current_segment = start_idx;
+
+    pthread_mutex_lock(&radio.hls_mutex);
+    memcpy(&radio.hls, next, sizeof(HLSContext));
+    radio.hls_prefetch_ready = false;
+    radio.hls_prefetch_segment = -1;
+    pthread_mutex_unlock(&radio.hls_mutex);
+    free(next);
+
+    hls_update_variant_metadata();
+}
+
+static pthread_t hls_refresh_thread;
+static volatile bool hls_refresh_running = false;
+
+// Background live playlist refresher. Re-polls the active media playlist every
+// half target duration and appends new segments to the ring, so the segment
+// list stays ahead of playback instead of being refetched at the window edge.
+static void* hls_refresh_thread_func(void* arg) {
+    (void)arg;
+
+    uint8_t* playlist_buf = malloc(64 * 1024);
+    HLSContext* fresh = malloc(sizeof(HLSContext));
+    if (!playlist_buf || !fresh) {
+        LOG_error("[HLS] Failed to allocate playlist refresh buffers\n");
+        free(playlist_buf);
+        free(fresh);
+        return NULL;
+    }
+
+    uint64_t next_due = radio_now_ms();
+    while (hls_refresh_running && !radio.should_stop) {
+        pthread_mutex_lock(&radio.hls_mutex);
+        float target = radio.hls.target_duration;
+        bool is_live = radio.hls.is_live;
+        char url[HLS_MAX_URL_LEN];
+        strcpy(url, radio.hls.media_url[0] ? radio.hls.media_url : radio.current_url);
+        pthread_mutex_unlock(&radio.hls_mutex);
+
+        if (!is_live) break;
+
+        uint64_t interval_ms = target > 0 ? (uint64_t)(target * 500.0f) : 5000;
+        if (interval_ms < 1000) interval_ms = 1000;
+        next_due += interval_ms;
+
+        // Sleep in short slices so Radio_stop stays responsive
+        while (hls_refresh_running && !radio.should_stop && radio_now_ms() < next_due) {
+            usleep(50000);
+        }
+        if (!hls_refresh_running || radio.should_stop) break;
+
+        // Don't let a slow fetch cause a burst of catch-up refreshes
+        uint64_t fetch_start = radio_now_ms();
+        if (next_due < fetch_start) next_due = fetch_start;
+
+        int len = radio_net_fetch(url, playlist_buf, 64 * 1024 - 1, NULL, 0);
+        if (len <= 0) continue;
+        playlist_buf[len] = '\0';
+
+        char base_url[HLS_MAX_URL_LEN];
+        radio_hls_get_base_url(url, base_url, HLS_MAX_URL_LEN);
+        memset(fresh, 0, sizeof(HLSContext));
+        radio_hls_parse_playlist(fresh, (char*)playlist_buf, base_url);
+
+        pthread_mutex_lock(&radio.hls_mutex);
+        // Discard if a variant switch replaced the playlist while we were fetching
+        const char* active = radio.hls.media_url[0] ? radio.hls.media_url : radio.current_url;
+        if (fresh->segment_count > 0 && strcmp(url, active) == 0) {
+            if (radio_hls_merge_playlist(&radio.hls, fresh) > 0) {
+                pthread_cond_signal(&radio.hls_segments_cond);
+            }
+        }
+        if (!fresh->is_live) {
+            radio.hls.is_live = false;
+            pthread_cond_signal(&radio.hls_segments_cond);
+        }
+        pthread_mutex_unlock(&radio.hls_mutex);
     }
+
+    free(fresh);
+    free(playlist_buf);
+    return NULL;
+}
+
+// Mark the current segment as played and move to the next one
+static void hls_advance_segment(void) {
+    pthread_mutex_lock(&radio.hls_mutex);
+    radio.hls.last_played_sequence = radio.hls.media_sequence + radio.hls.current_segment;
+    radio.hls.current_segment++;
+    pthread_mutex_unlock(&radio.hls_mutex);
 }
 
 // HLS streaming thread
@@ -652,45 +1282,37 @@ static void* hls_stream_thread_func(void* arg) {
 
     radio.state = RADIO_STATE_BUFFERING;
 
+    // Keep the live segment list ahead of playback
+    if (radio.hls.is_live) {
+        hls_refresh_running = true;
+        if (pthread_create(&hls_refresh_thread, NULL, hls_refresh_thread_func, NULL) != 0) {
+            LOG_error("[HLS] Failed to start playlist refresher\n");
+            hls_refresh_running = false;
+        }
+    }
+
     int loop_iteration = 0;
     while (!radio.should_stop) {
         loop_iteration++;
 
-        // Check if we need to refresh the playlist (for live streams)
-        if (radio.hls.is_live && radio.hls.current_segment >= radio.hls.segment_count) {
-            // Fetch updated playlist
-            uint8_t* playlist_buf = malloc(64 * 1024);
-            if (playlist_buf) {
-                int len = radio_net_fetch(radio.current_url, playlist_buf, 64 * 1024, NULL, 0);
-                if (len > 0) {
-                    playlist_buf[len] = '\0';
-                    char base_url[HLS_MAX_URL_LEN];
-                    radio_hls_get_base_url(radio.current_url, base_url, HLS_MAX_URL_LEN);
-
-                    radio_hls_parse_playlist(&radio.hls, (char*)playlist_buf, base_url);
-
-                    // Skip segments we've already played based on last_played_sequence
-                    // media_sequence is the sequence number of the first segment in the new playlist
-                    // We want to start at last_played_sequence + 1
-                    if (radio.hls.last_played_sequence >= 0) {
-                        int next_seq = radio.hls.last_played_sequence + 1;
-                        int start_idx = next_seq - radio.hls.media_sequence;
-                        if (start_idx < 0) start_idx = 0;
-                        if (start_idx > radio.hls.segment_count) start_idx = radio.hls.segment_count;
-                        radio.hls.current_segment = start_idx;
-                    } else {
-                        radio.hls.current_segment = 0;
-                    }
-                }
-                free(playlist_buf);
-            }
-
-            // If still no segments, wait a bit
-            if (radio.hls.current_segment >= radio.hls.segment_count) {
-                usleep(100000);  // 100ms
-                continue;
+        // Live playlists are refreshed in the background - wait for new segments
+        pthread_mutex_lock(&radio.hls_mutex);
+        while (radio.hls.is_live && !radio.should_stop &&
+               radio.hls.current_segment >= radio.hls.segment_count) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += 200 * 1000000;
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000;
             }
+            pthread_cond_timedwait(&radio.hls_segments_cond, &radio.hls_mutex, &deadline);
         }
+        pthread_mutex_unlock(&radio.hls_mutex);
+        if (radio.should_stop) break;
+
+        // Segment boundary - adapt bitrate to measured throughput
+        hls_check_variant_switch();
 
         // Get next segment
         if (radio.hls.current_segment >= radio.hls.segment_count) {
@@ -698,16 +1320,17 @@ static void* hls_stream_thread_func(void* arg) {
                 // End of stream
                 break;
             }
-            usleep(100000);
             continue;
         }
 
         // Wait if buffer is nearly full to prevent overflow
         // Use high threshold (90%) and short wait to minimize network fetch delays
+        uint64_t wait_start = radio_now_ms();
         while (radio.audio_ring_count > AUDIO_RING_SIZE * 9 / 10 && !radio.should_stop) {
             usleep(50000);  // 50ms - short wait, check frequently
         }
         if (radio.should_stop) break;
+        uint64_t throttle_ms = radio_now_ms() - wait_start;
 
         // Validate segment index
         if (radio.hls.current_segment < 0 || radio.hls.current_segment >= HLS_MAX_SEGMENTS) {
@@ -715,9 +1338,16 @@ static void* hls_stream_thread_func(void* arg) {
             break;
         }
 
-        const char* seg_url = radio.hls.segments[radio.hls.current_segment].url;
-        const char* seg_title = radio.hls.segments[radio.hls.current_segment].title;
-        const char* seg_artist = radio.hls.segments[radio.hls.current_segment].artist;
+        // Copy the segment out of the ring - the refresher may recycle played slots
+        HLSSegment seg;
+        pthread_mutex_lock(&radio.hls_mutex);
+        int seg_sequence = radio.hls.media_sequence + radio.hls.current_segment;
+        memcpy(&seg, radio_hls_segment(&radio.hls, radio.hls.current_segment), sizeof(HLSSegment));
+        pthread_mutex_unlock(&radio.hls_mutex);
+
+        const char* seg_url = seg.url;
+        const char* seg_title = seg.title;
+        const char* seg_artist = seg.artist;
 
         // Save old metadata BEFORE any updates to detect changes for album art fetch
         char old_artist[256], old_title[256];
@@ -737,7 +1367,7 @@ static void* hls_stream_thread_func(void* arg) {
         // Validate URL
         if (!seg_url || seg_url[0] == '\0') {
             LOG_error("[HLS] Empty segment URL at index %d\n", radio.hls.current_segment);
-            radio.hls.current_segment++;
+            hls_advance_segment();
             continue;
         }
 
@@ -746,7 +1376,7 @@ static void* hls_stream_thread_func(void* arg) {
         bool use_prefetch = false;
         pthread_mutex_lock(&radio.hls_mutex);
         if (radio.hls_prefetch_ready &&
-            radio.hls_prefetch_segment == radio.hls.current_segment) {
+            radio.hls_prefetch_segment == seg_sequence) {
             // Use prefetched data - instant, no network wait
             seg_len = radio.hls_prefetch_len;
             memcpy(segment_buf, radio.hls_prefetch_buf, seg_len);
@@ -761,8 +1391,14 @@ static void* hls_stream_thread_func(void* arg) {
             int retry_count = 0;
             const int max_retries = 3;
             while (retry_count < max_retries) {
+                uint64_t fetch_start = radio_now_ms();
                 seg_len = radio_net_fetch(seg_url, segment_buf, HLS_SEGMENT_BUF_SIZE, NULL, 0);
-                if (seg_len > 0) break;
+                if (seg_len > 0) {
+                    pthread_mutex_lock(&radio.hls_mutex);
+                    hls_note_throughput(seg_len, radio_now_ms() - fetch_start);
+                    pthread_mutex_unlock(&radio.hls_mutex);
+                    break;
+                }
                 retry_count++;
                 if (retry_count < max_retries && !radio.should_stop) {
                     usleep(100000 * retry_count);  // 100ms, 200ms, 300ms delays
@@ -770,22 +1406,27 @@ static void* hls_stream_thread_func(void* arg) {
             }
             if (seg_len <= 0) {
                 LOG_error("[HLS] Failed to fetch segment after %d retries: %s\n", max_retries, seg_url);
-                radio.hls.current_segment++;
+                hls_advance_segment();
                 continue;
             }
         }
 
+        // Segment arrival time drives the jitter estimate (throttle time excluded)
+        jitter_note_arrival(throttle_ms);
+        radio.jitter_idle_ms += throttle_ms;
+
         // Start prefetching next segment in background while we process current one
-        int next_seg = radio.hls.current_segment + 1;
+        int next_seq = seg_sequence + 1;
         pthread_mutex_lock(&radio.hls_mutex);
-        bool should_prefetch = (next_seg < radio.hls.segment_count && !radio.hls_prefetch_ready);
+        bool should_prefetch = (next_seq - radio.hls.media_sequence < radio.hls.segment_count &&
+                                !radio.hls_prefetch_ready);
         pthread_mutex_unlock(&radio.hls_mutex);
         if (should_prefetch) {
-            start_segment_prefetch(next_seg);
+            start_segment_prefetch(next_seq);
         }
 
         // Calculate and update bitrate from segment size and duration
-        float seg_duration = radio.hls.segments[radio.hls.current_segment].duration;
+        float seg_duration = seg.duration;
         if (seg_duration > 0) {
             int bitrate = (int)((seg_len * 8.0f) / (seg_duration * 1000.0f));
             if (bitrate > 0 && bitrate < 1000) {  // Sanity check (0-1000 kbps)
@@ -833,14 +1474,18 @@ static void* hls_stream_thread_func(void* arg) {
             int frames_decoded = 0;
             int aac_pos = 0;  // Current position in aac_buf
 
-            // Process all AAC data from segment
-            while (aac_pos < aac_len && !radio.should_stop) {
+            // Process all AAC data from segment. The decoder only takes what fits its
+            // input buffer, so keep decoding after the last fill until it runs dry:
+            // the next segment clears that buffer
+            while (!radio.should_stop) {
                 // Feed data to FDK-AAC (it handles ADTS sync internally)
                 UCHAR* inBuffer[] = { aac_buf + aac_pos };
                 UINT inBufferLength[] = { (UINT)(aac_len - aac_pos) };
                 UINT bytesValid[] = { (UINT)(aac_len - aac_pos) };
 
-                aacDecoder_Fill(radio.aac_decoder, inBuffer, inBufferLength, bytesValid);
+                if (aac_pos < aac_len) {
+                    aacDecoder_Fill(radio.aac_decoder, inBuffer, inBufferLength, bytesValid);
+                }
 
                 // Decode frames until no more data
                 INT_PCM decode_buf[2048 * 2];  // HE-AAC can output 2048 frames stereo
@@ -878,7 +1523,7 @@ static void* hls_stream_thread_func(void* arg) {
 
                         pthread_mutex_unlock(&radio.audio_mutex);
                     }
-                } else if (err == AAC_DEC_NOT_ENOUGH_BITS) {
+                } else if (err == AAC_DEC_NOT_ENOUGH_BITS || aac_pos >= aac_len) {
                     break;
                 } else if (err == AAC_DEC_TRANSPORT_SYNC_ERROR) {
                     // Sync lost, try to continue with remaining data
@@ -890,17 +1535,17 @@ static void* hls_stream_thread_func(void* arg) {
             }
         }
 
-        // Update state based on buffer level - require 10 seconds of audio before playing
-        // This provides maximum headroom for network latency
-        if (radio.state == RADIO_STATE_BUFFERING &&
-            radio.audio_ring_count > SAMPLE_RATE * 2 * 10) {  // 10 seconds of stereo audio
-            radio.state = RADIO_STATE_PLAYING;
-        }
+        // Update state based on buffer level against the adaptive start target
+        jitter_note_decoded();
+        jitter_check_start();
 
-        // Track the sequence number of the segment we just played (before incrementing)
-        radio.hls.last_played_sequence = radio.hls.media_sequence + radio.hls.current_segment;
+        // Track the sequence number of the segment we just played and move on
+        hls_advance_segment();
+    }
 
-        radio.hls.current_segment++;
+    if (hls_refresh_running) {
+        hls_refresh_running = false;
+        pthread_join(hls_refresh_thread, NULL);
     }
 
 
@@ -921,81 +1566,152 @@ static int find_mp3_sync(const uint8_t* buf, int size) {
     return -1;
 }
 
-// Streaming thread
-static void* stream_thread_func(void* arg) {
-    (void)arg;  // Unused
-    uint8_t recv_buf[8192];
+// Apply a seek requested by the UI: move the time-shift play position and
+// drop everything decoded or buffered from the old position
+static void timeshift_apply_seek(void) {
+    pthread_mutex_lock(&radio.audio_mutex);
+    int rate = radio.aac_sample_rate ? radio.aac_sample_rate : radio.mp3_sample_rate;
+    int buffered_ms = rate > 0 ? (int)((int64_t)radio.audio_ring_count / AUDIO_CHANNELS * 1000 / rate) : 0;
 
-    while (!radio.should_stop && radio.socket_fd >= 0) {
-        bool has_data = false;
+    if (radio.timeshift_seek_live) {
+        radio_timeshift_go_live();
+    } else {
+        radio_timeshift_seek(radio.timeshift_seek_ms, buffered_ms);
+    }
+    radio.timeshift_seek_pending = false;
+    radio.timeshift_seek_live = false;
+    radio.timeshift_seek_ms = 0;
 
-        // Verify SSL context is valid before use
-        if (radio.use_ssl && !radio.ssl_initialized) {
-            radio.state = RADIO_STATE_ERROR;
-            snprintf(radio.error_msg, sizeof(radio.error_msg), "SSL context invalid");
-            break;
-        }
+    radio.audio_ring_read = 0;
+    radio.audio_ring_write = 0;
+    radio.audio_ring_count = 0;
+    jitter_flush();
+    pthread_mutex_unlock(&radio.audio_mutex);
 
-        // For SSL, check if there's pending data in the SSL buffer first
-        if (radio.use_ssl && radio.ssl_initialized && mbedtls_ssl_get_bytes_avail(&radio.ssl) > 0) {
-            has_data = true;
-        }
+    radio.stream_buffer_pos = 0;
+    radio.aac_inbuf_size = 0;
+    if (radio.aac_initialized) {
+        aacDecoder_SetParam(radio.aac_decoder, AAC_TPDEC_CLEAR_BUFFER, 1);
+    }
+    if (radio.mp3_initialized) {
+        drmp3dec_init(&radio.mp3_decoder);
+    }
+}
 
-        // If no pending SSL data, use select to wait for socket data
-        if (!has_data) {
-            fd_set read_fds;
-            FD_ZERO(&read_fds);
-            FD_SET(radio.socket_fd, &read_fds);
+// Move recorded stream data to the decoder while the PCM ring has room.
+// When paused the ring stays full, so the recording simply grows.
+static void timeshift_fill_stream_buffer(void) {
+    if (radio.audio_ring_count >= AUDIO_RING_SIZE - TIMESHIFT_RING_MARGIN) return;
 
-            struct timeval tv = {0, 100000};  // 100ms timeout
-            int ret = select(radio.socket_fd + 1, &read_fds, NULL, NULL, &tv);
+    int space = radio.stream_buffer_size - radio.stream_buffer_pos;
+    if (space > TIMESHIFT_READ_CHUNK) space = TIMESHIFT_READ_CHUNK;
+    if (space <= 0) return;
 
-            if (ret < 0) {
+    int n = radio_timeshift_read(radio.stream_buffer + radio.stream_buffer_pos, space);
+    if (n > 0) radio.stream_buffer_pos += n;
+}
+
+// Streaming thread
+static void* stream_thread_func(void* arg) {
+    (void)arg;  // Unused
+    uint8_t recv_buf[8192];
+    RadioConn* c = radio.conn;
+    bool timeshift = radio_timeshift_active();
+
+    while (!radio.should_stop && c->socket_fd >= 0) {
+        int bytes_read = 0;
+
+        if (timeshift) {
+            if (radio.timeshift_seek_pending) timeshift_apply_seek();
+            radio.timeshifted = radio_timeshift_behind_ms() > TIMESHIFT_BEHIND_MS;
+        }
+
+        // Data buffered by a promoted pre-connect goes through the normal path first
+        if (radio.preload_pos < radio.preload_len) {
+            bytes_read = radio.preload_len - radio.preload_pos;
+            if (bytes_read > (int)sizeof(recv_buf)) bytes_read = sizeof(recv_buf);
+            memcpy(recv_buf, preconnect.buf + radio.preload_pos, bytes_read);
+            radio.preload_pos += bytes_read;
+        } else {
+            bool has_data = false;
+
+            // Verify SSL context is valid before use
+            if (c->use_ssl && !c->ssl_initialized) {
                 radio.state = RADIO_STATE_ERROR;
-                snprintf(radio.error_msg, sizeof(radio.error_msg), "Select error");
+                snprintf(radio.error_msg, sizeof(radio.error_msg), "SSL context invalid");
                 break;
             }
 
-            if (ret == 0) continue;  // Timeout, check should_stop
-            has_data = true;
-        }
+            // For SSL, check if there's pending data in the SSL buffer first
+            if (c->use_ssl && c->ssl_initialized && mbedtls_ssl_get_bytes_avail(&c->ssl) > 0) {
+                has_data = true;
+            }
 
-        // Receive data
-        int bytes_read = radio_recv(recv_buf, sizeof(recv_buf));
-        if (bytes_read <= 0) {
-            // For SSL, check if it's a non-fatal error
-            if (radio.use_ssl && (bytes_read == MBEDTLS_ERR_SSL_WANT_READ ||
+            // If no pending SSL data, use select to wait for socket data
+            if (!has_data) {
+                fd_set read_fds;
+                FD_ZERO(&read_fds);
+                FD_SET(c->socket_fd, &read_fds);
+
+                // Keep the decoder fed from the recording when behind live
+                bool catching_up = radio.timeshifted &&
+                                   radio.audio_ring_count < AUDIO_RING_SIZE - TIMESHIFT_RING_MARGIN;
+                struct timeval tv = {0, catching_up ? 10000 : 100000};  // 10ms / 100ms timeout
+                int ret = select(c->socket_fd + 1, &read_fds, NULL, NULL, &tv);
+
+                if (ret < 0) {
+                    radio.state = RADIO_STATE_ERROR;
+                    snprintf(radio.error_msg, sizeof(radio.error_msg), "Select error");
+                    break;
+                }
+
+                if (ret > 0) has_data = true;
+                else if (!timeshift) continue;  // Timeout, check should_stop
+            }
+
+            // Receive data
+            if (has_data) bytes_read = radio_recv(c, recv_buf, sizeof(recv_buf));
+            if (has_data && bytes_read <= 0) {
+                // For SSL, check if it's a non-fatal error
+                if (c->use_ssl && (bytes_read == MBEDTLS_ERR_SSL_WANT_READ ||
                                    bytes_read == MBEDTLS_ERR_SSL_WANT_WRITE ||
                                    bytes_read == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET)) {
-                continue;  // Retry
-            }
-            // Transient network errors - could potentially implement reconnection here
-            // For now, set error state and let the user retry
-            radio.state = RADIO_STATE_ERROR;
-            if (bytes_read == 0) {
-                snprintf(radio.error_msg, sizeof(radio.error_msg), "Stream ended - server closed connection");
-            } else {
-                snprintf(radio.error_msg, sizeof(radio.error_msg), "Network error - connection lost");
+                    continue;  // Retry
+                }
+                // Transient network errors - could potentially implement reconnection here
+                // For now, set error state and let the user retry
+                radio.state = RADIO_STATE_ERROR;
+                if (bytes_read == 0) {
+                    snprintf(radio.error_msg, sizeof(radio.error_msg), "Stream ended - server closed connection");
+                } else {
+                    snprintf(radio.error_msg, sizeof(radio.error_msg), "Network error - connection lost");
+                }
+                break;
             }
-            break;
         }
 
+        if (bytes_read > 0) jitter_note_arrival(0);
+
         // Process received data
         int i = 0;
         while (i < bytes_read && !radio.should_stop) {
             if (radio.icy_metaint > 0 && radio.bytes_until_meta == 0) {
-                // Read metadata length byte (max 255 * 16 = 4080 bytes)
-                int meta_len = recv_buf[i++] * 16;
-                // Validate metadata size (max 4080 bytes per ICY spec)
-                if (meta_len > 4080) {
-                    LOG_error("ICY metadata too large: %d bytes\n", meta_len);
-                    meta_len = 0;  // Skip invalid metadata
+                if (radio.icy_meta_len < 0) {
+                    // Metadata length byte (max 255 * 16 = 4080 bytes)
+                    radio.icy_meta_len = recv_buf[i++] * 16;
+                    radio.icy_meta_fill = 0;
                 }
-                if (meta_len > 0 && i + meta_len <= bytes_read) {
-                    parse_icy_metadata(&recv_buf[i], meta_len);
-                    i += meta_len;
+                // Collect the block, which may continue in the next read
+                int take = radio.icy_meta_len - radio.icy_meta_fill;
+                if (take > bytes_read - i) take = bytes_read - i;
+                memcpy(radio.icy_meta_buf + radio.icy_meta_fill, &recv_buf[i], take);
+                radio.icy_meta_fill += take;
+                i += take;
+                if (radio.icy_meta_fill == radio.icy_meta_len) {
+                    if (radio.icy_meta_len > 0) parse_icy_metadata(radio.icy_meta_buf, radio.icy_meta_len);
+                    radio.icy_meta_len = -1;
+                    radio.bytes_until_meta = radio.icy_metaint;
                 }
-                radio.bytes_until_meta = radio.icy_metaint;
             } else {
                 // Calculate how many bytes to copy
                 int bytes_to_copy = bytes_read - i;
@@ -1003,8 +1719,10 @@ static void* stream_thread_func(void* arg) {
                     bytes_to_copy = radio.bytes_until_meta;
                 }
 
-                // Add to stream buffer if space available
-                if (radio.stream_buffer_pos + bytes_to_copy <= radio.stream_buffer_size) {
+                // Record for time-shift, or add to stream buffer if space available
+                if (timeshift) {
+                    radio_timeshift_write(&recv_buf[i], bytes_to_copy);
+                } else if (radio.stream_buffer_pos + bytes_to_copy <= radio.stream_buffer_size) {
                     memcpy(radio.stream_buffer + radio.stream_buffer_pos, &recv_buf[i], bytes_to_copy);
                     radio.stream_buffer_pos += bytes_to_copy;
                 }
@@ -1016,6 +1734,8 @@ static void* stream_thread_func(void* arg) {
             }
         }
 
+        if (timeshift) timeshift_fill_stream_buffer();
+
         // Initialize decoder once we have enough data
         if (radio.stream_buffer_pos >= 16384) {
             if (radio.audio_format == RADIO_FORMAT_AAC && !radio.aac_initialized) {
@@ -1051,6 +1771,13 @@ static void* stream_thread_func(void* arg) {
                 } else {
                     LOG_error("No MP3 sync found in buffer\n");
                 }
+            } else if (radio.audio_format == RADIO_FORMAT_OGG && !radio.ogg_initialized) {
+                // Ogg framing is resynced by libogg, the codec comes from the BOS page
+                if (radio_ogg_open(ogg_pcm_callback, ogg_tags_callback) == 0) {
+                    radio.ogg_initialized = true;
+                    radio.ogg_sample_rate = 0;  // Will be set on first packet
+                    radio.state = RADIO_STATE_BUFFERING;
+                }
             }
         }
 
@@ -1136,10 +1863,8 @@ static void* stream_thread_func(void* arg) {
             }
 
             // Update state based on buffer level
-            if (radio.state == RADIO_STATE_BUFFERING &&
-                radio.audio_ring_count > AUDIO_RING_SIZE * 2 / 3) {
-                radio.state = RADIO_STATE_PLAYING;
-            }
+            jitter_note_decoded();
+            jitter_check_start();
         } else if (radio.audio_format == RADIO_FORMAT_MP3 && radio.mp3_initialized && radio.stream_buffer_pos >= 1024) {
             // MP3 decoding using low-level frame decoder
             // DRMP3_MAX_SAMPLES_PER_FRAME = 1152*2 = 2304
@@ -1213,10 +1938,21 @@ static void* stream_thread_func(void* arg) {
             }
 
             // Update state based on buffer level
-            if (radio.state == RADIO_STATE_BUFFERING &&
-                radio.audio_ring_count > AUDIO_RING_SIZE * 2 / 3) {
-                radio.state = RADIO_STATE_PLAYING;
+            jitter_note_decoded();
+            jitter_check_start();
+        } else if (radio.audio_format == RADIO_FORMAT_OGG && radio.ogg_initialized && radio.stream_buffer_pos > 0) {
+            // Ogg decoding: pages and packets are reassembled inside radio_ogg
+            int ret = radio_ogg_feed(radio.stream_buffer, radio.stream_buffer_pos);
+            radio.stream_buffer_pos = 0;
+            if (ret != 0) {
+                radio.state = RADIO_STATE_ERROR;
+                snprintf(radio.error_msg, sizeof(radio.error_msg), "Unsupported Ogg stream codec");
+                break;
             }
+
+            // Update state based on buffer level
+            jitter_note_decoded();
+            jitter_check_start();
         }
 
         // If buffering and have enough data
@@ -1235,11 +1971,19 @@ int Radio_init(void) {
 
     memset(&radio, 0, sizeof(RadioContext));
 
-    radio.socket_fd = -1;
+    for (int i = 0; i < RADIO_CONN_SLOTS; i++) {
+        radio.conn_slots[i].socket_fd = -1;
+    }
+    radio.conn = &radio.conn_slots[0];
     radio.state = RADIO_STATE_STOPPED;
 
     pthread_mutex_init(&radio.audio_mutex, NULL);
+    pthread_mutex_init(&preconnect.mutex, NULL);
+    pthread_cond_init(&preconnect.done, NULL);
+    pthread_mutex_init(&mirror_race.mutex, NULL);
+    pthread_cond_init(&mirror_race.cond, NULL);
     pthread_mutex_init(&radio.hls_mutex, NULL);
+    pthread_cond_init(&radio.hls_segments_cond, NULL);
 
     // Allocate buffers
     radio.stream_buffer_size = RADIO_BUFFER_SIZE;
@@ -1267,9 +2011,15 @@ int Radio_init(void) {
     // Try to load custom stations
     Radio_loadStations();
 
+    // Load mirror latency history (before curated stations register their mirrors)
+    radio_mirror_init();
+
     // Load curated stations from JSON files
     radio_curated_init();
 
+    // Load cached station health probes
+    radio_health_init();
+
     // Initialize album art module
     album_art_init();
 
@@ -1280,14 +2030,52 @@ int Radio_init(void) {
 void Radio_quit(void) {
     Radio_stop();
 
+    // A cancelled pre-connect worker still uses the spare connection and buffers
+    Radio_cancelPreconnect();
+    pthread_mutex_lock(&preconnect.mutex);
+    while (preconnect.busy) {
+        pthread_cond_wait(&preconnect.done, &preconnect.mutex);
+    }
+    pthread_mutex_unlock(&preconnect.mutex);
+    free(preconnect.buf);
+    free(preconnect.hls);
+    preconnect.buf = NULL;
+    preconnect.hls = NULL;
+    pthread_mutex_destroy(&preconnect.mutex);
+    pthread_cond_destroy(&preconnect.done);
+
+    // Losing mirror race workers close their connections on their own
+    pthread_mutex_lock(&mirror_race.mutex);
+    for (int i = 0; i < RADIO_CONN_SLOTS; i++) {
+        while (radio.conn_slots[i].racing) {
+            pthread_cond_wait(&mirror_race.cond, &mirror_race.mutex);
+        }
+    }
+    pthread_mutex_unlock(&mirror_race.mutex);
+    pthread_mutex_destroy(&mirror_race.mutex);
+    pthread_cond_destroy(&mirror_race.cond);
+
     // Cleanup curated stations module
     radio_curated_cleanup();
 
     // Cleanup album art module
     album_art_cleanup();
 
+    // Persist station health probes and mirror latencies
+    radio_health_cleanup();
+    radio_mirror_cleanup();
+
+    // Remove the time-shift recording
+    radio_timeshift_cleanup();
+
+    time_stretch_destroy(radio.jitter_ts);
+    free(radio.jitter_out);
+    radio.jitter_ts = NULL;
+    radio.jitter_out = NULL;
+
     pthread_mutex_destroy(&radio.audio_mutex);
     pthread_mutex_destroy(&radio.hls_mutex);
+    pthread_cond_destroy(&radio.hls_segments_cond);
 
     if (radio.stream_buffer) {
         free(radio.stream_buffer);
@@ -1391,6 +2179,406 @@ void Radio_loadStations(void) {
     }
 }
 
+// Probe a station: follow redirects, time connect and first byte, read headers.
+// Safe to call from worker threads; uses its own connection.
+int Radio_probeStation(const char* url, RadioProbeResult* result) {
+    memset(result, 0, sizeof(RadioProbeResult));
+    uint64_t start = radio_now_ms();
+
+    if (radio_hls_is_url(url)) {
+        // Playlist fetch stands in for connect and first byte
+        uint8_t* buf = malloc(64 * 1024);
+        if (!buf) return -1;
+        int len = radio_net_fetch(url, buf, 64 * 1024 - 1, result->content_type,
+                                  sizeof(result->content_type));
+        result->connect_ms = result->ttfb_ms = (int)(radio_now_ms() - start);
+        if (len > 0) {
+            buf[len] = '\0';
+            result->ok = strstr((char*)buf, "#EXTM3U") != NULL;
+        }
+        free(buf);
+        return result->ok ? 0 : -1;
+    }
+
+    RadioConn* c = calloc(1, sizeof(RadioConn));
+    if (!c) return -1;
+    c->socket_fd = -1;
+
+    if (open_stream(c, url) == 0) {
+        result->connect_ms = c->connect_ms;
+        result->bitrate = c->bitrate;
+        strncpy(result->content_type, c->content_type, sizeof(result->content_type) - 1);
+
+        // Wait for the first body byte (may already be in the TLS buffer)
+        bool has_data = c->use_ssl && mbedtls_ssl_get_bytes_avail(&c->ssl) > 0;
+        if (!has_data) {
+            fd_set read_fds;
+            FD_ZERO(&read_fds);
+            FD_SET(c->socket_fd, &read_fds);
+            struct timeval tv = {RADIO_PROBE_BODY_TIMEOUT_SEC, 0};
+            has_data = select(c->socket_fd + 1, &read_fds, NULL, NULL, &tv) > 0;
+        }
+        uint8_t byte;
+        if (has_data && radio_recv(c, &byte, 1) == 1) {
+            result->ttfb_ms = (int)(radio_now_ms() - start);
+            result->ok = true;
+        }
+        conn_close(c);
+    }
+
+    free(c);
+    return result->ok ? 0 : -1;
+}
+
+// Find a free connection slot (not current, not excluded, not racing)
+static RadioConn* spare_conn(RadioConn* exclude) {
+    for (int i = 0; i < RADIO_CONN_SLOTS; i++) {
+        RadioConn* c = &radio.conn_slots[i];
+        if (c != radio.conn && c != exclude && !c->racing) return c;
+    }
+    return NULL;
+}
+
+// Error pages and captive portals often come back as 200 text/html
+static bool conn_has_audio(const RadioConn* c) {
+    const char* ct = c->content_type;
+    while (*ct == ' ') ct++;
+    return strncasecmp(ct, "text/", 5) != 0;
+}
+
+static void* mirror_racer_func(void* arg) {
+    MirrorRacer* r = (MirrorRacer*)arg;
+    RadioConn* c = r->conn;
+
+    // Give faster mirrors their head start, unless one already won
+    bool wanted = true;
+    uint64_t start_at = radio_now_ms() + r->delay_ms;
+    while (radio_now_ms() < start_at) {
+        pthread_mutex_lock(&mirror_race.mutex);
+        wanted = mirror_race.generation == r->generation && !mirror_race.winner;
+        pthread_mutex_unlock(&mirror_race.mutex);
+        if (!wanted) break;
+        usleep(10000);
+    }
+
+    bool ok = false;
+    if (wanted) {
+        uint64_t start = radio_now_ms();
+        if (open_stream(c, r->url) == 0) {
+            ok = conn_has_audio(c);
+            if (!ok) {
+                snprintf(c->error_msg, sizeof(c->error_msg), "Not an audio stream");
+                conn_close(c);
+            }
+        }
+        int latency_ms = ok ? (int)(radio_now_ms() - start) : -1;
+        radio_mirror_record(r->station_url, r->url, latency_ms);
+        // Remember where a redirect landed so later plays can skip the hop
+        if (ok && strcmp(c->final_url, r->url) != 0) {
+            radio_mirror_record(r->station_url, c->final_url, latency_ms);
+        }
+    }
+
+    pthread_mutex_lock(&mirror_race.mutex);
+    bool current = mirror_race.generation == r->generation;
+    if (ok && current && !mirror_race.winner) {
+        mirror_race.winner = c;
+    } else if (ok) {
+        conn_close(c);
+    } else if (current && wanted && !mirror_race.error_msg[0]) {
+        snprintf(mirror_race.error_msg, sizeof(mirror_race.error_msg), "%s", c->error_msg);
+    }
+    if (current) mirror_race.pending--;
+    c->racing = false;
+    pthread_cond_broadcast(&mirror_race.cond);
+    pthread_mutex_unlock(&mirror_race.mutex);
+
+    free(r);
+    return NULL;
+}
+
+// Open a direct stream, racing the station's known mirrors with staggered starts.
+// On success radio.conn is the winning connection; on failure radio.error_msg is set.
+static int open_stream_raced(const char* url) {
+    char urls[MIRROR_RACE_MAX][RADIO_MAX_URL];
+    int count = radio_mirror_candidates(url, urls, MIRROR_RACE_MAX);
+
+    // radio.conn is idle after Radio_stop; borrow spares for the other mirrors
+    RadioConn* slots[MIRROR_RACE_MAX];
+    int slot_count = 0;
+    slots[slot_count++] = radio.conn;
+    RadioConn* held = (preconnect.busy || preconnect.ready) ? preconnect.conn : NULL;
+    while (slot_count < count) {
+        RadioConn* c = spare_conn(held);
+        if (!c) break;
+        c->racing = true;  // Reserve so spare_conn() moves on
+        slots[slot_count++] = c;
+    }
+    if (count > slot_count) count = slot_count;
+
+    if (count == 1) {
+        uint64_t start = radio_now_ms();
+        if (open_stream(radio.conn, urls[0]) != 0) {
+            radio_mirror_record(url, urls[0], -1);
+            snprintf(radio.error_msg, sizeof(radio.error_msg), "%s", radio.conn->error_msg);
+            return -1;
+        }
+        int latency_ms = (int)(radio_now_ms() - start);
+        radio_mirror_record(url, urls[0], latency_ms);
+        if (strcmp(radio.conn->final_url, urls[0]) != 0) {
+            radio_mirror_record(url, radio.conn->final_url, latency_ms);
+        }
+        return 0;
+    }
+
+    pthread_mutex_lock(&mirror_race.mutex);
+    mirror_race.generation++;
+    mirror_race.winner = NULL;
+    mirror_race.pending = 0;
+    mirror_race.error_msg[0] = '\0';
+    uint32_t generation = mirror_race.generation;
+
+    for (int i = 0; i < count; i++) {
+        MirrorRacer* r = calloc(1, sizeof(MirrorRacer));
+        if (!r) {
+            slots[i]->racing = false;
+            continue;
+        }
+        r->conn = slots[i];
+        r->conn->socket_fd = -1;
+        r->conn->racing = true;
+        r->generation = generation;
+        r->delay_ms = i * MIRROR_RACE_STAGGER_MS;
+        strncpy(r->station_url, url, RADIO_MAX_URL - 1);
+        strncpy(r->url, urls[i], RADIO_MAX_URL - 1);
+
+        // Detached with a larger stack (mbedtls + getaddrinfo), like the pre-connect
+        pthread_t thread;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setstacksize(&attr, 1024 * 1024);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        if (pthread_create(&thread, &attr, mirror_racer_func, r) == 0) {
+            mirror_race.pending++;
+        } else {
+            LOG_error("[Radio] Failed to start mirror race worker\n");
+            r->conn->racing = false;
+            free(r);
+        }
+        pthread_attr_destroy(&attr);
+    }
+
+    while (!mirror_race.winner && mirror_race.pending > 0) {
+        pthread_cond_wait(&mirror_race.cond, &mirror_race.mutex);
+    }
+    RadioConn* winner = mirror_race.winner;
+    if (!winner) {
+        snprintf(radio.error_msg, sizeof(radio.error_msg), "%s",
+                 mirror_race.error_msg[0] ? mirror_race.error_msg : "Connection failed");
+    }
+    mirror_race.generation++;  // Anyone still connecting lost
+    pthread_mutex_unlock(&mirror_race.mutex);
+
+    if (!winner) return -1;
+    radio.conn = winner;
+    return 0;
+}
+
+// Start HLS streaming thread with larger stack (mbedtls + getaddrinfo need more stack space)
+static int hls_start_thread(void) {
+    radio.should_stop = false;
+    radio.thread_running = true;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    size_t stacksize = 1024 * 1024;  // 1MB stack - getaddrinfo uses a lot of stack
+    pthread_attr_setstacksize(&attr, stacksize);
+    if (pthread_create(&radio.stream_thread, &attr, hls_stream_thread_func, NULL) != 0) {
+        pthread_attr_destroy(&attr);
+        radio.thread_running = false;
+        radio.state = RADIO_STATE_ERROR;
+        snprintf(radio.error_msg, sizeof(radio.error_msg), "Thread creation failed");
+        return -1;
+    }
+    pthread_attr_destroy(&attr);
+
+    // Unpause audio device for radio playback
+    Player_resumeAudio();
+
+    return 0;
+}
+
+// Open the pre-connect to the station's historically fastest mirror
+static int preconnect_open_fastest(void) {
+    char fastest[1][RADIO_MAX_URL];
+    radio_mirror_candidates(preconnect.url, fastest, 1);
+
+    uint64_t start = radio_now_ms();
+    int ret = open_stream(preconnect.conn, fastest[0]);
+    radio_mirror_record(preconnect.url, fastest[0], ret == 0 ? (int)(radio_now_ms() - start) : -1);
+    return ret;
+}
+
+// Pre-connect worker: opens the connection (direct) or fetches playlist and first
+// segment (HLS) into the spare context, then holds it until promoted or cancelled
+static void* preconnect_thread_func(void* arg) {
+    (void)arg;
+
+    if (preconnect.is_hls) {
+        memset(preconnect.hls, 0, sizeof(HLSContext));
+        if (radio_hls_fetch_playlist(preconnect.hls, preconnect.url) > 0 && !preconnect.cancel) {
+            preconnect.len = radio_net_fetch(radio_hls_segment(preconnect.hls, 0)->url,
+                                             preconnect.buf, HLS_SEGMENT_BUF_SIZE, NULL, 0);
+            preconnect.ready = preconnect.len > 0;
+            preconnect.ready_ms = radio_now_ms();
+        }
+    } else if (preconnect_open_fastest() == 0) {
+        RadioConn* c = preconnect.conn;
+        uint64_t opened = radio_now_ms();
+        preconnect.ready = true;
+
+        // Buffer up to the cap, then let TCP flow control hold the server
+        while (!preconnect.cancel && !preconnect.promote) {
+            if (radio_now_ms() - opened > PRECONNECT_IDLE_TIMEOUT_MS) {
+                preconnect.ready = false;
+                break;
+            }
+            if (preconnect.len >= PRECONNECT_DIRECT_CAP) {
+                usleep(50000);
+                continue;
+            }
+            if (!(c->use_ssl && mbedtls_ssl_get_bytes_avail(&c->ssl) > 0)) {
+                fd_set read_fds;
+                FD_ZERO(&read_fds);
+                FD_SET(c->socket_fd, &read_fds);
+                struct timeval tv = {0, 100000};  // 100ms - stay responsive to promote/cancel
+                if (select(c->socket_fd + 1, &read_fds, NULL, NULL, &tv) <= 0) continue;
+            }
+            int n = radio_recv(c, preconnect.buf + preconnect.len, PRECONNECT_DIRECT_CAP - preconnect.len);
+            if (n > 0) {
+                preconnect.len += n;
+            } else if (!(c->use_ssl && (n == MBEDTLS_ERR_SSL_WANT_READ ||
+                                        n == MBEDTLS_ERR_SSL_WANT_WRITE ||
+                                        n == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET))) {
+                preconnect.ready = false;
+                break;
+            }
+        }
+    }
+
+    pthread_mutex_lock(&preconnect.mutex);
+    if (preconnect.cancel || !preconnect.ready) {
+        if (!preconnect.is_hls) conn_close(preconnect.conn);
+        preconnect.ready = false;
+    }
+    preconnect.busy = false;
+    pthread_cond_broadcast(&preconnect.done);
+    pthread_mutex_unlock(&preconnect.mutex);
+    return NULL;
+}
+
+// Drop a finished HLS pre-connect nobody promoted in time, like the direct
+// worker does with its idle connection (caller holds preconnect.mutex)
+static void preconnect_expire_locked(void) {
+    if (preconnect.is_hls && preconnect.ready && !preconnect.busy &&
+        radio_now_ms() - preconnect.ready_ms > PRECONNECT_IDLE_TIMEOUT_MS) {
+        preconnect.ready = false;
+    }
+}
+
+bool Radio_preconnect(const char* url) {
+    if (!url || !url[0] || Radio_isActive() || radio.thread_running) return false;
+
+    pthread_mutex_lock(&preconnect.mutex);
+    preconnect_expire_locked();
+    if (preconnect.busy || preconnect.ready) {
+        bool same = !preconnect.cancel && strcmp(preconnect.url, url) == 0;
+        if (same || preconnect.busy) {
+            // Already on it, or the previous worker is still winding down
+            pthread_mutex_unlock(&preconnect.mutex);
+            return same;
+        }
+        if (!preconnect.is_hls) conn_close(preconnect.conn);
+        preconnect.ready = false;
+    }
+
+    if (!preconnect.buf) preconnect.buf = malloc(HLS_SEGMENT_BUF_SIZE);
+    if (!preconnect.hls) preconnect.hls = malloc(sizeof(HLSContext));
+    if (!preconnect.buf || !preconnect.hls) {
+        pthread_mutex_unlock(&preconnect.mutex);
+        return false;
+    }
+
+    strncpy(preconnect.url, url, RADIO_MAX_URL - 1);
+    preconnect.url[RADIO_MAX_URL - 1] = '\0';
+    preconnect.is_hls = radio_hls_is_url(url);
+    preconnect.conn = spare_conn(NULL);
+    if (!preconnect.conn) {
+        // Every spare slot is still held by a losing mirror race attempt
+        pthread_mutex_unlock(&preconnect.mutex);
+        return false;
+    }
+    preconnect.conn->socket_fd = -1;
+    preconnect.len = 0;
+    preconnect.cancel = false;
+    preconnect.promote = false;
+    preconnect.ready = false;
+    preconnect.busy = true;
+
+    // Detached with a larger stack (mbedtls + getaddrinfo), like the HLS thread
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 1024 * 1024);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    bool started = pthread_create(&thread, &attr, preconnect_thread_func, NULL) == 0;
+    if (!started) {
+        LOG_error("[Radio] Failed to start pre-connect thread\n");
+        preconnect.busy = false;
+    }
+    pthread_attr_destroy(&attr);
+    pthread_mutex_unlock(&preconnect.mutex);
+    return started;
+}
+
+void Radio_cancelPreconnect(void) {
+    pthread_mutex_lock(&preconnect.mutex);
+    if (preconnect.busy) {
+        // Worker releases the connection when it notices
+        preconnect.cancel = true;
+    } else if (preconnect.ready) {
+        if (!preconnect.is_hls) conn_close(preconnect.conn);
+        preconnect.ready = false;
+    }
+    pthread_mutex_unlock(&preconnect.mutex);
+}
+
+// Take over a pre-connect for url. Returns true if its connection (direct) or
+// playlist and first segment (HLS) now belong to the caller.
+static bool preconnect_claim(const char* url) {
+    pthread_mutex_lock(&preconnect.mutex);
+    preconnect_expire_locked();
+    bool match = (preconnect.busy || preconnect.ready) && !preconnect.cancel &&
+                 strcmp(preconnect.url, url) == 0;
+    if (match) preconnect.promote = true;
+    pthread_mutex_unlock(&preconnect.mutex);
+
+    if (!match) {
+        Radio_cancelPreconnect();
+        return false;
+    }
+
+    // A connect still in progress finishes first - no slower than starting over
+    pthread_mutex_lock(&preconnect.mutex);
+    while (preconnect.busy) {
+        pthread_cond_wait(&preconnect.done, &preconnect.mutex);
+    }
+    bool ok = preconnect.ready;
+    preconnect.ready = false;  // Ownership moves to the caller
+    preconnect.promote = false;
+    pthread_mutex_unlock(&preconnect.mutex);
+    return ok;
+}
+
 int Radio_play(const char* url) {
     Radio_stop();
 
@@ -1406,6 +2594,12 @@ int Radio_play(const char* url) {
     radio.audio_ring_write = 0;
     radio.audio_ring_read = 0;
     radio.audio_ring_count = 0;
+    jitter_reset();
+
+    memset(&radio.stats, 0, sizeof(radio.stats));
+    radio.stats.first_audio_ms = -1;
+    radio.session_start_ms = radio_now_ms();
+    radio.rebuffer_start_ms = 0;
 
     memset(&radio.metadata, 0, sizeof(RadioMetadata));
 
@@ -1414,8 +2608,26 @@ int Radio_play(const char* url) {
     radio.ts_aac_pid = -1;
     memset(&radio.hls, 0, sizeof(HLSContext));
 
+    // Take over a speculative connection to this station if one is ready
+    bool promoted = preconnect_claim(url);
+
     // Check if this is an HLS stream
-    if (radio_hls_is_url(url)) {
+    if (radio_hls_is_url(url) && promoted) {
+        radio.stream_type = STREAM_TYPE_HLS;
+
+        // Playlist and first segment came from the pre-connect
+        memcpy(&radio.hls, preconnect.hls, sizeof(HLSContext));
+        radio.hls.current_segment = 0;
+        radio.hls.last_played_sequence = -1;
+        memcpy(radio.hls_prefetch_buf, preconnect.buf, preconnect.len);
+        radio.hls_prefetch_len = preconnect.len;
+        radio.hls_prefetch_segment = radio.hls.media_sequence;
+        radio.hls_prefetch_ready = true;
+        radio.hls_throughput_bps = 0;
+        hls_update_variant_metadata();
+
+        return hls_start_thread();
+    } else if (radio_hls_is_url(url)) {
         radio.stream_type = STREAM_TYPE_HLS;
 
         // Fetch and parse the M3U8 playlist
@@ -1462,100 +2674,44 @@ int Radio_play(const char* url) {
             return -1;
         }
 
-        // Start HLS streaming thread with larger stack (mbedtls + getaddrinfo need more stack space)
-        radio.should_stop = false;
-        radio.thread_running = true;
-        pthread_attr_t attr;
-        pthread_attr_init(&attr);
-        size_t stacksize = 1024 * 1024;  // 1MB stack - getaddrinfo uses a lot of stack
-        int stack_result = pthread_attr_setstacksize(&attr, stacksize);
-        if (pthread_create(&radio.stream_thread, &attr, hls_stream_thread_func, NULL) != 0) {
-            pthread_attr_destroy(&attr);
-            radio.state = RADIO_STATE_ERROR;
-            snprintf(radio.error_msg, sizeof(radio.error_msg), "Thread creation failed");
-            return -1;
+        if (!radio.hls.media_url[0]) {
+            strncpy(radio.hls.media_url, url, HLS_MAX_URL_LEN - 1);
         }
-        pthread_attr_destroy(&attr);
-
-        // Unpause audio device for radio playback
-        Player_resumeAudio();
+        radio.hls_throughput_bps = 0;
+        hls_update_variant_metadata();
 
-        return 0;
+        return hls_start_thread();
     }
 
     // Direct stream (Shoutcast/Icecast)
     radio.stream_type = STREAM_TYPE_DIRECT;
 
-    // Connect with redirect handling (max 5 redirects)
-    char current_url[RADIO_MAX_URL];
-    strncpy(current_url, url, RADIO_MAX_URL - 1);
-    current_url[RADIO_MAX_URL - 1] = '\0';
-
-    int max_redirects = 5;
-    int header_result;
-
-    for (int redirect_count = 0; redirect_count <= max_redirects; redirect_count++) {
-        // Connect to stream
-        if (connect_stream(current_url) != 0) {
-            radio.state = RADIO_STATE_ERROR;
-            return -1;
-        }
-
-        // Parse headers
-        header_result = parse_headers();
-
-        if (header_result == 0) {
-            // Success - headers parsed, ready to stream
-            break;
-        } else if (header_result == 1) {
-            // Redirect - cleanup current connection and try new URL
-            if (radio.use_ssl) {
-                ssl_cleanup();
-                radio.use_ssl = false;
-            } else {
-                close(radio.socket_fd);
-            }
-            radio.socket_fd = -1;
-
-            if (radio.redirect_url[0] == '\0') {
-                snprintf(radio.error_msg, sizeof(radio.error_msg), "Empty redirect URL");
-                radio.state = RADIO_STATE_ERROR;
-                return -1;
-            }
-
-            strncpy(current_url, radio.redirect_url, RADIO_MAX_URL - 1);
-            current_url[RADIO_MAX_URL - 1] = '\0';
-
-            if (redirect_count == max_redirects) {
-                snprintf(radio.error_msg, sizeof(radio.error_msg), "Too many redirects");
-                radio.state = RADIO_STATE_ERROR;
-                return -1;
-            }
-        } else {
-            // Error - cleanup connection
-            if (radio.use_ssl) {
-                ssl_cleanup();
-                radio.use_ssl = false;
-            } else {
-                close(radio.socket_fd);
-            }
-            radio.socket_fd = -1;
-            radio.state = RADIO_STATE_ERROR;
-            return -1;
-        }
+    if (promoted) {
+        // Pre-connect already holds an open connection and some stream data
+        radio.conn = preconnect.conn;
+        radio.preload_len = preconnect.len;
+        radio.preload_pos = 0;
+    } else if (open_stream_raced(url) != 0) {
+        radio.state = RADIO_STATE_ERROR;
+        return -1;
+    }
+    conn_apply_headers(radio.conn);
+
+    // Record the compressed stream so it can be paused and rewound
+    // (the seek index only understands MP3 and ADTS frames)
+    if (radio.audio_format == RADIO_FORMAT_AAC) {
+        radio_timeshift_open(TIMESHIFT_CODEC_ADTS);
+    } else if (radio.audio_format == RADIO_FORMAT_MP3) {
+        radio_timeshift_open(TIMESHIFT_CODEC_MP3);
     }
 
     // Start streaming thread
     radio.should_stop = false;
     radio.thread_running = true;
     if (pthread_create(&radio.stream_thread, NULL, stream_thread_func, NULL) != 0) {
-        if (radio.use_ssl) {
-            ssl_cleanup();
-            radio.use_ssl = false;
-        } else {
-            close(radio.socket_fd);
-        }
-        radio.socket_fd = -1;
+        conn_close(radio.conn);
+        radio_timeshift_close();
+        radio.preload_len = 0;
         radio.state = RADIO_STATE_ERROR;
         snprintf(radio.error_msg, sizeof(radio.error_msg), "Thread creation failed");
         return -1;
@@ -1572,8 +2728,8 @@ void Radio_stop(void) {
 
     // Close socket immediately to unblock any pending recv() calls
     // This makes the thread exit faster instead of waiting for timeout
-    if (radio.socket_fd >= 0) {
-        shutdown(radio.socket_fd, SHUT_RDWR);  // Unblock recv()
+    if (radio.conn && radio.conn->socket_fd >= 0) {
+        shutdown(radio.conn->socket_fd, SHUT_RDWR);  // Unblock recv()
     }
 
     if (radio.thread_running) {
@@ -1589,14 +2745,19 @@ void Radio_stop(void) {
     radio.hls_prefetch_ready = false;
     radio.hls_prefetch_segment = -1;
 
+    radio_timeshift_close();
+    radio.paused = false;
+    radio.timeshifted = false;
+    radio.timeshift_seek_pending = false;
+    radio.timeshift_seek_live = false;
+    radio.timeshift_seek_ms = 0;
+
     // Cleanup SSL if active
-    if (radio.use_ssl) {
-        ssl_cleanup();
-        radio.use_ssl = false;
-    } else if (radio.socket_fd >= 0) {
-        close(radio.socket_fd);
+    if (radio.conn) {
+        conn_close(radio.conn);
     }
-    radio.socket_fd = -1;
+    radio.preload_len = 0;
+    radio.preload_pos = 0;
 
     if (radio.mp3_initialized) {
         // Low-level drmp3dec doesn't need uninit
@@ -1614,6 +2775,12 @@ void Radio_stop(void) {
         radio.aac_channels = 0;
     }
 
+    if (radio.ogg_initialized) {
+        radio_ogg_close();
+        radio.ogg_initialized = false;
+        radio.ogg_sample_rate = 0;
+    }
+
     // Reset HLS state
     radio.stream_type = STREAM_TYPE_DIRECT;
     radio.ts_pid_detected = false;
@@ -1622,6 +2789,14 @@ void Radio_stop(void) {
     // Clear album art
     album_art_clear();
 
+    // Record stalls so field reports show how playback went
+    if (radio.session_start_ms && radio.stats.rebuffer_count > 0) {
+        LOG_info("[Radio] Session stalled: first audio %dms, %d rebuffers (%dms) on %s\n",
+                  radio.stats.first_audio_ms, radio.stats.rebuffer_count,
+                  radio.stats.rebuffer_ms, radio.current_url);
+    }
+    radio.session_start_ms = 0;
+
     radio.state = RADIO_STATE_STOPPED;
 
     // Pause audio device when radio stops
@@ -1662,35 +2837,40 @@ const char* Radio_getError(void) {
     return radio.error_msg;
 }
 
+const RadioPlaybackStats* Radio_getPlaybackStats(void) {
+    return &radio.stats;
+}
+
 void Radio_update(void) {
-    // Check for buffer underrun - transition to buffering when below 2 seconds
-    // This gives time to rebuffer before audio actually runs out
-    if (radio.state == RADIO_STATE_PLAYING && radio.audio_ring_count < SAMPLE_RATE * 2 * 2) {
-        radio.state = RADIO_STATE_BUFFERING;
+    // Playback is stretched below the low-water mark, so only a ring that has
+    // actually run dry needs a full rebuffer
+    if (radio.state == RADIO_STATE_PLAYING && radio.audio_ring_count < jitter_samples(JITTER_UNDERRUN_MS)) {
+        jitter_underrun();
     }
 }
 
 int Radio_getAudioSamples(int16_t* buffer, int max_samples) {
-    pthread_mutex_lock(&radio.audio_mutex);
-
-    // Check for underrun and transition to buffering if needed
-    // This provides faster response than waiting for Radio_update()
-    // But continue to provide remaining audio to avoid abrupt silence
-    if (radio.state == RADIO_STATE_PLAYING && radio.audio_ring_count < SAMPLE_RATE * 2 * 2) {
-        radio.state = RADIO_STATE_BUFFERING;
-        // Don't return early - continue to drain remaining buffer smoothly
+    // Paused: keep the ring intact; the stream is still being recorded
+    if (radio.paused) {
+        memset(buffer, 0, max_samples * sizeof(int16_t));
+        return 0;
     }
 
-    int samples_to_read = max_samples;
-    if (samples_to_read > radio.audio_ring_count) {
-        samples_to_read = radio.audio_ring_count;
+    pthread_mutex_lock(&radio.audio_mutex);
+
+    // Only a ring that has run dry forces a rebuffer; a low ring is handled
+    // by stretching playback below instead
+    if (radio.state == RADIO_STATE_PLAYING && radio.audio_ring_count < max_samples &&
+        radio.audio_ring_count < jitter_samples(JITTER_UNDERRUN_MS)) {
+        jitter_underrun();
     }
+    jitter_check_start();
 
-    for (int i = 0; i < samples_to_read; i++) {
-        buffer[i] = radio.audio_ring[radio.audio_ring_read];
-        radio.audio_ring_read = (radio.audio_ring_read + 1) % AUDIO_RING_SIZE;
+    // Hold output while (re)buffering so the ring can reach the start target
+    int samples_to_read = 0;
+    if (radio.state == RADIO_STATE_PLAYING) {
+        samples_to_read = jitter_read(buffer, max_samples / AUDIO_CHANNELS) * AUDIO_CHANNELS;
     }
-    radio.audio_ring_count -= samples_to_read;
 
     // Fill rest with silence
     for (int i = samples_to_read; i < max_samples; i++) {
@@ -1706,6 +2886,46 @@ bool Radio_isActive(void) {
     return radio.state != RADIO_STATE_STOPPED && radio.state != RADIO_STATE_ERROR;
 }
 
+bool Radio_canTimeshift(void) {
+    return Radio_isActive() && radio.stream_type == STREAM_TYPE_DIRECT && radio_timeshift_active();
+}
+
+void Radio_setPaused(bool paused) {
+    if (!Radio_canTimeshift() || radio.paused == paused) return;
+    radio.paused = paused;
+    if (paused) {
+        Player_pauseAudio();
+    } else {
+        Player_resumeAudio();
+    }
+}
+
+bool Radio_isPaused(void) {
+    return radio.paused;
+}
+
+void Radio_seek(int delta_sec) {
+    if (!Radio_canTimeshift()) return;
+    pthread_mutex_lock(&radio.audio_mutex);
+    radio.timeshift_seek_ms += delta_sec * 1000;
+    radio.timeshift_seek_pending = true;
+    pthread_mutex_unlock(&radio.audio_mutex);
+}
+
+void Radio_goLive(void) {
+    if (!Radio_canTimeshift()) return;
+    pthread_mutex_lock(&radio.audio_mutex);
+    radio.timeshift_seek_live = true;
+    radio.timeshift_seek_pending = true;
+    pthread_mutex_unlock(&radio.audio_mutex);
+}
+
+int Radio_getTimeshiftDelay(void) {
+    if (!Radio_canTimeshift()) return 0;
+    int behind_ms = radio_timeshift_behind_ms();
+    return behind_ms > TIMESHIFT_BEHIND_MS ? behind_ms / 1000 : 0;
+}
+
 // Curated stations API - delegates to radio_curated module
 int Radio_getCuratedCountryCount(void) {
     return radio_curated_get_country_count();
@@ -39,6 +39,10 @@ typedef struct {
     char station_name[256]; // Station name from ICY
     int bitrate;            // Stream bitrate in kbps
     char content_type[64];  // audio/mpeg, audio/ogg, etc.
+    int variant_index;      // HLS variant in use (0 = lowest bandwidth)
+    int variant_count;      // Number of HLS variants (0 if not adaptive)
+    int variant_bitrate;    // Advertised bandwidth of current variant in kbps
+    int throughput;         // Measured segment download throughput in kbps
 } RadioMetadata;
 
 // Radio states
@@ -77,6 +81,53 @@ int Radio_play(const char* url);
 // Stop streaming
 void Radio_stop(void);
 
+// Result of probing a station stream
+typedef struct {
+    bool ok;                // Reachable and sent audio (or a valid playlist)
+    int connect_ms;         // DNS + TCP (+ TLS) to the final host
+    int ttfb_ms;            // From start of probe to first audio byte
+    int bitrate;            // icy-br in kbps, 0 if not advertised
+    char content_type[64];
+} RadioProbeResult;
+
+// Playback quality of the current (or last) session, since Radio_play()
+typedef struct {
+    int first_audio_ms;     // Radio_play() to first audio out, -1 until then
+    int rebuffer_count;     // Times the ring ran dry once playing
+    int rebuffer_ms;        // Total time spent rebuffering
+} RadioPlaybackStats;
+
+// Get playback statistics (read by tests/radio_stream; logged at Radio_stop()
+// if playback stalled)
+const RadioPlaybackStats* Radio_getPlaybackStats(void);
+
+// Probe a station URL (follows redirects). Blocking; for worker threads.
+// Returns 0 if the station is alive, -1 otherwise
+int Radio_probeStation(const char* url, RadioProbeResult* result);
+
+// Time-shift (direct streams only): the stream keeps recording to the SD card
+// while paused, so playback can resume, rewind or jump back to live.
+bool Radio_canTimeshift(void);
+void Radio_setPaused(bool paused);
+bool Radio_isPaused(void);
+
+// Seek relative to what is currently heard (negative = back)
+void Radio_seek(int delta_sec);
+
+// Skip ahead to the live edge
+void Radio_goLive(void);
+
+// Seconds behind live (0 when live)
+int Radio_getTimeshiftDelay(void);
+
+// Speculatively connect to a highlighted station while stopped (at most one).
+// Radio_play() on the same URL promotes it without reconnecting.
+// Returns true if a pre-connect for url is now running or ready.
+bool Radio_preconnect(const char* url);
+
+// Drop any speculative connection (e.g. the cursor moved)
+void Radio_cancelPreconnect(void);
+
 // Get current state
 RadioState Radio_getState(void);
 
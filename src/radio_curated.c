@@ -1,5 +1,6 @@
 #define _GNU_SOURCE
 #include "radio_curated.h"
+#include "radio_mirror.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -87,6 +88,13 @@ static int load_country_stations(const char* filepath) {
                 strncpy(curated_stations[curated_station_count].country_code, country_code, 7);
                 curated_stations[curated_station_count].country_code[7] = '\0';
                 curated_station_count++;
+
+                // Optional alternate URLs, raced against the main one on play
+                JSON_Array* mirrors = json_object_get_array(station, "mirrors");
+                int mirror_count = mirrors ? json_array_get_count(mirrors) : 0;
+                for (int m = 0; m < mirror_count; m++) {
+                    radio_mirror_add(url, json_array_get_string(mirrors, m));
+                }
             }
         }
     }
@@ -0,0 +1,261 @@
+#define _GNU_SOURCE
+#include "radio_health.h"
+#include "radio.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "defines.h"
+#include "api.h"
+
+#define RADIO_HEALTH_FILE SHARED_USERDATA_PATH "/music-player/radio/health.txt"
+#define RADIO_HEALTH_MAX 320                    // Curated + user stations
+#define RADIO_HEALTH_TTL_SEC (12 * 60 * 60)     // Re-probe healthy/slow stations twice a day
+#define RADIO_HEALTH_DEAD_TTL_SEC (60 * 60)     // Dead stations often come back - retry sooner
+#define RADIO_HEALTH_WORKERS 3                  // Concurrent probes
+#define RADIO_HEALTH_SLOW_CONNECT_MS 2000
+#define RADIO_HEALTH_SLOW_TTFB_MS 4000
+
+typedef struct {
+    char url[RADIO_MAX_URL];
+    RadioHealthStatus status;
+    int connect_ms;
+    int ttfb_ms;
+    int bitrate;
+    char content_type[64];
+    time_t checked_at;
+    bool queued;
+    bool probing;
+} HealthEntry;
+
+// Module state
+static HealthEntry entries[RADIO_HEALTH_MAX];
+static int entry_count = 0;
+static pthread_mutex_t health_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int active_workers = 0;
+static volatile bool health_stopping = false;
+static volatile uint32_t health_version = 0;
+static bool health_dirty = false;
+
+// Caller holds health_mutex
+static HealthEntry* find_entry(const char* url) {
+    for (int i = 0; i < entry_count; i++) {
+        if (strcmp(entries[i].url, url) == 0) return &entries[i];
+    }
+    return NULL;
+}
+
+// Caller holds health_mutex
+static HealthEntry* add_entry(const char* url) {
+    if (entry_count >= RADIO_HEALTH_MAX) return NULL;
+    HealthEntry* e = &entries[entry_count++];
+    memset(e, 0, sizeof(HealthEntry));
+    strncpy(e->url, url, RADIO_MAX_URL - 1);
+    return e;
+}
+
+static int entry_ttl(const HealthEntry* e) {
+    return e->status == RADIO_HEALTH_DEAD ? RADIO_HEALTH_DEAD_TTL_SEC : RADIO_HEALTH_TTL_SEC;
+}
+
+// Caller holds health_mutex
+static void save_locked(void) {
+    mkdir(SHARED_USERDATA_PATH "/music-player", 0755);
+    mkdir(SHARED_USERDATA_PATH "/music-player/radio", 0755);
+    FILE* f = fopen(RADIO_HEALTH_FILE, "w");
+    if (!f) return;
+
+    for (int i = 0; i < entry_count; i++) {
+        HealthEntry* e = &entries[i];
+        if (e->checked_at == 0) continue;
+        // Format: url|status|connect_ms|ttfb_ms|bitrate|checked_at|content_type
+        fprintf(f, "%s|%d|%d|%d|%d|%ld|%s\n", e->url, (int)e->status,
+                e->connect_ms, e->ttfb_ms, e->bitrate, (long)e->checked_at, e->content_type);
+    }
+
+    fclose(f);
+    health_dirty = false;
+}
+
+void radio_health_init(void) {
+    pthread_mutex_lock(&health_mutex);
+    health_stopping = false;
+    entry_count = 0;
+
+    FILE* f = fopen(RADIO_HEALTH_FILE, "r");
+    if (f) {
+        char line[1024];
+        while (fgets(line, sizeof(line), f) && entry_count < RADIO_HEALTH_MAX) {
+            char* nl = strchr(line, '\n');
+            if (nl) *nl = '\0';
+
+            char* url = strtok(line, "|");
+            char* status = strtok(NULL, "|");
+            char* connect_ms = strtok(NULL, "|");
+            char* ttfb_ms = strtok(NULL, "|");
+            char* bitrate = strtok(NULL, "|");
+            char* checked_at = strtok(NULL, "|");
+            char* content_type = strtok(NULL, "|");
+            if (!url || !status || !connect_ms || !ttfb_ms || !bitrate || !checked_at) continue;
+
+            HealthEntry* e = add_entry(url);
+            if (!e) break;
+            e->status = (RadioHealthStatus)atoi(status);
+            e->connect_ms = atoi(connect_ms);
+            e->ttfb_ms = atoi(ttfb_ms);
+            e->bitrate = atoi(bitrate);
+            e->checked_at = (time_t)atol(checked_at);
+            if (content_type) {
+                strncpy(e->content_type, content_type, sizeof(e->content_type) - 1);
+            }
+        }
+        fclose(f);
+    }
+
+    health_version++;
+    pthread_mutex_unlock(&health_mutex);
+}
+
+void radio_health_cleanup(void) {
+    pthread_mutex_lock(&health_mutex);
+    health_stopping = true;
+    // Drop anything not started yet
+    for (int i = 0; i < entry_count; i++) {
+        entries[i].queued = false;
+    }
+    if (health_dirty) save_locked();
+    pthread_mutex_unlock(&health_mutex);
+}
+
+static RadioHealthStatus classify(const RadioProbeResult* r) {
+    if (!r->ok) return RADIO_HEALTH_DEAD;
+    if (r->connect_ms > RADIO_HEALTH_SLOW_CONNECT_MS || r->ttfb_ms > RADIO_HEALTH_SLOW_TTFB_MS) {
+        return RADIO_HEALTH_SLOW;
+    }
+    return RADIO_HEALTH_OK;
+}
+
+static void* health_worker_func(void* arg) {
+    (void)arg;
+
+    while (!health_stopping) {
+        // Don't compete with playback for bandwidth
+        if (Radio_isActive()) {
+            usleep(500000);
+            continue;
+        }
+
+        char url[RADIO_MAX_URL];
+        bool found = false;
+        pthread_mutex_lock(&health_mutex);
+        for (int i = 0; i < entry_count; i++) {
+            if (entries[i].queued) {
+                entries[i].queued = false;
+                entries[i].probing = true;
+                strcpy(url, entries[i].url);
+                found = true;
+                break;
+            }
+        }
+        pthread_mutex_unlock(&health_mutex);
+        if (!found) break;
+
+        RadioProbeResult result;
+        Radio_probeStation(url, &result);
+
+        // Look up again - the table may have been reloaded meanwhile
+        pthread_mutex_lock(&health_mutex);
+        HealthEntry* e = find_entry(url);
+        if (e) {
+            e->status = classify(&result);
+            e->connect_ms = result.connect_ms;
+            e->ttfb_ms = result.ttfb_ms;
+            e->bitrate = result.bitrate;
+            strncpy(e->content_type, result.content_type, sizeof(e->content_type) - 1);
+            e->content_type[sizeof(e->content_type) - 1] = '\0';
+            e->checked_at = time(NULL);
+            e->probing = false;
+            health_dirty = true;
+            health_version++;
+        }
+        pthread_mutex_unlock(&health_mutex);
+    }
+
+    pthread_mutex_lock(&health_mutex);
+    active_workers--;
+    if (active_workers == 0 && health_dirty) {
+        save_locked();
+    }
+    pthread_mutex_unlock(&health_mutex);
+    return NULL;
+}
+
+void radio_health_probe(const char* const* urls, int count) {
+    time_t now = time(NULL);
+
+    pthread_mutex_lock(&health_mutex);
+    health_stopping = false;
+
+    int queued = 0;
+    for (int i = 0; i < count; i++) {
+        if (!urls[i] || !urls[i][0]) continue;
+        HealthEntry* e = find_entry(urls[i]);
+        if (!e) e = add_entry(urls[i]);
+        if (!e) break;
+        if (e->queued || e->probing) continue;
+        if (e->checked_at == 0 || now - e->checked_at >= entry_ttl(e)) {
+            e->queued = true;
+            queued++;
+        }
+    }
+
+    // Top up the worker pool; workers exit once the queue is empty
+    int to_start = RADIO_HEALTH_WORKERS - active_workers;
+    if (to_start > queued) to_start = queued;
+    for (int i = 0; i < to_start; i++) {
+        pthread_t thread;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setstacksize(&attr, 1024 * 1024);  // mbedtls + getaddrinfo
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        if (pthread_create(&thread, &attr, health_worker_func, NULL) == 0) {
+            active_workers++;
+        } else {
+            LOG_error("[RadioHealth] Failed to start probe worker\n");
+        }
+        pthread_attr_destroy(&attr);
+    }
+
+    pthread_mutex_unlock(&health_mutex);
+}
+
+RadioHealthStatus radio_health_get(const char* url) {
+    RadioHealthStatus status = RADIO_HEALTH_UNKNOWN;
+    time_t now = time(NULL);
+
+    pthread_mutex_lock(&health_mutex);
+    HealthEntry* e = find_entry(url);
+    if (e && e->checked_at > 0 && now - e->checked_at < entry_ttl(e)) {
+        status = e->status;
+    }
+    pthread_mutex_unlock(&health_mutex);
+    return status;
+}
+
+int radio_health_rank(const char* url) {
+    switch (radio_health_get(url)) {
+        case RADIO_HEALTH_OK: return 0;
+        case RADIO_HEALTH_UNKNOWN: return 1;
+        case RADIO_HEALTH_SLOW: return 2;
+        case RADIO_HEALTH_DEAD: return 3;
+    }
+    return 1;
+}
+
+uint32_t radio_health_version(void) {
+    return health_version;
+}
@@ -0,0 +1,34 @@
+#ifndef __RADIO_HEALTH_H__
+#define __RADIO_HEALTH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Station health from background probes
+typedef enum {
+    RADIO_HEALTH_UNKNOWN = 0,   // Never probed or result expired
+    RADIO_HEALTH_OK,
+    RADIO_HEALTH_SLOW,          // Reachable but slow to connect or start audio
+    RADIO_HEALTH_DEAD           // Unreachable, HTTP error, or no audio
+} RadioHealthStatus;
+
+// Load cached probe results from disk
+void radio_health_init(void);
+
+// Save results and stop queuing new probes (running probes finish in the background)
+void radio_health_cleanup(void);
+
+// Queue probes for stations whose cached result is missing or older than the TTL.
+// Runs on a small worker pool; workers wait while radio is playing.
+void radio_health_probe(const char* const* urls, int count);
+
+// Get cached health for a station URL
+RadioHealthStatus radio_health_get(const char* url);
+
+// Sort key: healthy stations first, dead last
+int radio_health_rank(const char* url);
+
+// Incremented whenever a probe result changes (for re-sorting lists)
+uint32_t radio_health_version(void);
+
+#endif
@@ -73,7 +73,10 @@ int radio_hls_parse_playlist(HLSContext* ctx, const char* content, const char* b
     float segment_duration = 0;
     char segment_title[128] = "";
     char segment_artist[128] = "";
-    char variant_url[HLS_MAX_URL_LEN] = "";
+    HLSVariant variants[HLS_MAX_VARIANTS];
+    int variant_count = 0;
+    int pending_bandwidth = 0;
+    char pending_codecs[64] = "";
     bool is_master_playlist = false;
 
     while (*line && ctx->segment_count < HLS_MAX_SEGMENTS) {
@@ -94,8 +97,24 @@ int radio_hls_parse_playlist(HLSContext* ctx, const char* content, const char* b
             if (strncmp(line_buf, "#EXTM3U", 7) == 0) {
                 // Valid M3U8 header
             } else if (strncmp(line_buf, "#EXT-X-STREAM-INF:", 18) == 0) {
-                // Master playlist - we need to fetch the variant
+                // Master playlist - remember attributes for the URL on the next line
                 is_master_playlist = true;
+                pending_bandwidth = 0;
+                pending_codecs[0] = '\0';
+                const char* bw = strstr(line_buf, ":BANDWIDTH=");
+                if (!bw) bw = strstr(line_buf, ",BANDWIDTH=");
+                if (bw) pending_bandwidth = atoi(bw + 11);
+                const char* codecs = strstr(line_buf, "CODECS=\"");
+                if (codecs) {
+                    codecs += 8;
+                    const char* codecs_end = strchr(codecs, '"');
+                    if (codecs_end) {
+                        int len = codecs_end - codecs;
+                        if (len > 63) len = 63;
+                        strncpy(pending_codecs, codecs, len);
+                        pending_codecs[len] = '\0';
+                    }
+                }
             } else if (strncmp(line_buf, "#EXT-X-TARGETDURATION:", 22) == 0) {
                 ctx->target_duration = atof(line_buf + 22);
             } else if (strncmp(line_buf, "#EXT-X-MEDIA-SEQUENCE:", 22) == 0) {
@@ -135,16 +154,22 @@ int radio_hls_parse_playlist(HLSContext* ctx, const char* content, const char* b
                 ctx->is_live = false;
             } else if (line_buf[0] != '#' && line_buf[0] != '\0') {
                 // This is a URL
-                if (is_master_playlist && variant_url[0] == '\0') {
-                    // Save first variant URL
-                    radio_hls_resolve_url(ctx->base_url, line_buf, variant_url, HLS_MAX_URL_LEN);
-                } else if (!is_master_playlist) {
+                if (is_master_playlist) {
+                    if (variant_count < HLS_MAX_VARIANTS) {
+                        HLSVariant* v = &variants[variant_count++];
+                        radio_hls_resolve_url(ctx->base_url, line_buf, v->url, HLS_MAX_URL_LEN);
+                        v->bandwidth = pending_bandwidth;
+                        strcpy(v->codecs, pending_codecs);
+                    }
+                } else {
                     // Media segment
-                    radio_hls_resolve_url(ctx->base_url, line_buf,
-                               ctx->segments[ctx->segment_count].url, HLS_MAX_URL_LEN);
-                    ctx->segments[ctx->segment_count].duration = segment_duration;
-                    strncpy(ctx->segments[ctx->segment_count].title, segment_title, 127);
-                    strncpy(ctx->segments[ctx->segment_count].artist, segment_artist, 127);
+                    HLSSegment* seg = radio_hls_segment(ctx, ctx->segment_count);
+                    radio_hls_resolve_url(ctx->base_url, line_buf, seg->url, HLS_MAX_URL_LEN);
+                    seg->duration = segment_duration;
+                    strncpy(seg->title, segment_title, 127);
+                    seg->title[127] = '\0';
+                    strncpy(seg->artist, segment_artist, 127);
+                    seg->artist[127] = '\0';
                     ctx->segment_count++;
                     segment_duration = 0;
                     segment_title[0] = '\0';
@@ -158,24 +183,150 @@ int radio_hls_parse_playlist(HLSContext* ctx, const char* content, const char* b
         while (*line == '\n' || *line == '\r') line++;
     }
 
-    // If master playlist, fetch the variant playlist
-    if (is_master_playlist && variant_url[0]) {
-        uint8_t* playlist_buf = malloc(64 * 1024);
-        if (playlist_buf) {
-            int len = radio_net_fetch(variant_url, playlist_buf, 64 * 1024, NULL, 0);
-            if (len > 0) {
-                playlist_buf[len] = '\0';
-                // Update base URL for variant
-                radio_hls_get_base_url(variant_url, ctx->base_url, HLS_MAX_URL_LEN);
-                radio_hls_parse_playlist(ctx, (char*)playlist_buf, ctx->base_url);
+    // If master playlist, keep the variant list and start on the first listed variant
+    if (is_master_playlist && variant_count > 0) {
+        char first_url[HLS_MAX_URL_LEN];
+        strcpy(first_url, variants[0].url);
+
+        // Sort by ascending bandwidth (insertion sort, at most HLS_MAX_VARIANTS)
+        for (int i = 1; i < variant_count; i++) {
+            HLSVariant tmp = variants[i];
+            int j = i - 1;
+            while (j >= 0 && variants[j].bandwidth > tmp.bandwidth) {
+                variants[j + 1] = variants[j];
+                j--;
+            }
+            variants[j + 1] = tmp;
+        }
+
+        memcpy(ctx->variants, variants, variant_count * sizeof(HLSVariant));
+        ctx->variant_count = variant_count;
+        ctx->current_variant = 0;
+        for (int i = 0; i < variant_count; i++) {
+            if (strcmp(variants[i].url, first_url) == 0) {
+                ctx->current_variant = i;
+                break;
             }
-            free(playlist_buf);
         }
+
+        radio_hls_load_variant(ctx, ctx->current_variant);
     }
 
     return ctx->segment_count;
 }
 
+// Segment ring slot for entry `index` after the oldest one
+HLSSegment* radio_hls_segment(HLSContext* ctx, int index) {
+    return &ctx->segments[(unsigned)(ctx->media_sequence + index) % HLS_MAX_SEGMENTS];
+}
+
+// Append new segments from a refreshed live playlist, diffing by media sequence
+int radio_hls_merge_playlist(HLSContext* ctx, const HLSContext* fresh) {
+    ctx->target_duration = fresh->target_duration;
+    ctx->is_live = fresh->is_live;
+
+    int newest_seq = ctx->media_sequence + ctx->segment_count - 1;
+    int fresh_newest = fresh->media_sequence + fresh->segment_count - 1;
+    if (fresh_newest <= newest_seq) return 0;
+
+    // Fell behind the live window entirely - restart from the fresh playlist
+    if (ctx->segment_count == 0 || fresh->media_sequence > newest_seq + 1) {
+        memcpy(ctx->segments, fresh->segments, sizeof(ctx->segments));
+        ctx->media_sequence = fresh->media_sequence;
+        ctx->segment_count = fresh->segment_count;
+        ctx->current_segment = 0;
+        return fresh->segment_count;
+    }
+
+    int appended = 0;
+    for (int seq = newest_seq + 1; seq <= fresh_newest; seq++) {
+        if (ctx->segment_count == HLS_MAX_SEGMENTS) {
+            // Only evict segments that have already been played
+            if (ctx->current_segment <= 0) break;
+            ctx->media_sequence++;
+            ctx->segment_count--;
+            ctx->current_segment--;
+        }
+        // Both rings are keyed by sequence number, so slots line up
+        const HLSSegment* src = &fresh->segments[(unsigned)seq % HLS_MAX_SEGMENTS];
+        memcpy(radio_hls_segment(ctx, ctx->segment_count), src, sizeof(HLSSegment));
+        ctx->segment_count++;
+        appended++;
+    }
+    return appended;
+}
+
+// Fetch a variant's media playlist into ctx
+int radio_hls_load_variant(HLSContext* ctx, int index) {
+    if (index < 0 || index >= ctx->variant_count) return -1;
+
+    uint8_t* playlist_buf = malloc(64 * 1024);
+    if (!playlist_buf) return -1;
+
+    const char* url = ctx->variants[index].url;
+    int len = radio_net_fetch(url, playlist_buf, 64 * 1024, NULL, 0);
+    if (len <= 0) {
+        free(playlist_buf);
+        return -1;
+    }
+    playlist_buf[len] = '\0';
+
+    // Update base URL for variant
+    char base_url[HLS_MAX_URL_LEN];
+    radio_hls_get_base_url(url, base_url, HLS_MAX_URL_LEN);
+    int seg_count = radio_hls_parse_playlist(ctx, (char*)playlist_buf, base_url);
+    free(playlist_buf);
+
+    strncpy(ctx->media_url, url, HLS_MAX_URL_LEN - 1);
+    ctx->media_url[HLS_MAX_URL_LEN - 1] = '\0';
+    ctx->current_variant = index;
+    return seg_count;
+}
+
+// Variants can be swapped mid-stream if the decoder config stays the same
+static bool variant_compatible(const HLSVariant* a, const HLSVariant* b) {
+    if (a->codecs[0] == '\0' || b->codecs[0] == '\0') return true;
+    return strcmp(a->codecs, b->codecs) == 0;
+}
+
+// Pick the next variant from throughput and buffer health
+int radio_hls_select_variant(const HLSContext* ctx, int throughput_bps, float buffered_sec,
+                             float low_sec, float high_sec) {
+    int cur = ctx->current_variant;
+    if (ctx->variant_count < 2 || throughput_bps <= 0) return cur;
+
+    const HLSVariant* current = &ctx->variants[cur];
+
+    // Highest compatible variant that fits in the given share of throughput
+    int fit_down = -1, fit_up = -1, lowest = -1;
+    for (int i = 0; i < ctx->variant_count; i++) {
+        if (!variant_compatible(current, &ctx->variants[i])) continue;
+        if (lowest < 0) lowest = i;
+        if (ctx->variants[i].bandwidth <= throughput_bps * 8 / 10) fit_down = i;
+        if (ctx->variants[i].bandwidth <= throughput_bps * 6 / 10) fit_up = i;
+    }
+
+    // Buffer nearly drained: step down one compatible variant regardless of estimate
+    if (buffered_sec < low_sec) {
+        for (int i = cur - 1; i >= 0; i--) {
+            if (variant_compatible(current, &ctx->variants[i])) return i;
+        }
+        return cur;
+    }
+
+    // Current variant no longer fits - drop straight to the best one that does
+    if (current->bandwidth > throughput_bps * 8 / 10) {
+        return fit_down >= 0 ? fit_down : (lowest >= 0 ? lowest : cur);
+    }
+
+    // Only move up with comfortable headroom on both throughput and buffer
+    if (fit_up > cur && buffered_sec >= high_sec) {
+        return fit_up;
+    }
+
+    return cur;
+}
+
 // Fetch and parse M3U8 playlist from URL
 int radio_hls_fetch_playlist(HLSContext* ctx, const char* url) {
     uint8_t* playlist_buf = malloc(64 * 1024);
@@ -197,6 +348,12 @@ int radio_hls_fetch_playlist(HLSContext* ctx, const char* url) {
     int seg_count = radio_hls_parse_playlist(ctx, (char*)playlist_buf, base_url);
     free(playlist_buf);
 
+    // A master playlist already recorded the chosen variant's URL
+    if (ctx->variant_count == 0) {
+        strncpy(ctx->media_url, url, HLS_MAX_URL_LEN - 1);
+        ctx->media_url[HLS_MAX_URL_LEN - 1] = '\0';
+    }
+
     return seg_count;
 }
 
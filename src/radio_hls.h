@@ -5,6 +5,7 @@
 #include <stdbool.h>
 
 #define HLS_MAX_SEGMENTS 64
+#define HLS_MAX_VARIANTS 8
 #define HLS_MAX_URL_LEN 1024
 #define HLS_SEGMENT_BUF_SIZE (256 * 1024)
 #define HLS_AAC_BUF_SIZE (128 * 1024)
@@ -17,14 +18,27 @@ typedef struct {
     char artist[128];
 } HLSSegment;
 
+// HLS variant stream from a master playlist (#EXT-X-STREAM-INF)
+typedef struct {
+    char url[HLS_MAX_URL_LEN];
+    int bandwidth;       // Peak bits per second (BANDWIDTH attribute)
+    char codecs[64];     // CODECS attribute, empty if not given
+} HLSVariant;
+
 // HLS context
+// segments is a ring keyed by sequence number: entry i (0 = oldest) lives in
+// slot (media_sequence + i) % HLS_MAX_SEGMENTS. Use radio_hls_segment() to access it.
 typedef struct {
     char base_url[HLS_MAX_URL_LEN];
+    char media_url[HLS_MAX_URL_LEN];       // Media playlist currently in use
+    HLSVariant variants[HLS_MAX_VARIANTS]; // Sorted by ascending bandwidth
+    int variant_count;                     // 0 if not from a master playlist
+    int current_variant;
     HLSSegment segments[HLS_MAX_SEGMENTS];
     int segment_count;
-    int current_segment;
+    int current_segment;                   // Entry index relative to the oldest segment
     float target_duration;
-    int media_sequence;
+    int media_sequence;                    // Sequence number of the oldest segment
     int last_played_sequence;
     bool is_live;
     uint32_t last_playlist_fetch;
@@ -41,6 +55,25 @@ int radio_hls_parse_playlist(HLSContext* ctx, const char* content, const char* b
 // Returns number of segments found, or -1 on error
 int radio_hls_fetch_playlist(HLSContext* ctx, const char* url);
 
+// Get segment entry `index` (0 = oldest) from the segment ring
+HLSSegment* radio_hls_segment(HLSContext* ctx, int index);
+
+// Merge a freshly parsed live playlist into ctx, appending segments newer than the
+// newest one held. Played entries are evicted when the ring is full.
+// Returns number of segments appended
+int radio_hls_merge_playlist(HLSContext* ctx, const HLSContext* fresh);
+
+// Fetch the media playlist of variant `index` into ctx, keeping the variant list.
+// Caller re-aligns current_segment using last_played_sequence.
+// Returns number of segments found, or -1 on error
+int radio_hls_load_variant(HLSContext* ctx, int index);
+
+// Choose the variant to play next from measured throughput (bits/s) and buffered seconds.
+// Below low_sec it steps down whatever the estimate; it only climbs from high_sec up.
+// Only variants with the current codec config are considered so switches are seamless.
+int radio_hls_select_variant(const HLSContext* ctx, int throughput_bps, float buffered_sec,
+                             float low_sec, float high_sec);
+
 // URL utilities
 void radio_hls_get_base_url(const char* url, char* base, int base_size);
 void radio_hls_resolve_url(const char* base, const char* relative, char* result, int result_size);
@@ -0,0 +1,216 @@
+#define _GNU_SOURCE
+#include "radio_mirror.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "defines.h"
+#include "api.h"
+
+#define RADIO_MIRROR_FILE SHARED_USERDATA_PATH "/music-player/radio/mirrors.txt"
+#define RADIO_MIRROR_STATIONS 64
+#define RADIO_MIRROR_MAX_FAILURES 3     // Consecutive failures before a mirror goes last
+
+typedef struct {
+    char url[RADIO_MAX_URL];
+    int latency_ms;         // Smoothed time to audio headers (0 = never measured)
+    int failures;           // Consecutive failed attempts
+} MirrorEntry;
+
+// mirrors[0] is always the station URL itself
+typedef struct {
+    char station_url[RADIO_MAX_URL];
+    MirrorEntry mirrors[RADIO_MIRROR_MAX];
+    int count;
+    time_t last_used;
+} MirrorStation;
+
+// Module state
+static MirrorStation stations[RADIO_MIRROR_STATIONS];
+static int station_count = 0;
+static bool mirror_dirty = false;
+static pthread_mutex_t mirror_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Caller holds mirror_mutex
+static MirrorStation* find_station(const char* station_url, bool create) {
+    for (int i = 0; i < station_count; i++) {
+        if (strcmp(stations[i].station_url, station_url) == 0) return &stations[i];
+    }
+    if (!create) return NULL;
+
+    MirrorStation* s;
+    if (station_count < RADIO_MIRROR_STATIONS) {
+        s = &stations[station_count++];
+    } else {
+        // Reuse the least recently played station
+        s = &stations[0];
+        for (int i = 1; i < station_count; i++) {
+            if (stations[i].last_used < s->last_used) s = &stations[i];
+        }
+    }
+
+    memset(s, 0, sizeof(MirrorStation));
+    strncpy(s->station_url, station_url, RADIO_MAX_URL - 1);
+    strncpy(s->mirrors[0].url, station_url, RADIO_MAX_URL - 1);
+    s->count = 1;
+    return s;
+}
+
+// Caller holds mirror_mutex
+static MirrorEntry* find_mirror(MirrorStation* s, const char* mirror_url, bool create) {
+    for (int i = 0; i < s->count; i++) {
+        if (strcmp(s->mirrors[i].url, mirror_url) == 0) return &s->mirrors[i];
+    }
+    if (!create) return NULL;
+
+    MirrorEntry* m;
+    if (s->count < RADIO_MIRROR_MAX) {
+        m = &s->mirrors[s->count++];
+    } else {
+        // Replace the worst alternate (never the station URL)
+        m = &s->mirrors[1];
+        for (int i = 2; i < s->count; i++) {
+            MirrorEntry* e = &s->mirrors[i];
+            if (e->failures > m->failures ||
+                (e->failures == m->failures && e->latency_ms > m->latency_ms)) {
+                m = e;
+            }
+        }
+    }
+
+    memset(m, 0, sizeof(MirrorEntry));
+    strncpy(m->url, mirror_url, RADIO_MAX_URL - 1);
+    return m;
+}
+
+// Lower is better: measured mirrors by latency, then unmeasured, then failing
+static int mirror_score(const MirrorEntry* m) {
+    if (m->failures >= RADIO_MIRROR_MAX_FAILURES) return 2000000 + m->failures;
+    if (m->latency_ms == 0) return 1000000;
+    return m->latency_ms;
+}
+
+void radio_mirror_init(void) {
+    pthread_mutex_lock(&mirror_mutex);
+    station_count = 0;
+    mirror_dirty = false;
+
+    FILE* f = fopen(RADIO_MIRROR_FILE, "r");
+    if (f) {
+        char line[RADIO_MAX_URL * 2 + 64];
+        while (fgets(line, sizeof(line), f)) {
+            char* nl = strchr(line, '\n');
+            if (nl) *nl = '\0';
+
+            // Format: station_url|mirror_url|latency_ms|failures
+            char* station_url = strtok(line, "|");
+            char* mirror_url = strtok(NULL, "|");
+            char* latency = strtok(NULL, "|");
+            char* failures = strtok(NULL, "|");
+            if (!station_url || !mirror_url || !latency || !failures) continue;
+
+            MirrorStation* s = find_station(station_url, true);
+            MirrorEntry* m = find_mirror(s, mirror_url, true);
+            m->latency_ms = atoi(latency);
+            m->failures = atoi(failures);
+        }
+        fclose(f);
+    }
+
+    pthread_mutex_unlock(&mirror_mutex);
+}
+
+void radio_mirror_cleanup(void) {
+    pthread_mutex_lock(&mirror_mutex);
+    if (mirror_dirty) {
+        mkdir(SHARED_USERDATA_PATH "/music-player", 0755);
+        mkdir(SHARED_USERDATA_PATH "/music-player/radio", 0755);
+        FILE* f = fopen(RADIO_MIRROR_FILE, "w");
+        if (f) {
+            for (int i = 0; i < station_count; i++) {
+                MirrorStation* s = &stations[i];
+                for (int j = 0; j < s->count; j++) {
+                    fprintf(f, "%s|%s|%d|%d\n", s->station_url, s->mirrors[j].url,
+                            s->mirrors[j].latency_ms, s->mirrors[j].failures);
+                }
+            }
+            fclose(f);
+            mirror_dirty = false;
+        } else {
+            LOG_error("[RadioMirror] Failed to save %s\n", RADIO_MIRROR_FILE);
+        }
+    }
+    pthread_mutex_unlock(&mirror_mutex);
+}
+
+void radio_mirror_add(const char* station_url, const char* mirror_url) {
+    if (!station_url || !mirror_url || !mirror_url[0]) return;
+
+    pthread_mutex_lock(&mirror_mutex);
+    MirrorStation* s = find_station(station_url, true);
+    find_mirror(s, mirror_url, true);
+    pthread_mutex_unlock(&mirror_mutex);
+}
+
+int radio_mirror_candidates(const char* station_url, char urls[][RADIO_MAX_URL], int max) {
+    if (max <= 0) return 0;
+
+    pthread_mutex_lock(&mirror_mutex);
+    MirrorStation* s = find_station(station_url, false);
+    if (!s) {
+        pthread_mutex_unlock(&mirror_mutex);
+        strncpy(urls[0], station_url, RADIO_MAX_URL - 1);
+        urls[0][RADIO_MAX_URL - 1] = '\0';
+        return 1;
+    }
+
+    // Insertion sort by score (stable, so the station URL leads ties)
+    int order[RADIO_MIRROR_MAX];
+    for (int i = 0; i < s->count; i++) {
+        int j = i;
+        while (j > 0 && mirror_score(&s->mirrors[order[j - 1]]) > mirror_score(&s->mirrors[i])) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    int count = s->count < max ? s->count : max;
+    bool has_station = false;
+    for (int i = 0; i < count; i++) {
+        strncpy(urls[i], s->mirrors[order[i]].url, RADIO_MAX_URL - 1);
+        urls[i][RADIO_MAX_URL - 1] = '\0';
+        if (strcmp(urls[i], station_url) == 0) has_station = true;
+    }
+    // Mirrors can all go stale, so the station URL keeps the last slot
+    if (!has_station) {
+        strncpy(urls[count - 1], station_url, RADIO_MAX_URL - 1);
+        urls[count - 1][RADIO_MAX_URL - 1] = '\0';
+    }
+    pthread_mutex_unlock(&mirror_mutex);
+    return count;
+}
+
+void radio_mirror_record(const char* station_url, const char* mirror_url, int latency_ms) {
+    if (!station_url || !mirror_url || !mirror_url[0]) return;
+
+    pthread_mutex_lock(&mirror_mutex);
+    MirrorStation* s = find_station(station_url, true);
+    s->last_used = time(NULL);
+
+    MirrorEntry* m = find_mirror(s, mirror_url, latency_ms >= 0);
+    if (m) {
+        if (latency_ms < 0) {
+            m->failures++;
+        } else {
+            m->failures = 0;
+            if (latency_ms == 0) latency_ms = 1;  // 0 means "never measured"
+            m->latency_ms = m->latency_ms ? (m->latency_ms * 3 + latency_ms) / 4 : latency_ms;
+        }
+        mirror_dirty = true;
+    }
+    pthread_mutex_unlock(&mirror_mutex);
+}
@@ -0,0 +1,27 @@
+#ifndef __RADIO_MIRROR_H__
+#define __RADIO_MIRROR_H__
+
+#include <stdbool.h>
+#include "radio.h"  // For RADIO_MAX_URL
+
+#define RADIO_MIRROR_MAX 4          // Alternate URLs remembered per station
+
+// Load mirror latency history from disk
+void radio_mirror_init(void);
+
+// Save history
+void radio_mirror_cleanup(void);
+
+// Register an advertised mirror for a station (from station lists)
+void radio_mirror_add(const char* station_url, const char* mirror_url);
+
+// Get the URLs to try for a station, historically fastest first.
+// The station URL itself is always included (in the last slot if it
+// didn't make the cut). Returns count.
+int radio_mirror_candidates(const char* station_url, char urls[][RADIO_MAX_URL], int max);
+
+// Record how long a mirror took to deliver audio headers (latency_ms < 0 = failed).
+// Mirrors not seen before (e.g. redirect targets) are added.
+void radio_mirror_record(const char* station_url, const char* mirror_url, int latency_ms);
+
+#endif
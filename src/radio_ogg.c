@@ -0,0 +1,344 @@
+#define _GNU_SOURCE
+#include "radio_ogg.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include <ogg/ogg.h>
+#include <opus.h>
+
+// stb_vorbis implementation lives in player.c
+#define STB_VORBIS_HEADER_ONLY
+#include "audio/stb_vorbis.h"
+
+#include "defines.h"
+#include "api.h"
+
+#define OGG_OPUS_RATE 48000
+#define OGG_MAX_FRAMES 5760                 // 120ms at 48kHz, the longest Opus packet
+#define OGG_VORBIS_BUF_SIZE (128 * 1024)    // Raw pages waiting for the Vorbis decoder
+#define OGG_MAX_COMMENT 256
+
+typedef enum {
+    OGG_CODEC_NONE = 0,     // No BOS page seen yet
+    OGG_CODEC_OPUS,
+    OGG_CODEC_VORBIS,
+    OGG_CODEC_UNSUPPORTED
+} OggCodec;
+
+typedef struct {
+    bool open;
+    ogg_sync_state sync;
+    ogg_stream_state stream;
+    bool stream_init;
+
+    // Current chain (logical stream)
+    int serial;
+    OggCodec codec;
+    int packets;                // Packets seen so far (headers come first)
+    bool in_bos_group;          // Only BOS pages seen since the chain started
+
+    // Opus (libopus, always decoded to 48kHz stereo)
+    OpusDecoder* opus;
+    int opus_preskip;           // Samples still to drop at chain start
+
+    // Vorbis (stb_vorbis pushdata API, fed whole pages)
+    stb_vorbis* vorbis;
+    uint8_t* vorbis_buf;
+    int vorbis_len;
+    int vorbis_rate;
+
+    int16_t pcm[OGG_MAX_FRAMES * 2];
+
+    RadioOggPcmCallback on_pcm;
+    RadioOggTagsCallback on_tags;
+} OggContext;
+
+static OggContext ogg;
+
+static uint32_t read_le32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Copy the value of a "KEY=value" comment if it matches key (first match wins)
+static void copy_comment(const uint8_t* p, uint32_t n, const char* key, char* out) {
+    size_t key_len = strlen(key);
+    if (out[0] || n <= key_len || strncasecmp((const char*)p, key, key_len) != 0) return;
+
+    n -= key_len;
+    if (n >= OGG_MAX_COMMENT) n = OGG_MAX_COMMENT - 1;
+    memcpy(out, p + key_len, n);
+    out[n] = '\0';
+}
+
+// Parse a Vorbis comment block (shared by OpusTags and the Vorbis comment header).
+// data starts after the codec magic: vendor length, vendor, count, then entries
+static void parse_comments(const uint8_t* data, int len) {
+    if (len < 8) return;
+
+    uint32_t vendor_len = read_le32(data);
+    if (vendor_len > (uint32_t)len - 8) return;
+
+    const uint8_t* p = data + 4 + vendor_len;
+    const uint8_t* end = data + len;
+    uint32_t count = read_le32(p);
+    p += 4;
+
+    char artist[OGG_MAX_COMMENT] = "";
+    char title[OGG_MAX_COMMENT] = "";
+    for (uint32_t i = 0; i < count && end - p >= 4; i++) {
+        uint32_t n = read_le32(p);
+        p += 4;
+        if (n > (uint32_t)(end - p)) break;
+
+        copy_comment(p, n, "ARTIST=", artist);
+        copy_comment(p, n, "TITLE=", title);
+        p += n;
+    }
+
+    if ((artist[0] || title[0]) && ogg.on_tags) {
+        ogg.on_tags(artist, title);
+    }
+}
+
+static void end_chain(void) {
+    if (ogg.opus) {
+        opus_decoder_destroy(ogg.opus);
+        ogg.opus = NULL;
+    }
+    if (ogg.vorbis) {
+        stb_vorbis_close(ogg.vorbis);
+        ogg.vorbis = NULL;
+    }
+    ogg.vorbis_len = 0;
+    ogg.codec = OGG_CODEC_NONE;
+    ogg.packets = 0;
+}
+
+// Identify the codec from the identification header on a BOS page
+static OggCodec identify_codec(const ogg_page* page) {
+    const uint8_t* body = page->body;
+    long len = page->body_len;
+
+    if (len >= 19 && memcmp(body, "OpusHead", 8) == 0) {
+        // Channel mapping family 0 (mono/stereo) is all radio uses
+        return body[9] <= 2 ? OGG_CODEC_OPUS : OGG_CODEC_UNSUPPORTED;
+    }
+    if (len >= 30 && memcmp(body, "\x01vorbis", 7) == 0) {
+        return OGG_CODEC_VORBIS;
+    }
+    return OGG_CODEC_UNSUPPORTED;
+}
+
+// A BOS page starts a new chain: reset decoders for the new logical stream
+static void start_chain(const ogg_page* page, OggCodec codec) {
+    end_chain();
+
+    ogg.serial = ogg_page_serialno(page);
+    if (ogg.stream_init) {
+        ogg_stream_reset_serialno(&ogg.stream, ogg.serial);
+    } else {
+        ogg_stream_init(&ogg.stream, ogg.serial);
+        ogg.stream_init = true;
+    }
+
+    ogg.codec = codec;
+    if (codec == OGG_CODEC_OPUS) {
+        const uint8_t* head = page->body;
+        int16_t gain = (int16_t)(head[16] | (head[17] << 8));
+        int err = 0;
+
+        ogg.opus = opus_decoder_create(OGG_OPUS_RATE, 2, &err);
+        if (!ogg.opus) {
+            LOG_error("[RadioOgg] Opus decoder init failed: %d\n", err);
+            ogg.codec = OGG_CODEC_UNSUPPORTED;
+            return;
+        }
+        if (gain != 0) opus_decoder_ctl(ogg.opus, OPUS_SET_GAIN(gain));
+        ogg.opus_preskip = head[10] | (head[11] << 8);
+    } else if (codec == OGG_CODEC_UNSUPPORTED) {
+        LOG_error("[RadioOgg] Unsupported codec in Ogg stream\n");
+    }
+}
+
+static void opus_packet(const ogg_packet* op) {
+    if (ogg.packets == 0) return;  // OpusHead, already read from the BOS page
+
+    if (ogg.packets == 1) {
+        if (op->bytes >= 8 && memcmp(op->packet, "OpusTags", 8) == 0) {
+            parse_comments(op->packet + 8, op->bytes - 8);
+        }
+        return;
+    }
+
+    int frames = opus_decode(ogg.opus, op->packet, op->bytes, ogg.pcm, OGG_MAX_FRAMES, 0);
+    if (frames <= 0) return;  // Corrupt packet, skip it
+
+    int skip = ogg.opus_preskip < frames ? ogg.opus_preskip : frames;
+    ogg.opus_preskip -= skip;
+    if (frames > skip && ogg.on_pcm) {
+        ogg.on_pcm(ogg.pcm + skip * 2, frames - skip, OGG_OPUS_RATE);
+    }
+}
+
+// Run a page through libogg packet assembly (Opus audio, header packets)
+static void read_packets(ogg_page* page) {
+    if (ogg_stream_pagein(&ogg.stream, page) != 0) return;
+
+    ogg_packet op;
+    int ret;
+    while ((ret = ogg_stream_packetout(&ogg.stream, &op)) != 0) {
+        if (ret < 0) continue;  // Gap from lost pages
+
+        if (ogg.codec == OGG_CODEC_OPUS) {
+            opus_packet(&op);
+        } else if (ogg.packets == 1 && op.bytes >= 7 && memcmp(op.packet, "\x03vorbis", 7) == 0) {
+            parse_comments(op.packet + 7, op.bytes - 7);
+        }
+        ogg.packets++;
+    }
+}
+
+static void vorbis_consume(int used) {
+    if (used >= ogg.vorbis_len) {
+        ogg.vorbis_len = 0;
+    } else {
+        memmove(ogg.vorbis_buf, ogg.vorbis_buf + used, ogg.vorbis_len - used);
+        ogg.vorbis_len -= used;
+    }
+}
+
+// Convert planar float output to interleaved stereo int16
+static void vorbis_output(float** out, int channels, int samples) {
+    float* left = out[0];
+    float* right = channels > 1 ? out[1] : out[0];
+
+    while (samples > 0 && ogg.on_pcm) {
+        int frames = samples < OGG_MAX_FRAMES ? samples : OGG_MAX_FRAMES;
+        for (int i = 0; i < frames; i++) {
+            float l = left[i] * 32767.0f;
+            float r = right[i] * 32767.0f;
+            if (l > 32767.0f) l = 32767.0f; else if (l < -32768.0f) l = -32768.0f;
+            if (r > 32767.0f) r = 32767.0f; else if (r < -32768.0f) r = -32768.0f;
+            ogg.pcm[i * 2] = (int16_t)l;
+            ogg.pcm[i * 2 + 1] = (int16_t)r;
+        }
+        ogg.on_pcm(ogg.pcm, frames, ogg.vorbis_rate);
+
+        left += frames;
+        right += frames;
+        samples -= frames;
+    }
+}
+
+// stb_vorbis parses Ogg framing itself, so it gets the raw pages of the current chain
+static void vorbis_page(const ogg_page* page) {
+    int size = page->header_len + page->body_len;
+    if (ogg.vorbis_len + size > OGG_VORBIS_BUF_SIZE) {
+        if (!ogg.vorbis) {
+            LOG_error("[RadioOgg] Vorbis headers too large\n");
+            ogg.codec = OGG_CODEC_UNSUPPORTED;
+            return;
+        }
+        // Decoder stalled on a damaged page: drop it and resync on the next one
+        stb_vorbis_flush_pushdata(ogg.vorbis);
+        ogg.vorbis_len = 0;
+    }
+
+    memcpy(ogg.vorbis_buf + ogg.vorbis_len, page->header, page->header_len);
+    memcpy(ogg.vorbis_buf + ogg.vorbis_len + page->header_len, page->body, page->body_len);
+    ogg.vorbis_len += size;
+
+    if (!ogg.vorbis) {
+        int used = 0, error = 0;
+        ogg.vorbis = stb_vorbis_open_pushdata(ogg.vorbis_buf, ogg.vorbis_len, &used, &error, NULL);
+        if (!ogg.vorbis) {
+            if (error != VORBIS_need_more_data) {
+                LOG_error("[RadioOgg] Vorbis header error: %d\n", error);
+                ogg.codec = OGG_CODEC_UNSUPPORTED;
+            }
+            return;
+        }
+        ogg.vorbis_rate = stb_vorbis_get_info(ogg.vorbis).sample_rate;
+        vorbis_consume(used);
+    }
+
+    while (ogg.vorbis_len > 0) {
+        int channels = 0, samples = 0;
+        float** out = NULL;
+        int used = stb_vorbis_decode_frame_pushdata(ogg.vorbis, ogg.vorbis_buf, ogg.vorbis_len,
+                                                    &channels, &out, &samples);
+        if (used == 0) break;  // Needs more data
+        vorbis_consume(used);
+
+        if (samples > 0 && channels > 0) {
+            vorbis_output(out, channels, samples);
+        }
+    }
+}
+
+int radio_ogg_open(RadioOggPcmCallback on_pcm, RadioOggTagsCallback on_tags) {
+    radio_ogg_close();
+
+    ogg.vorbis_buf = malloc(OGG_VORBIS_BUF_SIZE);
+    if (!ogg.vorbis_buf) {
+        LOG_error("[RadioOgg] Failed to allocate page buffer\n");
+        return -1;
+    }
+
+    ogg_sync_init(&ogg.sync);
+    ogg.on_pcm = on_pcm;
+    ogg.on_tags = on_tags;
+    ogg.open = true;
+    return 0;
+}
+
+void radio_ogg_close(void) {
+    if (!ogg.open) return;
+
+    end_chain();
+    if (ogg.stream_init) ogg_stream_clear(&ogg.stream);
+    ogg_sync_clear(&ogg.sync);
+    free(ogg.vorbis_buf);
+    memset(&ogg, 0, sizeof(ogg));
+}
+
+int radio_ogg_feed(const uint8_t* data, int len) {
+    if (!ogg.open) return -1;
+
+    char* buf = ogg_sync_buffer(&ogg.sync, len);
+    if (!buf) return -1;
+    memcpy(buf, data, len);
+    ogg_sync_wrote(&ogg.sync, len);
+
+    ogg_page page;
+    int ret;
+    while ((ret = ogg_sync_pageout(&ogg.sync, &page)) != 0) {
+        if (ret < 0) continue;  // Skipped bytes to resync on a page boundary
+
+        if (ogg_page_bos(&page)) {
+            OggCodec codec = identify_codec(&page);
+            // Multiplexed streams put all BOS pages first: keep the audio one
+            if (ogg.in_bos_group && codec == OGG_CODEC_UNSUPPORTED &&
+                (ogg.codec == OGG_CODEC_OPUS || ogg.codec == OGG_CODEC_VORBIS)) {
+                continue;
+            }
+            start_chain(&page, codec);
+            ogg.in_bos_group = true;
+        } else {
+            ogg.in_bos_group = false;
+            // Pages before the first BOS, or from another logical stream
+            if (ogg.codec == OGG_CODEC_NONE || ogg_page_serialno(&page) != ogg.serial) continue;
+        }
+
+        if (ogg.codec == OGG_CODEC_OPUS) {
+            read_packets(&page);
+        } else if (ogg.codec == OGG_CODEC_VORBIS) {
+            if (ogg.packets < 3) read_packets(&page);  // Comment header
+            vorbis_page(&page);
+        }
+    }
+
+    return (ogg.codec == OGG_CODEC_UNSUPPORTED && !ogg.in_bos_group) ? -1 : 0;
+}
@@ -0,0 +1,27 @@
+#ifndef __RADIO_OGG_H__
+#define __RADIO_OGG_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Push decoder for Ogg Opus / Ogg Vorbis radio streams. Handles chained
+// streams (Icecast starts a new logical stream with a BOS page on every
+// track change) and reads the track title from each chain's comment header.
+
+// Decoded audio: interleaved stereo, frames = samples per channel
+typedef void (*RadioOggPcmCallback)(const int16_t* pcm, int frames, int sample_rate);
+
+// New ARTIST/TITLE comments (either may be empty)
+typedef void (*RadioOggTagsCallback)(const char* artist, const char* title);
+
+// Start decoding a new stream. Returns 0 on success, -1 on allocation failure
+int radio_ogg_open(RadioOggPcmCallback on_pcm, RadioOggTagsCallback on_tags);
+
+// Free decoder state
+void radio_ogg_close(void);
+
+// Feed raw stream bytes; decoded audio is delivered through the callbacks.
+// Returns 0, or -1 if the current chain uses a codec we can't decode
+int radio_ogg_feed(const uint8_t* data, int len);
+
+#endif
@@ -0,0 +1,471 @@
+#define _GNU_SOURCE
+#include "radio_timeshift.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "defines.h"
+#include "api.h"
+
+#define TIMESHIFT_FILE SHARED_USERDATA_PATH "/music-player/radio/timeshift.dat"
+#define TIMESHIFT_CHUNK (64 * 1024)         // Write unit; every write is one aligned chunk
+#define TIMESHIFT_FILE_CHUNKS 512           // 32MB ring - about 30 minutes at 128kbps
+#define TIMESHIFT_RAM_CHUNKS 4              // Chunk being filled + chunks queued for the writer
+#define TIMESHIFT_INDEX_INTERVAL 8192       // One seek point per 8KB of stream (0.5s at 128kbps)
+#define TIMESHIFT_INDEX_MAX ((TIMESHIFT_FILE_CHUNKS + TIMESHIFT_RAM_CHUNKS) * \
+                             (TIMESHIFT_CHUNK / TIMESHIFT_INDEX_INTERVAL))  // Covers the ring at any bitrate
+#define TIMESHIFT_LIVE_EDGE_US 1000000      // Seeking this close to live just goes live
+#define TIMESHIFT_HEADER_LEN 7              // Enough for an ADTS header (MP3 needs 4)
+
+// Seek point: a frame start and the audio time at that frame
+typedef struct {
+    uint64_t pos;
+    uint64_t time_us;
+} TimeshiftIndexEntry;
+
+typedef struct {
+    int fd;
+    volatile bool active;
+    TimeshiftCodec codec;
+
+    // Stream bytes are addressed by absolute position since the stream started.
+    // Chunk k lives in RAM slot k % TIMESHIFT_RAM_CHUNKS until the writer takes
+    // it, then in write_buf while it is written to file slot k % TIMESHIFT_FILE_CHUNKS.
+    uint8_t* ram;
+    uint8_t* write_buf;
+    uint64_t write_pos;
+    uint64_t flushed_chunks;        // Chunks [0, flushed_chunks) have left RAM
+    uint64_t writing_chunk;         // Chunk in write_buf, UINT64_MAX if none
+    uint64_t lost_pos;              // Chunks the writer fell behind on end here
+    uint64_t read_pos;
+    bool write_failed;              // SD card error - only RAM data is usable
+
+    // Writer thread
+    pthread_t writer;
+    bool writer_running;
+    bool stopping;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    // Frame parser for the seek index
+    uint8_t hdr[TIMESHIFT_HEADER_LEN];
+    int hdr_len;
+    uint64_t hdr_pos;               // Absolute position of hdr[0]
+    int frame_skip;                 // Body bytes left in the current frame
+    uint64_t time_us;               // Audio time at the end of the parsed frames
+    uint64_t live_frame_pos;        // Start of the newest frame
+    TimeshiftIndexEntry index[TIMESHIFT_INDEX_MAX];
+    int index_head;                 // Oldest entry
+    int index_count;
+} TimeshiftContext;
+
+static TimeshiftContext ts = {
+    .fd = -1,
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER
+};
+
+// ============================================================================
+// Frame headers
+// ============================================================================
+
+// MPEG audio layer II/III header. Returns frame length or 0 if invalid.
+static int parse_mp3_header(const uint8_t* h, int* samples, int* sample_rate) {
+    static const int rates[3] = {44100, 48000, 32000};
+    static const short v1_l2[15] = {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384};
+    static const short v1_l3[15] = {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320};
+    static const short v2_l23[15] = {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160};
+
+    if (h[0] != 0xFF || (h[1] & 0xE0) != 0xE0) return 0;
+    int version = (h[1] >> 3) & 3;  // 0 = MPEG2.5, 2 = MPEG2, 3 = MPEG1
+    int layer = (h[1] >> 1) & 3;    // 1 = III, 2 = II (layer I isn't used by stations)
+    int br_idx = h[2] >> 4;
+    int sr_idx = (h[2] >> 2) & 3;
+    int padding = (h[2] >> 1) & 1;
+    if (version == 1 || (layer != 1 && layer != 2) || br_idx == 0 || br_idx == 15 || sr_idx == 3) {
+        return 0;
+    }
+
+    bool mpeg1 = (version == 3);
+    int rate = rates[sr_idx] >> (mpeg1 ? 0 : (version == 2 ? 1 : 2));
+    int kbps = mpeg1 ? (layer == 2 ? v1_l2[br_idx] : v1_l3[br_idx]) : v2_l23[br_idx];
+
+    // MPEG2/2.5 layer III frames carry half the samples
+    bool half = !mpeg1 && layer == 1;
+    *samples = half ? 576 : 1152;
+    *sample_rate = rate;
+    return (half ? 72 : 144) * kbps * 1000 / rate + padding;
+}
+
+// ADTS (AAC) header. Returns frame length or 0 if invalid.
+static int parse_adts_header(const uint8_t* h, int* samples, int* sample_rate) {
+    static const int rates[13] = {96000, 88200, 64000, 48000, 44100, 32000, 24000,
+                                  22050, 16000, 12000, 11025, 8000, 7350};
+
+    if (h[0] != 0xFF || (h[1] & 0xF6) != 0xF0) return 0;
+    int sr_idx = (h[2] >> 2) & 0x0F;
+    if (sr_idx > 12) return 0;
+    int frame_len = ((h[3] & 0x03) << 11) | (h[4] << 3) | (h[5] >> 5);
+    if (frame_len < TIMESHIFT_HEADER_LEN) return 0;
+
+    *samples = 1024 * ((h[6] & 0x03) + 1);
+    *sample_rate = rates[sr_idx];
+    return frame_len;
+}
+
+// ============================================================================
+// Seek index (caller holds ts.mutex)
+// ============================================================================
+
+static TimeshiftIndexEntry* index_at(int i) {
+    return &ts.index[(ts.index_head + i) % TIMESHIFT_INDEX_MAX];
+}
+
+static void index_add(uint64_t pos, uint64_t time_us) {
+    if (ts.index_count > 0 && pos < index_at(ts.index_count - 1)->pos + TIMESHIFT_INDEX_INTERVAL) {
+        return;
+    }
+    if (ts.index_count == TIMESHIFT_INDEX_MAX) {
+        ts.index_head = (ts.index_head + 1) % TIMESHIFT_INDEX_MAX;
+        ts.index_count--;
+    }
+    TimeshiftIndexEntry* e = index_at(ts.index_count++);
+    e->pos = pos;
+    e->time_us = time_us;
+}
+
+// Last entry at or before pos (entries are sorted by both pos and time)
+static int index_find_pos(uint64_t pos) {
+    int lo = 0, hi = ts.index_count - 1, found = -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (index_at(mid)->pos <= pos) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return found;
+}
+
+// Last entry at or before time_us
+static int index_find_time(uint64_t time_us) {
+    int lo = 0, hi = ts.index_count - 1, found = -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (index_at(mid)->time_us <= time_us) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return found;
+}
+
+static uint64_t time_at_pos(uint64_t pos) {
+    int i = index_find_pos(pos);
+    if (i >= 0) return index_at(i)->time_us;
+    return ts.index_count > 0 ? index_at(0)->time_us : 0;
+}
+
+// Walk frame headers in newly received data, adding seek points
+static void index_frames(const uint8_t* data, int len) {
+    uint64_t pos = ts.write_pos;
+    int i = 0;
+
+    while (i < len) {
+        if (ts.frame_skip > 0) {
+            int n = len - i;
+            if (n > ts.frame_skip) n = ts.frame_skip;
+            i += n;
+            pos += n;
+            ts.frame_skip -= n;
+            continue;
+        }
+
+        if (ts.hdr_len == 0) ts.hdr_pos = pos;
+        ts.hdr[ts.hdr_len++] = data[i++];
+        pos++;
+        if (ts.hdr_len < TIMESHIFT_HEADER_LEN) continue;
+
+        int samples = 0, rate = 0;
+        int frame_len = (ts.codec == TIMESHIFT_CODEC_ADTS)
+            ? parse_adts_header(ts.hdr, &samples, &rate)
+            : parse_mp3_header(ts.hdr, &samples, &rate);
+
+        if (frame_len >= TIMESHIFT_HEADER_LEN && rate > 0) {
+            index_add(ts.hdr_pos, ts.time_us);
+            ts.live_frame_pos = ts.hdr_pos;
+            ts.time_us += (uint64_t)samples * 1000000 / rate;
+            ts.frame_skip = frame_len - TIMESHIFT_HEADER_LEN;
+            ts.hdr_len = 0;
+        } else {
+            // Not a frame start - slide forward one byte and resync
+            memmove(ts.hdr, ts.hdr + 1, TIMESHIFT_HEADER_LEN - 1);
+            ts.hdr_len--;
+            ts.hdr_pos++;
+        }
+    }
+}
+
+// ============================================================================
+// Ring storage
+// ============================================================================
+
+// Oldest position still readable (caller holds ts.mutex). The writer may be
+// overwriting the file slot of chunk flushed_chunks - TIMESHIFT_FILE_CHUNKS.
+static uint64_t oldest_pos(void) {
+    if (ts.write_failed) return ts.flushed_chunks * TIMESHIFT_CHUNK;
+    uint64_t oldest = 0;
+    if (ts.flushed_chunks + 1 > TIMESHIFT_FILE_CHUNKS) {
+        oldest = (ts.flushed_chunks + 1 - TIMESHIFT_FILE_CHUNKS) * TIMESHIFT_CHUNK;
+    }
+    return oldest > ts.lost_pos ? oldest : ts.lost_pos;
+}
+
+// First seek point at or after pos (the live frame if none)
+static uint64_t frame_at_or_after(uint64_t pos) {
+    int i = index_find_pos(pos);
+    if (i >= 0 && index_at(i)->pos == pos) return pos;
+    i++;
+    return i < ts.index_count ? index_at(i)->pos : ts.live_frame_pos;
+}
+
+static void* timeshift_writer_func(void* arg) {
+    (void)arg;
+
+    pthread_mutex_lock(&ts.mutex);
+    while (true) {
+        if (ts.flushed_chunks < ts.write_pos / TIMESHIFT_CHUNK) {
+            // Take the chunk out of RAM so the network side never waits on the SD card
+            uint64_t k = ts.flushed_chunks;
+            memcpy(ts.write_buf, ts.ram + (k % TIMESHIFT_RAM_CHUNKS) * TIMESHIFT_CHUNK, TIMESHIFT_CHUNK);
+            ts.writing_chunk = k;
+            ts.flushed_chunks++;
+            off_t offset = (off_t)(k % TIMESHIFT_FILE_CHUNKS) * TIMESHIFT_CHUNK;
+
+            pthread_mutex_unlock(&ts.mutex);
+            ssize_t written = ts.write_failed ? 0 : pwrite(ts.fd, ts.write_buf, TIMESHIFT_CHUNK, offset);
+            pthread_mutex_lock(&ts.mutex);
+
+            if (written != TIMESHIFT_CHUNK && !ts.write_failed) {
+                LOG_error("[Timeshift] Write failed at chunk %llu, rewind limited to memory\n",
+                          (unsigned long long)k);
+                ts.write_failed = true;
+            }
+            ts.writing_chunk = UINT64_MAX;
+            continue;
+        }
+        if (ts.stopping) break;
+        pthread_cond_wait(&ts.cond, &ts.mutex);
+    }
+    pthread_mutex_unlock(&ts.mutex);
+    return NULL;
+}
+
+int radio_timeshift_open(TimeshiftCodec codec) {
+    radio_timeshift_close();
+
+    mkdir(SHARED_USERDATA_PATH "/music-player", 0755);
+    mkdir(SHARED_USERDATA_PATH "/music-player/radio", 0755);
+    int fd = open(TIMESHIFT_FILE, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        LOG_error("[Timeshift] Failed to open %s\n", TIMESHIFT_FILE);
+        return -1;
+    }
+
+    // RAM slots plus the writer's buffer
+    if (!ts.ram) ts.ram = malloc((TIMESHIFT_RAM_CHUNKS + 1) * TIMESHIFT_CHUNK);
+    if (!ts.ram) {
+        close(fd);
+        return -1;
+    }
+    ts.write_buf = ts.ram + TIMESHIFT_RAM_CHUNKS * TIMESHIFT_CHUNK;
+
+    pthread_mutex_lock(&ts.mutex);
+    ts.fd = fd;
+    ts.codec = codec;
+    ts.write_pos = 0;
+    ts.flushed_chunks = 0;
+    ts.writing_chunk = UINT64_MAX;
+    ts.lost_pos = 0;
+    ts.read_pos = 0;
+    ts.write_failed = false;
+    ts.stopping = false;
+    ts.hdr_len = 0;
+    ts.hdr_pos = 0;
+    ts.frame_skip = 0;
+    ts.time_us = 0;
+    ts.live_frame_pos = 0;
+    ts.index_head = 0;
+    ts.index_count = 0;
+    pthread_mutex_unlock(&ts.mutex);
+
+    if (pthread_create(&ts.writer, NULL, timeshift_writer_func, NULL) != 0) {
+        LOG_error("[Timeshift] Failed to start writer thread\n");
+        close(fd);
+        ts.fd = -1;
+        return -1;
+    }
+    ts.writer_running = true;
+    ts.active = true;
+    return 0;
+}
+
+void radio_timeshift_close(void) {
+    pthread_mutex_lock(&ts.mutex);
+    ts.active = false;
+    ts.stopping = true;
+    pthread_cond_broadcast(&ts.cond);
+    pthread_mutex_unlock(&ts.mutex);
+
+    if (ts.writer_running) {
+        pthread_join(ts.writer, NULL);
+        ts.writer_running = false;
+    }
+    if (ts.fd >= 0) {
+        close(ts.fd);
+        ts.fd = -1;
+    }
+}
+
+void radio_timeshift_cleanup(void) {
+    radio_timeshift_close();
+    free(ts.ram);
+    ts.ram = NULL;
+    ts.write_buf = NULL;
+    unlink(TIMESHIFT_FILE);
+}
+
+bool radio_timeshift_active(void) {
+    return ts.active;
+}
+
+void radio_timeshift_write(const uint8_t* data, int len) {
+    pthread_mutex_lock(&ts.mutex);
+    if (!ts.active) {
+        pthread_mutex_unlock(&ts.mutex);
+        return;
+    }
+
+    index_frames(data, len);
+
+    while (len > 0) {
+        uint64_t k = ts.write_pos / TIMESHIFT_CHUNK;
+
+        // SD card fell a whole RAM queue behind - drop the oldest queued chunk
+        // from the recording rather than stall the stream; everything up to
+        // it can no longer be rewound to
+        if (k >= ts.flushed_chunks + TIMESHIFT_RAM_CHUNKS) {
+            if (ts.lost_pos == 0) {
+                LOG_error("[Timeshift] SD card too slow, dropping chunk %llu from the recording\n",
+                          (unsigned long long)ts.flushed_chunks);
+            }
+            ts.flushed_chunks++;
+            ts.lost_pos = ts.flushed_chunks * TIMESHIFT_CHUNK;
+        }
+
+        int offset = ts.write_pos % TIMESHIFT_CHUNK;
+        int n = TIMESHIFT_CHUNK - offset;
+        if (n > len) n = len;
+        memcpy(ts.ram + (k % TIMESHIFT_RAM_CHUNKS) * TIMESHIFT_CHUNK + offset, data, n);
+        ts.write_pos += n;
+        data += n;
+        len -= n;
+
+        if (ts.write_pos % TIMESHIFT_CHUNK == 0) {
+            pthread_cond_broadcast(&ts.cond);
+        }
+    }
+
+    pthread_mutex_unlock(&ts.mutex);
+}
+
+int radio_timeshift_read(uint8_t* buf, int len) {
+    pthread_mutex_lock(&ts.mutex);
+    if (!ts.active) {
+        pthread_mutex_unlock(&ts.mutex);
+        return 0;
+    }
+
+    // Paused past the end of the window - carry on from the oldest frame kept
+    if (ts.read_pos < oldest_pos()) {
+        ts.read_pos = frame_at_or_after(oldest_pos());
+    }
+
+    int total = 0;
+    while (total < len && ts.read_pos < ts.write_pos) {
+        uint64_t k = ts.read_pos / TIMESHIFT_CHUNK;
+        int offset = ts.read_pos % TIMESHIFT_CHUNK;
+        int n = TIMESHIFT_CHUNK - offset;
+        if (n > len - total) n = len - total;
+        if ((uint64_t)n > ts.write_pos - ts.read_pos) n = (int)(ts.write_pos - ts.read_pos);
+
+        if (k >= ts.flushed_chunks) {
+            memcpy(buf + total, ts.ram + (k % TIMESHIFT_RAM_CHUNKS) * TIMESHIFT_CHUNK + offset, n);
+        } else if (k == ts.writing_chunk) {
+            memcpy(buf + total, ts.write_buf + offset, n);
+        } else {
+            // Read from the file without holding up the network side
+            uint64_t pos = ts.read_pos;
+            pthread_mutex_unlock(&ts.mutex);
+            ssize_t got = pread(ts.fd, buf + total, n,
+                                (off_t)(k % TIMESHIFT_FILE_CHUNKS) * TIMESHIFT_CHUNK + offset);
+            pthread_mutex_lock(&ts.mutex);
+
+            // The writer may have lapped us while we were reading
+            if (got != n || pos < oldest_pos() || ts.read_pos != pos) break;
+        }
+
+        ts.read_pos += n;
+        total += n;
+    }
+
+    pthread_mutex_unlock(&ts.mutex);
+    return total;
+}
+
+void radio_timeshift_seek(int delta_ms, int buffered_ms) {
+    pthread_mutex_lock(&ts.mutex);
+    if (!ts.active || ts.index_count == 0) {
+        pthread_mutex_unlock(&ts.mutex);
+        return;
+    }
+
+    int64_t heard_us = (int64_t)time_at_pos(ts.read_pos) - (int64_t)buffered_ms * 1000;
+    int64_t target_us = heard_us + (int64_t)delta_ms * 1000;
+
+    if (target_us >= (int64_t)ts.time_us - TIMESHIFT_LIVE_EDGE_US) {
+        ts.read_pos = ts.live_frame_pos;
+    } else {
+        // Not earlier than the oldest frame still on disk
+        uint64_t oldest = frame_at_or_after(oldest_pos());
+        int i = index_find_time(target_us > 0 ? (uint64_t)target_us : 0);
+        uint64_t pos = (i >= 0) ? index_at(i)->pos : oldest;
+        ts.read_pos = (pos < oldest) ? oldest : pos;
+    }
+
+    pthread_mutex_unlock(&ts.mutex);
+}
+
+void radio_timeshift_go_live(void) {
+    pthread_mutex_lock(&ts.mutex);
+    ts.read_pos = ts.live_frame_pos;
+    pthread_mutex_unlock(&ts.mutex);
+}
+
+int radio_timeshift_behind_ms(void) {
+    pthread_mutex_lock(&ts.mutex);
+    int behind = 0;
+    if (ts.active && ts.read_pos < ts.live_frame_pos) {
+        behind = (int)((ts.time_us - time_at_pos(ts.read_pos)) / 1000);
+    }
+    pthread_mutex_unlock(&ts.mutex);
+    return behind;
+}
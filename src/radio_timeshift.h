@@ -0,0 +1,48 @@
+#ifndef __RADIO_TIMESHIFT_H__
+#define __RADIO_TIMESHIFT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Time-shift buffer for direct radio streams: compressed audio as received is
+// kept in a bounded ring file on the SD card so live radio can be paused,
+// rewound and caught up again.
+
+// Frame syntax of the stored stream (for the seek index)
+typedef enum {
+    TIMESHIFT_CODEC_MP3 = 0,
+    TIMESHIFT_CODEC_ADTS
+} TimeshiftCodec;
+
+// Start recording a new stream. Returns 0 on success, -1 if the ring file
+// can't be used (playback then bypasses the time-shift buffer).
+int radio_timeshift_open(TimeshiftCodec codec);
+
+// Stop recording and flush pending writes (keeps the ring file for reuse)
+void radio_timeshift_close(void);
+
+// Delete the ring file
+void radio_timeshift_cleanup(void);
+
+// Is a stream being recorded?
+bool radio_timeshift_active(void);
+
+// Append received stream bytes (ICY metadata already stripped)
+void radio_timeshift_write(const uint8_t* data, int len);
+
+// Read up to len bytes at the play position and advance it.
+// Returns bytes read (0 = caught up with live)
+int radio_timeshift_read(uint8_t* buf, int len);
+
+// Move the play position by delta_ms relative to what is being heard
+// (buffered_ms = decoded audio not yet played). Lands on a frame boundary,
+// clamped to the recorded window.
+void radio_timeshift_seek(int delta_ms, int buffered_ms);
+
+// Move the play position to the newest frame
+void radio_timeshift_go_live(void);
+
+// How far the play position is behind live, in ms of audio
+int radio_timeshift_behind_ms(void);
+
+#endif
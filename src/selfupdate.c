@@ -11,6 +11,7 @@
 #include <zip.h>
 
 #include "include/parson/parson.h"
+#include "http_download.h"
 
 // Paths
 static char pak_path[512] = "";
@@ -24,6 +25,15 @@ static pthread_t update_thread;
 static volatile bool update_running = false;
 static volatile bool update_cancel = false;
 
+// Update ZIP download, run beside the progress loop
+typedef struct {
+    const char* url;
+    const char* path;
+    HttpDownloadProgress progress;
+    volatile bool done;
+    int result;
+} UpdateDownload;
+
 // Forward declarations
 static void* check_thread_func(void* arg);
 static void* update_thread_func(void* arg);
@@ -434,6 +444,14 @@ static void* check_thread_func(void* arg) {
 }
 
 // Update thread - downloads and applies update
+static void* download_thread_func(void* arg) {
+    UpdateDownload* download = (UpdateDownload*)arg;
+    download->result = http_download_file(download->url, download->path,
+                                          &download->progress, &update_cancel);
+    download->done = true;
+    return NULL;
+}
+
 static void* update_thread_func(void* arg) {
     (void)arg;
 
@@ -461,69 +479,45 @@ static void* update_thread_func(void* arg) {
         return NULL;
     }
 
-    // Get file size using wget --spider (follows redirects to get actual CDN size)
-    char size_cmd[1024];
-    snprintf(size_cmd, sizeof(size_cmd),
-        "%s --spider -S -T 10 -t 1 -U \"NextUI-Music-Player\" \"%s\" 2>&1 | grep -i 'Content-Length' | tail -1 | awk '{print $2}'",
-        wget_path, update_status.download_url);
+    // Download in-process (ranged connections, resumable) on a helper thread
+    // while this one reports progress
+    UpdateDownload download;
+    memset(&download, 0, sizeof(download));
+    download.url = update_status.download_url;
+    download.path = zip_file;
 
-    long total_size = 0;
-    FILE* size_pipe = popen(size_cmd, "r");
-    if (size_pipe) {
-        char size_buf[32];
-        if (fgets(size_buf, sizeof(size_buf), size_pipe)) {
-            total_size = atol(size_buf);
-        }
-        pclose(size_pipe);
-    }
-
-    // Fallback to ~5MB if size detection fails
-    if (total_size <= 0) {
-        total_size = 5 * 1024 * 1024;
+    pthread_t download_thread;
+    if (pthread_create(&download_thread, NULL, download_thread_func, &download) != 0) {
+        strcpy(update_status.error_message, "Download failed");
+        snprintf(cmd, sizeof(cmd), "rm -rf \"%s\"", temp_dir);
+        system(cmd);
+        update_status.state = SELFUPDATE_STATE_ERROR;
+        update_running = false;
+        return NULL;
     }
-    update_status.download_total = total_size;
-
-    // Start wget in background with a completion marker
-    char done_marker[600];
-    snprintf(done_marker, sizeof(done_marker), "%s/download.done", temp_dir);
 
-    snprintf(cmd, sizeof(cmd),
-        "(%s -q -U \"NextUI-Music-Player\" -O \"%s\" \"%s\" 2>/dev/null; touch \"%s\") &",
-        wget_path, zip_file, update_status.download_url, done_marker);
-    system(cmd);
+    // Monitor download progress
+    while (!download.done) {
+        update_status.download_bytes = (long)download.progress.bytes;
+        update_status.download_total = (long)download.progress.total;
 
-    // Monitor download progress by checking file size
-    while (!update_cancel) {
-        // Check if download is complete
-        if (access(done_marker, F_OK) == 0) {
-            break;
-        }
+        // Download is 0-40% of total update
+        update_status.progress_percent = (download.progress.percent * 40) / 100;
 
-        // Get current file size
-        struct stat st;
-        if (stat(zip_file, &st) == 0) {
-            update_status.download_bytes = st.st_size;
-
-            // Calculate progress (download is 0-40% of total update)
-            if (update_status.download_total > 0) {
-                int dl_pct = (int)((update_status.download_bytes * 100) / update_status.download_total);
-                if (dl_pct > 100) dl_pct = 100;
-                update_status.progress_percent = (dl_pct * 40) / 100;  // Scale to 0-40%
-            }
-
-            // Format status detail
+        if (update_status.download_total > 0) {
             double dl_mb = update_status.download_bytes / (1024.0 * 1024.0);
             double total_mb = update_status.download_total / (1024.0 * 1024.0);
             snprintf(update_status.status_detail, sizeof(update_status.status_detail),
                 "%.1f MB / %.1f MB", dl_mb, total_mb);
+        } else if (update_status.download_bytes > 0) {
+            snprintf(update_status.status_detail, sizeof(update_status.status_detail),
+                "%.1f MB", update_status.download_bytes / (1024.0 * 1024.0));
         }
-
         usleep(200000);  // 200ms polling interval
     }
+    pthread_join(download_thread, NULL);
 
     if (update_cancel) {
-        // Kill any running wget process
-        system("pkill -f 'wget.*NextUI-Music-Player' 2>/dev/null");
         snprintf(cmd, sizeof(cmd), "rm -rf \"%s\"", temp_dir);
         system(cmd);
         update_status.state = SELFUPDATE_STATE_IDLE;
@@ -532,7 +526,7 @@ static void* update_thread_func(void* arg) {
     }
 
     // Verify download completed successfully
-    if (access(zip_file, F_OK) != 0) {
+    if (download.result <= 0 || access(zip_file, F_OK) != 0) {
         strcpy(update_status.error_message, "Download failed");
         snprintf(cmd, sizeof(cmd), "rm -rf \"%s\"", temp_dir);
         system(cmd);
@@ -24,6 +24,16 @@ static const float soft_limiter_thresholds[] = {0.0f, 0.7f, 0.6f, 0.5f};
 #define SOFT_LIMITER_VALUE_COUNT 4
 #define DEFAULT_SOFT_LIMITER_INDEX 2  // Medium (0.6)
 
+// Podcast auto-download (newest episodes per show, 0 = off)
+static const int podcast_auto_values[] = {0, 1, 2, 3, 5};
+#define PODCAST_AUTO_VALUE_COUNT 5
+#define DEFAULT_PODCAST_AUTO_INDEX 0  // Off
+
+// Podcast storage limit in GB
+static const int podcast_storage_values[] = {1, 2, 4, 8, 16};
+#define PODCAST_STORAGE_VALUE_COUNT 5
+#define DEFAULT_PODCAST_STORAGE_INDEX 2  // 4 GB
+
 // Current settings
 static struct {
     int screen_off_timeout;  // seconds, 0 = off
@@ -31,6 +41,8 @@ static struct {
     int bass_filter_hz;      // 0=off, 80, 100, 120, 150, 200
     int soft_limiter_index;  // 0=off, 1=mild, 2=medium, 3=strong
     bool scrobbling_enabled; // true = log plays to .scrobbler.log
+    int podcast_auto_download;  // episodes per show, 0 = off
+    int podcast_storage_gb;     // limit for downloaded episodes
 } current_settings;
 
 // Find index of current screen off value in the values array
@@ -53,6 +65,14 @@ static int get_bass_filter_index(void) {
     return DEFAULT_BASS_FILTER_INDEX;
 }
 
+// Find index of a value in a settings table (default_index if not found)
+static int find_value_index(const int* values, int count, int value, int default_index) {
+    for (int i = 0; i < count; i++) {
+        if (values[i] == value) return i;
+    }
+    return default_index;
+}
+
 void Settings_init(void) {
     // Set defaults
     current_settings.screen_off_timeout = screen_off_values[DEFAULT_SCREEN_OFF_INDEX];
@@ -60,6 +80,8 @@ void Settings_init(void) {
     current_settings.bass_filter_hz = bass_filter_values[DEFAULT_BASS_FILTER_INDEX];
     current_settings.soft_limiter_index = DEFAULT_SOFT_LIMITER_INDEX;
     current_settings.scrobbling_enabled = true;  // Scrobbling on by default
+    current_settings.podcast_auto_download = podcast_auto_values[DEFAULT_PODCAST_AUTO_INDEX];
+    current_settings.podcast_storage_gb = podcast_storage_values[DEFAULT_PODCAST_STORAGE_INDEX];
 
     // Try to load from file
     FILE* f = fopen(SETTINGS_FILE, "r");
@@ -96,6 +118,14 @@ void Settings_init(void) {
         if (sscanf(line, "scrobbling_enabled=%d", &value) == 1) {
             current_settings.scrobbling_enabled = (value != 0);
         }
+        if (sscanf(line, "podcast_auto_download=%d", &value) == 1) {
+            int i = find_value_index(podcast_auto_values, PODCAST_AUTO_VALUE_COUNT, value, -1);
+            if (i >= 0) current_settings.podcast_auto_download = value;
+        }
+        if (sscanf(line, "podcast_storage_gb=%d", &value) == 1) {
+            int i = find_value_index(podcast_storage_values, PODCAST_STORAGE_VALUE_COUNT, value, -1);
+            if (i >= 0) current_settings.podcast_storage_gb = value;
+        }
     }
     fclose(f);
 }
@@ -158,6 +188,8 @@ void Settings_save(void) {
     fprintf(f, "bass_filter_hz=%d\n", current_settings.bass_filter_hz);
     fprintf(f, "soft_limiter=%d\n", current_settings.soft_limiter_index);
     fprintf(f, "scrobbling_enabled=%d\n", current_settings.scrobbling_enabled ? 1 : 0);
+    fprintf(f, "podcast_auto_download=%d\n", current_settings.podcast_auto_download);
+    fprintf(f, "podcast_storage_gb=%d\n", current_settings.podcast_storage_gb);
     fclose(f);
 }
 
@@ -247,3 +279,58 @@ void Settings_toggleScrobbling(void) {
     current_settings.scrobbling_enabled = !current_settings.scrobbling_enabled;
     Settings_save();
 }
+
+// Podcast auto-download getters/cyclers
+int Settings_getPodcastAutoDownload(void) {
+    return current_settings.podcast_auto_download;
+}
+
+void Settings_cyclePodcastAutoDownloadNext(void) {
+    int index = find_value_index(podcast_auto_values, PODCAST_AUTO_VALUE_COUNT,
+                                 current_settings.podcast_auto_download, DEFAULT_PODCAST_AUTO_INDEX);
+    index = (index + 1) % PODCAST_AUTO_VALUE_COUNT;
+    current_settings.podcast_auto_download = podcast_auto_values[index];
+    Settings_save();
+}
+
+void Settings_cyclePodcastAutoDownloadPrev(void) {
+    int index = find_value_index(podcast_auto_values, PODCAST_AUTO_VALUE_COUNT,
+                                 current_settings.podcast_auto_download, DEFAULT_PODCAST_AUTO_INDEX);
+    index = (index - 1 + PODCAST_AUTO_VALUE_COUNT) % PODCAST_AUTO_VALUE_COUNT;
+    current_settings.podcast_auto_download = podcast_auto_values[index];
+    Settings_save();
+}
+
+const char* Settings_getPodcastAutoDownloadDisplayStr(void) {
+    static char buf[16];
+    if (current_settings.podcast_auto_download == 0) return "Off";
+    snprintf(buf, sizeof(buf), "%d per show", current_settings.podcast_auto_download);
+    return buf;
+}
+
+// Podcast storage limit getters/cyclers
+int Settings_getPodcastStorageGB(void) {
+    return current_settings.podcast_storage_gb;
+}
+
+void Settings_cyclePodcastStorageNext(void) {
+    int index = find_value_index(podcast_storage_values, PODCAST_STORAGE_VALUE_COUNT,
+                                 current_settings.podcast_storage_gb, DEFAULT_PODCAST_STORAGE_INDEX);
+    index = (index + 1) % PODCAST_STORAGE_VALUE_COUNT;
+    current_settings.podcast_storage_gb = podcast_storage_values[index];
+    Settings_save();
+}
+
+void Settings_cyclePodcastStoragePrev(void) {
+    int index = find_value_index(podcast_storage_values, PODCAST_STORAGE_VALUE_COUNT,
+                                 current_settings.podcast_storage_gb, DEFAULT_PODCAST_STORAGE_INDEX);
+    index = (index - 1 + PODCAST_STORAGE_VALUE_COUNT) % PODCAST_STORAGE_VALUE_COUNT;
+    current_settings.podcast_storage_gb = podcast_storage_values[index];
+    Settings_save();
+}
+
+const char* Settings_getPodcastStorageDisplayStr(void) {
+    static char buf[16];
+    snprintf(buf, sizeof(buf), "%d GB", current_settings.podcast_storage_gb);
+    return buf;
+}
@@ -51,4 +51,18 @@ bool Settings_getScrobblingEnabled(void);
 void Settings_setScrobblingEnabled(bool enabled);
 void Settings_toggleScrobbling(void);
 
+// Podcast auto-download: newest episodes fetched per show (0 = off)
+// Values: 0, 1, 2, 3, 5
+int Settings_getPodcastAutoDownload(void);
+void Settings_cyclePodcastAutoDownloadNext(void);
+void Settings_cyclePodcastAutoDownloadPrev(void);
+const char* Settings_getPodcastAutoDownloadDisplayStr(void);  // "Off", "2 per show"
+
+// Podcast storage limit for downloaded episodes, in GB
+// Values: 1, 2, 4, 8, 16
+int Settings_getPodcastStorageGB(void);
+void Settings_cyclePodcastStorageNext(void);
+void Settings_cyclePodcastStoragePrev(void);
+const char* Settings_getPodcastStorageDisplayStr(void);  // "4 GB"
+
 #endif
@@ -0,0 +1,415 @@
+#include "time_stretch.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "defines.h"
+#include "api.h"
+
+#if defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#define TIME_STRETCH_NEON 1
+#endif
+
+#define TS_CHANNELS 2
+
+#define TS_WINDOW_MS 20      // Analysis/synthesis window
+#define TS_TOLERANCE_MS 5    // How far a segment may move to line up
+#define TS_BLOCK_MS 10       // Silence detection block
+
+struct TimeStretch {
+    int window;              // Frames per segment (multiple of 16)
+    int hop;                 // Output frames per hop (window / 2)
+    int tolerance;           // Search range either side of the nominal position (even)
+    float speed;
+    bool skip_silence;
+
+    int16_t* window_q15;     // Hann window, one value per sample (both channels)
+    int16_t* tail;           // Windowed second half of the last segment
+
+    // Input not used up yet; in[0] is absolute frame in_start
+    int16_t* in;
+    size_t in_len;
+    size_t in_cap;
+    int64_t in_start;
+
+    double ana_pos;          // Nominal input position of the next segment
+    int64_t prev_pos;        // Input position of the last segment used
+    bool started;
+
+    // Mono downmixes for the similarity search
+    int16_t* tmpl_dec;       // Natural continuation, 2x decimated [window / 2]
+    int16_t* cand_dec;       // Search region, 2x decimated [window / 2 + tolerance]
+    int16_t* tmpl_full;      // [window]
+    int16_t* cand_full;      // [window + 2]
+
+    // Silence gate: input passes through in whole blocks
+    int block;
+    int16_t* gate;
+    int gate_fill;
+    int64_t silent_frames;   // Length of the current pause so far
+    int keep_frames;
+};
+
+// ============ VECTOR KERNELS ============
+
+// Dot product of two int16 vectors. Inputs are kept within +-2048 so the
+// 32-bit lanes can't overflow for n up to 2048
+static int64_t dot_s16(const int16_t* a, const int16_t* b, int n) {
+    int64_t sum = 0;
+    int i = 0;
+#ifdef TIME_STRETCH_NEON
+    int32x4_t acc = vdupq_n_s32(0);
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t va = vld1q_s16(a + i);
+        int16x8_t vb = vld1q_s16(b + i);
+        acc = vmlal_s16(acc, vget_low_s16(va), vget_low_s16(vb));
+        acc = vmlal_s16(acc, vget_high_s16(va), vget_high_s16(vb));
+    }
+    int64x2_t acc64 = vpaddlq_s32(acc);
+    sum = vgetq_lane_s64(acc64, 0) + vgetq_lane_s64(acc64, 1);
+#endif
+    for (; i < n; i++) {
+        sum += (int32_t)a[i] * b[i];
+    }
+    return sum;
+}
+
+// Sum of squares of full-scale samples
+static int64_t energy_s16(const int16_t* a, int n) {
+    int64_t sum = 0;
+    int i = 0;
+#ifdef TIME_STRETCH_NEON
+    int64x2_t acc = vdupq_n_s64(0);
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t va = vld1q_s16(a + i);
+        acc = vpadalq_s32(acc, vmull_s16(vget_low_s16(va), vget_low_s16(va)));
+        acc = vpadalq_s32(acc, vmull_s16(vget_high_s16(va), vget_high_s16(va)));
+    }
+    sum = vgetq_lane_s64(acc, 0) + vgetq_lane_s64(acc, 1);
+#endif
+    for (; i < n; i++) {
+        sum += (int32_t)a[i] * a[i];
+    }
+    return sum;
+}
+
+// out = tail + seg * w (first half), tail = seg * w (second half); Q15 window
+static void overlap_add(int16_t* out, int16_t* tail, const int16_t* seg,
+                        const int16_t* w, int half_samples) {
+    int i = 0;
+#ifdef TIME_STRETCH_NEON
+    for (; i + 8 <= half_samples; i += 8) {
+        int16x8_t head = vqrdmulhq_s16(vld1q_s16(seg + i), vld1q_s16(w + i));
+        vst1q_s16(out + i, vqaddq_s16(vld1q_s16(tail + i), head));
+        vst1q_s16(tail + i, vqrdmulhq_s16(vld1q_s16(seg + half_samples + i),
+                                          vld1q_s16(w + half_samples + i)));
+    }
+#endif
+    for (; i < half_samples; i++) {
+        int32_t v = tail[i] + (((int32_t)seg[i] * w[i] + (1 << 14)) >> 15);
+        out[i] = (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+        tail[i] = (int16_t)(((int32_t)seg[half_samples + i] * w[half_samples + i] + (1 << 14)) >> 15);
+    }
+}
+
+// tail = seg * w (second half) over the first half of seg: the overlap-add
+// that follows then gives seg back unchanged instead of fading in from zero
+static void prime_tail(int16_t* tail, const int16_t* seg, const int16_t* w, int half_samples) {
+    for (int i = 0; i < half_samples; i++) {
+        tail[i] = (int16_t)(((int32_t)seg[i] * w[half_samples + i] + (1 << 14)) >> 15);
+    }
+}
+
+// Mono at half rate, scaled to +-2048 for dot_s16
+static void downmix_decimated(const int16_t* in, int16_t* out, int n) {
+    for (int i = 0; i < n; i++) {
+        const int16_t* f = in + i * 2 * TS_CHANNELS;
+        out[i] = (int16_t)(((int32_t)f[0] + f[1] + f[2] + f[3]) >> 6);
+    }
+}
+
+// Mono at full rate, scaled to +-2048 for dot_s16
+static void downmix_full(const int16_t* in, int16_t* out, int n) {
+    for (int i = 0; i < n; i++) {
+        out[i] = (int16_t)(((int32_t)in[i * TS_CHANNELS] + in[i * TS_CHANNELS + 1]) >> 5);
+    }
+}
+
+// Normalized similarity, compared without a square root (sign kept)
+static double similarity(int64_t corr, int64_t energy) {
+    double c = (double)corr;
+    return (c < 0 ? -c * c : c * c) / ((double)energy + 1.0);
+}
+
+// ============ WSOLA ============
+
+static const int16_t* frame_at(TimeStretch* ts, int64_t pos) {
+    return ts->in + (pos - ts->in_start) * TS_CHANNELS;
+}
+
+// Whether enough input has arrived for the next hop
+static bool hop_ready(TimeStretch* ts) {
+    int64_t need = (int64_t)ts->ana_pos + ts->tolerance + 1 + ts->window;
+    if (ts->started) {
+        int64_t continuation_end = ts->prev_pos + ts->hop + ts->window;
+        if (continuation_end > need) need = continuation_end;
+    }
+    return need <= ts->in_start + (int64_t)ts->in_len;
+}
+
+// Input position near the nominal one whose segment best continues the last
+static int64_t find_segment(TimeStretch* ts) {
+    int64_t nominal = (int64_t)ts->ana_pos;
+    if (!ts->started) return nominal;
+
+    int64_t continuation = ts->prev_pos + ts->hop;
+    int64_t region = nominal - ts->tolerance;
+    if (region < ts->in_start + 1) region = ts->in_start + 1;  // room for refinement
+    int candidates = (int)((nominal + ts->tolerance - region) / 2);
+    if (candidates < 0) return continuation;
+
+    // Coarse search every 2 frames on the decimated downmix
+    int half = ts->window / 2;
+    downmix_decimated(frame_at(ts, continuation), ts->tmpl_dec, half);
+    downmix_decimated(frame_at(ts, region), ts->cand_dec, half + candidates);
+
+    // Ties (e.g. silence) go to the candidate nearest the nominal position
+    int64_t energy = dot_s16(ts->cand_dec, ts->cand_dec, half);
+    int best = 0;
+    int64_t best_dist = INT64_MAX;
+    double best_score = -1e300;
+    for (int m = 0; m <= candidates; m++) {
+        double score = similarity(dot_s16(ts->tmpl_dec, ts->cand_dec + m, half), energy);
+        int64_t dist = llabs(region + 2 * m - nominal);
+        if (score > best_score || (score == best_score && dist < best_dist)) {
+            best_score = score;
+            best_dist = dist;
+            best = m;
+        }
+        if (m < candidates) {
+            int32_t out_s = ts->cand_dec[m];
+            int32_t in_s = ts->cand_dec[m + half];
+            energy += in_s * in_s - out_s * out_s;
+        }
+    }
+
+    // Refine to the exact frame
+    int64_t coarse = region + 2 * best;
+    downmix_full(frame_at(ts, continuation), ts->tmpl_full, ts->window);
+    downmix_full(frame_at(ts, coarse - 1), ts->cand_full, ts->window + 2);
+    int fine = 1;
+    best_score = similarity(dot_s16(ts->tmpl_full, ts->cand_full + 1, ts->window),
+                            dot_s16(ts->cand_full + 1, ts->cand_full + 1, ts->window));
+    for (int k = 0; k < 3; k += 2) {
+        const int16_t* cand = ts->cand_full + k;
+        double score = similarity(dot_s16(ts->tmpl_full, cand, ts->window),
+                                  dot_s16(cand, cand, ts->window));
+        if (score > best_score) {
+            best_score = score;
+            fine = k;
+        }
+    }
+    return coarse - 1 + fine;
+}
+
+// Drop input no later hop can reach
+static void compact_input(TimeStretch* ts) {
+    int64_t keep = (int64_t)ts->ana_pos - ts->tolerance - 1;
+    if (ts->started && ts->prev_pos + ts->hop < keep) keep = ts->prev_pos + ts->hop;
+    if (keep <= ts->in_start) return;
+
+    size_t drop = (size_t)(keep - ts->in_start);
+    if (drop > ts->in_len) drop = ts->in_len;
+    memmove(ts->in, ts->in + drop * TS_CHANNELS, (ts->in_len - drop) * TS_CHANNELS * sizeof(int16_t));
+    ts->in_len -= drop;
+    ts->in_start += drop;
+}
+
+static int append_input(TimeStretch* ts, const int16_t* frames, size_t count) {
+    if (ts->in_len + count > ts->in_cap) {
+        size_t cap = ts->in_cap * 2;
+        if (cap < ts->in_len + count) cap = ts->in_len + count;
+        int16_t* grown = realloc(ts->in, cap * TS_CHANNELS * sizeof(int16_t));
+        if (!grown) {
+            LOG_error("[TimeStretch] Failed to grow input buffer\n");
+            return -1;
+        }
+        ts->in = grown;
+        ts->in_cap = cap;
+    }
+    memcpy(ts->in + ts->in_len * TS_CHANNELS, frames, count * TS_CHANNELS * sizeof(int16_t));
+    ts->in_len += count;
+    return 0;
+}
+
+// ============ SILENCE GATE ============
+
+static void gate_block(TimeStretch* ts) {
+    int samples = ts->block * TS_CHANNELS;
+    int64_t threshold = (int64_t)TIME_STRETCH_SILENCE_RMS * TIME_STRETCH_SILENCE_RMS * samples;
+
+    if (energy_s16(ts->gate, samples) < threshold) {
+        ts->silent_frames += ts->block;
+        if (ts->silent_frames > ts->keep_frames) {
+            ts->gate_fill = 0;
+            return;
+        }
+    } else {
+        ts->silent_frames = 0;
+    }
+    append_input(ts, ts->gate, ts->block);
+    ts->gate_fill = 0;
+}
+
+static void gate_input(TimeStretch* ts, const int16_t* frames, size_t count) {
+    if (!ts->skip_silence) {
+        // Pass on a block left over from when skipping was on
+        if (ts->gate_fill > 0) {
+            append_input(ts, ts->gate, ts->gate_fill);
+            ts->gate_fill = 0;
+        }
+        ts->silent_frames = 0;
+        if (count > 0) append_input(ts, frames, count);
+        return;
+    }
+
+    while (count > 0) {
+        size_t take = (size_t)(ts->block - ts->gate_fill);
+        if (take > count) take = count;
+        memcpy(ts->gate + ts->gate_fill * TS_CHANNELS, frames, take * TS_CHANNELS * sizeof(int16_t));
+        ts->gate_fill += (int)take;
+        frames += take * TS_CHANNELS;
+        count -= take;
+        if (ts->gate_fill == ts->block) gate_block(ts);
+    }
+}
+
+// ============ PUBLIC API ============
+
+TimeStretch* time_stretch_create(int sample_rate) {
+    if (sample_rate <= 0) return NULL;
+
+    TimeStretch* ts = (TimeStretch*)calloc(1, sizeof(TimeStretch));
+    if (!ts) return NULL;
+
+    ts->window = (sample_rate * TS_WINDOW_MS / 1000) & ~15;
+    ts->hop = ts->window / 2;
+    ts->tolerance = (sample_rate * TS_TOLERANCE_MS / 1000) & ~1;
+    ts->speed = 1.0f;
+    ts->block = sample_rate * TS_BLOCK_MS / 1000;
+    ts->keep_frames = sample_rate * TIME_STRETCH_SILENCE_KEEP_MS / 1000;
+    ts->in_cap = (size_t)ts->window * 4;
+
+    ts->window_q15 = malloc(ts->window * TS_CHANNELS * sizeof(int16_t));
+    ts->tail = calloc(ts->hop * TS_CHANNELS, sizeof(int16_t));
+    ts->in = malloc(ts->in_cap * TS_CHANNELS * sizeof(int16_t));
+    ts->tmpl_dec = malloc(ts->window / 2 * sizeof(int16_t));
+    ts->cand_dec = malloc((ts->window / 2 + ts->tolerance) * sizeof(int16_t));
+    ts->tmpl_full = malloc(ts->window * sizeof(int16_t));
+    ts->cand_full = malloc((ts->window + 2) * sizeof(int16_t));
+    ts->gate = malloc(ts->block * TS_CHANNELS * sizeof(int16_t));
+
+    if (!ts->window_q15 || !ts->tail || !ts->in || !ts->tmpl_dec || !ts->cand_dec ||
+        !ts->tmpl_full || !ts->cand_full || !ts->gate) {
+        LOG_error("[TimeStretch] Failed to allocate buffers\n");
+        time_stretch_destroy(ts);
+        return NULL;
+    }
+
+    // Periodic Hann: halves a hop apart sum to 1, so overlap-add keeps the level
+    for (int n = 0; n < ts->window; n++) {
+        float w = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * n / ts->window);
+        int16_t q = (int16_t)lrintf(w * 32767.0f);
+        ts->window_q15[n * TS_CHANNELS] = q;
+        ts->window_q15[n * TS_CHANNELS + 1] = q;
+    }
+
+    return ts;
+}
+
+void time_stretch_destroy(TimeStretch* ts) {
+    if (!ts) return;
+    free(ts->window_q15);
+    free(ts->tail);
+    free(ts->in);
+    free(ts->tmpl_dec);
+    free(ts->cand_dec);
+    free(ts->tmpl_full);
+    free(ts->cand_full);
+    free(ts->gate);
+    free(ts);
+}
+
+void time_stretch_set_speed(TimeStretch* ts, float speed) {
+    if (!ts) return;
+    if (speed < TIME_STRETCH_MIN_SPEED) speed = TIME_STRETCH_MIN_SPEED;
+    if (speed > TIME_STRETCH_MAX_SPEED) speed = TIME_STRETCH_MAX_SPEED;
+    ts->speed = speed;
+}
+
+void time_stretch_set_skip_silence(TimeStretch* ts, bool skip) {
+    if (ts) ts->skip_silence = skip;
+}
+
+void time_stretch_reset(TimeStretch* ts) {
+    if (!ts) return;
+    memset(ts->tail, 0, ts->hop * TS_CHANNELS * sizeof(int16_t));
+    ts->in_len = 0;
+    ts->in_start = 0;
+    ts->ana_pos = 0;
+    ts->prev_pos = 0;
+    ts->started = false;
+    ts->gate_fill = 0;
+    ts->silent_frames = 0;
+}
+
+size_t time_stretch_process(TimeStretch* ts, const int16_t* in, size_t frames,
+                            int16_t* out, size_t max_out) {
+    if (!ts) return 0;
+
+    if (in && frames > 0) gate_input(ts, in, frames);
+
+    size_t produced = 0;
+    while (produced + ts->hop <= max_out && hop_ready(ts)) {
+        int64_t pos = find_segment(ts);
+        if (!ts->started) {
+            prime_tail(ts->tail, frame_at(ts, pos), ts->window_q15, ts->hop * TS_CHANNELS);
+        }
+        overlap_add(out + produced * TS_CHANNELS, ts->tail, frame_at(ts, pos),
+                    ts->window_q15, ts->hop * TS_CHANNELS);
+        produced += ts->hop;
+
+        ts->prev_pos = pos;
+        ts->started = true;
+        ts->ana_pos += ts->hop * ts->speed;
+    }
+
+    compact_input(ts);
+    return produced;
+}
+
+size_t time_stretch_drain(TimeStretch* ts, int16_t* out, size_t max_out) {
+    if (!ts) return 0;
+
+    // The pending tail plus the rising half of the natural continuation is
+    // the continuation itself, so the input from there plays on unchanged
+    int64_t from = ts->started ? ts->prev_pos + ts->hop : (int64_t)ts->ana_pos;
+    int64_t end = ts->in_start + (int64_t)ts->in_len;
+    if (from < ts->in_start) from = ts->in_start;
+
+    size_t n = 0;
+    if (from < end) {
+        n = (size_t)(end - from);
+        if (n > max_out) n = max_out;
+        memcpy(out, frame_at(ts, from), n * TS_CHANNELS * sizeof(int16_t));
+    }
+    size_t gated = (size_t)ts->gate_fill;
+    if (gated > max_out - n) gated = max_out - n;
+    memcpy(out + n * TS_CHANNELS, ts->gate, gated * TS_CHANNELS * sizeof(int16_t));
+    n += gated;
+
+    time_stretch_reset(ts);
+    return n;
+}
@@ -169,6 +169,9 @@ static const ControlHelp radio_list_controls[] = {
 static const ControlHelp radio_playing_controls[] = {
     {"Up/R1", "Next Station"},
     {"Down/L1", "Prev Station"},
+    {"A", "Pause/Resume"},
+    {"Left/Right", "Rewind/Forward 10s"},
+    {"X", "Jump to Live"},
     {"Select", "Screen Off"},
     {"Select + A", "Wake Screen"},
     {"Start (hold)", "Exit App"},
@@ -204,6 +207,7 @@ static const ControlHelp podcast_menu_controls[] = {
 // Podcast manage menu controls
 static const ControlHelp podcast_manage_controls[] = {
     {"Up/Down", "Navigate"},
+    {"Left/Right", "Change Setting"},
     {"Start (hold)", "Exit App"},
     {NULL, NULL}
 };
@@ -236,6 +240,7 @@ static const ControlHelp podcast_search_controls[] = {
 // Podcast episodes list controls
 static const ControlHelp podcast_episodes_controls[] = {
     {"Up/Down", "Navigate"},
+    {"Select + A", "Download Episode"},
     {"Y", "Refresh Episodes"},
     {"X", "Mark Played/Unplayed"},
     {"Start (hold)", "Exit App"},
@@ -246,6 +251,8 @@ static const ControlHelp podcast_episodes_controls[] = {
 static const ControlHelp podcast_playing_controls[] = {
     {"Left", "Rewind 10s"},
     {"Right", "Forward 30s"},
+    {"X", "Playback Speed"},
+    {"Y", "Skip Silence On/Off"},
     {"Select", "Screen Off"},
     {"Select + A", "Wake Screen"},
     {"Start (hold)", "Exit App"},
@@ -1,10 +1,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <sys/stat.h>
 
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
 
 #include "defines.h"
 #include "api.h"
@@ -15,21 +13,18 @@
 #include "ui_utils.h"
 #include "ui_icons.h"
 #include "ui_album_art.h"
-#include "wget_fetch.h"
+#include "ui_thumbnail.h"
+#include "settings.h"
 #include "module_common.h"
 
-// Max artwork size (1MB to match radio album art buffer)
-#define PODCAST_ARTWORK_MAX_SIZE (1024 * 1024)
-
 // Scroll state for selected item title in lists
 static ScrollTextState podcast_title_scroll = {0};
 
 // Scroll state for playing screen episode title
 static ScrollTextState podcast_playing_title_scroll = {0};
 
-// Podcast artwork state
-static SDL_Surface* podcast_artwork = NULL;
-static char podcast_artwork_url[512] = {0};
+// Feed whose artwork the album art background was last built from
+static char playing_art_feed_id[17] = {0};
 
 // Podcast progress GPU state
 static int progress_bar_x = 0, progress_bar_y = 0;
@@ -40,415 +35,48 @@ static int progress_duration_ms = 0;
 static int progress_last_position_sec = -1;
 static bool progress_position_set = false;
 
-// Helper to convert surface to ARGB8888 for proper scaling
-static SDL_Surface* convert_to_argb8888(SDL_Surface* src) {
-    if (!src) return NULL;
-
-    SDL_Surface* converted = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB8888, 0);
-    SDL_FreeSurface(src);
-    return converted;
-}
-
-// Check if downloaded image data is complete (not truncated)
-// JPEG: ends with FF D9, PNG: ends with IEND chunk
-static bool is_image_complete(const uint8_t* data, int size) {
-    if (size < 4) return false;
-    // JPEG: starts with FF D8, ends with FF D9
-    if (data[0] == 0xFF && data[1] == 0xD8) {
-        return (data[size - 2] == 0xFF && data[size - 1] == 0xD9);
-    }
-    // PNG: starts with 89 50 4E 47, ends with IEND chunk (AE 42 60 82)
-    if (data[0] == 0x89 && data[1] == 0x50 && data[2] == 0x4E && data[3] == 0x47) {
-        return (size >= 8 &&
-                data[size - 4] == 0xAE && data[size - 3] == 0x42 &&
-                data[size - 2] == 0x60 && data[size - 1] == 0x82);
-    }
-    // Unknown format — assume complete
-    return true;
-}
-
-// Fetch podcast artwork from URL (cached in podcast folder)
-// feed_id: the podcast's feed_id for storing artwork in its folder
-static void podcast_fetch_artwork(const char* artwork_url, const char* feed_id) {
-    if (!artwork_url || !artwork_url[0] || !feed_id || !feed_id[0]) return;
-
-    // Already have this artwork
-    if (strcmp(podcast_artwork_url, artwork_url) == 0 && podcast_artwork) return;
-
-    // Clear old artwork and invalidate album art background cache
-    if (podcast_artwork) {
-        SDL_FreeSurface(podcast_artwork);
-        podcast_artwork = NULL;
-        cleanup_album_art_background();
-    }
-    strncpy(podcast_artwork_url, artwork_url, sizeof(podcast_artwork_url) - 1);
-
-    // Build cache path: <podcast_data_dir>/<feed_id>/artwork.jpg
-    char feed_dir[512];
-    Podcast_getFeedDataPath(feed_id, feed_dir, sizeof(feed_dir));
-
-    char cache_path[768];
-    snprintf(cache_path, sizeof(cache_path), "%s/artwork.jpg", feed_dir);
-
-    // Try to load from cache first
-    FILE* f = fopen(cache_path, "rb");
-    if (f) {
-        fseek(f, 0, SEEK_END);
-        long size = ftell(f);
-        fseek(f, 0, SEEK_SET);
-
-        if (size > 0 && size < PODCAST_ARTWORK_MAX_SIZE) {
-            uint8_t* data = (uint8_t*)malloc(size);
-            if (data && fread(data, 1, size, f) == (size_t)size) {
-                if (is_image_complete(data, size)) {
-                    SDL_RWops* rw = SDL_RWFromConstMem(data, size);
-                    if (rw) {
-                        SDL_Surface* loaded = IMG_Load_RW(rw, 1);
-                        podcast_artwork = convert_to_argb8888(loaded);
-                    }
-                }
-            }
-            free(data);
-        }
-        fclose(f);
-        if (podcast_artwork) return;
-        // Cached file is corrupt/incomplete — delete it so we re-fetch
-        remove(cache_path);
-    }
-
-    // Fetch from network using static buffer
-    static uint8_t artwork_buffer[PODCAST_ARTWORK_MAX_SIZE];
-    int size = wget_fetch(artwork_url, artwork_buffer, PODCAST_ARTWORK_MAX_SIZE);
-
-    if (size > 0 && is_image_complete(artwork_buffer, size)) {
-        // Save to podcast folder (directory should already exist from subscription)
-        f = fopen(cache_path, "wb");
-        if (f) {
-            fwrite(artwork_buffer, 1, size, f);
-            fclose(f);
-        }
-
-        // Load as SDL surface and convert to ARGB8888 for proper scaling
-        SDL_RWops* rw = SDL_RWFromConstMem(artwork_buffer, size);
-        if (rw) {
-            SDL_Surface* loaded = IMG_Load_RW(rw, 1);
-            podcast_artwork = convert_to_argb8888(loaded);
-        }
-    }
-}
-
 // Clear podcast artwork (call when leaving playing screen)
 void Podcast_clearArtwork(void) {
-    if (podcast_artwork) {
-        SDL_FreeSurface(podcast_artwork);
-        podcast_artwork = NULL;
-    }
-    podcast_artwork_url[0] = '\0';
+    playing_art_feed_id[0] = '\0';
     memset(&podcast_playing_title_scroll, 0, sizeof(podcast_playing_title_scroll));
     PodcastProgress_clear();  // Clear GPU progress layer
 }
 
-// Thumbnail cache for subscription artwork on main page
-#define THUMBNAIL_CACHE_SIZE 8
-typedef struct {
-    char feed_id[17];
-    SDL_Surface* thumbnail;
-} ThumbnailCacheEntry;
-static ThumbnailCacheEntry thumbnail_cache[THUMBNAIL_CACHE_SIZE];
-static int thumbnail_cache_count = 0;
-
-// Scale surface to size x size and apply circular mask
-static SDL_Surface* load_circular_thumbnail_from_surface(SDL_Surface* raw, int size) {
-    if (!raw) return NULL;
-
-    // Convert to ARGB8888 for proper scaling
-    SDL_Surface* converted = SDL_ConvertSurfaceFormat(raw, SDL_PIXELFORMAT_ARGB8888, 0);
-    if (!converted) return NULL;
-
-    // Scale to size x size
-    SDL_Surface* scaled = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_ARGB8888);
-    if (!scaled) { SDL_FreeSurface(converted); return NULL; }
-    SDL_Rect src = {0, 0, converted->w, converted->h};
-    SDL_Rect dst = {0, 0, size, size};
-    SDL_BlitScaled(converted, &src, scaled, &dst);
-    SDL_FreeSurface(converted);
-
-    // Apply circular mask
-    int radius = size / 2;
-    uint32_t* pixels = (uint32_t*)scaled->pixels;
-    int pitch = scaled->pitch / 4;
-    for (int y = 0; y < size; y++) {
-        for (int x = 0; x < size; x++) {
-            int dx = x - radius;
-            int dy = y - radius;
-            if (dx * dx + dy * dy > radius * radius) {
-                pixels[y * pitch + x] = 0;  // Fully transparent
-            }
-        }
-    }
-
-    return scaled;
-}
-
-// Load image file from disk path, scale to size x size, apply circular mask
-static SDL_Surface* load_circular_thumbnail(const char* path, int size) {
-    FILE* f = fopen(path, "rb");
-    if (!f) return NULL;
-
-    fseek(f, 0, SEEK_END);
-    long fsize = ftell(f);
-    fseek(f, 0, SEEK_SET);
-    if (fsize <= 0 || fsize > 1024 * 1024) { fclose(f); return NULL; }
-
-    uint8_t* data = (uint8_t*)malloc(fsize);
-    if (!data) { fclose(f); return NULL; }
-    if ((long)fread(data, 1, fsize, f) != fsize) { free(data); fclose(f); return NULL; }
-    fclose(f);
-
-    SDL_RWops* rw = SDL_RWFromConstMem(data, fsize);
-    SDL_Surface* raw = NULL;
-    if (rw) raw = IMG_Load_RW(rw, 1);
-    free(data);
-    if (!raw) return NULL;
-
-    SDL_Surface* result = load_circular_thumbnail_from_surface(raw, size);
-    SDL_FreeSurface(raw);
-    return result;
-}
-
-// Add thumbnail to in-memory cache (FIFO eviction)
-static void cache_thumbnail(const char* cache_key, SDL_Surface* surface) {
-    if (thumbnail_cache_count >= THUMBNAIL_CACHE_SIZE) {
-        SDL_FreeSurface(thumbnail_cache[0].thumbnail);
-        for (int i = 0; i < THUMBNAIL_CACHE_SIZE - 1; i++) {
-            thumbnail_cache[i] = thumbnail_cache[i + 1];
-        }
-        thumbnail_cache_count = THUMBNAIL_CACHE_SIZE - 1;
-    }
-    ThumbnailCacheEntry* entry = &thumbnail_cache[thumbnail_cache_count];
-    strncpy(entry->feed_id, cache_key, sizeof(entry->feed_id) - 1);
-    entry->feed_id[sizeof(entry->feed_id) - 1] = '\0';
-    entry->thumbnail = surface;
-    thumbnail_cache_count++;
-}
-
-// Look up thumbnail in memory cache
-static SDL_Surface* find_cached_thumbnail(const char* cache_key) {
-    for (int i = 0; i < thumbnail_cache_count; i++) {
-        if (strcmp(thumbnail_cache[i].feed_id, cache_key) == 0 && thumbnail_cache[i].thumbnail) {
-            return thumbnail_cache[i].thumbnail;
-        }
-    }
-    return NULL;
-}
+// Charts/search artwork cache, keyed by itunes_id
+#define PODCAST_CACHE_DIR SDCARD_PATH "/.cache/podcast"
 
-// Lazy load one subscription thumbnail from disk (call once per frame)
-// Returns true if a thumbnail was loaded (caller should redraw)
-static bool subscription_thumb_load_one(const char* feed_id, int size) {
-    if (!feed_id || !feed_id[0] || size <= 0) return false;
-
-    // Already in memory cache
-    if (find_cached_thumbnail(feed_id)) return false;
-
-    // Load from disk: <feed_data_dir>/artwork.jpg
+// Feed artwork saved on subscribe: <feed_data_dir>/artwork.jpg
+static void get_feed_artwork_path(const char* feed_id, char* path, int path_size) {
     char feed_dir[512];
     Podcast_getFeedDataPath(feed_id, feed_dir, sizeof(feed_dir));
-    char art_path[768];
-    snprintf(art_path, sizeof(art_path), "%s/artwork.jpg", feed_dir);
-
-    SDL_Surface* thumb = load_circular_thumbnail(art_path, size);
-    if (thumb) {
-        cache_thumbnail(feed_id, thumb);
-        return true;
-    }
-    return false;
+    snprintf(path, path_size, "%s/artwork.jpg", feed_dir);
 }
 
-// Disk cache path for artwork by itunes_id
-#define PODCAST_CACHE_PARENT SDCARD_PATH "/.cache"
-#define PODCAST_CACHE_DIR    SDCARD_PATH "/.cache/podcast"
-
-static void get_artwork_cache_path(const char* itunes_id, char* path, int path_size) {
+static void get_itunes_artwork_path(const char* itunes_id, char* path, int path_size) {
     snprintf(path, path_size, PODCAST_CACHE_DIR "/%s.jpg", itunes_id);
 }
 
-// Get artwork thumbnail: memory cache -> disk cache -> NULL (non-blocking)
-static SDL_Surface* get_artwork_thumbnail(const char* itunes_id, int size) {
-    if (!itunes_id || !itunes_id[0] || size <= 0) return NULL;
-
-    // Check memory cache
-    SDL_Surface* cached = find_cached_thumbnail(itunes_id);
-    if (cached) return cached;
-
-    // Check disk cache
-    char cache_path[768];
-    get_artwork_cache_path(itunes_id, cache_path, sizeof(cache_path));
-    SDL_Surface* thumb = load_circular_thumbnail(cache_path, size);
-    if (thumb) {
-        cache_thumbnail(itunes_id, thumb);
-        return thumb;
-    }
-
-    return NULL;
-}
-
-// Lazy fetch: download one artwork from network, save to disk, cache in memory
-// Returns true if an image was fetched (caller should break to limit one per frame)
-static bool artwork_fetch_one(const char* itunes_id, const char* artwork_url, int size) {
-    if (!itunes_id || !itunes_id[0] || !artwork_url || !artwork_url[0] || size <= 0) return false;
-
-    // Already in memory
-    if (find_cached_thumbnail(itunes_id)) return false;
-
-    // Already on disk
-    char cache_path[768];
-    get_artwork_cache_path(itunes_id, cache_path, sizeof(cache_path));
-    SDL_Surface* thumb = load_circular_thumbnail(cache_path, size);
-    if (thumb) {
-        cache_thumbnail(itunes_id, thumb);
-        return true;
-    }
-
-    // Fetch from network
-    static uint8_t art_buf[PODCAST_ARTWORK_MAX_SIZE];
-    int dl_size = wget_fetch(artwork_url, art_buf, PODCAST_ARTWORK_MAX_SIZE);
-    if (dl_size <= 0 || !is_image_complete(art_buf, dl_size)) return false;
-
-    // Save to disk cache
-    mkdir(PODCAST_CACHE_PARENT, 0755);
-    mkdir(PODCAST_CACHE_DIR, 0755);
-    FILE* f = fopen(cache_path, "wb");
-    if (f) {
-        fwrite(art_buf, 1, dl_size, f);
-        fclose(f);
-    }
-
-    // Load into surface from memory
-    SDL_RWops* rw = SDL_RWFromConstMem(art_buf, dl_size);
-    if (!rw) return false;
-    SDL_Surface* raw = IMG_Load_RW(rw, 1);
-    if (!raw) return false;
-
-    thumb = load_circular_thumbnail_from_surface(raw, size);
-    SDL_FreeSurface(raw);
-    if (!thumb) return false;
-
-    cache_thumbnail(itunes_id, thumb);
-    return true;
+// Thumbnail size in rich list items (same as image_size in pill_rich)
+static int list_thumb_size(void) {
+    return SCALE1(PILL_SIZE) * 3 / 2 - SCALE1(4) * 2;
 }
 
-void Podcast_clearThumbnailCache(void) {
-    for (int i = 0; i < thumbnail_cache_count; i++) {
-        if (thumbnail_cache[i].thumbnail) {
-            SDL_FreeSurface(thumbnail_cache[i].thumbnail);
-            thumbnail_cache[i].thumbnail = NULL;
-        }
-        thumbnail_cache[i].feed_id[0] = '\0';
-    }
-    thumbnail_cache_count = 0;
-}
-
-bool Podcast_loadPendingThumbnails(void) {
-    int sub_count = Podcast_getSubscriptionCount();
-    if (sub_count == 0) return false;
-
-    PodcastFeed* feeds = Podcast_getSubscriptions(NULL);
-    int thumb_size = SCALE1(PILL_SIZE) * 3 / 2 - SCALE1(4) * 2;
-
-    for (int i = 0; i < sub_count; i++) {
-        if (subscription_thumb_load_one(feeds[i].feed_id, thumb_size)) return true;
-    }
-    return false;
-}
-
-// Episode header artwork (square with rounded corners, cached per feed)
-static SDL_Surface* episode_header_art = NULL;
-static char episode_header_feed_id[17] = {0};
-static int episode_header_art_size = 0;
-
-// Load image file, scale to size x size, apply rounded corner mask
-static SDL_Surface* load_rounded_thumbnail(const char* path, int size, int radius) {
-    FILE* f = fopen(path, "rb");
-    if (!f) return NULL;
-
-    fseek(f, 0, SEEK_END);
-    long fsize = ftell(f);
-    fseek(f, 0, SEEK_SET);
-    if (fsize <= 0 || fsize > 1024 * 1024) { fclose(f); return NULL; }
-
-    uint8_t* data = (uint8_t*)malloc(fsize);
-    if (!data) { fclose(f); return NULL; }
-    if ((long)fread(data, 1, fsize, f) != fsize) { free(data); fclose(f); return NULL; }
-    fclose(f);
-
-    SDL_RWops* rw = SDL_RWFromConstMem(data, fsize);
-    SDL_Surface* raw = NULL;
-    if (rw) raw = IMG_Load_RW(rw, 1);
-    free(data);
-    if (!raw) return NULL;
-
-    SDL_Surface* converted = SDL_ConvertSurfaceFormat(raw, SDL_PIXELFORMAT_ARGB8888, 0);
-    SDL_FreeSurface(raw);
-    if (!converted) return NULL;
-
-    SDL_Surface* scaled = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_ARGB8888);
-    if (!scaled) { SDL_FreeSurface(converted); return NULL; }
-    SDL_Rect src_r = {0, 0, converted->w, converted->h};
-    SDL_Rect dst_r = {0, 0, size, size};
-    SDL_BlitScaled(converted, &src_r, scaled, &dst_r);
-    SDL_FreeSurface(converted);
-
-    if (radius > 0) {
-        uint32_t* pixels = (uint32_t*)scaled->pixels;
-        int pitch_px = scaled->pitch / 4;
-        for (int py = 0; py < size; py++) {
-            for (int px = 0; px < size; px++) {
-                int cx = -1, cy = -1;
-                if (px < radius && py < radius) { cx = radius; cy = radius; }
-                else if (px >= size - radius && py < radius) { cx = size - 1 - radius; cy = radius; }
-                else if (px < radius && py >= size - radius) { cx = radius; cy = size - 1 - radius; }
-                else if (px >= size - radius && py >= size - radius) { cx = size - 1 - radius; cy = size - 1 - radius; }
-                if (cx >= 0 && (px - cx) * (px - cx) + (py - cy) * (py - cy) > radius * radius) {
-                    pixels[py * pitch_px + px] = 0;
-                }
-            }
-        }
-    }
-
-    return scaled;
-}
-
-// Get or load episode header artwork (cached by feed_id and size)
-static SDL_Surface* get_episode_header_art(const char* feed_id, int size) {
-    if (episode_header_art && strcmp(episode_header_feed_id, feed_id) == 0
-        && episode_header_art_size == size)
-        return episode_header_art;
-
-    if (episode_header_art) {
-        SDL_FreeSurface(episode_header_art);
-        episode_header_art = NULL;
-    }
-    episode_header_art_size = 0;
-    episode_header_feed_id[0] = '\0';
-
-    char feed_dir[512];
-    Podcast_getFeedDataPath(feed_id, feed_dir, sizeof(feed_dir));
+// Episode header artwork (square with rounded corners), placeholder while loading
+static SDL_Surface* get_episode_header_art(PodcastFeed* feed, int size) {
     char art_path[768];
-    snprintf(art_path, sizeof(art_path), "%s/artwork.jpg", feed_dir);
-
-    episode_header_art = load_rounded_thumbnail(art_path, size, SCALE1(8));
-    if (episode_header_art) {
-        strncpy(episode_header_feed_id, feed_id, sizeof(episode_header_feed_id) - 1);
-        episode_header_feed_id[sizeof(episode_header_feed_id) - 1] = '\0';
-        episode_header_art_size = size;
-    }
-    return episode_header_art;
+    get_feed_artwork_path(feed->feed_id, art_path, sizeof(art_path));
+    bool pending = false;
+    SDL_Surface* art = Thumbnail_get(art_path, feed->artwork_url, size, SCALE1(8), &pending);
+    if (!art && pending) art = Thumbnail_placeholder(size, SCALE1(8));
+    return art;
 }
 
 // Management menu item labels (Y button menu)
 static const char* podcast_manage_items[] = {
     "Search",
-    "Top Shows"
+    "Top Shows",
+    "Auto-Download",
+    "Storage Limit"
 };
 
 // Format duration as HH:MM:SS or MM:SS
@@ -520,17 +148,17 @@ static void render_section_header(SDL_Surface* screen, const char* text, int y)
 
 // --- Rich list item renderer (artwork + title + subtitle using rich pill) ---
 // Generic: works for subscriptions, search results, top shows
-// Thumbnails are memory-cache only (non-blocking). Lazy loading done by caller.
+// Artwork comes from the thumbnail service (non-blocking, placeholder while loading)
 static ListItemRichPos render_rich_list_item(SDL_Surface* screen, ListLayout* layout,
     const char* title, const char* subtitle,
-    const char* feed_id, const char* itunes_id,
+    const char* art_path, const char* art_url,
     int y, bool selected, int extra_subtitle_width) {
     char truncated[256];
 
-    // Check memory cache only (non-blocking)
-    const char* cache_key = (feed_id && feed_id[0]) ? feed_id :
-                            (itunes_id && itunes_id[0]) ? itunes_id : NULL;
-    SDL_Surface* thumb = cache_key ? find_cached_thumbnail(cache_key) : NULL;
+    int thumb_size = list_thumb_size();
+    bool pending = false;
+    SDL_Surface* thumb = art_path ? Thumbnail_get(art_path, art_url, thumb_size, thumb_size / 2, &pending) : NULL;
+    if (!thumb && pending) thumb = Thumbnail_placeholder(thumb_size, thumb_size / 2);
     bool has_image = (thumb != NULL);
 
     ListItemRichPos pos = render_list_item_pill_rich(screen, layout, title, subtitle, truncated, y, selected, has_image, extra_subtitle_width);
@@ -708,7 +336,10 @@ void render_podcast_main_page(SDL_Surface* screen, int show_setting,
                     badge_extra = SCALE1(4) + label_w + SCALE1(6);  // gap + text + pill padding
                 }
 
-                ListItemRichPos rpos = render_rich_list_item(screen, &pill_layout, feeds[i].title, ep_str, feeds[i].feed_id, NULL, y, is_selected, badge_extra);
+                char art_path[768];
+                get_feed_artwork_path(feeds[i].feed_id, art_path, sizeof(art_path));
+                ListItemRichPos rpos = render_rich_list_item(screen, &pill_layout, feeds[i].title, ep_str,
+                                                             art_path, feeds[i].artwork_url, y, is_selected, badge_extra);
 
                 // Render "N New" badge after subtitle text
                 if (feeds[i].new_episode_count > 0) {
@@ -767,6 +398,15 @@ void render_podcast_manage(SDL_Surface* screen, int show_setting,
         bool selected = (i == menu_selected);
         const char* item_label = podcast_manage_items[i];
 
+        // Auto-download settings show their value
+        if (i == PODCAST_MANAGE_AUTO_DOWNLOAD) {
+            snprintf(label_buf, sizeof(label_buf), "%s: %s", item_label, Settings_getPodcastAutoDownloadDisplayStr());
+            item_label = label_buf;
+        } else if (i == PODCAST_MANAGE_STORAGE) {
+            snprintf(label_buf, sizeof(label_buf), "%s: %s", item_label, Settings_getPodcastStorageDisplayStr());
+            item_label = label_buf;
+        }
+
         // Render menu item pill
         MenuItemPos pos = render_menu_item_pill(screen, &layout, item_label, truncated, i, selected, 0);
 
@@ -777,7 +417,11 @@ void render_podcast_manage(SDL_Surface* screen, int show_setting,
 
     // Button hints
     GFX_blitButtonGroup((char*[]){"START", "CONTROLS", NULL}, 0, screen, 0);
-    GFX_blitButtonGroup((char*[]){"B", "BACK", "A", "SELECT", NULL}, 1, screen, 1);
+    if (menu_selected == PODCAST_MANAGE_AUTO_DOWNLOAD || menu_selected == PODCAST_MANAGE_STORAGE) {
+        GFX_blitButtonGroup((char*[]){"B", "BACK", "LEFT/RIGHT", "CHANGE", NULL}, 1, screen, 1);
+    } else {
+        GFX_blitButtonGroup((char*[]){"B", "BACK", "A", "SELECT", NULL}, 1, screen, 1);
+    }
 }
 
 // Render Top Shows list
@@ -826,7 +470,6 @@ void render_podcast_top_shows(SDL_Surface* screen, int show_setting,
     layout.items_per_page = layout.list_h / layout.item_h;
     adjust_list_scroll(selected, scroll, layout.items_per_page);
 
-    int thumb_size = SCALE1(PILL_SIZE) * 3 / 2 - SCALE1(4) * 2;  // same as image_size in pill_rich
     for (int i = 0; i < layout.items_per_page && *scroll + i < count; i++) {
         int idx = *scroll + i;
         PodcastChartItem* item = &items[idx];
@@ -834,14 +477,11 @@ void render_podcast_top_shows(SDL_Surface* screen, int show_setting,
 
         int y = layout.list_y + i * layout.item_h;
 
+        char art_path[768];
+        get_itunes_artwork_path(item->itunes_id, art_path, sizeof(art_path));
         render_rich_list_item(screen, &layout, item->title, item->author,
-                              NULL, item->itunes_id, y, is_selected, 0);
-    }
-
-    // Lazy fetch: fetch one uncached artwork per frame for visible items
-    for (int i = 0; i < layout.items_per_page && *scroll + i < count; i++) {
-        PodcastChartItem* item = &items[*scroll + i];
-        if (artwork_fetch_one(item->itunes_id, item->artwork_url, thumb_size)) break;
+                              item->itunes_id[0] ? art_path : NULL, item->artwork_url,
+                              y, is_selected, 0);
     }
 
     render_scroll_indicators(screen, *scroll, layout.items_per_page, count);
@@ -916,7 +556,6 @@ void render_podcast_search_results(SDL_Surface* screen, int show_setting,
         selected_is_subscribed = Podcast_isSubscribed(results[selected].feed_url);
     }
 
-    int thumb_size = SCALE1(PILL_SIZE) * 3 / 2 - SCALE1(4) * 2;
     for (int i = 0; i < layout.items_per_page && *scroll + i < count; i++) {
         int idx = *scroll + i;
         PodcastSearchResult* result = &results[idx];
@@ -924,14 +563,11 @@ void render_podcast_search_results(SDL_Surface* screen, int show_setting,
 
         int y = layout.list_y + i * layout.item_h;
 
+        char art_path[768];
+        get_itunes_artwork_path(result->itunes_id, art_path, sizeof(art_path));
         render_rich_list_item(screen, &layout, result->title, result->author,
-                              NULL, result->itunes_id, y, is_selected, 0);
-    }
-
-    // Lazy fetch: fetch one uncached artwork per frame for visible items
-    for (int i = 0; i < layout.items_per_page && *scroll + i < count; i++) {
-        PodcastSearchResult* result = &results[*scroll + i];
-        if (artwork_fetch_one(result->itunes_id, result->artwork_url, thumb_size)) break;
+                              result->itunes_id[0] ? art_path : NULL, result->artwork_url,
+                              y, is_selected, 0);
     }
 
     render_scroll_indicators(screen, *scroll, layout.items_per_page, count);
@@ -985,7 +621,7 @@ void render_podcast_episodes(SDL_Surface* screen, int show_setting,
         // Render info area at fixed position
         int img_pad = SCALE1(2);
         int img_size = info_area_h - img_pad * 2;
-        SDL_Surface* header_art = get_episode_header_art(feed->feed_id, img_size);
+        SDL_Surface* header_art = get_episode_header_art(feed, img_size);
         bool has_art = (header_art != NULL);
         if (has_art) {
             SDL_Rect art_dst = {pad, base_y + img_pad, img_size, img_size};
@@ -1050,7 +686,7 @@ void render_podcast_episodes(SDL_Surface* screen, int show_setting,
         if (info_sy + info_area_h > base_y && info_sy < base_y + viewport_h) {
             int img_pad = SCALE1(2);
             int img_size = info_area_h - img_pad * 2;
-            SDL_Surface* header_art = get_episode_header_art(feed->feed_id, img_size);
+            SDL_Surface* header_art = get_episode_header_art(feed, img_size);
             bool has_art = (header_art != NULL);
 
             if (has_art) {
@@ -1333,7 +969,9 @@ void render_podcast_episodes(SDL_Surface* screen, int show_setting,
         const char* play_label = selected_is_resumable ? "RESUME" : "PLAY";
         GFX_blitButtonGroup((char*[]){"B", "BACK", "A", (char*)play_label, "Y", "REFRESH", NULL}, 1, screen, 1);
     } else {
-        GFX_blitButtonGroup((char*[]){"B", "BACK", "A", "DOWNLOAD", "Y", "REFRESH", NULL}, 1, screen, 1);
+        // Streamed; SELECT+A downloads instead (see controls help)
+        const char* play_label = selected_is_resumable ? "RESUME" : "STREAM";
+        GFX_blitButtonGroup((char*[]){"B", "BACK", "A", (char*)play_label, "Y", "REFRESH", NULL}, 1, screen, 1);
     }
 
     // Toast notification
@@ -1358,12 +996,17 @@ void render_podcast_playing(SDL_Surface* screen, int show_setting,
         return;
     }
 
-    // Fetch and render album art background (if available)
-    if (feed->artwork_url[0] && feed->feed_id[0]) {
-        podcast_fetch_artwork(feed->artwork_url, feed->feed_id);
-        if (podcast_artwork && podcast_artwork->w > 0 && podcast_artwork->h > 0) {
-            render_album_art_background(screen, podcast_artwork);
+    // Render album art background once its screen-height thumbnail is ready
+    if (feed->feed_id[0]) {
+        if (strcmp(playing_art_feed_id, feed->feed_id) != 0) {
+            cleanup_album_art_background();
+            strncpy(playing_art_feed_id, feed->feed_id, sizeof(playing_art_feed_id) - 1);
+            playing_art_feed_id[sizeof(playing_art_feed_id) - 1] = '\0';
         }
+        char art_path[768];
+        get_feed_artwork_path(feed->feed_id, art_path, sizeof(art_path));
+        SDL_Surface* art = Thumbnail_get(art_path, feed->artwork_url, hh, 0, NULL);
+        if (art) render_album_art_background(screen, art);
     }
 
     // === TOP BAR ===
@@ -1391,13 +1034,23 @@ void render_podcast_playing(SDL_Surface* screen, int show_setting,
     // Show position among downloaded episodes, not total episodes
     int downloaded_total = Podcast_countDownloadedEpisodes(feed_index);
     int downloaded_idx = Podcast_getDownloadedEpisodeIndex(feed_index, episode_index);
-    char ep_counter[32];
+    char ep_counter[64];
     if (downloaded_idx >= 0 && downloaded_total > 0) {
         snprintf(ep_counter, sizeof(ep_counter), "%02d / %02d", downloaded_idx + 1, downloaded_total);
     } else {
         // Fallback if episode is not downloaded (shouldn't happen in playing state)
         snprintf(ep_counter, sizeof(ep_counter), "%02d / %02d", episode_index + 1, feed->episode_count);
     }
+    // Speech playback settings of this feed, when not the defaults
+    int speed = Podcast_getPlaybackSpeed(feed_index);
+    if (speed != 100) {
+        int len = (int)strlen(ep_counter);
+        snprintf(ep_counter + len, sizeof(ep_counter) - len, "  %d.%02dx", speed / 100, speed % 100);
+    }
+    if (feed->skip_silence) {
+        int len = (int)strlen(ep_counter);
+        snprintf(ep_counter + len, sizeof(ep_counter) - len, "  SKIP SILENCE");
+    }
     SDL_Surface* counter_surf = TTF_RenderUTF8_Blended(Fonts_getTiny(), ep_counter, COLOR_GRAY);
     if (counter_surf) {
         int counter_x = badge_x + badge_w + SCALE1(8);
@@ -9,6 +9,8 @@
 typedef enum {
     PODCAST_MANAGE_SEARCH = 0,
     PODCAST_MANAGE_TOP_SHOWS,
+    PODCAST_MANAGE_AUTO_DOWNLOAD,   // Left/Right cycle the value
+    PODCAST_MANAGE_STORAGE,
     PODCAST_MANAGE_COUNT
 } PodcastManageMenuItem;
 
@@ -17,13 +19,6 @@ void render_podcast_main_page(SDL_Surface* screen, int show_setting,
     int selected, int* scroll,
     const char* toast_message, uint32_t toast_time);
 
-// Clear thumbnail cache (call from Podcast_cleanup)
-void Podcast_clearThumbnailCache(void);
-
-// Lazy load one pending thumbnail from disk (call from main loop)
-// Returns true if a thumbnail was loaded (caller should set dirty)
-bool Podcast_loadPendingThumbnails(void);
-
 // Render the podcast management menu (Y button opens this)
 void render_podcast_manage(SDL_Surface* screen, int show_setting,
                            int menu_selected, int subscription_count);
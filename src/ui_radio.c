@@ -9,11 +9,40 @@
 #include "ui_album_art.h"
 #include "album_art.h"
 #include "radio_curated.h"
+#include "radio_health.h"
 #include "module_common.h"
 
+// Draw a small DEAD/SLOW badge at the right edge of a list row.
+// Returns the width used (0 if the station is healthy or not yet probed).
+static int render_health_badge(SDL_Surface* screen, const char* url, int y, int item_h, bool selected) {
+    const char* label = NULL;
+    SDL_Color color;
+    switch (radio_health_get(url)) {
+        case RADIO_HEALTH_DEAD:
+            label = "DEAD";
+            color = (SDL_Color){0xE0, 0x40, 0x40, 0xFF};
+            break;
+        case RADIO_HEALTH_SLOW:
+            label = "SLOW";
+            color = (SDL_Color){0xE0, 0xA0, 0x30, 0xFF};
+            break;
+        default:
+            return 0;
+    }
+    if (selected) color = COLOR_GRAY;
+
+    SDL_Surface* badge = TTF_RenderUTF8_Blended(Fonts_getTiny(), label, color);
+    if (!badge) return 0;
+    int w = badge->w;
+    SDL_BlitSurface(badge, NULL, screen, &(SDL_Rect){screen->w - w - SCALE1(PADDING * 2), y + (item_h - badge->h) / 2});
+    SDL_FreeSurface(badge);
+    return w + SCALE1(6);
+}
+
 // Render the radio station list
 void render_radio_list(SDL_Surface* screen, int show_setting,
                        int radio_selected, int* radio_scroll,
+                       const int* sorted_indices, int sorted_count,
                        const char* toast_message, uint32_t toast_time) {
     GFX_clear(screen);
 
@@ -37,9 +66,9 @@ void render_radio_list(SDL_Surface* screen, int show_setting,
     ListLayout layout = calc_list_layout(screen);
     adjust_list_scroll(radio_selected, radio_scroll, layout.items_per_page);
 
-    for (int i = 0; i < layout.items_per_page && *radio_scroll + i < station_count; i++) {
+    for (int i = 0; i < layout.items_per_page && *radio_scroll + i < sorted_count; i++) {
         int idx = *radio_scroll + i;
-        RadioStation* station = &stations[idx];
+        RadioStation* station = &stations[sorted_indices[idx]];
         bool selected = (idx == radio_selected);
 
         int y = layout.list_y + i * layout.item_h;
@@ -51,18 +80,19 @@ void render_radio_list(SDL_Surface* screen, int show_setting,
         render_list_item_text(screen, NULL, station->name, Fonts_getMedium(),
                               pos.text_x, pos.text_y, layout.max_width, selected);
 
-        // Genre (if available)
+        // Health badge and genre (if available)
+        int badge_w = render_health_badge(screen, station->url, y, layout.item_h, selected);
         if (station->genre[0]) {
             SDL_Color genre_color = selected ? COLOR_GRAY : COLOR_DARK_TEXT;
             SDL_Surface* genre_text = TTF_RenderUTF8_Blended(Fonts_getTiny(), station->genre, genre_color);
             if (genre_text) {
-                SDL_BlitSurface(genre_text, NULL, screen, &(SDL_Rect){hw - genre_text->w - SCALE1(PADDING * 2), y + (layout.item_h - genre_text->h) / 2});
+                SDL_BlitSurface(genre_text, NULL, screen, &(SDL_Rect){hw - genre_text->w - badge_w - SCALE1(PADDING * 2), y + (layout.item_h - genre_text->h) / 2});
                 SDL_FreeSurface(genre_text);
             }
         }
     }
 
-    render_scroll_indicators(screen, *radio_scroll, layout.items_per_page, station_count);
+    render_scroll_indicators(screen, *radio_scroll, layout.items_per_page, sorted_count);
 
     // Show note for users using default stations (no custom stations yet)
     if (!Radio_hasUserStations()) {
@@ -438,12 +468,13 @@ void render_radio_add_stations(SDL_Surface* screen, int show_setting,
         render_list_item_text(screen, NULL, station->name, Fonts_getMedium(),
                               text_x + prefix_width, text_y, name_max_width, selected);
 
-        // Genre on right
+        // Health badge and genre on right
+        int badge_w = render_health_badge(screen, station->url, y, layout.item_h, selected);
         if (station->genre[0]) {
             SDL_Color genre_color = selected ? COLOR_GRAY : COLOR_DARK_TEXT;
             SDL_Surface* genre_text = TTF_RenderUTF8_Blended(Fonts_getTiny(), station->genre, genre_color);
             if (genre_text) {
-                SDL_BlitSurface(genre_text, NULL, screen, &(SDL_Rect){hw - genre_text->w - SCALE1(PADDING * 2), y + (layout.item_h - genre_text->h) / 2});
+                SDL_BlitSurface(genre_text, NULL, screen, &(SDL_Rect){hw - genre_text->w - badge_w - SCALE1(PADDING * 2), y + (layout.item_h - genre_text->h) / 2});
                 SDL_FreeSurface(genre_text);
             }
         }
@@ -630,6 +661,8 @@ void RadioStatus_renderGPU(void) {
     static RadioState last_state = RADIO_STATE_STOPPED;
     static int last_bitrate = 0;
     static int last_buf_pct = -1;
+    static int last_delay = 0;
+    static bool last_paused = false;
 
     if (state == RADIO_STATE_STOPPED) {
         if (last_state != RADIO_STATE_STOPPED) {
@@ -648,14 +681,21 @@ void RadioStatus_renderGPU(void) {
     const RadioMetadata* meta = Radio_getMetadata();
     int current_bitrate = meta ? meta->bitrate : 0;
 
+    // Time-shift position
+    int delay = Radio_getTimeshiftDelay();
+    bool paused = Radio_isPaused();
+
     // Skip expensive surface recreation if nothing changed
     int buf_pct = (int)(buffer_level * 100);
-    if (state == last_state && current_bitrate == last_bitrate && buf_pct == last_buf_pct) {
+    if (state == last_state && current_bitrate == last_bitrate && buf_pct == last_buf_pct &&
+        delay == last_delay && paused == last_paused) {
         return;
     }
     last_state = state;
     last_bitrate = current_bitrate;
     last_buf_pct = buf_pct;
+    last_delay = delay;
+    last_paused = paused;
 
     // Get status text
     // Show "buffering" only during initial connect or actual rebuffer (low buffer).
@@ -671,6 +711,14 @@ void RadioStatus_renderGPU(void) {
         default: break;
     }
 
+    // Paused or behind live: show how far back playback is
+    char timeshift_str[32];
+    if (paused || delay > 0) {
+        snprintf(timeshift_str, sizeof(timeshift_str), "%s-%d:%02d", paused ? "paused " : "",
+                 delay / 60, delay % 60);
+        status_text = timeshift_str;
+    }
+
     // Prepare bitrate string
     char bitrate_str[32] = "";
     if (current_bitrate > 0) {
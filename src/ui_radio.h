@@ -8,9 +8,10 @@
 // GPU layer for buffer indicator
 #define LAYER_BUFFER 4
 
-// Render the radio station list
+// Render the radio station list (sorted_indices maps list position to station)
 void render_radio_list(SDL_Surface* screen, int show_setting,
                        int radio_selected, int* radio_scroll,
+                       const int* sorted_indices, int sorted_count,
                        const char* toast_message, uint32_t toast_time);
 
 // Render the radio playing screen
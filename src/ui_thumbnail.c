@@ -0,0 +1,473 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include "ui_thumbnail.h"
+#include "http_client.h"
+#include "api.h"
+
+#define THUMBNAIL_CACHE_ENTRIES 64
+#define THUMBNAIL_QUEUE_SIZE 16     // Newest requests first, oldest dropped when full
+#define THUMBNAIL_DONE_SIZE 16
+#define THUMBNAIL_SOURCE_MAX_SIZE (1024 * 1024)  // Largest original image accepted
+#define THUMBNAIL_RETRY_MS 30000    // Wait before retrying a failed thumbnail
+#define THUMBNAIL_PLACEHOLDERS 4
+
+typedef struct {
+    char source[512];
+    int size;
+    int radius;
+} ThumbnailKey;
+
+typedef struct {
+    ThumbnailKey key;
+    char url[512];
+} ThumbnailRequest;
+
+typedef struct {
+    ThumbnailKey key;
+    SDL_Surface* surface;
+} ThumbnailResult;
+
+typedef struct {
+    ThumbnailKey key;
+    SDL_Surface* surface;   // NULL = failed, retried after THUMBNAIL_RETRY_MS
+    uint32_t last_used;
+    uint32_t failed_at;
+    bool used;
+} ThumbnailEntry;
+
+typedef struct {
+    int size;
+    int radius;
+    SDL_Surface* surface;
+} ThumbnailPlaceholder;
+
+// Memory cache (main thread only)
+static ThumbnailEntry cache[THUMBNAIL_CACHE_ENTRIES];
+static size_t cache_bytes = 0;
+static uint32_t cache_clock = 0;
+static ThumbnailPlaceholder placeholders[THUMBNAIL_PLACEHOLDERS];
+static int placeholder_next = 0;
+
+// Worker state (guarded by thumb_mutex)
+static pthread_mutex_t thumb_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t thumb_cond = PTHREAD_COND_INITIALIZER;
+static ThumbnailRequest queue[THUMBNAIL_QUEUE_SIZE];
+static int queue_count = 0;
+static ThumbnailResult done[THUMBNAIL_DONE_SIZE];
+static int done_count = 0;
+static ThumbnailKey in_flight;
+static bool in_flight_valid = false;
+static bool worker_running = false;
+
+static bool key_equal(const ThumbnailKey* a, const ThumbnailKey* b) {
+    return a->size == b->size && a->radius == b->radius && strcmp(a->source, b->source) == 0;
+}
+
+static size_t surface_bytes(SDL_Surface* s) {
+    return s ? (size_t)s->pitch * s->h : 0;
+}
+
+// Check if image data is complete (not truncated)
+// JPEG: ends with FF D9, PNG: ends with IEND chunk
+static bool is_image_complete(const uint8_t* data, int size) {
+    if (size < 4) return false;
+    if (data[0] == 0xFF && data[1] == 0xD8) {
+        return (data[size - 2] == 0xFF && data[size - 1] == 0xD9);
+    }
+    if (data[0] == 0x89 && data[1] == 0x50 && data[2] == 0x4E && data[3] == 0x47) {
+        return (size >= 8 &&
+                data[size - 4] == 0xAE && data[size - 3] == 0x42 &&
+                data[size - 2] == 0x60 && data[size - 1] == 0x82);
+    }
+    // Unknown format — assume complete
+    return true;
+}
+
+// <source without extension>_<size>_<radius>.bmp
+static void thumbnail_path(const ThumbnailKey* key, char* path, int path_size) {
+    const char* slash = strrchr(key->source, '/');
+    const char* dot = strrchr(key->source, '.');
+    int base_len = (dot && (!slash || dot > slash)) ? (int)(dot - key->source) : (int)strlen(key->source);
+    snprintf(path, path_size, "%.*s_%d_%d.bmp", base_len, key->source, key->size, key->radius);
+}
+
+// Create every missing directory above path
+static void make_parent_dirs(const char* path) {
+    char dir[512];
+    strncpy(dir, path, sizeof(dir) - 1);
+    dir[sizeof(dir) - 1] = '\0';
+    char* slash = strrchr(dir, '/');
+    if (!slash || slash == dir) return;
+    *slash = '\0';
+    for (char* p = dir + 1; *p; p++) {
+        if (*p == '/') {
+            *p = '\0';
+            mkdir(dir, 0755);
+            *p = '/';
+        }
+    }
+    mkdir(dir, 0755);
+}
+
+// Decode image data to ARGB8888
+static SDL_Surface* decode_image(const uint8_t* data, int size) {
+    SDL_RWops* rw = SDL_RWFromConstMem(data, size);
+    if (!rw) return NULL;
+    SDL_Surface* loaded = IMG_Load_RW(rw, 1);
+    if (!loaded) return NULL;
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(loaded);
+    return converted;
+}
+
+// Load the original image from disk, or fetch it and save it there
+static SDL_Surface* load_source(const ThumbnailRequest* req, bool have_file) {
+    uint8_t* data = (uint8_t*)malloc(THUMBNAIL_SOURCE_MAX_SIZE);
+    if (!data) return NULL;
+
+    SDL_Surface* image = NULL;
+    if (have_file) {
+        FILE* f = fopen(req->key.source, "rb");
+        if (f) {
+            int size = (int)fread(data, 1, THUMBNAIL_SOURCE_MAX_SIZE, f);
+            bool too_big = !feof(f);
+            fclose(f);
+            if (!too_big && size > 0 && is_image_complete(data, size)) {
+                image = decode_image(data, size);
+            }
+        }
+        // Cached file is corrupt/incomplete — delete it so we re-fetch
+        if (!image && req->url[0]) remove(req->key.source);
+    }
+
+    if (!image && req->url[0]) {
+        int size = http_fetch(req->url, data, THUMBNAIL_SOURCE_MAX_SIZE, NULL);
+        if (size > 0 && is_image_complete(data, size)) {
+            make_parent_dirs(req->key.source);
+            FILE* f = fopen(req->key.source, "wb");
+            if (f) {
+                fwrite(data, 1, size, f);
+                fclose(f);
+            }
+            image = decode_image(data, size);
+        }
+    }
+
+    free(data);
+    return image;
+}
+
+// Halve an ARGB8888 surface with a 2x2 box filter
+static SDL_Surface* halve_surface(SDL_Surface* src) {
+    int w = src->w / 2;
+    int h = src->h / 2;
+    SDL_Surface* dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!dst) return NULL;
+
+    int src_pitch = src->pitch / 4;
+    for (int y = 0; y < h; y++) {
+        const uint32_t* r0 = (const uint32_t*)src->pixels + (2 * y) * src_pitch;
+        const uint32_t* r1 = r0 + src_pitch;
+        uint32_t* out = (uint32_t*)((uint8_t*)dst->pixels + y * dst->pitch);
+        for (int x = 0; x < w; x++) {
+            uint32_t a = r0[2 * x], b = r0[2 * x + 1];
+            uint32_t c = r1[2 * x], d = r1[2 * x + 1];
+            // Two channels per 16-bit lane, four bytes sum to at most 1020
+            uint32_t rb = (((a & 0x00FF00FF) + (b & 0x00FF00FF) + (c & 0x00FF00FF) +
+                            (d & 0x00FF00FF) + 0x00020002) >> 2) & 0x00FF00FF;
+            uint32_t ag = ((((a >> 8) & 0x00FF00FF) + ((b >> 8) & 0x00FF00FF) +
+                            ((c >> 8) & 0x00FF00FF) + ((d >> 8) & 0x00FF00FF) +
+                            0x00020002) >> 2) & 0x00FF00FF;
+            out[x] = rb | (ag << 8);
+        }
+    }
+    return dst;
+}
+
+// Clear pixels outside the corner arcs (radius >= size/2 gives a circle)
+static void apply_mask(SDL_Surface* s, int radius) {
+    if (radius <= 0) return;
+    int size = s->w;
+    uint32_t* pixels = (uint32_t*)s->pixels;
+    int pitch = s->pitch / 4;
+
+    if (radius * 2 >= size) {
+        radius = size / 2;
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                int dx = x - radius;
+                int dy = y - radius;
+                if (dx * dx + dy * dy > radius * radius) pixels[y * pitch + x] = 0;
+            }
+        }
+        return;
+    }
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int cx = -1, cy = -1;
+            if (x < radius && y < radius) { cx = radius; cy = radius; }
+            else if (x >= size - radius && y < radius) { cx = size - 1 - radius; cy = radius; }
+            else if (x < radius && y >= size - radius) { cx = radius; cy = size - 1 - radius; }
+            else if (x >= size - radius && y >= size - radius) { cx = size - 1 - radius; cy = size - 1 - radius; }
+            if (cx >= 0 && (x - cx) * (x - cx) + (y - cy) * (y - cy) > radius * radius) {
+                pixels[y * pitch + x] = 0;
+            }
+        }
+    }
+}
+
+// Scale the original down to size x size and mask it
+static SDL_Surface* scale_thumbnail(SDL_Surface* image, int size, int radius) {
+    // Box-halve first so the final nearest-neighbour scale samples a nearby
+    // size, freeing each larger copy as soon as the next one exists
+    while (image->w >= size * 2 && image->h >= size * 2) {
+        SDL_Surface* half = halve_surface(image);
+        if (!half) break;
+        SDL_FreeSurface(image);
+        image = half;
+    }
+
+    SDL_Surface* thumb = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (thumb) {
+        SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+        SDL_BlitScaled(image, NULL, thumb, &(SDL_Rect){0, 0, size, size});
+        SDL_SetSurfaceBlendMode(thumb, SDL_BLENDMODE_BLEND);
+        apply_mask(thumb, radius);
+    }
+    SDL_FreeSurface(image);
+    return thumb;
+}
+
+// Build one thumbnail: saved bitmap if still current, else from the original
+static SDL_Surface* build_thumbnail(const ThumbnailRequest* req) {
+    char thumb_file[640];
+    thumbnail_path(&req->key, thumb_file, sizeof(thumb_file));
+
+    struct stat src_st, thumb_st;
+    bool have_file = stat(req->key.source, &src_st) == 0;
+    if (stat(thumb_file, &thumb_st) == 0 && (!have_file || thumb_st.st_mtime >= src_st.st_mtime)) {
+        SDL_Surface* loaded = SDL_LoadBMP(thumb_file);
+        if (loaded) {
+            if (loaded->w == req->key.size && loaded->h == req->key.size) {
+                SDL_Surface* thumb = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+                SDL_FreeSurface(loaded);
+                if (thumb) SDL_SetSurfaceBlendMode(thumb, SDL_BLENDMODE_BLEND);
+                return thumb;
+            }
+            SDL_FreeSurface(loaded);
+        }
+    }
+
+    SDL_Surface* image = load_source(req, have_file);
+    if (!image) return NULL;
+
+    SDL_Surface* thumb = scale_thumbnail(image, req->key.size, req->key.radius);
+    if (thumb && SDL_SaveBMP(thumb, thumb_file) != 0) {
+        LOG_error("[Thumbnail] Failed to save %s: %s\n", thumb_file, SDL_GetError());
+    }
+    return thumb;
+}
+
+static void* thumbnail_thread(void* arg) {
+    (void)arg;
+    while (1) {
+        pthread_mutex_lock(&thumb_mutex);
+        while (queue_count == 0) pthread_cond_wait(&thumb_cond, &thumb_mutex);
+        ThumbnailRequest req = queue[--queue_count];  // Newest first
+        in_flight = req.key;
+        in_flight_valid = true;
+        pthread_mutex_unlock(&thumb_mutex);
+
+        SDL_Surface* thumb = build_thumbnail(&req);
+
+        pthread_mutex_lock(&thumb_mutex);
+        in_flight_valid = false;
+        if (done_count < THUMBNAIL_DONE_SIZE) {
+            done[done_count].key = req.key;
+            done[done_count].surface = thumb;
+            done_count++;
+        } else if (thumb) {
+            SDL_FreeSurface(thumb);  // Not polled; asked for again on next draw
+        }
+        pthread_mutex_unlock(&thumb_mutex);
+    }
+    return NULL;
+}
+
+// Queue a request unless it's already queued, in progress or waiting to be polled
+static void queue_request(const ThumbnailKey* key, const char* url) {
+    pthread_mutex_lock(&thumb_mutex);
+
+    bool known = in_flight_valid && key_equal(&in_flight, key);
+    for (int i = 0; !known && i < queue_count; i++) known = key_equal(&queue[i].key, key);
+    for (int i = 0; !known && i < done_count; i++) known = key_equal(&done[i].key, key);
+
+    if (!known) {
+        if (queue_count == THUMBNAIL_QUEUE_SIZE) {
+            // Drop the oldest (likely scrolled out of view)
+            memmove(&queue[0], &queue[1], sizeof(queue[0]) * (THUMBNAIL_QUEUE_SIZE - 1));
+            queue_count--;
+        }
+        ThumbnailRequest* req = &queue[queue_count++];
+        req->key = *key;
+        strncpy(req->url, url ? url : "", sizeof(req->url) - 1);
+        req->url[sizeof(req->url) - 1] = '\0';
+        pthread_cond_signal(&thumb_cond);
+    }
+
+    if (!worker_running) {
+        pthread_t thread;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        if (pthread_create(&thread, &attr, thumbnail_thread, NULL) == 0) {
+            worker_running = true;
+        } else {
+            LOG_error("[Thumbnail] Failed to start worker thread\n");
+        }
+        pthread_attr_destroy(&attr);
+    }
+
+    pthread_mutex_unlock(&thumb_mutex);
+}
+
+static ThumbnailEntry* find_entry(const ThumbnailKey* key) {
+    for (int i = 0; i < THUMBNAIL_CACHE_ENTRIES; i++) {
+        if (cache[i].used && key_equal(&cache[i].key, key)) return &cache[i];
+    }
+    return NULL;
+}
+
+static void free_entry(ThumbnailEntry* e) {
+    if (e->surface) {
+        cache_bytes -= surface_bytes(e->surface);
+        SDL_FreeSurface(e->surface);
+        e->surface = NULL;
+    }
+    e->used = false;
+}
+
+// Store a finished thumbnail, evicting least recently used ones to fit
+static void store_result(const ThumbnailResult* r) {
+    ThumbnailEntry* slot = find_entry(&r->key);
+    if (slot) free_entry(slot);
+
+    size_t bytes = surface_bytes(r->surface);
+    while (1) {
+        ThumbnailEntry* oldest = NULL;
+        ThumbnailEntry* empty = NULL;
+        for (int i = 0; i < THUMBNAIL_CACHE_ENTRIES; i++) {
+            if (!cache[i].used) {
+                if (!empty) empty = &cache[i];
+            } else if (!oldest || cache[i].last_used < oldest->last_used) {
+                oldest = &cache[i];
+            }
+        }
+        if (empty && cache_bytes + bytes <= THUMBNAIL_CACHE_BYTES) {
+            slot = empty;
+            break;
+        }
+        if (!oldest) {
+            slot = empty;  // Larger than the whole budget; keep it alone
+            break;
+        }
+        free_entry(oldest);
+    }
+
+    slot->key = r->key;
+    slot->surface = r->surface;
+    slot->last_used = ++cache_clock;
+    slot->failed_at = r->surface ? 0 : SDL_GetTicks();
+    slot->used = true;
+    cache_bytes += bytes;
+}
+
+SDL_Surface* Thumbnail_get(const char* source_path, const char* url,
+                           int size, int radius, bool* pending) {
+    if (pending) *pending = false;
+    if (!source_path || !source_path[0] || size <= 0) return NULL;
+    if (strlen(source_path) >= sizeof(((ThumbnailKey*)0)->source)) return NULL;
+
+    ThumbnailKey key;
+    strcpy(key.source, source_path);
+    key.size = size;
+    key.radius = radius;
+
+    ThumbnailEntry* e = find_entry(&key);
+    if (e) {
+        if (e->surface) {
+            e->last_used = ++cache_clock;
+            return e->surface;
+        }
+        if (SDL_GetTicks() - e->failed_at < THUMBNAIL_RETRY_MS) return NULL;
+        free_entry(e);
+    }
+
+    queue_request(&key, url);
+    if (pending) *pending = true;
+    return NULL;
+}
+
+SDL_Surface* Thumbnail_placeholder(int size, int radius) {
+    if (size <= 0) return NULL;
+    for (int i = 0; i < THUMBNAIL_PLACEHOLDERS; i++) {
+        if (placeholders[i].surface && placeholders[i].size == size && placeholders[i].radius == radius)
+            return placeholders[i].surface;
+    }
+
+    SDL_Surface* s = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!s) return NULL;
+    SDL_FillRect(s, NULL, 0x40808080);  // Translucent gray, visible on any pill
+    SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_BLEND);
+    apply_mask(s, radius);
+
+    ThumbnailPlaceholder* p = &placeholders[placeholder_next];
+    placeholder_next = (placeholder_next + 1) % THUMBNAIL_PLACEHOLDERS;
+    if (p->surface) SDL_FreeSurface(p->surface);
+    p->size = size;
+    p->radius = radius;
+    p->surface = s;
+    return s;
+}
+
+bool Thumbnail_poll(void) {
+    ThumbnailResult results[THUMBNAIL_DONE_SIZE];
+
+    pthread_mutex_lock(&thumb_mutex);
+    int count = done_count;
+    memcpy(results, done, sizeof(results[0]) * count);
+    done_count = 0;
+    pthread_mutex_unlock(&thumb_mutex);
+
+    for (int i = 0; i < count; i++) store_result(&results[i]);
+    return count > 0;
+}
+
+void Thumbnail_clear(void) {
+    pthread_mutex_lock(&thumb_mutex);
+    queue_count = 0;
+    for (int i = 0; i < done_count; i++) {
+        if (done[i].surface) SDL_FreeSurface(done[i].surface);
+    }
+    done_count = 0;
+    pthread_mutex_unlock(&thumb_mutex);
+
+    for (int i = 0; i < THUMBNAIL_CACHE_ENTRIES; i++) {
+        if (cache[i].used) free_entry(&cache[i]);
+    }
+    cache_bytes = 0;
+
+    for (int i = 0; i < THUMBNAIL_PLACEHOLDERS; i++) {
+        if (placeholders[i].surface) SDL_FreeSurface(placeholders[i].surface);
+        placeholders[i].surface = NULL;
+    }
+}
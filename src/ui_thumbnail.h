@@ -0,0 +1,34 @@
+#ifndef __UI_THUMBNAIL_H__
+#define __UI_THUMBNAIL_H__
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Display-size artwork thumbnails, built off the UI thread.
+//
+// A thumbnail is the source image scaled to size x size with a corner mask
+// (radius 0 = square, size/2 = circle). The first request decodes the source
+// (fetching url into source_path if missing), box-reduces it and saves the
+// result next to the source as <source>_<size>_<radius>.bmp, so later sessions
+// just read back the small bitmap. Ready thumbnails stay in a memory LRU
+// bounded by THUMBNAIL_CACHE_BYTES.
+
+#define THUMBNAIL_CACHE_BYTES (8 * 1024 * 1024)
+
+// Get a thumbnail if it's ready, otherwise queue it and return NULL with
+// *pending set (draw Thumbnail_placeholder meanwhile). The surface belongs to
+// the cache and stays valid until the next Thumbnail_poll()/Thumbnail_clear()
+SDL_Surface* Thumbnail_get(const char* source_path, const char* url,
+                           int size, int radius, bool* pending);
+
+// Neutral masked square to draw while a thumbnail is pending
+SDL_Surface* Thumbnail_placeholder(int size, int radius);
+
+// Take in thumbnails finished in the background (call from main loop)
+// Returns true if any arrived (caller should set dirty)
+bool Thumbnail_poll(void);
+
+// Free all cached thumbnails and drop queued requests
+void Thumbnail_clear(void);
+
+#endif
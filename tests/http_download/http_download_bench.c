@@ -0,0 +1,52 @@
+// Wall time of a 12MB download from the stand-in (range_server.py, 1MB/s per
+// connection): one stream, four ranges, and four ranges where the first
+// connection runs at a quarter of the speed (work stealing evens it out).
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "http_download.h"
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <stand-in server port>\n", argv[0]);
+        return 2;
+    }
+
+    static const struct {
+        const char* path;
+        const char* name;
+    } runs[] = {
+        {"/norange", "single stream"},
+        {"/file", "four ranges"},
+        {"/slowfirst", "four ranges, slow first connection"},
+    };
+
+    char out_path[256];
+    mkdir(TEST_DATA_DIR, 0755);
+    snprintf(out_path, sizeof(out_path), "%s/bench.bin", TEST_DATA_DIR);
+
+    int status = 0;
+    for (int i = 0; i < (int)(sizeof(runs) / sizeof(runs[0])); i++) {
+        char url[128];
+        snprintf(url, sizeof(url), "http://127.0.0.1:%s%s", argv[1], runs[i].path);
+        unlink(out_path);
+        http_download_discard(out_path);
+
+        double start = now_sec();
+        int bytes = http_download_file(url, out_path, NULL, NULL);
+        double elapsed = now_sec() - start;
+        if (bytes <= 0) status = 1;
+        printf("%-36s %6.1fs  (%d bytes)\n", runs[i].name, elapsed, bytes);
+    }
+    unlink(out_path);
+    return status;
+}
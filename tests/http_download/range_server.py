@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""Stand-in file server for the multi-connection download test and benchmark.
+
+Binds a free local port and runs the given command with the port as its last
+argument, then exits with the command's status.
+
+Every path serves the same FILE_SIZE bytes (byte i = (i * 7) & 255) with an
+ETag, throttled to RATE bytes/s per connection:
+
+  /file          byte ranges supported
+  /norange       no Accept-Ranges, always the whole body
+  /slowfirst     byte ranges; the connection starting at 0 runs at RATE / 4
+  /fast/<path>   same as <path> without the throttle
+"""
+
+import http.server
+import re
+import socketserver
+import subprocess
+import sys
+import threading
+import time
+
+FILE_SIZE = 12 << 20
+RATE = 1 << 20
+STEP = 16384
+
+DATA = bytes((i * 7) & 255 for i in range(FILE_SIZE))
+
+
+class Handler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def log_message(self, fmt, *args):
+        pass
+
+    def do_GET(self):
+        path = self.path
+        throttle = True
+        if path.startswith("/fast/"):
+            path = path[5:]
+            throttle = False
+        ranges = not path.startswith("/norange")
+
+        start, end = 0, FILE_SIZE - 1
+        range_header = self.headers.get("Range")
+        if_range = self.headers.get("If-Range")
+        partial = ranges and range_header and (if_range is None or if_range == '"x1"')
+        if partial:
+            m = re.match(r"bytes=(\d+)-(\d*)", range_header)
+            start = int(m.group(1))
+            if m.group(2):
+                end = min(int(m.group(2)), end)
+        body = DATA[start:end + 1]
+
+        self.send_response(206 if partial else 200)
+        self.send_header("ETag", '"x1"')
+        if ranges:
+            self.send_header("Accept-Ranges", "bytes")
+        if partial:
+            self.send_header("Content-Range", "bytes %d-%d/%d" % (start, end, FILE_SIZE))
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+
+        rate = RATE // 4 if path.startswith("/slowfirst") and start == 0 else RATE
+        try:
+            for i in range(0, len(body), STEP):
+                self.wfile.write(body[i:i + STEP])
+                if throttle:
+                    time.sleep(STEP / rate)
+        except (BrokenPipeError, ConnectionResetError):
+            pass
+
+
+class Server(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    daemon_threads = True
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit("usage: range_server.py <command...>")
+    server = Server(("127.0.0.1", 0), Handler)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    status = subprocess.call(sys.argv[1:] + [str(server.server_address[1])])
+    server.shutdown()
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,7 @@
+// Host stand-in for the NextUI api.h (logging only)
+#pragma once
+#include <stdio.h>
+#include <stdbool.h>
+
+#define LOG_error(...) fprintf(stderr, __VA_ARGS__)
+#define LOG_info(...) fprintf(stderr, __VA_ARGS__)
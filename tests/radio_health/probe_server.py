@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Stand-in radio server for the station health prober test.
+
+Binds a free local port and runs the given test command with the port as its
+last argument, then exits with the command's status.
+
+  /ok/<n>        200 audio/mpeg, icy-br 128, audio right away
+  /redirect/<n>  302 to /ok/<n>
+  /slow/<n>      200 audio/mpeg, first audio byte after SLOW_BODY_DELAY
+  /dead/<n>      404
+  /stats         max_concurrent=<probes in flight at once, /stats excluded>
+"""
+
+import http.server
+import socketserver
+import subprocess
+import sys
+import threading
+import time
+
+SLOW_BODY_DELAY = 4.3  # Past the prober's 4s slow threshold, inside its 5s body timeout
+
+lock = threading.Lock()
+in_flight = 0
+max_in_flight = 0
+
+
+class Handler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.0"
+
+    def log_message(self, fmt, *args):
+        pass
+
+    def do_GET(self):
+        global in_flight, max_in_flight
+        if self.path == "/stats":
+            body = ("max_concurrent=%d\n" % max_in_flight).encode()
+            self.send_response(200)
+            self.send_header("Content-Type", "text/plain")
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+            return
+
+        with lock:
+            in_flight += 1
+            max_in_flight = max(max_in_flight, in_flight)
+        try:
+            self.serve_probe()
+        except (BrokenPipeError, ConnectionResetError):
+            pass
+        finally:
+            with lock:
+                in_flight -= 1
+
+    def serve_probe(self):
+        kind = self.path.split("/")[1]
+        if kind == "redirect":
+            self.send_response(302)
+            host, port = self.server.server_address
+            target = self.path.replace("/redirect/", "/ok/", 1)
+            self.send_header("Location", "http://%s:%d%s" % (host, port, target))
+            self.end_headers()
+            return
+        if kind not in ("ok", "slow"):
+            self.send_error(404)
+            return
+
+        self.send_response(200)
+        self.send_header("Content-Type", "audio/mpeg")
+        self.send_header("icy-br", "128")
+        self.end_headers()
+        self.wfile.flush()
+        if kind == "slow":
+            time.sleep(SLOW_BODY_DELAY)
+        # A few MP3 frame headers' worth of bytes, then hang up
+        self.wfile.write(b"\xff\xfb\x90\x64" * 256)
+
+
+class Server(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    daemon_threads = True
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit("usage: probe_server.py <test command...>")
+    server = Server(("127.0.0.1", 0), Handler)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    port = str(server.server_address[1])
+    status = subprocess.call(sys.argv[1:] + [port])
+    server.shutdown()
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,181 @@
+// Station health prober against the local stand-in server (probe_server.py).
+// Runs the real Radio_probeStation() and radio_health.c worker pool, then
+// checks classification, ranking, bounded concurrency, persistence and TTLs.
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "defines.h"
+#include "radio.h"
+#include "radio_health.h"
+#include "radio_net.h"
+
+#define HEALTH_FILE SHARED_USERDATA_PATH "/music-player/radio/health.txt"
+#define PROBE_WORKERS 3         // RADIO_HEALTH_WORKERS
+#define WAIT_TIMEOUT_SEC 40
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        failures++; \
+    } \
+} while (0)
+
+typedef struct {
+    const char* path;           // On the stand-in server, NULL = nothing listening
+    RadioHealthStatus expected;
+} Case;
+
+static const Case cases[] = {
+    {"/ok/1", RADIO_HEALTH_OK},
+    {"/ok/2", RADIO_HEALTH_OK},
+    {"/redirect/3", RADIO_HEALTH_OK},
+    {"/slow/1", RADIO_HEALTH_SLOW},
+    {"/slow/2", RADIO_HEALTH_SLOW},
+    {"/slow/3", RADIO_HEALTH_SLOW},
+    {"/slow/4", RADIO_HEALTH_SLOW},
+    {"/dead/1", RADIO_HEALTH_DEAD},
+    {NULL, RADIO_HEALTH_DEAD},
+};
+#define CASE_COUNT (int)(sizeof(cases) / sizeof(cases[0]))
+
+static char case_urls[CASE_COUNT][RADIO_MAX_URL];
+
+static const char* status_name(RadioHealthStatus s) {
+    switch (s) {
+        case RADIO_HEALTH_OK: return "ok";
+        case RADIO_HEALTH_SLOW: return "slow";
+        case RADIO_HEALTH_DEAD: return "dead";
+        default: return "unknown";
+    }
+}
+
+static void write_health_file(const char* contents) {
+    mkdir(SHARED_USERDATA_PATH "/music-player", 0755);
+    mkdir(SHARED_USERDATA_PATH "/music-player/radio", 0755);
+    FILE* f = fopen(HEALTH_FILE, "w");
+    if (!f) return;
+    fputs(contents, f);
+    fclose(f);
+}
+
+static bool wait_for_results(void) {
+    for (int waited = 0; waited < WAIT_TIMEOUT_SEC * 10; waited++) {
+        int done = 0;
+        for (int i = 0; i < CASE_COUNT; i++) {
+            if (radio_health_get(case_urls[i]) != RADIO_HEALTH_UNKNOWN) done++;
+        }
+        if (done == CASE_COUNT) return true;
+        usleep(100000);
+    }
+    return false;
+}
+
+static int fetch_max_concurrent(const char* base) {
+    char url[RADIO_MAX_URL];
+    snprintf(url, sizeof(url), "%s/stats", base);
+    uint8_t buf[256];
+    int len = radio_net_fetch(url, buf, sizeof(buf) - 1, NULL, 0);
+    if (len <= 0) return -1;
+    buf[len] = '\0';
+    const char* p = strstr((char*)buf, "max_concurrent=");
+    return p ? atoi(p + 15) : -1;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <stand-in server port>\n", argv[0]);
+        return 2;
+    }
+    char base[64];
+    snprintf(base, sizeof(base), "http://127.0.0.1:%s", argv[1]);
+
+    const char* urls[CASE_COUNT];
+    for (int i = 0; i < CASE_COUNT; i++) {
+        if (cases[i].path) {
+            snprintf(case_urls[i], RADIO_MAX_URL, "%s%s", base, cases[i].path);
+        } else {
+            snprintf(case_urls[i], RADIO_MAX_URL, "http://127.0.0.1:1/");
+        }
+        urls[i] = case_urls[i];
+    }
+    int count = CASE_COUNT;
+
+    // Probe everything from an empty cache
+    mkdir(TEST_DATA_DIR, 0755);
+    mkdir(SHARED_USERDATA_PATH, 0755);
+    unlink(HEALTH_FILE);
+    radio_health_init();
+    for (int i = 0; i < count; i++) {
+        CHECK(radio_health_get(urls[i]) == RADIO_HEALTH_UNKNOWN, "%s known before probing", urls[i]);
+    }
+    radio_health_probe(urls, count);
+    CHECK(wait_for_results(), "probes did not finish within %ds", WAIT_TIMEOUT_SEC);
+
+    for (int i = 0; i < count; i++) {
+        RadioHealthStatus got = radio_health_get(urls[i]);
+        CHECK(got == cases[i].expected, "%s: expected %s, got %s", urls[i],
+              status_name(cases[i].expected), status_name(got));
+    }
+
+    // Four slow stations hold their connections: the pool runs full but no wider
+    int max_concurrent = fetch_max_concurrent(base);
+    CHECK(max_concurrent == PROBE_WORKERS, "expected %d probes in flight at most, server saw %d",
+          PROBE_WORKERS, max_concurrent);
+
+    // Sort key: ok < never probed < slow < dead
+    CHECK(radio_health_rank(urls[0]) < radio_health_rank("http://127.0.0.1:1/unprobed"), "ok ranks first");
+    CHECK(radio_health_rank("http://127.0.0.1:1/unprobed") < radio_health_rank(urls[3]), "unknown before slow");
+    CHECK(radio_health_rank(urls[3]) < radio_health_rank(urls[7]), "slow before dead");
+
+    // Fresh results aren't probed again
+    uint32_t version = radio_health_version();
+    radio_health_probe(urls, count);
+    sleep(1);
+    CHECK(radio_health_version() == version, "fresh results were re-probed");
+
+    // Results survive a restart
+    radio_health_cleanup();
+    radio_health_init();
+    for (int i = 0; i < count; i++) {
+        RadioHealthStatus got = radio_health_get(urls[i]);
+        CHECK(got == cases[i].expected, "%s after reload: expected %s, got %s", urls[i],
+              status_name(cases[i].expected), status_name(got));
+    }
+    radio_health_cleanup();
+
+    // Expired results read as unknown; dead stations expire sooner
+    char cache[1024];
+    long now = (long)time(NULL);
+    snprintf(cache, sizeof(cache),
+             "http://a/|%d|100|200|128|%ld|audio/mpeg\n"
+             "http://b/|%d|100|200|128|%ld|audio/mpeg\n"
+             "http://c/|%d|0|0|0|%ld|\n"
+             "http://d/|%d|0|0|0|%ld|\n",
+             RADIO_HEALTH_OK, now - 60,
+             RADIO_HEALTH_OK, now - 13 * 60 * 60,
+             RADIO_HEALTH_DEAD, now - 10 * 60,
+             RADIO_HEALTH_DEAD, now - 2 * 60 * 60);
+    write_health_file(cache);
+    radio_health_init();
+    CHECK(radio_health_get("http://a/") == RADIO_HEALTH_OK, "recent ok result kept");
+    CHECK(radio_health_get("http://b/") == RADIO_HEALTH_UNKNOWN, "ok result past 12h TTL expired");
+    CHECK(radio_health_get("http://c/") == RADIO_HEALTH_DEAD, "recent dead result kept");
+    CHECK(radio_health_get("http://d/") == RADIO_HEALTH_UNKNOWN, "dead result past 1h TTL expired");
+    radio_health_cleanup();
+
+    if (failures) {
+        fprintf(stderr, "radio_health_test: %d failure(s)\n", failures);
+        return 1;
+    }
+    printf("radio_health_test: all checks passed\n");
+    return 0;
+}
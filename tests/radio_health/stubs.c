@@ -0,0 +1,58 @@
+// Link stand-ins for the parts of the player the radio probe never reaches
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <fdk-aac/aacdecoder_lib.h>
+
+#include "album_art.h"
+#include "radio_curated.h"
+#include "radio_ogg.h"
+
+#define DR_MP3_IMPLEMENTATION
+#include "dr_mp3.h"
+
+void Player_resumeAudio(void) {}
+void Player_pauseAudio(void) {}
+void Player_resetSampleRate(void) {}
+void Player_setSampleRate(int sample_rate) { (void)sample_rate; }
+
+void album_art_init(void) {}
+void album_art_cleanup(void) {}
+void album_art_fetch(const char* artist, const char* title) { (void)artist; (void)title; }
+struct SDL_Surface* album_art_get(void) { return NULL; }
+void album_art_clear(void) {}
+
+void radio_curated_init(void) {}
+void radio_curated_cleanup(void) {}
+int radio_curated_get_country_count(void) { return 0; }
+const CuratedCountry* radio_curated_get_countries(void) { return NULL; }
+int radio_curated_get_station_count(const char* country_code) { (void)country_code; return 0; }
+const CuratedStation* radio_curated_get_stations(const char* country_code, int* count) {
+    (void)country_code;
+    *count = 0;
+    return NULL;
+}
+
+int radio_ogg_open(RadioOggPcmCallback on_pcm, RadioOggTagsCallback on_tags) {
+    (void)on_pcm;
+    (void)on_tags;
+    return -1;
+}
+void radio_ogg_close(void) {}
+int radio_ogg_feed(const uint8_t* data, int len) { (void)data; (void)len; return -1; }
+
+HANDLE_AACDECODER aacDecoder_Open(int transport, UINT layers) { (void)transport; (void)layers; return NULL; }
+void aacDecoder_Close(HANDLE_AACDECODER h) { (void)h; }
+AAC_DECODER_ERROR aacDecoder_Fill(HANDLE_AACDECODER h, UCHAR** buf, const UINT* size, UINT* valid) {
+    (void)h; (void)buf; (void)size; (void)valid;
+    return AAC_DEC_TRANSPORT_SYNC_ERROR;
+}
+AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER h, INT_PCM* out, INT size, UINT flags) {
+    (void)h; (void)out; (void)size; (void)flags;
+    return AAC_DEC_TRANSPORT_SYNC_ERROR;
+}
+CStreamInfo* aacDecoder_GetStreamInfo(HANDLE_AACDECODER h) { (void)h; return NULL; }
+AAC_DECODER_ERROR aacDecoder_SetParam(HANDLE_AACDECODER h, int param, INT value) {
+    (void)h; (void)param; (void)value;
+    return AAC_DEC_OK;
+}
@@ -0,0 +1,7 @@
+// Host stand-in: the radio code only passes SDL surfaces through
+#pragma once
+#include <stdint.h>
+typedef uint8_t Uint8;
+typedef uint16_t Uint16;
+typedef uint32_t Uint32;
+typedef struct SDL_Surface SDL_Surface;
@@ -0,0 +1,5 @@
+// Host stand-in for the NextUI defines.h; userdata goes to a scratch directory
+#pragma once
+#define SDCARD_PATH TEST_DATA_DIR
+#define SHARED_USERDATA_PATH TEST_DATA_DIR "/shared"
+#define USERDATA_PATH TEST_DATA_DIR "/user"
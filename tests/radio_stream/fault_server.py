@@ -0,0 +1,333 @@
+#!/usr/bin/env python3
+"""Fault-injection stand-in for radio stations, HLS streams and podcast feeds.
+
+Binds a free local port and runs the given command with the port as its last
+argument, then exits with the command's status. With --port <n> it serves on
+that port until interrupted, to point the player itself at.
+
+  /icy/stream.mp3    Icecast-style MP3 (128kbps 44.1kHz silent frames) paced in
+                     real time after an initial burst; icy-metaint 8000 with a
+                     new StreamTitle each block when asked for Icy-MetaData
+  /icy/edge.mp3      Same, metadata blocks cycling through the awkward cases:
+                     split across reads, empty, and the 4080-byte maximum
+  /hls/live.m3u8     Live window of HLS_WINDOW segments of HLS_SEGMENT_SEC
+                     that slides with the clock (no EXT-X-ENDLIST)
+  /hls/seg<n>.aac    ADTS segment n of the live stream
+  /feed.xml          RSS feed of FEED_ITEMS episodes, with ETag/Last-Modified
+                     (304 when they match) and gzip when the client accepts it
+  /redirect/<path>   302 to /<path>
+
+Faults go in the query string, which is carried over to redirects and to the
+segment URIs of a playlist:
+
+  latency=<ms>   delay before the response headers
+  kbps=<n>       cap the body's bandwidth
+  jitter=<ms>    pause up to ms (random) every 16KB, made up for afterwards
+  drop=<bytes>   hang up after this many body bytes
+  fail=<n>       hang up without a response on every n-th request with it
+  corrupt=<n>    flip one random byte in every n body bytes
+  burst=<bytes>  ICY bytes sent before real-time pacing starts (default 64KB)
+  gzip=1|bare    gzip playlists/feeds even unasked; bare omits Content-Encoding
+"""
+
+import gzip
+import http.server
+import random
+import socketserver
+import subprocess
+import sys
+import threading
+import time
+import urllib.parse
+
+MP3_FRAME = bytes([0xFF, 0xFB, 0x90, 0x64]) + bytes(413)  # MPEG-1 L3 128kbps 44.1kHz, silent
+MP3_BYTES_PER_SEC = len(MP3_FRAME) * 44100 / 1152
+ICY_METAINT = 8000
+ICY_BURST = 64 * 1024
+
+AAC_FRAME_SAMPLES = 1024
+AAC_PAYLOAD = 364  # ~128kbps at 44.1kHz
+HLS_SEGMENT_SEC = 2
+HLS_WINDOW = 4
+
+FEED_ITEMS = 200
+FEED_ETAG = '"feed-1"'
+FEED_LAST_MODIFIED = "Mon, 05 Oct 2026 08:00:00 GMT"
+
+CHUNK = 4096
+JITTER_SPAN = 16 * 1024
+
+start_time = time.monotonic()
+fail_count = 0
+counts_lock = threading.Lock()
+
+
+class Dropped(Exception):
+    pass
+
+
+def adts_frame():
+    length = 7 + AAC_PAYLOAD
+    # MPEG-4 AAC LC, 44.1kHz (index 4), 2 channels, no CRC
+    header = bytes([
+        0xFF, 0xF1,
+        (1 << 6) | (4 << 2) | (2 >> 2),
+        ((2 & 3) << 6) | (length >> 11),
+        (length >> 3) & 0xFF,
+        ((length & 7) << 5) | 0x1F,
+        0xFC,
+    ])
+    return header + bytes(AAC_PAYLOAD)
+
+
+ADTS_FRAME = adts_frame()
+SEGMENT_FRAMES = -(-HLS_SEGMENT_SEC * 44100 // AAC_FRAME_SAMPLES)
+
+
+def mp3_bytes(pos, n):
+    """n bytes of the endless MP3 stream from byte pos."""
+    start = pos % len(MP3_FRAME)
+    return (MP3_FRAME * (n // len(MP3_FRAME) + 2))[start:start + n]
+
+
+def live_sequence():
+    """Sequence number one past the newest complete segment."""
+    return HLS_WINDOW + int((time.monotonic() - start_time) // HLS_SEGMENT_SEC)
+
+
+def feed_xml(base):
+    items = []
+    for i in range(FEED_ITEMS):
+        n = FEED_ITEMS - i
+        items.append(
+            "<item><title>Episode %d</title><guid>stand-in-%d</guid>"
+            "<pubDate>Mon, %02d Oct 2026 08:00:00 GMT</pubDate>"
+            "<itunes:duration>1800</itunes:duration>"
+            "<description>Episode %d of the stand-in feed, long enough to look "
+            "like a real show note and make the feed worth compressing.</description>"
+            '<enclosure url="%s/media/%d.mp3" type="audio/mpeg" length="1000000"/></item>'
+            % (n, n, 1 + n % 28, n, base, n))
+    return ('<?xml version="1.0" encoding="UTF-8"?>'
+            '<rss version="2.0" xmlns:itunes="http://www.itunes.com/dtds/podcast-1.0.dtd">'
+            "<channel><title>Stand-in Feed</title><description>Fault injection</description>"
+            + "".join(items) + "</channel></rss>").encode()
+
+
+class Body:
+    """Writes a response body through the query's fault profile."""
+
+    def __init__(self, wfile, profile, rate=None, burst=0):
+        self.wfile = wfile
+        self.sent = 0
+        self.started = time.monotonic()
+        self.rand = random.Random(1234)
+        self.drop = int(profile.get("drop", 0))
+        self.corrupt = int(profile.get("corrupt", 0))
+        self.jitter = int(profile.get("jitter", 0)) / 1000.0
+        self.next_jitter = JITTER_SPAN
+        kbps = int(profile.get("kbps", 0))
+        if kbps > 0:
+            cap = kbps * 1000 / 8
+            rate = cap if rate is None else min(rate, cap)
+        self.rate = rate
+        self.burst = burst
+
+    def write(self, data, flush=False):
+        for pos in range(0, len(data), CHUNK):
+            self._write_chunk(bytearray(data[pos:pos + CHUNK]))
+        if flush:
+            self.wfile.flush()
+
+    def _write_chunk(self, chunk):
+        if self.drop and self.sent + len(chunk) > self.drop:
+            self.wfile.write(chunk[:self.drop - self.sent])
+            self.wfile.flush()
+            raise Dropped()
+        if self.corrupt:
+            for i in range(len(chunk)):
+                if self.rand.randrange(self.corrupt) == 0:
+                    chunk[i] ^= 0xFF
+        if self.jitter and self.sent >= self.next_jitter:
+            self.next_jitter += JITTER_SPAN
+            self.wfile.flush()
+            time.sleep(self.rand.uniform(0, self.jitter))
+        if self.rate:
+            due = self.started + max(0, self.sent + len(chunk) - self.burst) / self.rate
+            wait = due - time.monotonic()
+            if wait > 0:
+                self.wfile.flush()
+                time.sleep(wait)
+        self.wfile.write(chunk)
+        self.sent += len(chunk)
+
+
+class Handler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.0"
+
+    def log_message(self, fmt, *args):
+        pass
+
+    def do_GET(self):
+        url = urllib.parse.urlsplit(self.path)
+        self.route = url.path
+        self.query = url.query
+        self.profile = dict(urllib.parse.parse_qsl(url.query))
+
+        global fail_count
+        fail = int(self.profile.get("fail", 0))
+        if fail:
+            with counts_lock:
+                fail_count += 1
+                count = fail_count
+            if count % fail == 0:
+                return  # Hang up without a response
+        latency = int(self.profile.get("latency", 0))
+        if latency:
+            time.sleep(latency / 1000.0)
+
+        try:
+            if self.route.startswith("/redirect/"):
+                self.redirect()
+            elif self.route in ("/icy/stream.mp3", "/icy/edge.mp3"):
+                self.icy(edge=self.route == "/icy/edge.mp3")
+            elif self.route == "/hls/live.m3u8":
+                self.playlist()
+            elif self.route.startswith("/hls/seg") and self.route.endswith(".aac"):
+                self.segment()
+            elif self.route == "/feed.xml":
+                self.feed()
+            else:
+                self.send_error(404)
+        except (Dropped, BrokenPipeError, ConnectionResetError):
+            pass
+
+    def with_query(self, path):
+        return path + ("?" + self.query if self.query else "")
+
+    def redirect(self):
+        host, port = self.server.server_address
+        target = self.with_query(self.route[len("/redirect"):])
+        self.send_response(302)
+        self.send_header("Location", "http://%s:%d%s" % (host, port, target))
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+    def send_text(self, body, content_type, extra_headers=()):
+        mode = self.profile.get("gzip")
+        accepted = "gzip" in self.headers.get("Accept-Encoding", "")
+        encoded = mode in ("1", "bare") or accepted
+        if encoded:
+            body = gzip.compress(body)
+        self.send_response(200)
+        self.send_header("Content-Type", content_type)
+        self.send_header("Content-Length", str(len(body)))
+        if encoded and mode != "bare":
+            self.send_header("Content-Encoding", "gzip")
+        for name, value in extra_headers:
+            self.send_header(name, value)
+        self.end_headers()
+        Body(self.wfile, self.profile).write(body)
+
+    def icy(self, edge):
+        metaint = ICY_METAINT if self.headers.get("Icy-MetaData") == "1" else 0
+        self.send_response(200)
+        self.send_header("Content-Type", "audio/mpeg")
+        self.send_header("icy-br", "128")
+        self.send_header("icy-name", "Stand-in Radio")
+        if metaint:
+            self.send_header("icy-metaint", str(metaint))
+        self.end_headers()
+        self.wfile.flush()
+
+        body = Body(self.wfile, self.profile, rate=MP3_BYTES_PER_SEC,
+                    burst=int(self.profile.get("burst", ICY_BURST)))
+        pos = 0  # Audio bytes sent, frames back to back
+        block = 0
+        while True:
+            if not metaint:
+                body.write(mp3_bytes(pos, CHUNK))
+                pos += CHUNK
+                continue
+            # metaint bytes of audio (ending mid-frame, as servers do), then a block
+            body.write(mp3_bytes(pos, metaint))
+            pos += metaint
+            block += 1
+            meta = ("StreamTitle='Stand-in - Track %d';" % block).encode()
+            kind = block % 4 if edge else 0
+            if kind == 2:
+                meta = b""
+            elif kind == 3:
+                meta = meta + b" " * (4080 - len(meta))
+            meta += b"\0" * (-len(meta) % 16)
+            packet = bytes([len(meta) // 16]) + meta
+            if kind == 1:
+                # Length byte and half the block now, the rest in a later read
+                half = len(packet) // 2
+                body.write(packet[:half], flush=True)
+                time.sleep(0.05)
+                body.write(packet[half:])
+            else:
+                body.write(packet)
+
+    def playlist(self):
+        newest = live_sequence()
+        first = newest - HLS_WINDOW
+        lines = ["#EXTM3U", "#EXT-X-VERSION:3",
+                 "#EXT-X-TARGETDURATION:%d" % HLS_SEGMENT_SEC,
+                 "#EXT-X-MEDIA-SEQUENCE:%d" % first]
+        for seq in range(first, newest):
+            lines.append("#EXTINF:%.3f," % (SEGMENT_FRAMES * AAC_FRAME_SAMPLES / 44100))
+            lines.append(self.with_query("seg%d.aac" % seq))
+        self.send_text(("\n".join(lines) + "\n").encode(), "application/vnd.apple.mpegurl")
+
+    def segment(self):
+        try:
+            seq = int(self.route[len("/hls/seg"):-len(".aac")])
+        except ValueError:
+            self.send_error(404)
+            return
+        if seq >= live_sequence():
+            self.send_error(404)  # Not produced yet
+            return
+        body = ADTS_FRAME * SEGMENT_FRAMES
+        self.send_response(200)
+        self.send_header("Content-Type", "audio/aac")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        Body(self.wfile, self.profile).write(body)
+
+    def feed(self):
+        if (self.headers.get("If-None-Match") == FEED_ETAG or
+                self.headers.get("If-Modified-Since") == FEED_LAST_MODIFIED):
+            self.send_response(304)
+            self.send_header("ETag", FEED_ETAG)
+            self.end_headers()
+            return
+        host, port = self.server.server_address
+        self.send_text(feed_xml("http://%s:%d" % (host, port)), "application/rss+xml",
+                       (("ETag", FEED_ETAG), ("Last-Modified", FEED_LAST_MODIFIED)))
+
+
+class Server(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    daemon_threads = True
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit("usage: fault_server.py <command...> | --port <n>")
+    if sys.argv[1] == "--port":
+        server = Server(("0.0.0.0", int(sys.argv[2])), Handler)
+        print("Serving on port %d" % server.server_address[1])
+        server.serve_forever()
+        return
+
+    server = Server(("127.0.0.1", 0), Handler)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    port = str(server.server_address[1])
+    status = subprocess.call(sys.argv[1:] + [port])
+    server.shutdown()
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
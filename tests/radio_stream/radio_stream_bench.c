@@ -0,0 +1,206 @@
+// Streaming regression bench against the fault-injection stand-in
+// (fault_server.py). Plays each scenario through the real Radio_play() for
+// PLAY_SEC, pulling audio at the stream's rate the way the audio callback
+// does, and reports time to first audio, rebuffers and CPU. Then times
+// radio_net_fetch() over gzip, redirects and faults, and revalidates a feed.
+// Exits non-zero if a scenario that should play never does, or a fetch
+// comes back wrong.
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+#include "defines.h"
+#include "radio.h"
+#include "radio_net.h"
+#include "http_client.h"
+
+#define PLAY_SEC 10
+#define TICK_MS 10              // Audio callback period being imitated
+#define FETCH_BUF (256 * 1024)
+
+extern volatile int stub_sample_rate;
+
+typedef struct {
+    const char* name;
+    const char* path;
+    bool expect_audio;          // Must reach first audio within PLAY_SEC
+} PlayScenario;
+
+static const PlayScenario play_scenarios[] = {
+    {"icy clean", "/icy/stream.mp3", true},
+    {"icy no burst", "/icy/stream.mp3?burst=0", true},
+    {"icy 800ms latency", "/icy/stream.mp3?latency=800", true},
+    {"icy jitter up to 1.5s", "/icy/stream.mp3?jitter=1500", true},
+    {"icy capped at 112kbps", "/icy/stream.mp3?kbps=112", true},
+    {"icy metadata edge cases", "/icy/edge.mp3", true},
+    {"icy corrupt 1 in 4000", "/icy/stream.mp3?corrupt=4000", true},
+    {"icy drop after 160KB", "/icy/stream.mp3?drop=163840", true},
+    {"icy via redirect", "/redirect/icy/stream.mp3", true},
+    {"hls live", "/hls/live.m3u8", true},
+    {"hls gzip playlist", "/hls/live.m3u8?gzip=1", true},
+    {"hls 1.5s per request", "/hls/live.m3u8?latency=1500", true},
+    {"hls every 3rd request fails", "/hls/live.m3u8?fail=3", true},
+    {"hls capped at 96kbps", "/hls/live.m3u8?kbps=96", false},
+};
+
+typedef struct {
+    const char* name;
+    const char* path;
+    bool expect_ok;
+} FetchScenario;
+
+static const FetchScenario fetch_scenarios[] = {
+    {"playlist", "/hls/live.m3u8", true},
+    {"playlist gzip", "/hls/live.m3u8?gzip=1", true},
+    {"playlist gzip, no header", "/hls/live.m3u8?gzip=bare", true},
+    {"playlist via two redirects", "/redirect/redirect/hls/live.m3u8", true},
+    {"feed gzip", "/feed.xml?gzip=1", true},
+    {"feed 500ms + 256kbps", "/feed.xml?latency=500&kbps=256", true},
+    {"feed dropped mid-body", "/feed.xml?drop=2000", false},
+};
+
+static const char* state_name(RadioState s) {
+    switch (s) {
+        case RADIO_STATE_STOPPED: return "stopped";
+        case RADIO_STATE_CONNECTING: return "connecting";
+        case RADIO_STATE_BUFFERING: return "buffering";
+        case RADIO_STATE_PLAYING: return "playing";
+        case RADIO_STATE_ERROR: return "error";
+        default: return "?";
+    }
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double cpu_sec(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 +
+           ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+// Play one scenario, pulling audio in real time. Returns false if it failed
+// its expectation
+static bool run_play(const char* base, const PlayScenario* sc) {
+    char url[RADIO_MAX_URL];
+    snprintf(url, sizeof(url), "%s%s", base, sc->path);
+
+    static int16_t buf[48000 * 2];
+    double start = now_sec();
+    double cpu_start = cpu_sec();
+    int64_t pulled = 0;  // Frames requested so far
+
+    int ret = Radio_play(url);
+    while (ret == 0 && now_sec() - start < PLAY_SEC) {
+        usleep(TICK_MS * 1000);
+        Radio_update();
+
+        int rate = stub_sample_rate > 0 ? stub_sample_rate : 48000;
+        int64_t due = (int64_t)((now_sec() - start) * rate);
+        int frames = (int)(due - pulled);
+        if (frames > rate) frames = rate;
+        if (frames > 0) {
+            Radio_getAudioSamples(buf, frames * 2);
+            pulled = due;
+        }
+    }
+
+    double wall = now_sec() - start;
+    double cpu = cpu_sec() - cpu_start;
+    RadioPlaybackStats stats = *Radio_getPlaybackStats();
+    RadioState state = Radio_getState();
+    char title[40];
+    snprintf(title, sizeof(title), "%s", Radio_getMetadata()->title);
+    Radio_stop();
+
+    bool ok = !sc->expect_audio || stats.first_audio_ms >= 0;
+    char first[16];
+    if (stats.first_audio_ms >= 0) {
+        snprintf(first, sizeof(first), "%dms", stats.first_audio_ms);
+    } else {
+        snprintf(first, sizeof(first), "none");
+    }
+    printf("%-28s %8s %4d %7dms %6.0fms %5.1f%%  %-10s %s%s\n", sc->name, first,
+           stats.rebuffer_count, stats.rebuffer_ms, cpu * 1000, cpu * 100 / wall,
+           state_name(state), title, ok ? "" : "  FAIL");
+    return ok;
+}
+
+static bool run_fetch(const char* base, const FetchScenario* sc, uint8_t* buf) {
+    char url[RADIO_MAX_URL];
+    snprintf(url, sizeof(url), "%s%s", base, sc->path);
+
+    double start = now_sec();
+    int len = radio_net_fetch(url, buf, FETCH_BUF, NULL, 0);
+    double elapsed = now_sec() - start;
+
+    bool ok = (len > 0) == sc->expect_ok;
+    printf("%-28s %7.0fms %8d bytes%s\n", sc->name, elapsed * 1000, len, ok ? "" : "  FAIL");
+    return ok;
+}
+
+// A feed fetched once and revalidated must come back 304
+static bool run_revalidate(const char* base, uint8_t* buf) {
+    char url[RADIO_MAX_URL];
+    snprintf(url, sizeof(url), "%s/feed.xml", base);
+
+    HttpValidators validators;
+    memset(&validators, 0, sizeof(validators));
+    int first = http_fetch_conditional(url, buf, FETCH_BUF, &validators);
+    double start = now_sec();
+    int second = http_fetch_conditional(url, buf, FETCH_BUF, &validators);
+    double elapsed = now_sec() - start;
+
+    bool ok = first > 0 && second == HTTP_NOT_MODIFIED;
+    printf("%-28s %7.0fms %s%s\n", "feed revalidation", elapsed * 1000,
+           second == HTTP_NOT_MODIFIED ? "304" : "no 304", ok ? "" : "  FAIL");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <stand-in server port>\n", argv[0]);
+        return 2;
+    }
+    char base[64];
+    snprintf(base, sizeof(base), "http://127.0.0.1:%s", argv[1]);
+
+    mkdir(TEST_DATA_DIR, 0755);
+    mkdir(SHARED_USERDATA_PATH, 0755);
+    if (Radio_init() != 0) {
+        fprintf(stderr, "Radio_init failed\n");
+        return 1;
+    }
+
+    int failures = 0;
+    printf("%-28s %8s %4s %9s %8s %6s  %-10s %s\n", "scenario", "1st audio", "rebuf",
+           "stalled", "cpu", "cpu", "end state", "title");
+    for (int i = 0; i < (int)(sizeof(play_scenarios) / sizeof(play_scenarios[0])); i++) {
+        if (!run_play(base, &play_scenarios[i])) failures++;
+    }
+    Radio_quit();
+
+    uint8_t* buf = malloc(FETCH_BUF);
+    if (!buf) return 1;
+    printf("\n%-28s %9s %s\n", "fetch", "time", "result");
+    for (int i = 0; i < (int)(sizeof(fetch_scenarios) / sizeof(fetch_scenarios[0])); i++) {
+        if (!run_fetch(base, &fetch_scenarios[i], buf)) failures++;
+    }
+    if (!run_revalidate(base, buf)) failures++;
+    free(buf);
+
+    if (failures) {
+        fprintf(stderr, "radio_stream_bench: %d scenario(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
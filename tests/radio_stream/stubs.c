@@ -0,0 +1,125 @@
+// Link stand-ins for the parts of the player the radio stream code reaches.
+// MP3 decodes for real (dr_mp3); the AAC decoder is a stand-in that turns each
+// ADTS frame into silence, which is all the stand-in server's segments hold.
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <fdk-aac/aacdecoder_lib.h>
+
+#include "album_art.h"
+#include "radio_curated.h"
+#include "radio_ogg.h"
+
+#define DR_MP3_IMPLEMENTATION
+#include "dr_mp3.h"
+
+// Output rate the stream asked for, read by the bench to pace playback
+volatile int stub_sample_rate = 0;
+
+void Player_resumeAudio(void) {}
+void Player_pauseAudio(void) {}
+void Player_resetSampleRate(void) { stub_sample_rate = 0; }
+void Player_setSampleRate(int sample_rate) { stub_sample_rate = sample_rate; }
+
+void album_art_init(void) {}
+void album_art_cleanup(void) {}
+void album_art_fetch(const char* artist, const char* title) { (void)artist; (void)title; }
+struct SDL_Surface* album_art_get(void) { return NULL; }
+void album_art_clear(void) {}
+
+void radio_curated_init(void) {}
+void radio_curated_cleanup(void) {}
+int radio_curated_get_country_count(void) { return 0; }
+const CuratedCountry* radio_curated_get_countries(void) { return NULL; }
+int radio_curated_get_station_count(const char* country_code) { (void)country_code; return 0; }
+const CuratedStation* radio_curated_get_stations(const char* country_code, int* count) {
+    (void)country_code;
+    *count = 0;
+    return NULL;
+}
+
+int radio_ogg_open(RadioOggPcmCallback on_pcm, RadioOggTagsCallback on_tags) {
+    (void)on_pcm;
+    (void)on_tags;
+    return -1;
+}
+void radio_ogg_close(void) {}
+int radio_ogg_feed(const uint8_t* data, int len) { (void)data; (void)len; return -1; }
+
+// ============== AAC DECODER ==============
+
+#define STUB_AAC_INBUF 8192  // FDK-AAC's transport input buffer size
+#define STUB_AAC_FRAME 1024
+
+struct AAC_DECODER_INSTANCE {
+    UCHAR buf[STUB_AAC_INBUF];
+    UINT len;
+    CStreamInfo info;
+};
+
+static const INT adts_rates[] = {96000, 88200, 64000, 48000, 44100, 32000, 24000,
+                                 22050, 16000, 12000, 11025, 8000, 7350};
+
+static void drop_input(HANDLE_AACDECODER h, UINT n) {
+    memmove(h->buf, h->buf + n, h->len - n);
+    h->len -= n;
+}
+
+HANDLE_AACDECODER aacDecoder_Open(int transport, UINT layers) {
+    (void)transport;
+    (void)layers;
+    return (HANDLE_AACDECODER)calloc(1, sizeof(struct AAC_DECODER_INSTANCE));
+}
+
+void aacDecoder_Close(HANDLE_AACDECODER h) { free(h); }
+
+AAC_DECODER_ERROR aacDecoder_Fill(HANDLE_AACDECODER h, UCHAR** buf, const UINT* size, UINT* valid) {
+    UINT n = *valid;
+    if (n > STUB_AAC_INBUF - h->len) n = STUB_AAC_INBUF - h->len;
+    memcpy(h->buf + h->len, buf[0] + (size[0] - *valid), n);
+    h->len += n;
+    *valid -= n;
+    return AAC_DEC_OK;
+}
+
+AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER h, INT_PCM* out, INT size, UINT flags) {
+    (void)flags;
+
+    // Skip to the next ADTS sync word
+    UINT skip = 0;
+    while (skip + 1 < h->len && !(h->buf[skip] == 0xFF && (h->buf[skip + 1] & 0xF6) == 0xF0)) skip++;
+    if (skip > 0) {
+        drop_input(h, skip);
+        return AAC_DEC_TRANSPORT_SYNC_ERROR;
+    }
+    if (h->len < 7) return AAC_DEC_NOT_ENOUGH_BITS;
+
+    const UCHAR* p = h->buf;
+    UINT frame_len = ((p[3] & 3) << 11) | (p[4] << 3) | (p[5] >> 5);
+    UINT rate_index = (p[2] >> 2) & 15;
+    INT channels = ((p[2] & 1) << 2) | (p[3] >> 6);
+    if (frame_len < 7 || rate_index >= sizeof(adts_rates) / sizeof(adts_rates[0]) ||
+        channels < 1 || channels > 2) {
+        drop_input(h, 1);
+        return AAC_DEC_TRANSPORT_SYNC_ERROR;
+    }
+    if (h->len < frame_len) return AAC_DEC_NOT_ENOUGH_BITS;
+    drop_input(h, frame_len);
+
+    if (size < STUB_AAC_FRAME * channels) return AAC_DEC_TRANSPORT_SYNC_ERROR;
+    memset(out, 0, STUB_AAC_FRAME * channels * sizeof(INT_PCM));
+    h->info.sampleRate = adts_rates[rate_index];
+    h->info.frameSize = STUB_AAC_FRAME;
+    h->info.numChannels = channels;
+    return AAC_DEC_OK;
+}
+
+CStreamInfo* aacDecoder_GetStreamInfo(HANDLE_AACDECODER h) { return &h->info; }
+
+AAC_DECODER_ERROR aacDecoder_SetParam(HANDLE_AACDECODER h, int param, INT value) {
+    (void)value;
+    if (param == AAC_TPDEC_CLEAR_BUFFER) h->len = 0;
+    return AAC_DEC_OK;
+}
@@ -0,0 +1,8 @@
+// Host stand-in for the NextUI api.h (logging only)
+#pragma once
+#include <stdio.h>
+#include <stdbool.h>
+#include <SDL2/SDL.h>
+
+#define LOG_error(...) fprintf(stderr, __VA_ARGS__)
+#define LOG_info(...) fprintf(stderr, __VA_ARGS__)
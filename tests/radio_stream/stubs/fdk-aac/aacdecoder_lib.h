@@ -0,0 +1,27 @@
+// Host stand-in for the FDK-AAC decoder API used by radio.c (see stubs.c)
+#pragma once
+typedef unsigned char UCHAR;
+typedef unsigned int UINT;
+typedef int INT;
+typedef short INT_PCM;
+typedef struct AAC_DECODER_INSTANCE* HANDLE_AACDECODER;
+typedef enum {
+    AAC_DEC_OK = 0,
+    AAC_DEC_NOT_ENOUGH_BITS = 0x1002,
+    AAC_DEC_TRANSPORT_SYNC_ERROR = 0x0101
+} AAC_DECODER_ERROR;
+typedef struct {
+    INT sampleRate;
+    INT frameSize;
+    INT numChannels;
+} CStreamInfo;
+enum { TT_MP4_ADTS = 2 };
+enum { AAC_TPDEC_CLEAR_BUFFER = 0x0603 };
+#define IS_OUTPUT_VALID(e) ((e) == AAC_DEC_OK)
+
+HANDLE_AACDECODER aacDecoder_Open(int transport, UINT layers);
+void aacDecoder_Close(HANDLE_AACDECODER h);
+AAC_DECODER_ERROR aacDecoder_Fill(HANDLE_AACDECODER h, UCHAR** buf, const UINT* size, UINT* valid);
+AAC_DECODER_ERROR aacDecoder_DecodeFrame(HANDLE_AACDECODER h, INT_PCM* out, INT size, UINT flags);
+CStreamInfo* aacDecoder_GetStreamInfo(HANDLE_AACDECODER h);
+AAC_DECODER_ERROR aacDecoder_SetParam(HANDLE_AACDECODER h, int param, INT value);